@@ -6,7 +6,6 @@
 
 #include "GFX/Mesh.hpp"
 #include "GFX/Renderer.hpp"
-#include "GFX/Primitives.hpp"
 
 #include "Input/KeyCode.hpp"
 
@@ -53,9 +52,6 @@ private:
 	glm::vec2                  m_BallPos;
 	glm::vec2                  m_BallDir;
 
-	GFX::Object                m_Paddle;
-	GFX::Object                m_Ball;
-	GFX::Object                m_Midline;
 
 	ClientPacket               m_Packet = {};
 	bool                       m_IsPacketDirty = true;
@@ -68,12 +64,7 @@ MyApp::MyApp(int argc, char** argv)
 	, m_P1Pos(kDefaultPaddleOffsetX, kWinHeight / 2 - kPaddleSize.y / 2)
 	, m_P2Pos(kWinWidth - kPaddleSize.x - kDefaultPaddleOffsetX, kWinHeight / 2 - kPaddleSize.y / 2)
 	, m_BallPos(kWinWidth / 2 - kBallSize / 2, kWinHeight / 2 - kBallSize / 2)
-	, m_Paddle(GFX::Primitives::CreateQuad({}, kPaddleSize.x, kPaddleSize.y))
-	, m_Ball(GFX::Primitives::CreateQuad({}, kBallSize, kBallSize))
-	, m_Midline(GFX::Primitives::CreateLine({ kWinWidth / 2, .0F, .0F }, { kWinWidth / 2, kWinHeight, .0F }))
 {
-	m_Paddle.Rotate(glm::radians(-90.0F), glm::vec3{ 1.0F, .0F, .0F });
-	m_Ball.Rotate(glm::radians(-90.0F), glm::vec3{ 1.0F, .0F, .0F });
 }
 
 auto MyApp::OnInit() -> Status
@@ -168,19 +159,16 @@ auto MyApp::OnShutdown() -> Status
 
 auto MyApp::RenderPlayground() -> void
 {
-	m_Rdr->SubmitObject(m_Midline, GFX::Renderer::PrimitiveMode::Lines);
+	m_Rdr->Debug().Line({ kWinWidth / 2, .0F, .0F }, { kWinWidth / 2, kWinHeight, .0F });
 }
 
 auto MyApp::RenderPlayers() -> void
 {
-	m_Paddle.SetPosition({ m_P1Pos + kPaddleSize * .5F, 0.0F });
-	m_Rdr->SubmitObject(m_Paddle, GFX::Renderer::PrimitiveMode::Triangles);
+	auto& sprites = m_Rdr->Sprites();
 
-	m_Paddle.SetPosition({ m_P2Pos + kPaddleSize * .5F, 0.0F });
-	m_Rdr->SubmitObject(m_Paddle, GFX::Renderer::PrimitiveMode::Triangles);
-
-	m_Ball.SetPosition({ m_BallPos + kBallSize * .5F, 0.0F });
-	m_Rdr->SubmitObject(m_Ball, GFX::Renderer::PrimitiveMode::Triangles);
+	sprites.Quad(m_P1Pos + kPaddleSize * .5F, kPaddleSize);
+	sprites.Quad(m_P2Pos + kPaddleSize * .5F, kPaddleSize);
+	sprites.Quad(m_BallPos + kBallSize * .5F, { kBallSize, kBallSize });
 }
 
 auto MyApp::OnPacketReceived(U32 /*sender*/, Net::Packet packet) -> void
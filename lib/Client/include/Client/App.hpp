@@ -187,6 +187,11 @@ namespace Gaze::Client {
 		 */
 		auto Send(Net::Packet packet, U8 channel = 0) -> bool;
 
+		/**
+		 * @brief Get the statistics of the connection to the server
+		 */
+		[[nodiscard]] auto NetStats() const -> Net::Client::Stats;
+
 	private:
 		Net::Client m_Client; /**< Network client. Responsible for remote server connections */
 		Log::Logger m_Logger; /**< Engine Logger. Responsible for network client-specific logging */
@@ -201,6 +201,11 @@ namespace Gaze::Client {
 		return m_Client.Send(std::move(packet), channel);
 	}
 
+	auto ClientApp::NetStats() const -> Net::Client::Stats
+	{
+		return m_Client.GetStats();
+	}
+
 	ServerApp::ServerApp(int argc, char** argv)
 		: App(argc, argv)
 		, m_Logger("AppServer")
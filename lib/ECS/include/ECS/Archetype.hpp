@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ECS/Component.hpp"
+#include "ECS/Entity.hpp"
+
+#include "Core/Type.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Storage for all entities sharing the exact same set of components
+	 *
+	 * Entities are packed into fixed-size chunks. Inside a chunk each component
+	 * type has its own contiguous array (structure-of-arrays), so iterating a
+	 * few components of many entities touches only the memory it needs.
+	 * Rows are kept dense: removing an entity moves the last row into the hole.
+	 */
+	class Archetype
+	{
+	public:
+		static constexpr auto kChunkSize      = std::size_t(16 * 1024);
+		static constexpr auto kChunkAlignment = std::size_t(64);
+
+	public:
+		/**
+		 * @param components The component types stored, in any order.
+		 */
+		Archetype(std::vector<ComponentInfo> components);
+		Archetype(const Archetype&) = delete;
+		Archetype(Archetype&&) = delete;
+		~Archetype();
+
+		auto operator=(const Archetype&) = delete;
+		auto operator=(Archetype&&) = delete;
+
+		/**
+		 * @brief Append a row for @p entity.
+		 *
+		 * The row's components are left uninitialized; the caller must construct
+		 * every one of them before the row is used or removed.
+		 *
+		 * @return The new row.
+		 */
+		[[nodiscard]] auto Push(Entity entity) -> U32;
+		/**
+		 * @brief Destroy a row's components and fill the hole with the last row.
+		 *
+		 * @return The entity moved into @p row, or kNullEntity if @p row was the last row.
+		 */
+		auto Remove(U32 row) noexcept -> Entity;
+
+		/**
+		 * @brief Get the position of a component type in Components(), or -1 if absent.
+		 */
+		[[nodiscard]] auto TypeIndex(ComponentID id)                   const noexcept -> I32;
+		/**
+		 * @brief Get a component of a row.
+		 *
+		 * @param typeIndex The component type's position in Components().
+		 * @param row The row.
+		 */
+		[[nodiscard]] auto Component(I32 typeIndex, U32 row)           const noexcept -> void*;
+		/**
+		 * @brief Get the start of a component type's array in a chunk.
+		 */
+		[[nodiscard]] auto Column(I32 typeIndex, std::size_t chunk)    const noexcept -> void*;
+
+		[[nodiscard]] auto Mask()                                      const noexcept -> const ComponentMask&;
+		[[nodiscard]] auto Components()                                const noexcept -> const std::vector<ComponentInfo>&;
+		[[nodiscard]] auto Entities()                                  const noexcept -> const std::vector<Entity>&;
+		[[nodiscard]] auto Size()                                      const noexcept -> std::size_t;
+		[[nodiscard]] auto ChunkCapacity()                             const noexcept -> std::size_t;
+		[[nodiscard]] auto ChunkCount()                                const noexcept -> std::size_t;
+		/**
+		 * @brief Get the number of rows used in a chunk.
+		 */
+		[[nodiscard]] auto ChunkRows(std::size_t chunk)                const noexcept -> std::size_t;
+
+	private:
+		struct alignas(kChunkAlignment) Chunk
+		{
+			Byte data[kChunkSize];
+		};
+
+	private:
+		ComponentMask              m_Mask;
+		std::vector<ComponentInfo> m_Components;
+		std::vector<std::size_t>   m_Offsets;       /**< Offset of each component array in a chunk */
+		std::size_t                m_ChunkCapacity;
+		std::vector<Unique<Chunk>> m_Chunks;
+		std::vector<Entity>        m_Entities;      /**< Entity of each row */
+	};
+
+	inline auto Archetype::Component(I32 typeIndex, U32 row) const noexcept -> void*
+	{
+		const auto idx = std::size_t(typeIndex);
+
+		return m_Chunks[row / m_ChunkCapacity]->data + m_Offsets[idx] + (row % m_ChunkCapacity) * m_Components[idx].size;
+	}
+
+	inline auto Archetype::Column(I32 typeIndex, std::size_t chunk) const noexcept -> void*
+	{
+		return m_Chunks[chunk]->data + m_Offsets[std::size_t(typeIndex)];
+	}
+
+	inline auto Archetype::Mask() const noexcept -> const ComponentMask&
+	{
+		return m_Mask;
+	}
+
+	inline auto Archetype::Components() const noexcept -> const std::vector<ComponentInfo>&
+	{
+		return m_Components;
+	}
+
+	inline auto Archetype::Entities() const noexcept -> const std::vector<Entity>&
+	{
+		return m_Entities;
+	}
+
+	inline auto Archetype::Size() const noexcept -> std::size_t
+	{
+		return m_Entities.size();
+	}
+
+	inline auto Archetype::ChunkCapacity() const noexcept -> std::size_t
+	{
+		return m_ChunkCapacity;
+	}
+
+	inline auto Archetype::ChunkCount() const noexcept -> std::size_t
+	{
+		return (m_Entities.size() + m_ChunkCapacity - 1) / m_ChunkCapacity;
+	}
+
+	inline auto Archetype::ChunkRows(std::size_t chunk) const noexcept -> std::size_t
+	{
+		const auto begin = chunk * m_ChunkCapacity;
+		return std::min(m_ChunkCapacity, m_Entities.size() - begin);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ECS/Entity.hpp"
+#include "ECS/World.hpp"
+
+#include "Core/Type.hpp"
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Structural changes recorded for later
+	 *
+	 * Lets code iterating a World queue entity creation/destruction and
+	 * component additions/removals, which are then applied in recording
+	 * order once iteration is over.
+	 */
+	class CommandBuffer
+	{
+	public:
+		/**
+		 * @brief Record the creation of an entity with the given components.
+		 */
+		template<typename... Ts>
+		auto Create(Ts&&... components) -> void;
+		/**
+		 * @brief Record the destruction of an entity.
+		 */
+		auto Destroy(Entity entity) -> void;
+		/**
+		 * @brief Record the addition of a component to an entity.
+		 */
+		template<typename T>
+		auto Add(Entity entity, T&& component) -> void;
+		/**
+		 * @brief Record the removal of a component from an entity.
+		 */
+		template<typename T>
+		auto Remove(Entity entity) -> void;
+
+		/**
+		 * @brief Apply all recorded commands to @p world, in order, and clear the buffer.
+		 *
+		 * Commands targeting entities that are no longer alive are skipped.
+		 */
+		auto Apply(World& world) -> void;
+
+		[[nodiscard]] auto IsEmpty() const noexcept -> bool;
+
+	private:
+		std::vector<std::function<void(World&)>> m_Commands;
+	};
+
+	template<typename... Ts>
+	auto CommandBuffer::Create(Ts&&... components) -> void
+	{
+		// Held through a shared pointer so move-only components fit in a std::function
+		auto data = MakeShared<std::tuple<std::remove_cvref_t<Ts>...>>(std::forward<Ts>(components)...);
+
+		m_Commands.emplace_back([data = std::move(data)](World& world) {
+			std::apply([&world](auto&... args) { world.Create(std::move(args)...); }, *data);
+		});
+	}
+
+	inline auto CommandBuffer::Destroy(Entity entity) -> void
+	{
+		m_Commands.emplace_back([entity](World& world) { world.Destroy(entity); });
+	}
+
+	template<typename T>
+	auto CommandBuffer::Add(Entity entity, T&& component) -> void
+	{
+		auto data = MakeShared<std::remove_cvref_t<T>>(std::forward<T>(component));
+
+		m_Commands.emplace_back([entity, data = std::move(data)](World& world) {
+			if (world.IsAlive(entity)) {
+				world.Add(entity, std::move(*data));
+			}
+		});
+	}
+
+	template<typename T>
+	auto CommandBuffer::Remove(Entity entity) -> void
+	{
+		m_Commands.emplace_back([entity](World& world) {
+			if (world.IsAlive(entity)) {
+				world.Remove<T>(entity);
+			}
+		});
+	}
+
+	inline auto CommandBuffer::IsEmpty() const noexcept -> bool
+	{
+		return m_Commands.empty();
+	}
+}
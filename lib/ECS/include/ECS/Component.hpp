@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Gaze::ECS {
+	using ComponentID = U32;
+
+	static constexpr auto kMaxComponents = 64;
+
+	/**
+	 * @brief A set of component types, one bit per ComponentID
+	 */
+	using ComponentMask = std::bitset<kMaxComponents>;
+
+	namespace Detail {
+		inline auto NextComponentID() noexcept -> ComponentID
+		{
+			static auto next = std::atomic<ComponentID>(0);
+			return next++;
+		}
+
+		template<typename T>
+		auto ComponentTypeID() noexcept -> ComponentID
+		{
+			static const auto id = NextComponentID();
+			return id;
+		}
+	}
+
+	/**
+	 * @brief Get the process-wide ID of a component type
+	 *
+	 * IDs are assigned on first use. cv-qualifiers and references are ignored,
+	 * so `const T&` and `T` share an ID.
+	 */
+	template<typename T>
+	auto ComponentTypeID() noexcept -> ComponentID
+	{
+		return Detail::ComponentTypeID<std::remove_cvref_t<T>>();
+	}
+
+	/**
+	 * @brief Build the mask of a list of component types
+	 */
+	template<typename... Ts>
+	auto MaskOf() noexcept -> ComponentMask
+	{
+		auto mask = ComponentMask();
+		(mask.set(ComponentTypeID<Ts>()), ...);
+		return mask;
+	}
+
+	/**
+	 * @brief Type-erased description of a component type, used by archetype storage
+	 */
+	struct ComponentInfo
+	{
+		ComponentID id;
+		std::size_t size;
+		std::size_t alignment;
+		auto (*moveConstruct)(void* dst, void* src) -> void; /**< Move-construct at @p dst from @p src */
+		auto (*destroy)(void* ptr) -> void;
+
+		template<typename T>
+		static auto Of() noexcept -> ComponentInfo
+		{
+			static_assert(std::is_nothrow_move_constructible_v<T>, "Components must be nothrow move constructible");
+
+			return {
+				.id            = ComponentTypeID<T>(),
+				.size          = sizeof(T),
+				.alignment     = alignof(T),
+				.moveConstruct = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+				.destroy       = [](void* ptr) { static_cast<T*>(ptr)->~T(); },
+			};
+		}
+	};
+}
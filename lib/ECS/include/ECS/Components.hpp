@@ -0,0 +1,53 @@
+#pragma once
+
+#include "GFX/Object.hpp"
+
+#include "Physics/Rigidbody.hpp"
+
+#include "Core/Type.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Local position, rotation and scale of an entity.
+	 */
+	struct Transform
+	{
+		glm::vec3 position = glm::vec3(.0F);
+		glm::quat rotation = glm::quat(1.F, .0F, .0F, .0F);
+		glm::vec3 scale    = glm::vec3(1.F);
+	};
+
+	/**
+	 * @brief World matrix of an entity, computed from its Transform.
+	 *
+	 * Kept apart from Transform so the renderer only streams through matrices.
+	 *
+	 * @see UpdateWorldTransforms()
+	 */
+	struct WorldTransform
+	{
+		glm::mat4 matrix = glm::mat4(1.F);
+	};
+
+	/**
+	 * @brief Something to draw. The object's own transform is ignored in favor of the WorldTransform.
+	 */
+	struct Renderable
+	{
+		GFX::Object object;
+	};
+
+	/**
+	 * @brief A physics body driving the entity's Transform.
+	 *
+	 * The body is shared with the Physics::World simulating it.
+	 */
+	struct Rigidbody
+	{
+		Shared<Physics::Rigidbody> body;
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <limits>
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Handle to an entity of a World
+	 *
+	 * The generation is bumped every time an index is recycled, so handles to
+	 * destroyed entities never alias newer ones.
+	 */
+	struct Entity
+	{
+		static constexpr auto kInvalidIndex = std::numeric_limits<U32>::max();
+
+		U32 index      = kInvalidIndex;
+		U32 generation = 0;
+
+		[[nodiscard]] constexpr auto IsNull() const noexcept -> bool
+		{
+			return index == kInvalidIndex;
+		}
+
+		constexpr auto operator==(const Entity&) const noexcept -> bool = default;
+	};
+
+	inline constexpr auto kNullEntity = Entity();
+}
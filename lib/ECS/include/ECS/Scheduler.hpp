@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ECS/CommandBuffer.hpp"
+#include "ECS/Component.hpp"
+#include "ECS/World.hpp"
+
+#include "Core/Type.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Runs systems over a World, in parallel where their data access allows
+	 *
+	 * Each system declares which component types it reads and writes. Systems
+	 * are grouped into stages, in registration order: a system joins the
+	 * earliest stage after every earlier system it conflicts with (one writes
+	 * what the other reads or writes). Systems of a stage run concurrently;
+	 * their command buffers are applied between stages, in registration order.
+	 */
+	class Scheduler
+	{
+	public:
+		/**
+		 * @brief The data a system touches
+		 */
+		struct Access
+		{
+			ComponentMask reads;
+			ComponentMask writes;
+			bool          exclusive = false; /**< Runs alone, on the calling thread. For systems touching state outside the World (e.g. the renderer) */
+		};
+
+		using SystemFn = std::function<void(World& world, CommandBuffer& commands)>;
+
+	public:
+		/**
+		 * @brief Register a system.
+		 *
+		 * @param name The system's name, for diagnostics.
+		 * @param access The component types the system reads and writes.
+		 * @param fn The system. Must not make structural changes to the world directly.
+		 */
+		auto Add(std::string name, Access access, SystemFn fn) -> void;
+		/**
+		 * @brief Run all systems once.
+		 *
+		 * @param world The world to run the systems on.
+		 * @param pool If not null, systems sharing a stage run in parallel on it.
+		 */
+		auto Run(World& world, Jobs::ThreadPool* pool = nullptr) -> void;
+
+		/**
+		 * @brief Get the systems' names, grouped by stage.
+		 */
+		[[nodiscard]] auto Stages() -> std::vector<std::vector<std::string>>;
+
+	private:
+		struct System
+		{
+			std::string   name;
+			Access        access;
+			SystemFn      fn;
+			CommandBuffer commands;
+		};
+
+		[[nodiscard]] static auto Conflicts(const Access& lhs, const Access& rhs) noexcept -> bool;
+
+		auto BuildStages() -> void;
+
+	private:
+		std::vector<System>                   m_Systems;
+		std::vector<std::vector<std::size_t>> m_Stages;
+		bool                                  m_IsDirty = false;
+	};
+}
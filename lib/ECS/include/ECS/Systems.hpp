@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ECS/World.hpp"
+
+#include "GFX/Light.hpp"
+#include "GFX/Renderer.hpp"
+
+#include "Core/Type.hpp"
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Copy the pose of every Rigidbody into its entity's Transform.
+	 *
+	 * Reads Rigidbody, writes Transform.
+	 */
+	auto SyncRigidbodies(World& world) -> void;
+	/**
+	 * @brief Recompute every WorldTransform from its entity's Transform.
+	 *
+	 * Reads Transform, writes WorldTransform.
+	 *
+	 * @param pool If not null, chunks are processed in parallel on it.
+	 */
+	auto UpdateWorldTransforms(World& world, Jobs::ThreadPool* pool = nullptr) -> void;
+	/**
+	 * @brief Submit every Renderable to the renderer at its WorldTransform.
+	 *
+	 * Reads Renderable and WorldTransform. Must run on the renderer's thread.
+	 */
+	auto SubmitRenderables(World& world, GFX::Renderer& renderer, const GFX::Light lights[], I32 nLights) -> void;
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include "ECS/Archetype.hpp"
+#include "ECS/Component.hpp"
+#include "ECS/Entity.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include "Core/Type.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Gaze::ECS {
+	/**
+	 * @brief Entities and their components, grouped by archetype
+	 *
+	 * Structural changes (creating/destroying entities, adding/removing
+	 * components) move entities between archetypes and are not allowed while
+	 * the world is being iterated; record them in a CommandBuffer instead and
+	 * apply it afterwards.
+	 */
+	class World
+	{
+	public:
+		World() = default;
+		World(const World&) = delete;
+		World(World&&) = delete;
+
+		auto operator=(const World&) = delete;
+		auto operator=(World&&) = delete;
+
+		/**
+		 * @brief Create an entity without components.
+		 */
+		[[nodiscard]] auto Create() -> Entity;
+		/**
+		 * @brief Create an entity with the given components.
+		 */
+		template<typename... Ts>
+		auto Create(Ts&&... components) -> Entity;
+		/**
+		 * @brief Destroy an entity and its components. Does nothing if the entity is not alive.
+		 */
+		auto Destroy(Entity entity) -> void;
+		[[nodiscard]] auto IsAlive(Entity entity) const noexcept -> bool;
+
+		/**
+		 * @brief Add a component to an entity, or overwrite it if the entity already has one.
+		 *
+		 * @return The entity's component.
+		 */
+		template<typename T>
+		auto Add(Entity entity, T&& component) -> std::remove_cvref_t<T>&;
+		/**
+		 * @brief Remove a component from an entity. Does nothing if the entity does not have it.
+		 */
+		template<typename T>
+		auto Remove(Entity entity) -> void;
+		/**
+		 * @brief Get a component of an entity.
+		 *
+		 * The pointer is invalidated by any structural change.
+		 *
+		 * @return The component, or nullptr if the entity is not alive or does not have it.
+		 */
+		template<typename T>
+		[[nodiscard]] auto Get(Entity entity) const noexcept -> T*;
+		template<typename T>
+		[[nodiscard]] auto Has(Entity entity) const noexcept -> bool;
+
+		/**
+		 * @brief Call @p fn for every chunk of entities having all of @p Ts.
+		 *
+		 * @p fn is called as `fn(std::size_t count, const Entity* entities, Ts*... components)`,
+		 * with one contiguous array per component type. Use `const T` for
+		 * read-only access.
+		 */
+		template<typename... Ts, typename Fn>
+		auto EachChunk(Fn&& fn) -> void;
+		/**
+		 * @brief Call @p fn for every entity having all of @p Ts.
+		 *
+		 * @p fn is called as `fn(Entity entity, Ts&... components)`.
+		 */
+		template<typename... Ts, typename Fn>
+		auto Each(Fn&& fn) -> void;
+		/**
+		 * @brief Same as Each(), with chunks spread across a thread pool.
+		 *
+		 * @p fn may run concurrently for different entities.
+		 */
+		template<typename... Ts, typename Fn>
+		auto ParallelEach(Jobs::ThreadPool& pool, Fn&& fn) -> void;
+
+		[[nodiscard]] auto EntityCount() const noexcept -> std::size_t;
+
+	private:
+		struct Record
+		{
+			Archetype* archetype;
+			U32        row;
+			U32        generation;
+		};
+
+		/**
+		 * @brief Forbids structural changes while alive.
+		 */
+		class IterationGuard
+		{
+		public:
+			explicit IterationGuard(const World& world) noexcept : m_World(world) { m_World.m_IterationDepth++; }
+			~IterationGuard() noexcept { m_World.m_IterationDepth--; }
+
+			IterationGuard(const IterationGuard&) = delete;
+			auto operator=(const IterationGuard&) = delete;
+
+		private:
+			const World& m_World;
+		};
+
+		template<typename T>
+		auto Register() -> void;
+		auto FindOrCreateArchetype(const ComponentMask& mask) -> Archetype&;
+		auto AllocateEntity(Archetype& archetype)             -> std::pair<Entity, U32>;
+		/**
+		 * @brief Move an entity to another archetype, carrying over the components both share.
+		 *
+		 * @return The entity's new row. Components only present in @p target are left uninitialized.
+		 */
+		auto MoveEntity(Entity entity, Archetype& target)     -> U32;
+		auto AssertMutable()                            const noexcept -> void;
+
+		template<typename... Ts, typename Fn, std::size_t... Is>
+		static auto InvokeChunk(
+			Archetype& archetype,
+			std::size_t chunk,
+			const std::array<I32, sizeof...(Ts)>& typeIndices,
+			Fn& fn,
+			std::index_sequence<Is...>
+		) -> void;
+
+	private:
+		std::vector<Record>                                  m_Records;
+		std::vector<U32>                                     m_FreeIndices;
+		std::unordered_map<ComponentMask, Unique<Archetype>> m_Archetypes;
+		std::vector<Archetype*>                              m_ArchetypeList;
+		std::array<ComponentInfo, kMaxComponents>            m_ComponentInfos{};
+		ComponentMask                                        m_Registered;
+		mutable std::atomic<I32>                             m_IterationDepth{ 0 };
+	};
+
+	template<typename... Ts>
+	auto World::Create(Ts&&... components) -> Entity
+	{
+		(Register<std::remove_cvref_t<Ts>>(), ...);
+
+		auto& archetype = FindOrCreateArchetype(MaskOf<Ts...>());
+		const auto [entity, row] = AllocateEntity(archetype);
+
+		(new (archetype.Component(archetype.TypeIndex(ComponentTypeID<Ts>()), row)) std::remove_cvref_t<Ts>(std::forward<Ts>(components)), ...);
+
+		return entity;
+	}
+
+	template<typename T>
+	auto World::Add(Entity entity, T&& component) -> std::remove_cvref_t<T>&
+	{
+		using ComponentType = std::remove_cvref_t<T>;
+
+		GAZE_ASSERT(IsAlive(entity), "Entity is not alive");
+		AssertMutable();
+		Register<ComponentType>();
+
+		const auto  id     = ComponentTypeID<ComponentType>();
+		const auto& record = m_Records[entity.index];
+
+		if (record.archetype->Mask().test(id)) {
+			auto& existing = *static_cast<ComponentType*>(record.archetype->Component(record.archetype->TypeIndex(id), record.row));
+			existing = std::forward<T>(component);
+			return existing;
+		}
+
+		auto mask = record.archetype->Mask();
+		mask.set(id);
+
+		auto& target = FindOrCreateArchetype(mask);
+		const auto row = MoveEntity(entity, target);
+
+		return *new (target.Component(target.TypeIndex(id), row)) ComponentType(std::forward<T>(component));
+	}
+
+	template<typename T>
+	auto World::Remove(Entity entity) -> void
+	{
+		GAZE_ASSERT(IsAlive(entity), "Entity is not alive");
+		AssertMutable();
+
+		const auto  id     = ComponentTypeID<T>();
+		const auto& record = m_Records[entity.index];
+
+		if (!record.archetype->Mask().test(id)) {
+			return;
+		}
+
+		auto mask = record.archetype->Mask();
+		mask.reset(id);
+
+		MoveEntity(entity, FindOrCreateArchetype(mask));
+	}
+
+	template<typename T>
+	auto World::Get(Entity entity) const noexcept -> T*
+	{
+		if (!IsAlive(entity)) {
+			return nullptr;
+		}
+
+		const auto& record    = m_Records[entity.index];
+		const auto  typeIndex = record.archetype->TypeIndex(ComponentTypeID<T>());
+
+		return typeIndex < 0 ? nullptr : static_cast<T*>(record.archetype->Component(typeIndex, record.row));
+	}
+
+	template<typename T>
+	auto World::Has(Entity entity) const noexcept -> bool
+	{
+		return IsAlive(entity) && m_Records[entity.index].archetype->Mask().test(ComponentTypeID<T>());
+	}
+
+	template<typename... Ts, typename Fn>
+	auto World::EachChunk(Fn&& fn) -> void
+	{
+		const auto mask  = MaskOf<Ts...>();
+		const auto guard = IterationGuard(*this);
+
+		for (auto* archetype : m_ArchetypeList) {
+			if ((archetype->Mask() & mask) != mask || archetype->Size() == 0) {
+				continue;
+			}
+
+			const auto typeIndices = std::array<I32, sizeof...(Ts)>{ archetype->TypeIndex(ComponentTypeID<Ts>())... };
+			for (auto chunk = 0UL; chunk < archetype->ChunkCount(); chunk++) {
+				InvokeChunk<Ts...>(*archetype, chunk, typeIndices, fn, std::index_sequence_for<Ts...>());
+			}
+		}
+	}
+
+	template<typename... Ts, typename Fn>
+	auto World::Each(Fn&& fn) -> void
+	{
+		EachChunk<Ts...>([&fn](std::size_t count, const Entity* entities, Ts*... components) {
+			for (auto i = 0UL; i < count; i++) {
+				fn(entities[i], components[i]...);
+			}
+		});
+	}
+
+	template<typename... Ts, typename Fn>
+	auto World::ParallelEach(Jobs::ThreadPool& pool, Fn&& fn) -> void
+	{
+		struct Work
+		{
+			Archetype*                     archetype;
+			std::size_t                    chunk;
+			std::array<I32, sizeof...(Ts)> typeIndices;
+		};
+
+		const auto mask  = MaskOf<Ts...>();
+		const auto guard = IterationGuard(*this);
+
+		auto work = std::vector<Work>();
+		for (auto* archetype : m_ArchetypeList) {
+			if ((archetype->Mask() & mask) != mask) {
+				continue;
+			}
+
+			const auto typeIndices = std::array<I32, sizeof...(Ts)>{ archetype->TypeIndex(ComponentTypeID<Ts>())... };
+			for (auto chunk = 0UL; chunk < archetype->ChunkCount(); chunk++) {
+				work.push_back({ archetype, chunk, typeIndices });
+			}
+		}
+
+		const auto perChunk = [&fn](std::size_t count, const Entity* entities, Ts*... components) {
+			for (auto i = 0UL; i < count; i++) {
+				fn(entities[i], components[i]...);
+			}
+		};
+
+		pool.ParallelFor(work.size(), 1, [&](std::size_t begin, std::size_t end) {
+			for (auto i = begin; i < end; i++) {
+				InvokeChunk<Ts...>(*work[i].archetype, work[i].chunk, work[i].typeIndices, perChunk, std::index_sequence_for<Ts...>());
+			}
+		});
+	}
+
+	template<typename T>
+	auto World::Register() -> void
+	{
+		const auto id = ComponentTypeID<T>();
+		GAZE_ASSERT(id < kMaxComponents, "Too many component types");
+
+		if (!m_Registered.test(id)) {
+			m_ComponentInfos[id] = ComponentInfo::Of<T>();
+			m_Registered.set(id);
+		}
+	}
+
+	template<typename... Ts, typename Fn, std::size_t... Is>
+	auto World::InvokeChunk(
+		Archetype& archetype,
+		std::size_t chunk,
+		const std::array<I32, sizeof...(Ts)>& typeIndices,
+		Fn& fn,
+		std::index_sequence<Is...>
+	) -> void
+	{
+		fn(
+			archetype.ChunkRows(chunk),
+			archetype.Entities().data() + chunk * archetype.ChunkCapacity(),
+			static_cast<Ts*>(archetype.Column(typeIndices[Is], chunk))...
+		);
+	}
+}
@@ -0,0 +1,118 @@
+#include "ECS/Archetype.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+
+namespace Gaze::ECS {
+	static auto AlignUp(std::size_t value, std::size_t alignment) noexcept -> std::size_t
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	Archetype::Archetype(std::vector<ComponentInfo> components)
+		: m_Mask()
+		, m_Components(std::move(components))
+		, m_Offsets(m_Components.size())
+		, m_ChunkCapacity(0)
+		, m_Chunks()
+		, m_Entities()
+	{
+		// Largest alignment first keeps the padding between arrays small
+		std::sort(m_Components.begin(), m_Components.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.alignment != rhs.alignment ? lhs.alignment > rhs.alignment : lhs.id < rhs.id;
+		});
+
+		auto rowSize = std::size_t(0);
+		for (const auto& info : m_Components) {
+			GAZE_ASSERT(info.alignment <= kChunkAlignment, "Component alignment too large");
+
+			m_Mask.set(info.id);
+			rowSize += info.size;
+		}
+
+		// Component-less entities still take a row
+		m_ChunkCapacity = rowSize == 0 ? kChunkSize : kChunkSize / rowSize;
+		GAZE_ASSERT(m_ChunkCapacity > 0, "Components too large to fit a chunk");
+
+		const auto layout = [this](std::size_t capacity) {
+			auto offset = std::size_t(0);
+			for (auto i = 0UL; i < m_Components.size(); i++) {
+				offset       = AlignUp(offset, m_Components[i].alignment);
+				m_Offsets[i] = offset;
+				offset      += m_Components[i].size * capacity;
+			}
+			return offset;
+		};
+		while (layout(m_ChunkCapacity) > kChunkSize) {
+			m_ChunkCapacity--;
+		}
+	}
+
+	Archetype::~Archetype()
+	{
+		for (auto row = U32(0); row < m_Entities.size(); row++) {
+			for (auto i = 0UL; i < m_Components.size(); i++) {
+				m_Components[i].destroy(Component(I32(i), row));
+			}
+		}
+	}
+
+	auto Archetype::Push(Entity entity) -> U32
+	{
+		const auto row = U32(m_Entities.size());
+
+		if (row / m_ChunkCapacity >= m_Chunks.size()) {
+			m_Chunks.push_back(MakeUnique<Chunk>());
+		}
+		m_Entities.push_back(entity);
+
+		return row;
+	}
+
+	auto Archetype::Remove(U32 row) noexcept -> Entity
+	{
+		const auto last = U32(m_Entities.size() - 1);
+
+		for (auto i = 0UL; i < m_Components.size(); i++) {
+			auto* dst = Component(I32(i), row);
+
+			m_Components[i].destroy(dst);
+			if (row != last) {
+				auto* src = Component(I32(i), last);
+
+				m_Components[i].moveConstruct(dst, src);
+				m_Components[i].destroy(src);
+			}
+		}
+
+		auto moved = kNullEntity;
+		if (row != last) {
+			moved = m_Entities[last];
+			m_Entities[row] = moved;
+		}
+		m_Entities.pop_back();
+
+		// Keep one spare chunk around to avoid churn at chunk boundaries
+		if (m_Chunks.size() > ChunkCount() + 1) {
+			m_Chunks.pop_back();
+		}
+
+		return moved;
+	}
+
+	auto Archetype::TypeIndex(ComponentID id) const noexcept -> I32
+	{
+		if (!m_Mask.test(id)) {
+			return -1;
+		}
+
+		for (auto i = 0UL; i < m_Components.size(); i++) {
+			if (m_Components[i].id == id) {
+				return I32(i);
+			}
+		}
+
+		return -1;
+	}
+}
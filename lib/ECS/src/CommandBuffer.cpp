@@ -0,0 +1,11 @@
+#include "ECS/CommandBuffer.hpp"
+
+namespace Gaze::ECS {
+	auto CommandBuffer::Apply(World& world) -> void
+	{
+		for (auto& command : m_Commands) {
+			command(world);
+		}
+		m_Commands.clear();
+	}
+}
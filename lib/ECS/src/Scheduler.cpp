@@ -0,0 +1,97 @@
+#include "ECS/Scheduler.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include <algorithm>
+#include <future>
+
+namespace Gaze::ECS {
+	auto Scheduler::Add(std::string name, Access access, SystemFn fn) -> void
+	{
+		m_Systems.push_back({ std::move(name), access, std::move(fn), {} });
+		m_IsDirty = true;
+	}
+
+	auto Scheduler::Run(World& world, Jobs::ThreadPool* pool) -> void
+	{
+		if (m_IsDirty) {
+			BuildStages();
+		}
+
+		for (const auto& stage : m_Stages) {
+			if (pool == nullptr || stage.size() == 1) {
+				for (const auto idx : stage) {
+					m_Systems[idx].fn(world, m_Systems[idx].commands);
+				}
+			} else {
+				auto futures = std::vector<std::future<void>>();
+				futures.reserve(stage.size() - 1);
+
+				for (auto i = 1UL; i < stage.size(); i++) {
+					auto& system = m_Systems[stage[i]];
+					futures.push_back(pool->Submit([&system, &world] { system.fn(world, system.commands); }));
+				}
+
+				auto& first = m_Systems[stage.front()];
+				first.fn(world, first.commands);
+
+				for (auto& future : futures) {
+					pool->Wait(future);
+					future.get(); // Rethrows
+				}
+			}
+
+			for (const auto idx : stage) {
+				m_Systems[idx].commands.Apply(world);
+			}
+		}
+	}
+
+	auto Scheduler::Stages() -> std::vector<std::vector<std::string>>
+	{
+		if (m_IsDirty) {
+			BuildStages();
+		}
+
+		auto stages = std::vector<std::vector<std::string>>();
+		for (const auto& stage : m_Stages) {
+			auto& names = stages.emplace_back();
+			for (const auto idx : stage) {
+				names.push_back(m_Systems[idx].name);
+			}
+		}
+
+		return stages;
+	}
+
+	auto Scheduler::Conflicts(const Access& lhs, const Access& rhs) noexcept -> bool
+	{
+		return lhs.exclusive
+			|| rhs.exclusive
+			|| (lhs.writes & (rhs.reads | rhs.writes)).any()
+			|| (rhs.writes & lhs.reads).any();
+	}
+
+	auto Scheduler::BuildStages() -> void
+	{
+		auto stageOf = std::vector<std::size_t>(m_Systems.size(), 0);
+
+		m_Stages.clear();
+		for (auto i = 0UL; i < m_Systems.size(); i++) {
+			auto stage = std::size_t(0);
+			for (auto j = 0UL; j < i; j++) {
+				if (Conflicts(m_Systems[i].access, m_Systems[j].access)) {
+					stage = std::max(stage, stageOf[j] + 1);
+				}
+			}
+
+			stageOf[i] = stage;
+			if (stage == m_Stages.size()) {
+				m_Stages.emplace_back();
+			}
+			m_Stages[stage].push_back(i);
+		}
+
+		m_IsDirty = false;
+	}
+}
@@ -0,0 +1,41 @@
+#include "ECS/Systems.hpp"
+
+#include "ECS/Components.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+namespace Gaze::ECS {
+	auto SyncRigidbodies(World& world) -> void
+	{
+		world.Each<const Rigidbody, Transform>([](Entity, const Rigidbody& rb, Transform& transform) {
+			transform.position = rb.body->Origin();
+			transform.rotation = glm::angleAxis(rb.body->RotationAngle(), rb.body->RotationAxis());
+		});
+	}
+
+	auto UpdateWorldTransforms(World& world, Jobs::ThreadPool* pool) -> void
+	{
+		const auto update = [](Entity, const Transform& transform, WorldTransform& worldTransform) {
+			auto matrix = glm::mat4_cast(transform.rotation);
+			matrix[0] *= transform.scale.x;
+			matrix[1] *= transform.scale.y;
+			matrix[2] *= transform.scale.z;
+			matrix[3]  = glm::vec4(transform.position, 1.F);
+
+			worldTransform.matrix = matrix;
+		};
+
+		if (pool != nullptr) {
+			world.ParallelEach<const Transform, WorldTransform>(*pool, update);
+		} else {
+			world.Each<const Transform, WorldTransform>(update);
+		}
+	}
+
+	auto SubmitRenderables(World& world, GFX::Renderer& renderer, const GFX::Light lights[], I32 nLights) -> void
+	{
+		world.Each<const Renderable, const WorldTransform>([&](Entity, const Renderable& renderable, const WorldTransform& transform) {
+			renderer.SubmitObject(renderable.object, transform.matrix, lights, nLights, GFX::Renderer::PrimitiveMode::Triangles);
+		});
+	}
+}
@@ -0,0 +1,114 @@
+#include "ECS/World.hpp"
+
+namespace Gaze::ECS {
+	auto World::Create() -> Entity
+	{
+		return AllocateEntity(FindOrCreateArchetype({})).first;
+	}
+
+	auto World::Destroy(Entity entity) -> void
+	{
+		if (!IsAlive(entity)) {
+			return;
+		}
+		AssertMutable();
+
+		auto& record = m_Records[entity.index];
+
+		const auto moved = record.archetype->Remove(record.row);
+		if (!moved.IsNull()) {
+			m_Records[moved.index].row = record.row;
+		}
+
+		record.archetype = nullptr;
+		record.generation++;
+		m_FreeIndices.push_back(entity.index);
+	}
+
+	auto World::IsAlive(Entity entity) const noexcept -> bool
+	{
+		return entity.index < m_Records.size()
+			&& m_Records[entity.index].archetype != nullptr
+			&& m_Records[entity.index].generation == entity.generation;
+	}
+
+	auto World::EntityCount() const noexcept -> std::size_t
+	{
+		return m_Records.size() - m_FreeIndices.size();
+	}
+
+	auto World::FindOrCreateArchetype(const ComponentMask& mask) -> Archetype&
+	{
+		if (const auto it = m_Archetypes.find(mask); it != m_Archetypes.end()) {
+			return *it->second;
+		}
+
+		auto components = std::vector<ComponentInfo>();
+		for (auto id = 0UL; id < mask.size(); id++) {
+			if (mask.test(id)) {
+				GAZE_ASSERT(m_Registered.test(id), "Component type not registered");
+				components.push_back(m_ComponentInfos[id]);
+			}
+		}
+
+		auto& archetype = m_Archetypes[mask];
+		archetype = MakeUnique<Archetype>(std::move(components));
+		m_ArchetypeList.push_back(archetype.get());
+
+		return *archetype;
+	}
+
+	auto World::AllocateEntity(Archetype& archetype) -> std::pair<Entity, U32>
+	{
+		AssertMutable();
+
+		auto index = U32(0);
+		if (m_FreeIndices.empty()) {
+			index = U32(m_Records.size());
+			m_Records.push_back({ nullptr, 0, 0 });
+		} else {
+			index = m_FreeIndices.back();
+			m_FreeIndices.pop_back();
+		}
+
+		auto& record = m_Records[index];
+		const auto entity = Entity{ index, record.generation };
+
+		record.archetype = &archetype;
+		record.row       = archetype.Push(entity);
+
+		return { entity, record.row };
+	}
+
+	auto World::MoveEntity(Entity entity, Archetype& target) -> U32
+	{
+		auto& record = m_Records[entity.index];
+		auto& source = *record.archetype;
+
+		const auto row = target.Push(entity);
+		for (auto i = 0UL; i < source.Components().size(); i++) {
+			const auto& info      = source.Components()[i];
+			const auto  typeIndex = target.TypeIndex(info.id);
+
+			if (typeIndex >= 0) {
+				info.moveConstruct(target.Component(typeIndex, row), source.Component(I32(i), record.row));
+			}
+		}
+
+		// Destroys the moved-from components, along with the ones the target lacks
+		const auto moved = source.Remove(record.row);
+		if (!moved.IsNull()) {
+			m_Records[moved.index].row = record.row;
+		}
+
+		record.archetype = &target;
+		record.row       = row;
+
+		return row;
+	}
+
+	auto World::AssertMutable() const noexcept -> void
+	{
+		GAZE_ASSERT(m_IterationDepth.load() == 0, "Structural changes are not allowed while iterating; use a CommandBuffer");
+	}
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ECS/CommandBuffer.hpp"
+#include "ECS/Scheduler.hpp"
+#include "ECS/World.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+	struct Position
+	{
+		float x, y;
+	};
+
+	struct Velocity
+	{
+		float x, y;
+	};
+
+	struct Name
+	{
+		std::string value;
+	};
+}
+
+TEST_CASE("ECS - World") {
+	using namespace Gaze::ECS;
+
+	auto world = World();
+
+	SECTION("Entities keep their components across archetype moves") {
+		const auto a = world.Create(Position{ 1.F, 2.F }, Name{ "a" });
+		const auto b = world.Create(Position{ 3.F, 4.F }, Name{ "b" });
+
+		world.Add(a, Velocity{ 5.F, 6.F });
+
+		REQUIRE(world.Has<Velocity>(a));
+		REQUIRE_FALSE(world.Has<Velocity>(b));
+		REQUIRE(world.Get<Position>(a)->x == 1.F);
+		REQUIRE(world.Get<Name>(a)->value == "a");
+		REQUIRE(world.Get<Name>(b)->value == "b");
+
+		world.Remove<Position>(a);
+
+		REQUIRE_FALSE(world.Has<Position>(a));
+		REQUIRE(world.Get<Velocity>(a)->y == 6.F);
+		REQUIRE(world.Get<Name>(a)->value == "a");
+	}
+
+	SECTION("Destroyed entities are not alive and their handles are not reused") {
+		const auto a = world.Create(Position{ 1.F, 2.F });
+		const auto b = world.Create(Position{ 3.F, 4.F });
+
+		world.Destroy(a);
+		const auto c = world.Create(Position{ 5.F, 6.F });
+
+		REQUIRE_FALSE(world.IsAlive(a));
+		REQUIRE(world.IsAlive(b));
+		REQUIRE(world.IsAlive(c));
+		REQUIRE(c.index == a.index);
+		REQUIRE(world.Get<Position>(a) == nullptr);
+		REQUIRE(world.Get<Position>(b)->x == 3.F);
+		REQUIRE(world.EntityCount() == 2);
+	}
+
+	SECTION("Iteration visits exactly the entities having all requested components") {
+		for (auto i = 0; i < 5000; i++) {
+			const auto entity = world.Create(Position{ float(i), 0.F });
+			if (i % 2 == 0) {
+				world.Add(entity, Velocity{ 1.F, 1.F });
+			}
+		}
+
+		auto count = 0;
+		world.Each<Position, const Velocity>([&count](Entity, Position& pos, const Velocity& vel) {
+			pos.y += vel.y;
+			count++;
+		});
+		REQUIRE(count == 2500);
+
+		auto sum = 0.F;
+		world.Each<const Position>([&sum](Entity, const Position& pos) { sum += pos.y; });
+		REQUIRE(sum == 2500.F);
+	}
+
+	SECTION("Command buffers defer structural changes") {
+		const auto a = world.Create(Position{ 1.F, 2.F });
+		auto commands = CommandBuffer();
+
+		world.Each<const Position>([&commands](Entity entity, const Position&) {
+			commands.Add(entity, Velocity{ 1.F, 1.F });
+			commands.Create(Position{ 0.F, 0.F });
+		});
+		REQUIRE_FALSE(world.Has<Velocity>(a));
+
+		commands.Apply(world);
+		REQUIRE(world.Has<Velocity>(a));
+		REQUIRE(world.EntityCount() == 2);
+		REQUIRE(commands.IsEmpty());
+	}
+}
+
+TEST_CASE("ECS - Scheduler") {
+	using namespace Gaze::ECS;
+
+	auto scheduler = Scheduler();
+	const auto noop = [](World&, CommandBuffer&) {};
+
+	scheduler.Add("A", { .reads = MaskOf<Velocity>(), .writes = MaskOf<Position>() }, noop);
+	scheduler.Add("B", { .reads = MaskOf<Velocity>(), .writes = {} }, noop);
+	scheduler.Add("C", { .reads = MaskOf<Position>(), .writes = {} }, noop);
+	scheduler.Add("D", { .reads = {}, .writes = MaskOf<Velocity>() }, noop);
+
+	const auto stages = scheduler.Stages();
+
+	REQUIRE(stages.size() == 2);
+	REQUIRE(stages[0] == std::vector<std::string>{ "A", "B" });
+	REQUIRE(stages[1] == std::vector<std::string>{ "C", "D" });
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Geometry/Mesh.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Axis-aligned bounding box.
+	 */
+	struct AABB
+	{
+		glm::vec3 min; /**< Minimum corner */
+		glm::vec3 max; /**< Maximum corner */
+
+		/**
+		 * @brief Return the center of the box.
+		 */
+		[[nodiscard]] auto Center()  const noexcept -> glm::vec3;
+		/**
+		 * @brief Return the half-size of the box along each axis.
+		 */
+		[[nodiscard]] auto Extents() const noexcept -> glm::vec3;
+	};
+
+	/**
+	 * @brief Compute the bounding box of a mesh, in model space.
+	 *
+	 * @param mesh The mesh.
+	 *
+	 * @return The bounding box enclosing all vertices of all the mesh's primitives.
+	 */
+	[[nodiscard]] auto ComputeBounds(const Geometry::Mesh& mesh) noexcept -> AABB;
+	/**
+	 * @brief Transform a bounding box.
+	 *
+	 * @param box The bounding box.
+	 * @param transform The transform to apply.
+	 *
+	 * @return The bounding box enclosing the transformed box.
+	 */
+	[[nodiscard]] auto TransformBounds(const AABB& box, const glm::mat4& transform) noexcept -> AABB;
+	/**
+	 * @brief Merge two bounding boxes.
+	 *
+	 * @return The bounding box enclosing both boxes.
+	 */
+	[[nodiscard]] auto MergeBounds(const AABB& a, const AABB& b) noexcept -> AABB;
+
+	/**
+	 * @brief A view frustum, used for visibility tests.
+	 */
+	class Frustum
+	{
+	public:
+		/**
+		 * @brief Construct a frustum from a view-projection matrix.
+		 *
+		 * @param viewProjection The combined view and projection matrix.
+		 */
+		explicit Frustum(const glm::mat4& viewProjection) noexcept;
+
+		/**
+		 * @brief Check whether a bounding box is (at least partially) inside the frustum.
+		 *
+		 * The test is conservative; boxes near the frustum's corners may be
+		 * reported as visible even though they are not.
+		 *
+		 * @param box The bounding box, in world space.
+		 *
+		 * @return false if the box is definitely outside the frustum, true otherwise.
+		 */
+		[[nodiscard]] auto Intersects(const AABB& box) const noexcept -> bool;
+
+	private:
+		std::array<glm::vec4, 6> m_Planes;
+	};
+
+	inline auto AABB::Center() const noexcept -> glm::vec3
+	{
+		return (min + max) * .5F;
+	}
+
+	inline auto AABB::Extents() const noexcept -> glm::vec3
+	{
+		return (max - min) * .5F;
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Bounds.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Immediate-mode debug drawing
+	 *
+	 * Shapes are appended as world-space vertices into per-frame lists, which
+	 * the renderer streams to the GPU and draws unlit with a single draw call
+	 * per primitive type. The lists are cleared after every frame.
+	 *
+	 * @see Renderer::Debug()
+	 */
+	class DebugDraw
+	{
+	public:
+		/**
+		 * @brief A debug vertex, in world space.
+		 */
+		struct Vertex
+		{
+			glm::vec3 position;
+			U32       color;    /**< RGBA8, red in the lowest byte */
+		};
+
+		static inline const auto kWhite = glm::vec4(1.F, 1.F, 1.F, 1.F);
+
+	public:
+		/**
+		 * @brief Draw a line segment.
+		 *
+		 * @param from The start of the line.
+		 * @param to The end of the line.
+		 * @param color The color of the line.
+		 */
+		auto Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color = kWhite) -> void;
+		/**
+		 * @brief Draw the edges of an axis-aligned box.
+		 *
+		 * @param box The box.
+		 * @param color The color of the edges.
+		 */
+		auto Box(const AABB& box, const glm::vec4& color = kWhite) -> void;
+		/**
+		 * @brief Draw the edges of an oriented box.
+		 *
+		 * @param transform The box's transform. The box is centered on the origin of its local space.
+		 * @param halfExtents The box's half-size along each local axis.
+		 * @param color The color of the edges.
+		 */
+		auto Box(const glm::mat4& transform, const glm::vec3& halfExtents, const glm::vec4& color = kWhite) -> void;
+		/**
+		 * @brief Draw a wireframe sphere, as three orthogonal circles.
+		 *
+		 * @param center The center of the sphere.
+		 * @param radius The radius of the sphere.
+		 * @param color The color of the sphere.
+		 * @param nSegments The number of line segments per circle.
+		 */
+		auto Sphere(const glm::vec3& center, F32 radius, const glm::vec4& color = kWhite, I32 nSegments = 16) -> void;
+		/**
+		 * @brief Draw an arrow.
+		 *
+		 * @param from The tail of the arrow.
+		 * @param to The tip of the arrow.
+		 * @param color The color of the arrow.
+		 * @param headSize The length of the arrow head, in world units.
+		 */
+		auto Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color = kWhite, F32 headSize = .1F) -> void;
+		/**
+		 * @brief Draw a point.
+		 *
+		 * @param position The position of the point.
+		 * @param color The color of the point.
+		 */
+		auto Point(const glm::vec3& position, const glm::vec4& color = kWhite) -> void;
+
+		/**
+		 * @brief Discard everything drawn so far.
+		 */
+		auto Clear() noexcept -> void;
+
+		/**
+		 * @brief Return the line vertices, two per line.
+		 */
+		[[nodiscard]] auto Lines()  const noexcept -> const std::vector<Vertex>&;
+		/**
+		 * @brief Return the point vertices.
+		 */
+		[[nodiscard]] auto Points() const noexcept -> const std::vector<Vertex>&;
+
+		/**
+		 * @brief Pack a color into the RGBA8 format used by @ref Vertex.
+		 */
+		[[nodiscard]] static auto PackColor(const glm::vec4& color) noexcept -> U32;
+
+	private:
+		std::vector<Vertex> m_Lines;
+		std::vector<Vertex> m_Points;
+	};
+
+	inline auto DebugDraw::Lines() const noexcept -> const std::vector<Vertex>&
+	{
+		return m_Lines;
+	}
+
+	inline auto DebugDraw::Points() const noexcept -> const std::vector<Vertex>&
+	{
+		return m_Points;
+	}
+}
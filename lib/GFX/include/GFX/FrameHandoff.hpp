@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Hands frame packets from one producer thread to one consumer thread, double-buffered
+	 *
+	 * The producer records a frame into Recording() while the consumer works
+	 * on the previous one, then Publish()es it. Publishing blocks only if the
+	 * consumer is still on the frame before that, the one whose packet is
+	 * recorded into next, so the producer runs at most one frame ahead.
+	 *
+	 * The handoff goes through two counters, of frames published and
+	 * released, waited on with atomic waits: neither side takes a lock.
+	 * A packet's contents are visible to the other side once it has been
+	 * published, or released.
+	 *
+	 * @tparam TPacket The packet type. Default constructible; both packets
+	 *                 are constructed up front and reused
+	 */
+	template<typename TPacket>
+	class FrameHandoff
+	{
+	public:
+		FrameHandoff() = default;
+
+		FrameHandoff(const FrameHandoff&) = delete;
+		FrameHandoff(FrameHandoff&&) = delete;
+		auto operator=(const FrameHandoff&) = delete;
+		auto operator=(FrameHandoff&&) = delete;
+
+		/**
+		 * @brief Return the packet the producer records into.
+		 *
+		 * Only the producer may call this. The packet doesn't change until the
+		 * next Publish().
+		 */
+		[[nodiscard]] auto Recording() noexcept -> TPacket&;
+		/**
+		 * @brief Hand the recorded packet to the consumer.
+		 *
+		 * Only the producer may call this. Returns once the next packet to
+		 * record into has been released by the consumer.
+		 */
+		auto Publish() noexcept -> void;
+		/**
+		 * @brief Wait until the consumer has released every published packet.
+		 *
+		 * Only the producer may call this.
+		 */
+		auto WaitIdle() const noexcept -> void;
+
+		/**
+		 * @brief Wait for the oldest packet the consumer hasn't released yet.
+		 *
+		 * Only the consumer may call this. The same packet is returned until
+		 * it is released.
+		 *
+		 * @return The packet, or nullptr once the handoff is closed. Packets
+		 *         still published then are dropped.
+		 */
+		[[nodiscard]] auto Acquire() noexcept -> TPacket*;
+		/**
+		 * @brief Give the acquired packet back to the producer.
+		 *
+		 * Only the consumer may call this, after Acquire() returned a packet.
+		 */
+		auto Release() noexcept -> void;
+
+		/**
+		 * @brief Wake the consumer up for good; Acquire() returns nullptr from now on.
+		 */
+		auto Close() noexcept -> void;
+
+		[[nodiscard]] auto Published() const noexcept -> U64;
+		[[nodiscard]] auto Released()  const noexcept -> U64;
+
+	private:
+		static constexpr auto kClosed = U64(1) << 63;
+
+		static_assert(std::atomic<U64>::is_always_lock_free);
+
+	private:
+		std::array<TPacket, 2> m_Packets;
+		std::atomic<U64>       m_Published = 0; /**< Packets published so far, kClosed once closed */
+		std::atomic<U64>       m_Released  = 0; /**< Packets released so far */
+	};
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Recording() noexcept -> TPacket&
+	{
+		return m_Packets[Published() % 2];
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Publish() noexcept -> void
+	{
+		const auto published = m_Published.fetch_add(1, std::memory_order_release) + 1;
+		m_Published.notify_one();
+
+		// The next packet is the one published two frames ago
+		for (auto released = m_Released.load(std::memory_order_acquire); released + 1 < (published & ~kClosed); released = m_Released.load(std::memory_order_acquire)) {
+			m_Released.wait(released, std::memory_order_acquire);
+		}
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::WaitIdle() const noexcept -> void
+	{
+		const auto published = Published();
+		for (auto released = m_Released.load(std::memory_order_acquire); released < published; released = m_Released.load(std::memory_order_acquire)) {
+			m_Released.wait(released, std::memory_order_acquire);
+		}
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Acquire() noexcept -> TPacket*
+	{
+		const auto released = m_Released.load(std::memory_order_relaxed);
+
+		auto published = m_Published.load(std::memory_order_acquire);
+		while ((published & kClosed) == 0 && published == released) {
+			m_Published.wait(published, std::memory_order_acquire);
+			published = m_Published.load(std::memory_order_acquire);
+		}
+
+		if ((published & kClosed) != 0) {
+			return nullptr;
+		}
+
+		return &m_Packets[released % 2];
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Release() noexcept -> void
+	{
+		m_Released.fetch_add(1, std::memory_order_release);
+		m_Released.notify_all();
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Close() noexcept -> void
+	{
+		m_Published.fetch_or(kClosed, std::memory_order_release);
+		m_Published.notify_all();
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Published() const noexcept -> U64
+	{
+		return m_Published.load(std::memory_order_acquire) & ~kClosed;
+	}
+
+	template<typename TPacket>
+	auto FrameHandoff<TPacket>::Released() const noexcept -> U64
+	{
+		return m_Released.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Lays out pre-rendered views of meshes, and decides when instances are drawn with them
+	 *
+	 * An impostor is a mesh rendered beforehand from a set of directions
+	 * around it, each into a cell of its slot in the atlas: nYaw directions
+	 * around the mesh's up axis by nPitch elevations, from below to above.
+	 * Each view is an orthographic projection of the mesh's bounding sphere,
+	 * so a quad of the sphere's diameter facing the camera, textured with the
+	 * cell nearest the direction it is seen from, stands in for the mesh.
+	 *
+	 * Whether an instance is drawn as its mesh or its impostor depends on
+	 * the height of its bounding sphere on screen. Below switchSize pixels
+	 * it is an impostor, above switchSize + fadeSize it is its mesh, and in
+	 * between both are drawn with complementary dithering, see Blend().
+	 *
+	 * The class is renderer agnostic: it only computes the views and the
+	 * billboards. The renderer bakes and draws them, see
+	 * Renderer::SetImpostors().
+	 */
+	class ImpostorAtlas
+	{
+	public:
+		struct Settings
+		{
+			I32 nYaw             = 8;
+			I32 nPitch           = 4;
+			I32 cellResolution   = 128;   /**< Of each view, in texels. Best kept above switchSize */
+			I32 maxImpostors     = 32;    /**< Slots in the atlas, one per mesh */
+			F32 switchSize       = 96.F;  /**< Screen height of the bounding sphere, in pixels, under which instances are impostors */
+			F32 fadeSize         = 32.F;  /**< Over how many more pixels they cross-fade into their mesh */
+			I32 maxBakesPerFrame = 2;     /**< Meshes rendered into the atlas per frame, at most; the others are drawn as meshes meanwhile */
+		};
+
+		/**
+		 * @brief How much of an instance is drawn as its mesh and its impostor; they add up to 1.
+		 */
+		struct Weights
+		{
+			F32 mesh;
+			F32 impostor;
+		};
+
+		/**
+		 * @brief A camera-facing quad standing in for an instance.
+		 */
+		struct Billboard
+		{
+			glm::vec3  center; /**< World space, of the bounding sphere */
+			glm::vec3  right;  /**< Half the quad's width, along its horizontal axis */
+			glm::vec3  up;     /**< Half the quad's height, along its vertical axis */
+			glm::ivec2 cell;   /**< The view to texture it with: yaw, pitch */
+		};
+
+	public:
+		explicit ImpostorAtlas(Settings settings) noexcept;
+
+		/**
+		 * @brief Reserve a slot in the atlas for a mesh.
+		 *
+		 * @return The slot, or std::nullopt if every slot is taken.
+		 */
+		[[nodiscard]] auto Acquire() -> std::optional<I32>;
+		/**
+		 * @brief Give back a slot, once the mesh it holds is gone.
+		 */
+		auto Release(I32 slot) -> void;
+
+		/**
+		 * @brief Compute the height of a bounding sphere on screen.
+		 *
+		 * @param radius The sphere's radius.
+		 * @param distance From the camera to the sphere's center.
+		 * @param projectionScale The perspective projection's vertical scale, its [1][1] element.
+		 * @param viewportHeight In pixels.
+		 *
+		 * @return The sphere's diameter, in pixels; infinite once the camera is inside.
+		 */
+		[[nodiscard]] static auto ScreenSize(F32 radius, F32 distance, F32 projectionScale, F32 viewportHeight) noexcept -> F32;
+		/**
+		 * @brief Split an instance between its mesh and its impostor, from its height on screen.
+		 */
+		[[nodiscard]] auto Blend(F32 screenSize) const noexcept -> Weights;
+
+		/**
+		 * @brief Return the direction a cell was rendered from, in model space.
+		 *
+		 * @return A unit vector from the mesh towards the viewer.
+		 */
+		[[nodiscard]] auto CellDirection(glm::ivec2 cell) const noexcept -> glm::vec3;
+		/**
+		 * @brief Pick the cell rendered from the nearest direction.
+		 *
+		 * @param toViewer From the mesh towards the viewer, in model space. Needn't be normalized.
+		 */
+		[[nodiscard]] auto SelectCell(const glm::vec3& toViewer) const noexcept -> glm::ivec2;
+		/**
+		 * @brief Compute the view-projection matrix a cell is rendered with, from model space.
+		 *
+		 * @param cell The cell.
+		 * @param center The mesh's bounding sphere center, in model space.
+		 * @param radius The mesh's bounding sphere radius.
+		 */
+		[[nodiscard]] auto BakeViewProjection(glm::ivec2 cell, const glm::vec3& center, F32 radius) const noexcept -> glm::mat4;
+		/**
+		 * @brief Compute the billboard standing in for an instance.
+		 *
+		 * The quad faces the viewer, upright along the instance's up axis like
+		 * the cells it is textured with. Assumes @p model doesn't shear.
+		 *
+		 * @param model The instance's world transform.
+		 * @param center The mesh's bounding sphere center, in model space.
+		 * @param radius The mesh's bounding sphere radius.
+		 * @param viewer The camera's position.
+		 */
+		[[nodiscard]] auto MakeBillboard(const glm::mat4& model, const glm::vec3& center, F32 radius, const glm::vec3& viewer) const noexcept -> Billboard;
+
+		/**
+		 * @brief Return the size of a slot, in texels: the cells side by side.
+		 */
+		[[nodiscard]] auto SlotSize() const noexcept -> glm::ivec2;
+		[[nodiscard]] auto GetSettings() const noexcept -> const Settings& { return m_Settings; }
+
+	private:
+		Settings         m_Settings;
+		std::vector<I32> m_FreeSlots;
+	};
+}
@@ -5,13 +5,28 @@
 namespace Gaze::GFX {
 	/**
 	 * @brief A struct representing a light in the scene.
+	 *
+	 * Lights are point lights, unless they have a direction: directional
+	 * lights, such as the sun, light the whole scene from that direction,
+	 * without attenuation.
 	 */
 	struct Light
 	{
-		glm::vec3 position;
-		glm::vec3 direction;
+		glm::vec3 position;             /**< Ignored by directional lights */
+		glm::vec3 direction;            /**< The direction directional lights shine towards. Zero for point lights */
 		glm::vec3 diffuse;
 		float     ambientCoefficient;
-		float     attenuation;
+		float     attenuation;          /**< Ignored by directional lights */
+		bool      castsShadows = false; /**< Only used by renderers with shadows enabled, see Renderer::SetShadows() */
+
+		/**
+		 * @brief Check whether the light is directional.
+		 */
+		[[nodiscard]] auto IsDirectional() const noexcept -> bool;
 	};
+
+	inline auto Light::IsDirectional() const noexcept -> bool
+	{
+		return direction != glm::vec3(0.F);
+	}
 }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Bounds.hpp"
+#include "GFX/Light.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Picks the lights that matter most to an object out of a scene's lights.
+	 *
+	 * Each light's contribution is estimated at the point of the object's
+	 * bounds closest to it, using the same ambient and attenuation terms as
+	 * the shaders, weighted by the light's luminance. Directional lights are
+	 * estimated unattenuated. The lights are kept in
+	 * a structure-of-arrays layout so the estimates are computed four lights
+	 * at a time with SSE where available.
+	 */
+	class LightSelector
+	{
+	public:
+		/**
+		 * @brief Replace the scene's lights.
+		 *
+		 * @param lights The lights. Copied.
+		 * @param nLights The number of lights.
+		 */
+		auto SetLights(const Light lights[], I32 nLights) -> void;
+
+		/**
+		 * @brief Select the most influential lights for an object.
+		 *
+		 * Lights whose estimated contribution is below kMinContribution, such
+		 * as black lights or far, strongly attenuated ones without ambient
+		 * term, are never selected.
+		 *
+		 * @param bounds The object's bounds, in world space.
+		 * @param maxLights The maximum number of lights to select. At most 8.
+		 * @param[out] selected Receives the selected lights, most influential first.
+		 *
+		 * @return The number of lights selected.
+		 */
+		[[nodiscard]] auto Select(const AABB& bounds, I32 maxLights, Light selected[]) const noexcept -> I32;
+
+		[[nodiscard]] auto Lights()  const noexcept -> std::span<const Light>;
+		[[nodiscard]] auto Size()    const noexcept -> I32;
+		[[nodiscard]] auto IsEmpty() const noexcept -> bool;
+
+		/**
+		 * @brief Contribution under which a light is skipped, relative to a full intensity white light.
+		 */
+		static constexpr auto kMinContribution = 1.F / 1024.F;
+
+	private:
+		static constexpr auto kLaneCount     = 4;
+		static constexpr auto kMaxSelectable = 8;
+
+	private:
+		std::vector<Light> m_Lights;
+		// Structure of arrays, padded to a multiple of kLaneCount with black lights
+		std::vector<F32>   m_X;
+		std::vector<F32>   m_Y;
+		std::vector<F32>   m_Z;
+		std::vector<F32>   m_Luminance;
+		std::vector<F32>   m_Ambient;
+		std::vector<F32>   m_Attenuation;
+	};
+
+	inline auto LightSelector::Lights() const noexcept -> std::span<const Light>
+	{
+		return m_Lights;
+	}
+
+	inline auto LightSelector::Size() const noexcept -> I32
+	{
+		return I32(m_Lights.size());
+	}
+
+	inline auto LightSelector::IsEmpty() const noexcept -> bool
+	{
+		return m_Lights.empty();
+	}
+}
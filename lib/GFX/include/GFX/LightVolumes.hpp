@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Light.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <span>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Bounds the part of the scene each light reaches, for deferred shading.
+	 *
+	 * Point lights fade as 1 / (1 + attenuation * d^2) and never quite reach
+	 * zero. A light's volume is the sphere past which its brightest channel
+	 * contributes less than LightSelector::kMinContribution. Directional
+	 * lights and lights without attenuation reach everywhere, and cover the
+	 * whole screen.
+	 *
+	 * The shaders don't attenuate ambient terms, so those aren't part of any
+	 * volume: they are summed into a single scene ambient instead.
+	 */
+	class LightVolumes
+	{
+	public:
+		enum class Shape : U8
+		{
+			FullScreen,
+			Sphere,
+		};
+
+		struct Volume
+		{
+			I32   light;        /**< Index in the lights given to Build() */
+			Shape shape;
+			F32   radius;       /**< Spheres only */
+			bool  containsView; /**< Spheres only: the near plane may cut the sphere, so its front faces can't be relied on */
+		};
+
+	public:
+		/**
+		 * @brief Compute the volumes of a scene's lights, seen from a viewpoint.
+		 *
+		 * Lights too dark to contribute anywhere get no volume.
+		 *
+		 * @param lights The scene's lights.
+		 * @param viewPos The position of the camera.
+		 * @param nearReach The distance from the camera to the farthest corner of its near plane.
+		 */
+		auto Build(std::span<const Light> lights, const glm::vec3& viewPos, F32 nearReach) -> void;
+
+		[[nodiscard]] auto Volumes() const noexcept -> std::span<const Volume>;
+		/**
+		 * @brief The sum of the lights' ambient terms, to scale the albedo by.
+		 */
+		[[nodiscard]] auto Ambient() const noexcept -> const glm::vec3&;
+
+		/**
+		 * @brief The radius of a point light's volume.
+		 *
+		 * @return 0 for lights contributing nothing, infinity for lights reaching everywhere.
+		 */
+		[[nodiscard]] static auto Radius(const Light& light) noexcept -> F32;
+
+	private:
+		std::vector<Volume> m_Volumes;
+		glm::vec3           m_Ambient{ 0.F };
+	};
+
+	inline auto LightVolumes::Volumes() const noexcept -> std::span<const Volume>
+	{
+		return m_Volumes;
+	}
+
+	inline auto LightVolumes::Ambient() const noexcept -> const glm::vec3&
+	{
+		return m_Ambient;
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "GFX/TextureImage.hpp"
+
 #include <glm/vec3.hpp>
 
 namespace Gaze::GFX {
@@ -11,5 +13,6 @@ namespace Gaze::GFX {
 		glm::vec3 diffuse = { 1.F, 1.F, 1.F };
 		glm::vec3 specular;
 		float     shininess;
+		TextureID texture = kInvalidTextureID; /**< Modulates diffuse, see Renderer::LoadTexture(); none if invalid */
 	};
 }
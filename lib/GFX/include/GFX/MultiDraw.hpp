@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief A run of indirect draws issued with one multi-draw call.
+	 */
+	struct MultiDraw
+	{
+		std::size_t first; /**< The first draw, the draw ID the multi-draw's base instances are relative to */
+		std::size_t count;
+	};
+
+	/**
+	 * @brief Split groups of draws into multi-draws of at most @p maxDraws draws each.
+	 *
+	 * Multi-draws never straddle groups, so each can bind its group's
+	 * buffers. Draws select their records through an instanced draw ID
+	 * attribute counting up to @p maxDraws: a draw's base instance is its
+	 * index within its multi-draw, and the multi-draw's first draw is added
+	 * back by the shader. Groups may start anywhere, not only at multiples of
+	 * @p maxDraws.
+	 *
+	 * @param groupEnds The end of each group, increasing. The first group starts at draw 0.
+	 * @param maxDraws The most draws per multi-draw.
+	 * @param[out] out Receives the multi-draws, in draw order. Cleared first.
+	 */
+	auto SplitMultiDraws(std::span<const std::size_t> groupEnds, std::size_t maxDraws, std::vector<MultiDraw>& out) -> void;
+}
@@ -3,6 +3,7 @@
 #include "GFX/Material.hpp"
 
 #include "Geometry/Mesh.hpp"
+#include "Geometry/MeshHandle.hpp"
 
 #include <glm/vec3.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
@@ -21,12 +22,17 @@ namespace Gaze::GFX {
 		{
 			glm::mat4 transform;
 			Material  material;
+			bool      isStatic = false; /**< The object never moves. Static objects may be batched together, see @ref StaticBatcher */
 		};
 
 	public:
 		/**
 		 * @brief Construct a new Object.
 		 *
+		 * The mesh is moved into a new, unshared handle. Prefer the handle
+		 * overloads with a Geometry::MeshRegistry when many objects use the
+		 * same mesh.
+		 *
 		 * @param mesh The mesh to render.
 		 */
 		Object(Geometry::Mesh mesh);
@@ -39,12 +45,35 @@ namespace Gaze::GFX {
 		 */
 		Object(Geometry::Mesh mesh, Properties props);
 
+		/**
+		 * @brief Construct a new Object sharing an existing mesh.
+		 *
+		 * @param mesh The mesh to render.
+		 */
+		Object(Geometry::MeshHandle mesh);
+
+		/**
+		 * @brief Construct a new Object sharing an existing mesh.
+		 *
+		 * @param mesh The mesh to render.
+		 * @param props The object properties.
+		 */
+		Object(Geometry::MeshHandle mesh, Properties props);
+
 		/**
 		 * @brief Get the mesh associated with the object.
 		 *
 		 * @return The mesh.
 		 */
-		[[nodiscard]] auto Mesh() const noexcept -> const Geometry::Mesh&;
+		[[nodiscard]] auto Mesh()       const noexcept -> const Geometry::Mesh&;
+		/**
+		 * @brief Get the handle to the object's mesh.
+		 *
+		 * Objects sharing a mesh have handles with the same ID.
+		 *
+		 * @return The mesh handle.
+		 */
+		[[nodiscard]] auto SharedMesh() const noexcept -> const Geometry::MeshHandle&;
 
 		/**
 		 * @brief Set the object's position.
@@ -73,12 +102,30 @@ namespace Gaze::GFX {
 		 */
 		[[nodiscard]] auto GetProperties()       noexcept -> Properties&;
 
+		/**
+		 * @brief Check whether the object is marked as static.
+		 *
+		 * @return true if the object is static, false otherwise.
+		 */
+		[[nodiscard]] auto IsStatic()      const noexcept -> bool;
+		/**
+		 * @brief Mark the object as static (immovable) or dynamic.
+		 *
+		 * @param isStatic Whether the object is static.
+		 */
+		auto SetStatic(bool isStatic)            noexcept -> void;
+
 	private:
-		Geometry::Mesh m_Mesh;
-		Properties     m_Properties;
+		Geometry::MeshHandle m_Mesh;
+		Properties           m_Properties;
 	};
 
 	inline auto Object::Mesh() const noexcept -> const Geometry::Mesh&
+	{
+		return *m_Mesh;
+	}
+
+	inline auto Object::SharedMesh() const noexcept -> const Geometry::MeshHandle&
 	{
 		return m_Mesh;
 	}
@@ -92,4 +139,14 @@ namespace Gaze::GFX {
 	{
 		return m_Properties;
 	}
+
+	inline auto Object::IsStatic() const noexcept -> bool
+	{
+		return m_Properties.isStatic;
+	}
+
+	inline auto Object::SetStatic(bool isStatic) noexcept -> void
+	{
+		m_Properties.isStatic = isStatic;
+	}
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Batched screen-space text and graphs, drawn over the finished frame
+	 *
+	 * Everything is made of textured quads sampling a built-in 8x8 pixel font,
+	 * drawn by the renderer with one instanced draw call after the frame is
+	 * resolved. Positions are in framebuffer pixels, from the top-left
+	 * corner; on HiDPI displays there are more of them than window screen
+	 * coordinates. Quads are alpha-blended in submission order and cleared
+	 * after every frame.
+	 *
+	 * A hidden overlay ignores everything submitted to it, so drawing to it
+	 * unconditionally costs next to nothing while it is hidden.
+	 *
+	 * @see Renderer::Overlay()
+	 */
+	class Overlay
+	{
+	public:
+		/**
+		 * @brief A single quad, as uploaded to the GPU.
+		 */
+		struct Quad
+		{
+			glm::vec2 position; /**< Top-left corner, in pixels */
+			glm::vec2 size;     /**< In pixels */
+			U32       glyph;    /**< Cell of the font atlas, see GlyphIndex() */
+			U32       color;    /**< RGBA8, red in the lowest byte */
+		};
+
+		static constexpr auto kGlyphSize     = 8;  /**< Width and height of a glyph, in atlas texels */
+		static constexpr auto kAtlasColumns  = 16;
+		static constexpr auto kAtlasRows     = 6;
+		static constexpr auto kAtlasWidth    = kGlyphSize * kAtlasColumns;
+		static constexpr auto kAtlasHeight   = kGlyphSize * kAtlasRows;
+		static constexpr auto kSolidGlyph    = U32(95); /**< A fully covered cell, for solid rectangles */
+
+		static inline const auto kWhite = glm::vec4(1.F, 1.F, 1.F, 1.F);
+
+	public:
+		/**
+		 * @brief Draw a line of text. Printable ASCII only; other characters are drawn as '?'.
+		 *
+		 * @param position The top-left corner of the first character.
+		 * @param text The text. '\n' starts a new line.
+		 * @param color The color of the text.
+		 * @param scale The size of a character, in multiples of 8 pixels.
+		 */
+		auto Text(
+			const glm::vec2& position,
+			std::string_view text,
+			const glm::vec4& color = kWhite,
+			F32 scale = 1.F
+		) -> void;
+		/**
+		 * @brief Draw a solid rectangle.
+		 */
+		auto Rect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) -> void;
+		/**
+		 * @brief Draw a bar graph, one bar per value, oldest on the left.
+		 *
+		 * @param position The top-left corner of the graph.
+		 * @param size The size of the graph. Bars share its width.
+		 * @param values The values to graph.
+		 * @param maxValue The value of a full-height bar. Bars are clamped to it.
+		 * @param color The color of the bars.
+		 */
+		auto Graph(
+			const glm::vec2& position,
+			const glm::vec2& size,
+			std::span<const F32> values,
+			F32 maxValue,
+			const glm::vec4& color = kWhite
+		) -> void;
+
+		auto SetVisible(bool visible) noexcept -> void;
+		auto ToggleVisible()          noexcept -> void;
+		/**
+		 * @brief Discard all quads.
+		 */
+		auto Clear() noexcept -> void;
+
+		[[nodiscard]] auto IsVisible() const noexcept -> bool;
+		/**
+		 * @brief Return the quads.
+		 */
+		[[nodiscard]] auto Quads()     const noexcept -> const std::vector<Quad>&;
+
+		/**
+		 * @brief Return the atlas cell of a character.
+		 */
+		[[nodiscard]] static auto GlyphIndex(char c) noexcept -> U32;
+		/**
+		 * @brief Rasterize the font atlas.
+		 *
+		 * @return kAtlasWidth * kAtlasHeight coverage values, 0 or 255, rows from top to bottom.
+		 */
+		[[nodiscard]] static auto BuildFontAtlas() -> std::vector<U8>;
+
+	private:
+		std::vector<Quad> m_Quads;
+		bool              m_IsVisible = false;
+	};
+
+	inline auto Overlay::SetVisible(bool visible) noexcept -> void
+	{
+		m_IsVisible = visible;
+	}
+
+	inline auto Overlay::ToggleVisible() noexcept -> void
+	{
+		m_IsVisible = !m_IsVisible;
+	}
+
+	inline auto Overlay::IsVisible() const noexcept -> bool
+	{
+		return m_IsVisible;
+	}
+
+	inline auto Overlay::Quads() const noexcept -> const std::vector<Quad>&
+	{
+		return m_Quads;
+	}
+}
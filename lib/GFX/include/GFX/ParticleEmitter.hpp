@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Spawns and simulates particles, drawn as camera-facing quads
+	 *
+	 * Particles are stored as structure-of-arrays, each attribute a separate
+	 * array padded to a multiple of 4 particles, and simulated 4 at a time
+	 * with SIMD. Dead particles are replaced by the last live one, so live
+	 * particles stay packed at the front, in no particular order.
+	 *
+	 * @see Renderer::SubmitParticles()
+	 */
+	class ParticleEmitter
+	{
+	public:
+		struct Settings
+		{
+			glm::vec3   position       = { 0.F, 0.F, 0.F };
+			glm::vec3   spawnExtent    = { 0.F, 0.F, 0.F };   /**< Half size of the box around @c position particles spawn in */
+			glm::vec3   velocity       = { 0.F, 1.F, 0.F };   /**< Initial velocity, in units per second */
+			glm::vec3   velocitySpread = { .5F, .5F, .5F };   /**< Random variation added to the initial velocity, per axis, in both directions */
+			glm::vec3   gravity        = { 0.F, -9.81F, 0.F };
+			F32         drag           = 0.F;                 /**< Fraction of the velocity lost per second */
+			F32         rate           = 1000.F;              /**< Particles spawned per second by Update() */
+			F32         minLifetime    = 1.F;                 /**< In seconds */
+			F32         maxLifetime    = 2.F;
+			F32         startSize      = .1F;                 /**< Width of the quad at spawn, in world units */
+			F32         endSize        = .1F;                 /**< Width of the quad at death */
+			glm::vec4   startColor     = { 1.F, 1.F, 1.F, 1.F };
+			glm::vec4   endColor       = { 1.F, 1.F, 1.F, 0.F };
+			std::size_t maxParticles   = 100'000;             /**< Particles beyond this are not spawned */
+		};
+
+		/**
+		 * @brief A single particle, as uploaded to the GPU.
+		 */
+		struct Instance
+		{
+			glm::vec3 position;
+			F32       size;
+			U32       color; /**< RGBA8, red in the lowest byte */
+		};
+
+	public:
+		explicit ParticleEmitter(const Settings& settings, U32 seed = 1);
+
+		/**
+		 * @brief Spawn particles right away.
+		 *
+		 * @return The number of particles spawned, less than @p count if the emitter is full.
+		 */
+		auto Emit(std::size_t count) noexcept -> std::size_t;
+		/**
+		 * @brief Advance the simulation, kill the particles that outlived their lifetime and spawn new ones.
+		 *
+		 * @param dt The time step, in seconds.
+		 * @param pool If not null, the simulation of large emitters is spread over it.
+		 */
+		auto Update(F32 dt, Jobs::ThreadPool* pool = nullptr) noexcept -> void;
+		/**
+		 * @brief Write the live particles' quads, sized and colored by their age.
+		 *
+		 * Meant to write straight into mapped GPU memory.
+		 *
+		 * @return The number of quads written, at most the size of @p out.
+		 */
+		auto WriteInstances(std::span<Instance> out) const noexcept -> std::size_t;
+		/**
+		 * @brief Kill all particles.
+		 */
+		auto Clear() noexcept -> void;
+
+		/**
+		 * @brief Change the settings. Live particles are kept, up to the new maximum.
+		 */
+		auto SetSettings(const Settings& settings) -> void;
+
+		[[nodiscard]] auto GetSettings() const noexcept -> const Settings&;
+		[[nodiscard]] auto Count()       const noexcept -> std::size_t;
+
+	private:
+		enum Attribute : std::size_t
+		{
+			kPositionX,
+			kPositionY,
+			kPositionZ,
+			kVelocityX,
+			kVelocityY,
+			kVelocityZ,
+			kAge,         /**< Fraction of the lifetime elapsed, dead from 1 */
+			kAgeRate,     /**< 1 / lifetime */
+
+			kAttributeCount,
+		};
+
+		[[nodiscard]] auto Lane(Attribute attribute)       noexcept -> F32*;
+		[[nodiscard]] auto Lane(Attribute attribute) const noexcept -> const F32*;
+
+		/**
+		 * @brief Integrate the particles in [first, last). Both are multiples of 4.
+		 */
+		auto Simulate(std::size_t first, std::size_t last, F32 dt) noexcept -> void;
+		/**
+		 * @brief Replace the dead particles by live ones from the back.
+		 */
+		auto Compact() noexcept -> void;
+		[[nodiscard]] auto Random() noexcept -> F32;
+
+	private:
+		Settings         m_Settings;
+		std::size_t      m_Count  = 0;
+		std::size_t      m_Stride = 0; /**< Particles per attribute array, padding included */
+		std::vector<F32> m_Data;
+		F32              m_Pending = 0.F; /**< Fraction of a particle left to spawn by Update() */
+		U32              m_Random;
+	};
+
+	inline auto ParticleEmitter::GetSettings() const noexcept -> const Settings&
+	{
+		return m_Settings;
+	}
+
+	inline auto ParticleEmitter::Count() const noexcept -> std::size_t
+	{
+		return m_Count;
+	}
+
+	inline auto ParticleEmitter::Lane(Attribute attribute) noexcept -> F32*
+	{
+		return m_Data.data() + attribute * m_Stride;
+	}
+
+	inline auto ParticleEmitter::Lane(Attribute attribute) const noexcept -> const F32*
+	{
+		return m_Data.data() + attribute * m_Stride;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "GFX/Platform/OpenGL/Objects/Buffer.hpp"
+#include "GFX/TLSFAllocator.hpp"
+
+#include "Core/Type.hpp"
+
+#include <vector>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	/**
+	 * @brief Long-lived GPU memory, sub-allocated from large buffer pages
+	 *
+	 * Each page is a fixed-size buffer managed by a TLSFAllocator. When no
+	 * page has room for an allocation a new one is added, so existing buffers
+	 * are never reallocated and allocations never move, except through
+	 * Defragment(). Requests larger than a page get a dedicated page, released
+	 * as soon as it is empty again.
+	 *
+	 * Allocations can be moved by Defragment(): look up their offset with
+	 * Offset() whenever issuing draws instead of caching it.
+	 */
+	class BufferHeap
+	{
+	public:
+		struct Allocation
+		{
+			U32                   page;
+			TLSFAllocator::Handle handle;
+		};
+
+		struct Stats
+		{
+			I64 capacity;
+			I64 used;
+			I64 largestFreeBlock;
+			I32 nPages;
+			I32 nAllocations;
+			F32 fragmentation; /**< Worst fragmentation of all pages, see TLSFAllocator::Stats */
+		};
+
+	public:
+		explicit BufferHeap(I64 pageSize) noexcept;
+
+		/**
+		 * @brief Allocate a range, adding a page if needed.
+		 *
+		 * @param size The size of the range, in bytes.
+		 * @param alignment The alignment of the range's offset within its page.
+		 */
+		[[nodiscard]] auto Allocate(I64 size, I64 alignment)              -> Allocation;
+		auto Free(Allocation allocation)                                  -> void;
+		auto Upload(Allocation allocation, const void* data)     noexcept -> void;
+
+		[[nodiscard]] auto Offset(Allocation allocation)   const noexcept -> I64;
+		[[nodiscard]] auto PageBuffer(U32 page)            const noexcept -> const Objects::Buffer&;
+
+		/**
+		 * @brief Compact fragmented pages by moving allocations down on the GPU.
+		 *
+		 * Must not be called while draws reading from the heap are still to be
+		 * issued with offsets looked up before the call.
+		 *
+		 * @param budget The maximum number of bytes to move.
+		 *
+		 * @return The number of bytes moved.
+		 */
+		auto Defragment(I64 budget)                                       -> I64;
+
+		[[nodiscard]] auto GetStats()                      const noexcept -> Stats;
+
+	private:
+		/**
+		 * @brief Pages less fragmented than this are left alone by Defragment().
+		 */
+		static constexpr auto kDefragmentThreshold = .25F;
+
+		struct Page
+		{
+			Objects::Buffer buffer;
+			TLSFAllocator   allocator;
+		};
+
+	private:
+		I64                       m_PageSize;
+		std::vector<Unique<Page>> m_Pages; /**< Null once a dedicated page was released */
+	};
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "GFX/Platform/OpenGL/Objects/ReadbackBuffer.hpp"
+#include "GFX/Renderer.hpp"
+
+#include "Core/Type.hpp"
+
+#include "glad/gl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	/**
+	 * @brief Reads frames back through a ring of pixel pack buffers, without stalling
+	 *
+	 * Capture() only queues a glReadPixels into a free slot's buffer and
+	 * fences it. Poll() hands the slots whose fence signaled to a worker
+	 * thread, which copies the pixels out of the persistent mapping and runs
+	 * the callback, then frees the slot. The render thread never waits on
+	 * the GPU nor touches the pixels.
+	 */
+	class FrameCapturer
+	{
+	public:
+		using Callback = GFX::Renderer::CaptureCallback;
+
+		static constexpr auto kDefaultSlotCount = 4;
+
+	public:
+		explicit FrameCapturer(I32 nSlots = kDefaultSlotCount);
+		FrameCapturer(const FrameCapturer&) = delete;
+		FrameCapturer(FrameCapturer&&) = delete;
+		/**
+		 * @brief Deliver the captures still in flight, then stop the worker.
+		 */
+		~FrameCapturer();
+
+		auto operator=(const FrameCapturer&) = delete;
+		auto operator=(FrameCapturer&&) = delete;
+
+		/**
+		 * @brief Queue a readback of the bound read framebuffer's color buffer.
+		 *
+		 * @return false if every slot is still in flight; the capture is dropped.
+		 */
+		[[nodiscard]] auto Capture(I32 width, I32 height, U64 frame, Callback callback) -> bool;
+		/**
+		 * @brief Hand the readbacks the GPU has completed to the worker. Call once per frame.
+		 */
+		auto Poll() -> void;
+
+	private:
+		struct Slot
+		{
+			Unique<Objects::ReadbackBuffer> buffer;
+			GLsync                          fence = nullptr;
+			std::atomic<bool>               isBusy = false; /**< From Capture() until the worker is done with it */
+			I32                             width  = 0;
+			I32                             height = 0;
+			U64                             frame  = 0;
+			Callback                        callback;
+		};
+
+		/**
+		 * @brief Hand slots to the worker, in capture order, until one is not ready yet.
+		 *
+		 * @param wait Whether to block until each slot's readback completes.
+		 */
+		auto Dispatch(bool wait) -> void;
+		auto WorkerLoop(std::stop_token stopToken) -> void;
+
+	private:
+		std::vector<Unique<Slot>>   m_Slots;
+		std::deque<Slot*>           m_Pending; /**< Read back but not yet handed to the worker, in capture order */
+		std::mutex                  m_Mutex;
+		std::condition_variable_any m_CV;
+		std::deque<Slot*>           m_Queue;   /**< Waiting for the worker */
+		std::jthread                m_Worker;
+	};
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Object.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	/**
+	 * @brief A fixed-size buffer with immutable storage, updated through Upload()
+	 *
+	 * Not tied to any particular use: bind it to a vertex array as vertex or
+	 * index data, or anywhere else a buffer name is expected.
+	 */
+	class Buffer : public Object<Buffer>
+	{
+	public:
+		explicit Buffer(I64 size) noexcept;
+		static auto Release(GLID& id) noexcept -> void;
+
+		auto Upload(const void* data, I64 size, I64 offset) noexcept -> void;
+		/**
+		 * @brief Copy a range into another buffer, or elsewhere in the same one, on the GPU
+		 *
+		 * The source and destination ranges must not overlap.
+		 */
+		auto CopyTo(const Buffer& target, I64 readOffset, I64 writeOffset, I64 size) const noexcept -> void;
+
+		[[nodiscard]] auto Size() const noexcept -> I64 { return m_Size; }
+
+	private:
+		I64 m_Size;
+	};
+}
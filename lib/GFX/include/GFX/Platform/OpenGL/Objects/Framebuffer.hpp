@@ -6,35 +6,117 @@
 
 #include "glad/gl.h"
 
+#include <initializer_list>
+
 namespace Gaze::GFX::Platform::OpenGL::Objects {
+	class Texture;
+
 	class FramebufferAttachment : public Object<FramebufferAttachment>
 	{
 	public:
-		FramebufferAttachment(I32 width, I32 height);
+		FramebufferAttachment(I32 width, I32 height, I32 samples = 1);
 		static auto Release(GLID& id) noexcept -> void;
 	};
 
 	class Renderbuffer : public Object<Renderbuffer>
 	{
 	public:
-		Renderbuffer(I32 width, I32 height);
+		Renderbuffer(I32 width, I32 height, I32 samples = 1);
 		static auto Release(GLID& id) noexcept -> void;
 	};
 
 	class Framebuffer : public Object<Framebuffer>
 	{
 	public:
-		Framebuffer(I32 width, I32 height);
+		Framebuffer(I32 width, I32 height, I32 samples = 1);
 		static auto Release(GLID& id) noexcept -> void;
 
 		auto Bind() const noexcept -> void;
 
+		/**
+		 * @brief Copy the color attachment into another framebuffer
+		 *
+		 * Multisampled framebuffers are resolved in the process. Both
+		 * framebuffers must have the same dimensions.
+		 *
+		 * @param target The target framebuffer. 0 is the window's framebuffer
+		 */
+		auto BlitTo(GLID target) const noexcept -> void;
+
 		auto ColorAttachmentID() const noexcept -> GLID { return m_ColorAttachment.ID(); }
+		auto Width()             const noexcept -> I32  { return m_Width; }
+		auto Height()            const noexcept -> I32  { return m_Height; }
+		auto Samples()           const noexcept -> I32  { return m_Samples; }
 
 		static auto Unbind() noexcept -> void;
 
 	private:
 		FramebufferAttachment m_ColorAttachment;
 		Renderbuffer m_DepthStencilAttachment;
+		I32 m_Width;
+		I32 m_Height;
+		I32 m_Samples;
+	};
+
+	/**
+	 * @brief A framebuffer with a single depth attachment and no color, for depth-only passes such as shadow maps
+	 */
+	class DepthFramebuffer : public Object<DepthFramebuffer>
+	{
+	public:
+		DepthFramebuffer();
+		static auto Release(GLID& id) noexcept -> void;
+
+		/**
+		 * @brief Render into a layer of a depth texture array.
+		 *
+		 * @param texture A depth texture array or cube map array.
+		 * @param layer The layer; cube map arrays count faces, as cube * 6 + face.
+		 */
+		auto AttachLayer(const Texture& texture, I32 layer) noexcept -> void;
+	};
+
+	/**
+	 * @brief A framebuffer rendering into a layer of a color texture array, over its own depth buffer
+	 */
+	class LayerFramebuffer : public Object<LayerFramebuffer>
+	{
+	public:
+		/**
+		 * @param width, height Of the depth buffer; the layers attached must be as large.
+		 */
+		LayerFramebuffer(I32 width, I32 height);
+		static auto Release(GLID& id) noexcept -> void;
+
+		/**
+		 * @brief Render into a layer of a color texture array.
+		 */
+		auto AttachLayer(const Texture& texture, I32 layer) noexcept -> void;
+
+	private:
+		Renderbuffer m_DepthStencilAttachment;
+	};
+
+	/**
+	 * @brief A framebuffer rendering into whole 2D textures, attached by its user
+	 */
+	class TextureFramebuffer : public Object<TextureFramebuffer>
+	{
+	public:
+		TextureFramebuffer();
+		static auto Release(GLID& id) noexcept -> void;
+
+		/**
+		 * @brief Render into the base level of a 2D texture.
+		 *
+		 * @param attachment E.g. GL_COLOR_ATTACHMENT0 or GL_DEPTH_ATTACHMENT.
+		 */
+		auto Attach(GLenum attachment, const Texture& texture) noexcept -> void;
+		auto Attach(GLenum attachment, const Renderbuffer& renderbuffer) noexcept -> void;
+
+		/**
+		 * @brief Route the fragment shader outputs to color attachments, in output location order.
+		 */
+		auto SetDrawBuffers(std::initializer_list<GLenum> attachments) noexcept -> void;
 	};
 }
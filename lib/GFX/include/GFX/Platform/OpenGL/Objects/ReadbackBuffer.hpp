@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Object.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	/**
+	 * @brief A persistently mapped buffer the GPU writes into and the CPU reads from
+	 *
+	 * Meant as a pixel pack buffer target. The mapping is coherent, so data
+	 * written by the GPU can be read through Data() from any thread once a
+	 * fence placed after the write has signaled.
+	 */
+	class ReadbackBuffer : public Object<ReadbackBuffer>
+	{
+	public:
+		explicit ReadbackBuffer(I64 size) noexcept;
+		static auto Release(GLID& id) noexcept -> void;
+
+		[[nodiscard]] auto Data() const noexcept -> const Byte* { return m_Mapping; }
+		[[nodiscard]] auto Size() const noexcept -> I64         { return m_Size; }
+
+	private:
+		const Byte* m_Mapping;
+		I64         m_Size;
+	};
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Object.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	/**
+	 * @brief A persistently mapped buffer for data re-written every frame
+	 *
+	 * The buffer is split into regions, one per frame in flight. Each frame
+	 * writes into its own region through the persistent mapping, so writes
+	 * never stall on draws still reading the previous frames' data. A fence
+	 * guards each region until the GPU is done with it.
+	 */
+	class StreamBuffer : public Object<StreamBuffer>
+	{
+	public:
+		struct Allocation
+		{
+			void* data;   /**< Write pointer into the mapping */
+			I64   offset; /**< Offset from the start of the buffer, for use in draws */
+		};
+
+	public:
+		StreamBuffer(I64 regionSize, I32 nRegions = 3) noexcept;
+		StreamBuffer(StreamBuffer&& other) noexcept = default;
+		~StreamBuffer();
+		static auto Release(GLID& id) noexcept -> void;
+
+		/**
+		 * @brief Allocate memory from the current frame's region
+		 *
+		 * @param size The size of the allocation, in bytes
+		 * @param alignment The alignment of the allocation's offset
+		 *
+		 * @return The allocation, or std::nullopt if the region is full
+		 */
+		[[nodiscard]] auto Allocate(I64 size, I64 alignment)  noexcept -> std::optional<Allocation>;
+		/**
+		 * @brief Fence the current region and move on to the next one
+		 *
+		 * Call once per frame, after the last draw reading from the buffer.
+		 * Blocks if the next region is still in use by the GPU.
+		 */
+		auto EndFrame()                                       noexcept -> void;
+
+		[[nodiscard]] auto RegionSize()                 const noexcept -> I64;
+		[[nodiscard]] auto Remaining()                  const noexcept -> I64;
+		/**
+		 * @brief Get how large an allocation with @p alignment can still be, after the padding aligning it
+		 */
+		[[nodiscard]] auto Remaining(I64 alignment)     const noexcept -> I64;
+
+	private:
+		Byte*               m_Mapping;
+		I64                 m_RegionSize;
+		I64                 m_Cursor;
+		std::size_t         m_Region;
+		std::vector<GLsync> m_Fences;
+	};
+
+	inline auto StreamBuffer::RegionSize() const noexcept -> I64
+	{
+		return m_RegionSize;
+	}
+
+	inline auto StreamBuffer::Remaining() const noexcept -> I64
+	{
+		return m_RegionSize - m_Cursor;
+	}
+
+	inline auto StreamBuffer::Remaining(I64 alignment) const noexcept -> I64
+	{
+		// Offsets are aligned from the start of the buffer, not of the region
+		const auto regionBase = I64(m_Region) * m_RegionSize;
+		const auto aligned    = ((regionBase + m_Cursor + alignment - 1) / alignment) * alignment - regionBase;
+
+		return std::max(m_RegionSize - aligned, I64(0));
+	}
+}
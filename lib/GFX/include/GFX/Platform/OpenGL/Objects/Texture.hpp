@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Object.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	/**
+	 * @brief An immutable-storage texture
+	 *
+	 * 2D unless created with another target, such as an array of layers.
+	 */
+	class Texture : public Object<Texture>
+	{
+	public:
+		/**
+		 * @param width The width of the base level, in texels
+		 * @param height The height of the base level, in texels
+		 * @param internalFormat The sized internal format, e.g. GL_RGBA8
+		 * @param levels The number of mip levels
+		 */
+		Texture(I32 width, I32 height, GLenum internalFormat, I32 levels = 1) noexcept;
+		/**
+		 * @param target GL_TEXTURE_2D_ARRAY or GL_TEXTURE_CUBE_MAP_ARRAY
+		 * @param width The width of the base level, in texels
+		 * @param height The height of the base level, in texels
+		 * @param layers The number of layers; six per cube with GL_TEXTURE_CUBE_MAP_ARRAY
+		 * @param internalFormat The sized internal format, e.g. GL_DEPTH_COMPONENT32F
+		 * @param levels The number of mip levels
+		 */
+		Texture(GLenum target, I32 width, I32 height, I32 layers, GLenum internalFormat, I32 levels = 1) noexcept;
+		static auto Release(GLID& id) noexcept -> void;
+
+		/**
+		 * @brief Upload a whole mip level
+		 *
+		 * @param level The mip level
+		 * @param format The format of @p pixels, e.g. GL_RED
+		 * @param type The type of @p pixels' components, e.g. GL_UNSIGNED_BYTE
+		 * @param pixels Tightly packed rows, the first one at texture coordinate t = 0
+		 */
+		auto Upload(I32 level, GLenum format, GLenum type, const void* pixels) noexcept -> void;
+		/**
+		 * @brief Upload a whole mip level of one layer, already compressed in the texture's internal format
+		 *
+		 * @param level The mip level
+		 * @param layer The layer of an array texture; 0 otherwise
+		 * @param blocks The compressed blocks, as many as the level has
+		 */
+		auto UploadCompressed(I32 level, I32 layer, std::span<const std::byte> blocks) noexcept -> void;
+		auto SetFilter(GLenum minFilter, GLenum magFilter)                     noexcept -> void;
+		auto SetWrap(GLenum wrap)                                              noexcept -> void;
+		/**
+		 * @brief Remap the components read by shaders, e.g. to read a GL_R8 texture as white with alpha.
+		 */
+		auto SetSwizzle(GLenum r, GLenum g, GLenum b, GLenum a)                noexcept -> void;
+		/**
+		 * @brief Make depth textures compare their texels to a reference, for shadow samplers.
+		 *
+		 * @param func The comparison, e.g. GL_LEQUAL
+		 */
+		auto SetCompare(GLenum func)                                           noexcept -> void;
+		/**
+		 * @brief Compute every mip level below the base one from it, in every layer.
+		 */
+		auto GenerateMipmaps()                                                 noexcept -> void;
+
+		[[nodiscard]] auto Width()  const noexcept -> I32 { return m_Width; }
+		[[nodiscard]] auto Height() const noexcept -> I32 { return m_Height; }
+		[[nodiscard]] auto Layers() const noexcept -> I32 { return m_Layers; }
+
+	private:
+		I32    m_Width;
+		I32    m_Height;
+		I32    m_Layers;
+		GLenum m_Target;
+		GLenum m_InternalFormat;
+	};
+}
@@ -23,12 +23,16 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 			using ComponentCount = ValueWrapper<I32, struct ComponentCountTag>;
 			using Normalized     = ValueWrapper<bool>;
 			using RelativeOffset = ValueWrapper<U32, struct RelativeOffsetTag>;
+			using Integer        = ValueWrapper<bool, struct IntegerTag>;
 
 			enum class DataType
 			{
 				Byte,
+				UnsignedByte,
 				Short,
+				UnsignedShort,
 				Int,
+				UnsignedInt,
 				Fixed,
 				Float,
 				HalfFloat,
@@ -40,6 +44,7 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 			DataType       type;
 			Normalized     normalized;
 			RelativeOffset relativeOffset;
+			Integer        integer = Integer(false); /**< Read integer data as ivec/uvec attributes instead of converting it to float */
 		};
 
 	public:
@@ -54,7 +59,8 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 			Stride stride)
 		noexcept -> void;
 
-		auto SetLayout(std::initializer_list<Layout> layout) noexcept -> void;
-		auto SetIndexBuffer(IndexBuffer* buffer)             noexcept -> void;
+		auto SetLayout(std::initializer_list<Layout> layout)      noexcept -> void;
+		auto SetIndexBuffer(IndexBuffer* buffer)                  noexcept -> void;
+		auto SetBindingDivisor(BufferBinding binding, U32 divisor) noexcept -> void;
 	};
 }
@@ -3,6 +3,14 @@
 #include "GFX/Renderer.hpp"
 
 namespace Gaze::GFX::Platform::OpenGL {
+	namespace Objects {
+		class ShaderProgram;
+	}
+
+	class ShaderPermutations;
+	struct BufferSection;
+	struct ResidentMesh;
+
 	class Renderer : public GFX::Renderer
 	{
 		using GLID = U32;
@@ -17,7 +25,21 @@ namespace Gaze::GFX::Platform::OpenGL {
 		auto Clear(Buffer buffer)                             noexcept -> void override;
 		auto Flush()                                          noexcept -> void override;
 		auto Render()                                         noexcept -> void override;
+		auto SetResolveMode(ResolveMode mode, I32 samples)    noexcept -> void override;
+		auto SetVSync(VSyncMode mode)                         noexcept -> void override;
+		auto SetMaxFramesInFlight(I32 nFrames)                noexcept -> void override;
+		auto SetVertexPulling(bool enabled)                   noexcept -> void override;
+		auto SetVisibilityBuffer(bool enabled)                noexcept -> void override;
+		auto SetDeferredShading(bool enabled)                 noexcept -> void override;
+		auto SetSkinning(SkinningMode mode, Jobs::ThreadPool* pool) noexcept -> void override;
+		auto SetShadows(std::optional<ShadowCache::Settings> settings) -> void override;
+		auto SetStaticShadowCasters(const StaticBatcher* batcher) noexcept -> void override;
+		auto SetImpostors(std::optional<ImpostorAtlas::Settings> settings) -> void override;
+		auto LoadTexture(const Shared<const TextureImage>& image)      -> void override;
+		auto CaptureFrame(CaptureCallback callback)                    -> void override;
 		auto MakeContextCurrent()                             noexcept -> void override;
+		auto ReleaseContext()                                 noexcept -> void override;
+		auto Synchronize()                                    noexcept -> void override;
 		auto Stats()                                          noexcept -> RenderStats override;
 		auto SetViewport(I32 x, I32 y, I32 width, I32 height) noexcept -> void override;
 		auto SetCamera(Shared<Camera> camera)                 noexcept -> void override;
@@ -28,13 +50,175 @@ namespace Gaze::GFX::Platform::OpenGL {
 			I32 nLights,
 			PrimitiveMode mode
 		) -> void override;
+		auto SetLights(const struct Light lights[], I32 nLights)       -> void override;
 		auto SubmitObject(const Object& object, PrimitiveMode mode)    -> void override;
+		auto SubmitObject(const Object& object, const glm::mat4& transform, PrimitiveMode mode) -> void override;
+		auto SubmitSkinned(
+			const Object& object,
+			const glm::mat4& transform,
+			std::span<const glm::mat4> palette,
+			PrimitiveMode mode
+		) -> void override;
+		auto SubmitWithImpostor(const Object& object, const glm::mat4& transform) -> void override;
+		auto SubmitObject(
+			const Object& object,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode
+		) -> void override;
 		auto SubmitObject(
 			const Object& object,
+			const glm::mat4& transform,
 			const struct Light lights[],
 			I32 nLights,
 			PrimitiveMode mode
 		) -> void override;
+		auto SubmitParticles(const ParticleEmitter& emitter)           -> void override;
+		auto SubmitParticles(std::span<const ParticleEmitter::Instance> instances) -> void override;
+		auto SubmitTerrain(const Terrain& terrain)                     -> void override;
+		auto SubmitTerrain(const Terrain::Snapshot& snapshot)          -> void override;
+
+	private:
+		auto BindRenderTarget()  noexcept -> void;
+		auto Resolve()           noexcept -> void;
+		auto FlushTerrain()      noexcept -> void;
+		/**
+		 * @brief Redraw the shadow maps due this frame, with the queued and flushed sections as dynamic casters.
+		 */
+		auto RenderShadows()     noexcept -> void;
+		/**
+		 * @brief Keep the dynamic casters of the queued sections for RenderShadows(), before they are flushed.
+		 */
+		auto KeepShadowCasters()          -> void;
+		/**
+		 * @brief Draw the queued sections, terrain and impostors, and empty the queues.
+		 */
+		auto DrawQueued()        noexcept -> void;
+		/**
+		 * @brief Render the meshes waiting for their impostor into the atlas, as many as allowed per frame.
+		 */
+		auto BakeImpostors()     noexcept -> void;
+		/**
+		 * @brief Draw the impostors submitted since the last flush, in one instanced call.
+		 */
+		auto FlushImpostors()    noexcept -> void;
+		auto FlushParticles()    noexcept -> void;
+		/**
+		 * @brief Reserve room for particles in this frame's particle buffer, and queue their draw.
+		 *
+		 * @return The instances to write, fewer than @p count if the buffer ran out.
+		 */
+		[[nodiscard]] auto AllocateParticles(std::size_t count) -> std::span<ParticleEmitter::Instance>;
+		auto FlushSprites()      noexcept -> void;
+		auto FlushDebugDraw()    noexcept -> void;
+		auto FlushOverlay()      noexcept -> void;
+		auto BeginFrame()        noexcept -> void;
+		auto PaceFrames()        noexcept -> void;
+		/**
+		 * @brief Release the GPU copies of meshes that no longer exist and defragment the rest.
+		 */
+		auto MaintainMeshHeaps() noexcept -> void;
+		/**
+		 * @brief Upload the texture levels due this frame, and drop the textures whose image was released.
+		 */
+		auto StreamTextures()    noexcept -> void;
+		/**
+		 * @brief Queue the readbacks requested with CaptureFrame() for the frame just rendered.
+		 */
+		auto CaptureRequestedFrames() noexcept -> void;
+		/**
+		 * @brief Draw the submitted sections in [first, last) forward: pulled if vertex pulling is enabled, the skinned ones one by one.
+		 *
+		 * @param shaders The mesh shaders, or the G-buffer shaders when deferred.
+		 */
+		auto DrawForward(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> void;
+		/**
+		 * @brief Rasterize the first @p count submitted sections that can be into the visibility buffer, and shade them from it.
+		 *
+		 * @return Whether they were; false if there were none, or the per-frame buffers ran out.
+		 */
+		auto DrawVisibility(std::size_t count) noexcept -> bool;
+		/**
+		 * @brief Bind and clear the G-buffer, resized to the viewport if it changed.
+		 */
+		auto BindGBuffer() noexcept -> void;
+		/**
+		 * @brief Light the G-buffer with a volume per scene light, and composite it into the render target.
+		 */
+		auto ShadeDeferred() noexcept -> void;
+		/**
+		 * @brief Draw the submitted sections in [first, last) one by one, with vertex attributes.
+		 */
+		auto DrawSections(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> void;
+		/**
+		 * @brief Bind the vertex array and buffers a submitted section is drawn from.
+		 *
+		 * @param boundVertexBuffer, boundIndexPage The buffers last bound to the rigid vertex array, updated.
+		 *
+		 * @return The base vertex to draw the section with.
+		 */
+		auto BindSection(std::size_t idx, std::optional<U32>& boundVertexBuffer, std::optional<U32>& boundIndexPage) noexcept -> I32;
+		/**
+		 * @brief Bind the vertex array and buffers a section is drawn from, given its index and vertex sections.
+		 */
+		auto BindSection(
+			const BufferSection& sect,
+			const BufferSection& vertexSect,
+			std::optional<U32>& boundVertexBuffer,
+			std::optional<U32>& boundIndexPage
+		) noexcept -> I32;
+		/**
+		 * @brief Draw the rigid submitted sections in [first, last) with multi-draws pulling their vertices from the mesh heaps.
+		 *
+		 * @return The end of the sections drawn; less than @p last if the per-frame buffers ran out.
+		 */
+		auto DrawSectionsPulled(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> std::size_t;
+		/**
+		 * @brief Skin the sections queued for CPU skinning since the last flush.
+		 */
+		auto SkinOnCPU()                                       noexcept -> void;
+		/**
+		 * @brief Bind a mesh shader variant and upload the camera uniforms to it, compiling it on first use.
+		 */
+		auto UseMeshShader(U32 variant)                       noexcept -> Objects::ShaderProgram&;
+		/**
+		 * @brief As UseMeshShader(), from other permutations sharing the mesh fragment shader, such as the impostors'.
+		 */
+		auto UseMeshShader(ShaderPermutations& shaders, U32 variant) noexcept -> Objects::ShaderProgram&;
+		/**
+		 * @brief Draw the primitives of a resident mesh as triangles, with the rigid vertex array and the bound program.
+		 */
+		auto DrawResident(const ResidentMesh& resident)       noexcept -> void;
+		/**
+		 * @brief Upload a mesh to the mesh heaps, unless it already is resident.
+		 */
+		auto MakeResident(const Geometry::MeshHandle& mesh)            -> ResidentMesh&;
+		/**
+		 * @brief Request a texture at the size of world space bounds on screen.
+		 *
+		 * @return Where the mesh shaders sample the texture, see PackTexture(); 0 if it is invalid or has no level uploaded yet.
+		 */
+		auto RequestTexture(TextureID texture, const AABB& bounds) noexcept -> U32;
+		/**
+		 * @brief Select the scene's lights for world space bounds, or the default light if the scene has none.
+		 *
+		 * @return The number of lights written to @p lights, at most 8.
+		 */
+		auto SelectLights(const AABB& bounds, struct Light lights[]) const noexcept -> I32;
+		/**
+		 * @brief Queue the sections of an object, skinned by @p palette unless it is empty.
+		 *
+		 * @param fade Below 1 while the object cross-fades into its impostor: the share of its pixels drawn.
+		 */
+		auto Submit(
+			const Object& object,
+			const glm::mat4& transform,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode,
+			std::span<const glm::mat4> palette,
+			F32 fade = 1.F
+		) -> void;
 
 	private:
 		Impl* m_pImpl{ nullptr };
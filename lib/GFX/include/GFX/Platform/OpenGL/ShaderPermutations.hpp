@@ -0,0 +1,58 @@
+#pragma once
+
+#include "GFX/Platform/OpenGL/Objects/Shader.hpp"
+
+#include "Core/Type.hpp"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	/**
+	 * @brief Variants of a shader program, specialized at compile time with preprocessor defines
+	 *
+	 * The sources are written once, with features toggled by #if/#ifdef
+	 * blocks. Each variant is identified by a key, which the defines function
+	 * turns into the #define lines inserted right after the #version
+	 * directive. Variants are compiled and linked the first time they are
+	 * requested, then cached for the lifetime of the object.
+	 */
+	class ShaderPermutations
+	{
+	public:
+		using Key = U32;
+
+		/**
+		 * @brief Returns the #define lines specializing the sources for a key.
+		 */
+		using DefinesFn = std::function<std::string(Key key)>;
+
+	public:
+		ShaderPermutations(std::string vertexSource, std::string fragmentSource, DefinesFn defines) noexcept;
+
+		/**
+		 * @brief Get the variant for @p key, compiling it if needed.
+		 */
+		auto Get(Key key)                         -> Objects::ShaderProgram&;
+		[[nodiscard]] auto Size() const noexcept  -> std::size_t;
+
+	private:
+		/**
+		 * @brief Insert @p defines after the #version directive of @p source.
+		 */
+		[[nodiscard]] static auto Specialize(std::string_view source, std::string_view defines) -> std::string;
+
+	private:
+		std::string                                             m_VertexSource;
+		std::string                                             m_FragmentSource;
+		DefinesFn                                               m_Defines;
+		std::unordered_map<Key, Unique<Objects::ShaderProgram>> m_Variants;
+	};
+
+	inline auto ShaderPermutations::Size() const noexcept -> std::size_t
+	{
+		return m_Variants.size();
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "glad/gl.h"
+
+#include <array>
+#include <optional>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	namespace Objects {
+		class DepthFramebuffer;
+		class Framebuffer;
+		class LayerFramebuffer;
+		class ShaderProgram;
+		class TextureFramebuffer;
+		class VertexArray;
+	}
+
+	/**
+	 * @brief Shadows the OpenGL state the renderer touches, to skip redundant calls
+	 *
+	 * Every change goes through the cache, which only forwards it to OpenGL
+	 * if the value differs from the last one set. State starts out unknown, so
+	 * the first change of each kind is always issued.
+	 *
+	 * Anything that modifies the same state behind the cache's back (raw GL
+	 * calls, third-party code, deleting a bound object) must be followed by a
+	 * call to Invalidate().
+	 */
+	class StateCache
+	{
+	public:
+		enum class Capability
+		{
+			DepthTest,
+			Blend,
+			CullFace,
+			ProgramPointSize,
+			StencilTest,
+			DepthClamp,
+			PolygonOffsetFill,
+
+			Count,
+		};
+
+		struct Counters
+		{
+			I64 issued; /**< State changes forwarded to OpenGL */
+			I64 elided; /**< State changes skipped because the state was already set */
+		};
+
+		static constexpr auto kMaxTextureUnits          = 24;
+		static constexpr auto kMaxStorageBufferBindings = 8;
+
+	public:
+		auto UseProgram(const Objects::ShaderProgram& program)   noexcept -> void;
+		auto BindVertexArray(const Objects::VertexArray& array)  noexcept -> void;
+		/**
+		 * @brief Bind a framebuffer for drawing and reading.
+		 *
+		 * @param framebuffer The framebuffer, or nullptr for the window's.
+		 */
+		auto BindFramebuffer(const Objects::Framebuffer* framebuffer) noexcept -> void;
+		auto BindFramebuffer(const Objects::DepthFramebuffer& framebuffer) noexcept -> void;
+		auto BindFramebuffer(const Objects::LayerFramebuffer& framebuffer) noexcept -> void;
+		auto BindFramebuffer(const Objects::TextureFramebuffer& framebuffer) noexcept -> void;
+		auto BindTextureUnit(U32 unit, U32 texture)              noexcept -> void;
+		/**
+		 * @brief Bind a range of a buffer to an indexed shader storage binding.
+		 */
+		auto BindStorageBuffer(U32 index, U32 buffer, I64 offset, I64 size) noexcept -> void;
+		auto BindDrawIndirectBuffer(U32 buffer)                  noexcept -> void;
+
+		auto SetEnabled(Capability capability, bool enabled)     noexcept -> void;
+		auto SetBlendFunc(GLenum source, GLenum destination)     noexcept -> void;
+		auto SetDepthFunc(GLenum func)                           noexcept -> void;
+		auto SetDepthMask(bool enabled)                          noexcept -> void;
+		auto SetCullFace(GLenum face)                            noexcept -> void;
+		auto SetViewport(I32 x, I32 y, I32 width, I32 height)    noexcept -> void;
+
+		/**
+		 * @brief Forget all shadowed state, so that the next change of each kind is issued.
+		 */
+		auto Invalidate() noexcept -> void;
+
+		[[nodiscard]] auto GetCounters() const noexcept -> Counters;
+		auto ResetCounters()                   noexcept -> void;
+
+	private:
+		/**
+		 * @brief Record @p value as the current state.
+		 *
+		 * @return Whether the call should be issued.
+		 */
+		template<typename T>
+		auto Update(std::optional<T>& current, const T& value) noexcept -> bool;
+
+	private:
+		struct BlendFunc
+		{
+			GLenum source;
+			GLenum destination;
+
+			auto operator==(const BlendFunc&) const -> bool = default;
+		};
+
+		struct Viewport
+		{
+			I32 x, y, width, height;
+
+			auto operator==(const Viewport&) const -> bool = default;
+		};
+
+		struct BufferRange
+		{
+			U32 buffer;
+			I64 offset;
+			I64 size;
+
+			auto operator==(const BufferRange&) const -> bool = default;
+		};
+
+		std::optional<U32>                                              m_Program;
+		std::optional<U32>                                              m_VertexArray;
+		std::optional<U32>                                              m_Framebuffer;
+		std::array<std::optional<U32>, kMaxTextureUnits>                m_Textures;
+		std::array<std::optional<BufferRange>, kMaxStorageBufferBindings> m_StorageBuffers;
+		std::optional<U32>                                              m_DrawIndirectBuffer;
+		std::array<std::optional<bool>, std::size_t(Capability::Count)> m_Capabilities;
+		std::optional<BlendFunc>                                        m_BlendFunc;
+		std::optional<GLenum>                                           m_DepthFunc;
+		std::optional<bool>                                             m_DepthMask;
+		std::optional<GLenum>                                           m_CullFace;
+		std::optional<Viewport>                                         m_Viewport;
+		Counters                                                        m_Counters{};
+	};
+
+	template<typename T>
+	auto StateCache::Update(std::optional<T>& current, const T& value) noexcept -> bool
+	{
+		if (current == value) {
+			m_Counters.elided++;
+			return false;
+		}
+
+		current = value;
+		m_Counters.issued++;
+		return true;
+	}
+}
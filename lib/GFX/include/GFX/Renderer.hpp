@@ -4,8 +4,16 @@
 
 #include "GFX/API.hpp"
 #include "GFX/Camera.hpp"
+#include "GFX/DebugDraw.hpp"
+#include "GFX/ImpostorAtlas.hpp"
 #include "GFX/Mesh.hpp"
 #include "GFX/Object.hpp"
+#include "GFX/Overlay.hpp"
+#include "GFX/ParticleEmitter.hpp"
+#include "GFX/ShadowCache.hpp"
+#include "GFX/SpriteBatch.hpp"
+#include "GFX/Terrain.hpp"
+#include "GFX/TextureImage.hpp"
 
 #include "WM/Window.hpp"
 
@@ -13,8 +21,18 @@
 #include <glm/mat4x4.hpp>
 
 #include <array>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
 
 namespace Gaze::GFX {
+	class StaticBatcher;
+
 	using Vec3 = glm::vec3;
 
 	/**
@@ -34,8 +52,36 @@ namespace Gaze::GFX {
 		struct RenderStats
 		{
 			I32 nDrawCalls;
+			F64 frameTimeMs;             /**< CPU time between the last two calls to Render() */
+			F64 presentLatencyMs;        /**< Time from the first submission of the last completed frame until the GPU finished it, including the swap */
+			F64 pacingWaitMs;            /**< Time Render() spent blocked waiting for frames in flight to complete */
+			I32 nFramesInFlight;         /**< Number of frames submitted but not yet completed by the GPU */
+			I32 nStateChanges;           /**< OpenGL state changes (binds, enables, ...) actually issued */
+			I32 nStateChangesElided;     /**< State changes skipped because the state was already set */
+			I64 uploadedBytes;           /**< Mesh data uploaded to the GPU during the frame; meshes already resident are not uploaded again */
+			I64 meshMemoryBytes;         /**< GPU memory used by resident meshes */
+			F32 meshMemoryFragmentation; /**< 0 when the free mesh memory is contiguous, approaching 1 as it gets scattered */
+			I32 nShadowStaticRedraws;    /**< Shadow map layers whose cached static casters were redrawn */
+			I32 nImpostors;              /**< Instances drawn as impostors, those cross-fading into their mesh included */
+			I32 nInstancesMerged;        /**< Submissions drawn as an extra instance of another submission of the same mesh, rather than by their own draw call */
 		};
 
+		/**
+		 * @brief A frame read back from the GPU by CaptureFrame()
+		 */
+		struct FrameCapture
+		{
+			U64               frame;  /**< Index of the captured frame, counted by Render() */
+			I32               width;
+			I32               height;
+			std::vector<Byte> pixels; /**< RGBA8, rows from bottom to top */
+		};
+
+		/**
+		 * @brief Receives a captured frame, on a worker thread.
+		 */
+		using CaptureCallback = std::function<void(FrameCapture capture)>;
+
 		/**
 		 * @brief Defines the primitive mode for rendering.
 		 */
@@ -63,6 +109,37 @@ namespace Gaze::GFX {
 			kStencilBuffer = 1 << 2
 		};
 
+		/**
+		 * @brief Defines how buffer swaps are synchronised with the display.
+		 */
+		enum class VSyncMode
+		{
+			Off,     /**< Swap immediately. Lowest latency, may tear */
+			On,      /**< Wait for the vertical blank */
+			Adaptive /**< Wait for the vertical blank unless the frame is late. Falls back to On if unsupported */
+		};
+
+		/**
+		 * @brief Defines how the rendered frame reaches the window.
+		 *
+		 * The resolve step runs exactly once per frame, in Render().
+		 */
+		enum class ResolveMode
+		{
+			Direct,    /**< Render straight into the window's framebuffer. No resolve step */
+			Blit,      /**< Render offscreen, then copy (and MSAA resolve) into the window's framebuffer */
+			ScreenPass /**< Render offscreen, then draw a full-screen pass. Required for post-processing */
+		};
+
+		/**
+		 * @brief Defines where skinned meshes are deformed.
+		 */
+		enum class SkinningMode
+		{
+			GPU, /**< In the vertex shader, reading the joint matrices from a storage buffer */
+			CPU  /**< On the CPU with SIMD, before drawing. For GPUs where vertex work is the bottleneck */
+		};
+
 	public:
 		/**
 		 * @brief Construct a new renderer object
@@ -100,15 +177,175 @@ namespace Gaze::GFX {
 		virtual auto Clear(Buffer buffer = Buffer(kColorBuffer | kDepthBuffer)) noexcept -> void = 0;
 		/**
 		 * @brief Flush the command buffer
+		 *
+		 * Draws all pending submissions into the current render target. The
+		 * frame is not resolved nor presented.
 		 */
 		virtual auto Flush() noexcept -> void = 0;
 		/**
 		 * @brief Render the scene
 		 *
-		 * This function flushes the command buffer and swaps the back and front
-		 * buffers.
+		 * This function flushes the command buffer, resolves the render target
+		 * into the window's framebuffer, and swaps the back and front buffers.
 		 */
 		virtual auto Render() noexcept -> void = 0;
+		/**
+		 * @brief Set how the frame is resolved into the window's framebuffer
+		 *
+		 * @param mode The resolve mode. Defaults to ResolveMode::Direct
+		 * @param samples The number of MSAA samples of the offscreen target.
+		 *                Ignored with ResolveMode::Direct
+		 */
+		virtual auto SetResolveMode(ResolveMode mode, I32 samples = 1) noexcept -> void = 0;
+		/**
+		 * @brief Set the swap interval behaviour
+		 *
+		 * @param mode The VSync mode. The driver's default is used until this
+		 *             is called
+		 */
+		virtual auto SetVSync(VSyncMode mode) noexcept -> void = 0;
+		/**
+		 * @brief Limit how many frames the CPU may queue ahead of the GPU
+		 *
+		 * Render() blocks once the limit is reached until the oldest frame
+		 * completes. Lower values reduce input latency at the cost of
+		 * throughput.
+		 *
+		 * @param nFrames The maximum number of frames in flight. Defaults to 2
+		 */
+		virtual auto SetMaxFramesInFlight(I32 nFrames) noexcept -> void = 0;
+		/**
+		 * @brief Fetch vertices from storage buffers in the vertex shader
+		 *
+		 * Instead of binding vertex arrays per draw, the vertex shader reads
+		 * vertices and indices straight from the mesh buffers, so consecutive
+		 * submissions are merged into a few indirect multi-draws. Trades some
+		 * vertex shader work for far fewer draw calls and state changes.
+		 *
+		 * @param enabled Whether to use vertex pulling. Defaults to false
+		 */
+		virtual auto SetVertexPulling(bool enabled) noexcept -> void = 0;
+		/**
+		 * @brief Shade dense geometry once per pixel, through a visibility buffer
+		 *
+		 * A first pass rasterizes the rigid triangle submissions writing only
+		 * which draw and triangle cover each pixel. A full-screen pass then
+		 * reconstructs the surface behind every pixel from its triangle and
+		 * shades it, so lighting costs the same however many triangles and
+		 * layers of overdraw there are. Other submissions, skinned, fading or
+		 * not made of triangles, are drawn forward over the result.
+		 *
+		 * Works with or without vertex pulling; the visibility pass always
+		 * pulls its vertices.
+		 *
+		 * @param enabled Whether to use the visibility buffer. Defaults to false
+		 */
+		virtual auto SetVisibilityBuffer(bool enabled) noexcept -> void = 0;
+		/**
+		 * @brief Light opaque submissions in screen space, by every scene light reaching them
+		 *
+		 * Submissions are first drawn into a G-buffer holding their normal,
+		 * albedo and specular material. Each scene light is then drawn as its
+		 * volume, see LightVolumes: point lights as spheres whose covered
+		 * pixels are found with the stencil buffer, so a light only shades the
+		 * pixels it reaches. Directional and unattenuated lights cover the
+		 * screen. Suits scenes with many small lights.
+		 *
+		 * Submissions are lit by the lights set with SetLights(), rather than
+		 * by the lights they were submitted with, which only tell whether they
+		 * are lit. Terrain, impostors and the translucent particles and sprites
+		 * are still drawn forward, as are submissions resolved from the
+		 * visibility buffer. Shininess is stored up to 256.
+		 *
+		 * @param enabled Whether to shade deferred. Defaults to false
+		 */
+		virtual auto SetDeferredShading(bool enabled) noexcept -> void = 0;
+		/**
+		 * @brief Set how skinned meshes are deformed
+		 *
+		 * Skinned submissions are always drawn one by one, with or without
+		 * vertex pulling.
+		 *
+		 * @param mode The skinning mode. Defaults to SkinningMode::GPU
+		 * @param pool With SkinningMode::CPU, the pool the skinning of a
+		 *             flush's submissions is spread over. Skinning happens on
+		 *             the calling thread if null. Must outlive its use by the
+		 *             renderer
+		 */
+		virtual auto SetSkinning(SkinningMode mode, Jobs::ThreadPool* pool = nullptr) noexcept -> void = 0;
+		/**
+		 * @brief Enable shadow mapping
+		 *
+		 * Lights with Light::castsShadows set cast shadows: the first
+		 * directional one over cascades following the camera, and the first
+		 * ShadowCache::kMaxPointLights point lights in every direction. See
+		 * ShadowCache for how the maps are cached and updated.
+		 *
+		 * Static casters, see SetStaticShadowCasters(), are drawn into the
+		 * cached maps only when they or the shadow maps' views change. Objects
+		 * submitted with triangles and not marked static cast shadows each
+		 * frame. The maps are rendered by Render(), once every caster is
+		 * known: what a Flush() draws before is lit by the last frame's maps.
+		 * Terrain receives shadows but doesn't cast any.
+		 *
+		 * @param settings The shadow settings, or std::nullopt to disable
+		 *                 shadows. Disabled by default
+		 */
+		virtual auto SetShadows(std::optional<ShadowCache::Settings> settings) -> void = 0;
+		/**
+		 * @brief Set the static objects that cast shadows
+		 *
+		 * The batcher's batches are drawn into the cached shadow maps, which
+		 * are redrawn whenever its Version() changes. Its batches submitted
+		 * for rendering don't cast shadows a second time.
+		 *
+		 * @param batcher The static casters, or nullptr for none. Must
+		 *                outlive its use by the renderer
+		 */
+		virtual auto SetStaticShadowCasters(const StaticBatcher* batcher) noexcept -> void = 0;
+		/**
+		 * @brief Enable impostors for objects submitted with SubmitWithImpostor()
+		 *
+		 * Meshes are rendered into the impostor atlas the first time one of
+		 * their instances gets small enough on screen, a few per frame, and
+		 * stay there until they go away. Until then, their instances are drawn
+		 * as meshes. See ImpostorAtlas for when instances switch.
+		 *
+		 * Impostors are lit like their mesh, from the normals stored in the
+		 * atlas. They receive shadows but don't cast any.
+		 *
+		 * @param settings The impostor settings, or std::nullopt to disable
+		 *                 impostors. Disabled by default
+		 */
+		virtual auto SetImpostors(std::optional<ImpostorAtlas::Settings> settings) -> void = 0;
+		/**
+		 * @brief Make a texture available to materials, see Material::texture
+		 *
+		 * The texture gets a layer in a texture array of its shape, see
+		 * TextureArrays. Its smallest mip levels are uploaded on the next
+		 * Flush(), and finer ones over the following frames, as objects using
+		 * it get larger on screen. Levels are not evicted when they shrink
+		 * again. Textures that don't fit in the arrays are dropped, with a
+		 * warning; their materials are drawn untextured.
+		 *
+		 * The renderer only keeps a weak reference: the texture is dropped,
+		 * and its layer freed, once the image is released. That is the only
+		 * way to make room in the arrays.
+		 *
+		 * @param image The texture's levels
+		 */
+		virtual auto LoadTexture(const Shared<const TextureImage>& image) -> void = 0;
+		/**
+		 * @brief Capture the frame being rendered, without stalling
+		 *
+		 * The frame is read back asynchronously when Render() is called, and
+		 * @p callback receives the pixels a few frames later on a worker
+		 * thread, so it may take its time encoding or saving them. Captures
+		 * are dropped, with a warning, when too many are still in flight.
+		 *
+		 * @param callback Receives the captured frame
+		 */
+		virtual auto CaptureFrame(CaptureCallback callback) -> void = 0;
 		/**
 		 * @brief Make this renderer's context current
 		 *
@@ -118,6 +355,22 @@ namespace Gaze::GFX {
 		 * their context current before rendering.
 		 */
 		virtual auto MakeContextCurrent() noexcept -> void = 0;
+		/**
+		 * @brief Detach this renderer's context from the calling thread
+		 *
+		 * Lets another thread make it current. Does nothing if the context
+		 * isn't current on the calling thread.
+		 */
+		virtual auto ReleaseContext() noexcept -> void = 0;
+		/**
+		 * @brief Wait until the frames rendered so far have been drawn
+		 *
+		 * Only blocks when rendering on a render thread, see CreateRenderer().
+		 * The renderer then uses the skinning pool while the next frame is
+		 * being recorded, instead of copying it. Call this before destroying
+		 * the pool. Everything else it is given is copied.
+		 */
+		virtual auto Synchronize() noexcept -> void = 0;
 		/**
 		 * @brief Get the current render stats
 		 *
@@ -149,18 +402,74 @@ namespace Gaze::GFX {
 			PrimitiveMode mode
 		) -> void = 0;
 		/**
-		 * @brief Submit an object for rendering
+		 * @brief Set the scene's lights
+		 *
+		 * Objects submitted without explicit lights are lit by the most
+		 * influential of these, selected per object from its bounds, so a
+		 * scene can hold more lights than a single draw supports.
+		 *
+		 * @param lights The lights. Copied
+		 * @param nLights The number of lights
+		 */
+		virtual auto SetLights(const struct Light lights[], I32 nLights) -> void = 0;
+		/**
+		 * @brief Submit an object for rendering, lit by the scene's lights
+		 *
+		 * Without scene lights (see SetLights()), the object is lit by a
+		 * default white light at the origin.
+		 *
+		 * The same mesh submitted several times in a frame may be drawn as
+		 * instances of a single draw call, see RenderStats::nInstancesMerged.
 		 *
 		 * @param object The object to submit
 		 * @param mode The primitive mode to use
 		 */
 		virtual auto SubmitObject(const Object& object, PrimitiveMode mode) -> void = 0;
+		/**
+		 * @brief Submit an object for rendering with an explicit world transform, lit by the scene's lights
+		 *
+		 * @param object The object to submit
+		 * @param transform The world transform to render the object with
+		 * @param mode The primitive mode to use
+		 */
+		virtual auto SubmitObject(const Object& object, const glm::mat4& transform, PrimitiveMode mode) -> void = 0;
+		/**
+		 * @brief Submit a skinned object for rendering, lit by the scene's lights
+		 *
+		 * Lights are selected from the mesh's bind pose bounds.
+		 *
+		 * @param object The object to submit. Primitives without skin weights are drawn rigidly
+		 * @param transform The world transform to render the object with
+		 * @param palette The skinning matrices, one per joint the skin weights refer to,
+		 *                see Scene::AnimationSampler. Copied. A palette with fewer
+		 *                joints than the weights refer to draws the bind pose
+		 * @param mode The primitive mode to use
+		 */
+		virtual auto SubmitSkinned(
+			const Object& object,
+			const glm::mat4& transform,
+			std::span<const glm::mat4> palette,
+			PrimitiveMode mode
+		) -> void = 0;
+		/**
+		 * @brief Submit an object that turns into an impostor far away, lit by the scene's lights
+		 *
+		 * Drawn with triangles, as its mesh while large on screen and as a
+		 * camera-facing billboard once small, cross-fading in between. The
+		 * billboards submitted since the last Flush() are drawn together, in a
+		 * single instanced call. Without impostors enabled, see SetImpostors(),
+		 * this is SubmitObject() with triangles.
+		 *
+		 * @param object The object to submit. Rigid; skinning is ignored
+		 * @param transform The world transform to render the object with
+		 */
+		virtual auto SubmitWithImpostor(const Object& object, const glm::mat4& transform) -> void = 0;
 		/**
 		 * @brief Submit an object for rendering
 		 *
 		 * @param object The object to submit
 		 * @param lights The lights to use
-		 * @param nLights The number of lights
+		 * @param nLights The number of lights; with none, the object is drawn unlit in its material's diffuse color
 		 * @param mode The primitive mode to use
 		 */
 		virtual auto SubmitObject(
@@ -169,6 +478,92 @@ namespace Gaze::GFX {
 			I32 nLights,
 			PrimitiveMode mode
 		) -> void = 0;
+		/**
+		 * @brief Submit an object for rendering with an explicit world transform
+		 *
+		 * The object's own transform is ignored. Meant for transforms computed
+		 * elsewhere, such as a Scene::TransformHierarchy's world matrices.
+		 *
+		 * @param object The object to submit
+		 * @param transform The world transform to render the object with
+		 * @param lights The lights to use
+		 * @param nLights The number of lights; with none, the object is drawn unlit in its material's diffuse color
+		 * @param mode The primitive mode to use
+		 */
+		virtual auto SubmitObject(
+			const Object& object,
+			const glm::mat4& transform,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode
+		) -> void = 0;
+		/**
+		 * @brief Submit an emitter's particles for rendering
+		 *
+		 * The particles are written to the GPU right away, so the emitter may
+		 * be updated again before Render(). They are drawn in Render(), after
+		 * the objects and before sprites, as camera-facing quads: alpha-blended,
+		 * hidden by objects but not by each other.
+		 *
+		 * @param emitter The emitter to draw
+		 */
+		virtual auto SubmitParticles(const ParticleEmitter& emitter) -> void = 0;
+		/**
+		 * @brief Submit particles already written out as instances
+		 *
+		 * Drawn like an emitter's particles, see SubmitParticles(const ParticleEmitter&).
+		 *
+		 * @param instances The particles, as written by ParticleEmitter::WriteInstances(). Copied
+		 */
+		virtual auto SubmitParticles(std::span<const ParticleEmitter::Instance> instances) -> void = 0;
+		/**
+		 * @brief Submit the resident chunks of a terrain in the camera's view, lit by the scene's lights
+		 *
+		 * Tiles loaded since the last submission are uploaded first. Call
+		 * Terrain::Update() beforehand to stream tiles and pick the chunks'
+		 * levels of detail. The chunks are drawn with the objects, in as few
+		 * draw calls as the lights allow.
+		 *
+		 * @param terrain The terrain to draw
+		 */
+		virtual auto SubmitTerrain(const Terrain& terrain) -> void = 0;
+		/**
+		 * @brief Submit a snapshot of a terrain, lit by the scene's lights
+		 *
+		 * Drawn like a terrain, see SubmitTerrain(const Terrain&): the tiles
+		 * whose version wasn't uploaded yet are, then the chunks are drawn.
+		 *
+		 * @param snapshot The tiles and chunks. Copied, or uploaded, right away
+		 */
+		virtual auto SubmitTerrain(const Terrain::Snapshot& snapshot) -> void = 0;
+
+		/**
+		 * @brief Get the debug drawing interface
+		 *
+		 * Shapes drawn through it are rendered unlit with the current frame, in
+		 * Render(), then discarded.
+		 *
+		 * @return The debug drawing interface
+		 */
+		[[nodiscard]] auto Debug() noexcept -> DebugDraw&;
+		/**
+		 * @brief Get the 2D quad batch
+		 *
+		 * Quads submitted through it are drawn in Render(), after the objects
+		 * submitted this frame and before debug shapes, then discarded.
+		 *
+		 * @return The 2D quad batch
+		 */
+		[[nodiscard]] auto Sprites() noexcept -> SpriteBatch&;
+		/**
+		 * @brief Get the screen-space overlay
+		 *
+		 * The overlay is drawn in Render() over the resolved frame, after any
+		 * frame capture, then discarded. It starts out hidden.
+		 *
+		 * @return The overlay
+		 */
+		[[nodiscard]] auto Overlay() noexcept -> GFX::Overlay&;
 
 	protected:
 		[[nodiscard]] auto Window() const noexcept -> const WM::Window&;
@@ -176,8 +571,26 @@ namespace Gaze::GFX {
 
 	private:
 		Shared<WM::Window> m_Window;
+		DebugDraw          m_DebugDraw;
+		SpriteBatch        m_SpriteBatch;
+		GFX::Overlay       m_Overlay;
 	};
 
+	inline auto Renderer::Debug() noexcept -> DebugDraw&
+	{
+		return m_DebugDraw;
+	}
+
+	inline auto Renderer::Sprites() noexcept -> SpriteBatch&
+	{
+		return m_SpriteBatch;
+	}
+
+	inline auto Renderer::Overlay() noexcept -> GFX::Overlay&
+	{
+		return m_Overlay;
+	}
+
 	inline auto Renderer::Window() const noexcept -> const WM::Window&
 	{
 		return *m_Window.get();
@@ -188,5 +601,17 @@ namespace Gaze::GFX {
 	}
 
 
-	auto CreateRenderer(Shared<WM::Window> window) -> Unique<Renderer>;
+	/**
+	 * @brief Create a renderer for the current graphics API
+	 *
+	 * With a render thread, the renderer returned records the calls made to
+	 * it into a frame packet, and Render() hands the packet to a thread that
+	 * owns the graphics context and replays it, while the caller goes on
+	 * with the next frame. The caller only waits if the render thread is
+	 * still on the frame before. See ThreadedRenderer.
+	 *
+	 * @param window The window to render to
+	 * @param renderThread Whether to render on a dedicated thread
+	 */
+	auto CreateRenderer(Shared<WM::Window> window, bool renderThread = false) -> Unique<Renderer>;
 }
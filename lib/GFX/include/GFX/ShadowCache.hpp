@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Light.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Decides which shadow maps to redraw each frame, and from where
+	 *
+	 * Shadow maps are rendered in two layers. Static casters are drawn into a
+	 * cache that is only redrawn when they change, or when the view the map
+	 * is rendered from does. Each frame, the cache is copied into the map the
+	 * shaders sample and the dynamic casters are drawn on top, so moving
+	 * objects only cost their own draws.
+	 *
+	 * The shadow-casting directional light gets cascaded shadow maps: the
+	 * camera's view is split by distance into slices, each covered by one
+	 * cascade of its own resolution. Cascades are fitted to a bounding sphere
+	 * of their slice, slightly enlarged, and snapped to their texels, so they
+	 * neither shimmer nor move until the camera leaves the enlarged area. They
+	 * are updated on a staggered schedule, see IsCascadeDue(): the nearest
+	 * every frame and the farther ones, whose texels are larger, less often.
+	 *
+	 * Shadow-casting point lights get a cube map each, redrawn from scratch
+	 * only when the light moves.
+	 *
+	 * The class is renderer agnostic: it only computes the views. The
+	 * renderer draws them, see Renderer::SetShadows().
+	 */
+	class ShadowCache
+	{
+	public:
+		struct Settings
+		{
+			I32 nCascades          = 3;      /**< At most kMaxCascades */
+			I32 cascadeResolution  = 2048;
+			F32 cascadeDistance    = 80.F;   /**< The directional light casts no shadows beyond this distance from the camera */
+			F32 splitLambda        = .75F;   /**< Blends uniform (0) and logarithmic (1) cascade splits */
+			F32 cascadeMargin      = .25F;   /**< Cascades cover this much more than their slice, relatively, so they move less often */
+			F32 casterDistance     = 100.F;  /**< Casters this far towards the light from a cascade still cast into it */
+			I32 pointResolution    = 512;
+			F32 pointRange         = 50.F;   /**< Point lights cast no shadows beyond this distance, nor where they no longer light */
+		};
+
+		static constexpr auto kMaxCascades    = 4;
+		static constexpr auto kMaxPointLights = 4;
+		/**
+		 * @brief The shadow index of the directional light, see ShadowIndex().
+		 */
+		static constexpr auto kCascaded       = kMaxPointLights;
+
+		/**
+		 * @brief The shadow map texture a View renders into.
+		 */
+		enum class Target : U8
+		{
+			Cascade,  /**< A layer of the cascade array */
+			CubeFace, /**< A face of the point light cube map array, as layer = slot * 6 + face */
+		};
+
+		/**
+		 * @brief A layer of a shadow map to redraw this frame.
+		 */
+		struct View
+		{
+			glm::mat4 viewProjection;
+			Target    target;
+			I32       layer;
+			bool      redrawStatic; /**< The cached static casters are out of date */
+		};
+
+		/**
+		 * @brief A shadow-casting point light, as the shaders see it.
+		 */
+		struct PointShadow
+		{
+			glm::vec3 position;
+			F32       range;    /**< Far plane of the cube map, its depths are distances divided by it */
+		};
+
+	public:
+		explicit ShadowCache(Settings settings) noexcept;
+
+		/**
+		 * @brief Pick the shadow-casting lights out of a scene's lights.
+		 *
+		 * The first directional light casting shadows gets the cascades and
+		 * the first kMaxPointLights point lights casting shadows get a cube
+		 * map each. Lights that keep their position and range keep their
+		 * cached shadows.
+		 */
+		auto SetLights(std::span<const Light> lights) -> void;
+		/**
+		 * @brief Compute the views to redraw for a frame.
+		 *
+		 * @param cameraViewProjection The camera's view-projection matrix.
+		 * @param cameraPosition The camera's position.
+		 * @param staticVersion Changes whenever the static casters do, invalidating every cache.
+		 * @param frame The frame's index, drives the cascades' schedule.
+		 */
+		auto Update(const glm::mat4& cameraViewProjection, const glm::vec3& cameraPosition, U64 staticVersion, U64 frame) -> void;
+		/**
+		 * @brief Invalidate every cache, as if the static casters had changed.
+		 */
+		auto Invalidate() noexcept -> void;
+
+		/**
+		 * @brief Return which shadow map a light samples, if any.
+		 *
+		 * @return kCascaded for the shadow-casting directional light, the slot
+		 *         of a shadow-casting point light, or -1.
+		 */
+		[[nodiscard]] auto ShadowIndex(const Light& light) const noexcept -> I32;
+
+		[[nodiscard]] auto GetSettings()   const noexcept -> const Settings&;
+		/**
+		 * @brief Return the views to redraw this frame: the cascades due, then the point lights' faces.
+		 */
+		[[nodiscard]] auto Views()         const noexcept -> std::span<const View>;
+		/**
+		 * @brief Return the matrices the cascades were last rendered with, mapping world space to [0, 1] shadow map coordinates.
+		 *
+		 * Empty until the cascades were first rendered, or without a shadow-casting directional light.
+		 */
+		[[nodiscard]] auto Cascades()      const noexcept -> std::span<const glm::mat4>;
+		/**
+		 * @brief Return the size of a cascade's texels, in world units.
+		 */
+		[[nodiscard]] auto CascadeTexelSize(I32 cascade) const noexcept -> F32;
+		[[nodiscard]] auto PointShadows()  const noexcept -> std::span<const PointShadow>;
+
+		/**
+		 * @brief Check whether a cascade is updated on a given frame.
+		 *
+		 * The first cascade is updated every frame. Cascade i > 0 is updated
+		 * every 2^i frames, on the frames whose lowest set bit is i - 1, so at
+		 * most two cascades are ever updated on the same frame.
+		 */
+		[[nodiscard]] static auto IsCascadeDue(I32 cascade, U64 frame) noexcept -> bool;
+
+	private:
+		struct Cascade
+		{
+			glm::vec3 center;         /**< Of the area covered, snapped */
+			F32       radius;         /**< Of the area covered */
+			glm::vec3 direction;      /**< Of the light, when fitted */
+			glm::mat4 viewProjection;
+			U64       staticVersion;  /**< Of the static casters, when last drawn */
+			bool      isDirty;        /**< Moved, or invalidated */
+		};
+
+		struct PointSlot
+		{
+			PointShadow light;
+			U64         staticVersion;
+			bool        isDirty;
+		};
+
+		auto UpdateCascades(const glm::mat4& cameraViewProjection, const glm::vec3& cameraPosition, U64 staticVersion, U64 frame) -> void;
+		auto UpdatePointLights(U64 staticVersion) -> void;
+		/**
+		 * @brief Cover a sphere with a cascade, its center snapped to the cascade's texels.
+		 */
+		[[nodiscard]] auto FitCascade(const glm::vec3& center, F32 radius, const glm::vec3& direction) const noexcept -> Cascade;
+		[[nodiscard]] auto PointRange(const Light& light) const noexcept -> F32;
+
+	private:
+		Settings                 m_Settings;
+		std::optional<Light>     m_Sun;
+		std::vector<Light>       m_PointLights;
+		std::vector<Cascade>     m_Cascades;        /**< Empty until first fitted */
+		std::vector<glm::mat4>   m_CascadeMatrices; /**< Of m_Cascades, biased to [0, 1] */
+		std::vector<PointSlot>   m_PointSlots;
+		std::vector<PointShadow> m_PointShadows;
+		std::vector<View>        m_Views;
+	};
+
+	inline auto ShadowCache::GetSettings() const noexcept -> const Settings&
+	{
+		return m_Settings;
+	}
+
+	inline auto ShadowCache::Views() const noexcept -> std::span<const View>
+	{
+		return m_Views;
+	}
+
+	inline auto ShadowCache::Cascades() const noexcept -> std::span<const glm::mat4>
+	{
+		return m_CascadeMatrices;
+	}
+
+	inline auto ShadowCache::PointShadows() const noexcept -> std::span<const PointShadow>
+	{
+		return m_PointShadows;
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Geometry/Mesh.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <span>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Skin vertices on the CPU, blending up to four joint matrices per vertex.
+	 *
+	 * The fallback for GPU skinning. Matrices are blended and applied with
+	 * SSE where available. Normals are transformed by the blended matrix and
+	 * renormalized, which is exact as long as joints are not scaled
+	 * non-uniformly.
+	 *
+	 * @param vertices The bind pose vertices.
+	 * @param skin The skin weights, one per vertex.
+	 * @param palette The joint matrices, see Scene::Pose::ComputePalette().
+	 * @param[out] out Receives the skinned vertices, one per vertex. May be @p vertices itself.
+	 */
+	auto SkinVertices(
+		std::span<const Geometry::Vertex> vertices,
+		std::span<const Geometry::SkinWeights> skin,
+		std::span<const glm::mat4> palette,
+		std::span<Geometry::Vertex> out
+	) noexcept -> void;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Batched 2D quads
+	 *
+	 * Quads are collected on the CPU for the current frame and drawn by the
+	 * renderer with one instanced draw call, in layer order, under whatever
+	 * camera is active (usually an OrthographicCamera). Quads are unlit,
+	 * alpha-blended and ignore the depth buffer; within a layer they are drawn
+	 * in submission order. The batch is cleared after every frame.
+	 *
+	 * @see Renderer::Sprites()
+	 */
+	class SpriteBatch
+	{
+	public:
+		/**
+		 * @brief A single quad, as uploaded to the GPU.
+		 */
+		struct Sprite
+		{
+			glm::vec2 position; /**< Center of the quad, in world units */
+			glm::vec2 size;     /**< Width and height of the quad, in world units */
+			F32       rotation; /**< Counter-clockwise rotation around the center, in radians */
+			U32       color;    /**< RGBA8, red in the lowest byte */
+			I32       layer;    /**< Higher layers are drawn on top of lower ones */
+		};
+
+		static inline const auto kWhite = glm::vec4(1.F, 1.F, 1.F, 1.F);
+
+	public:
+		/**
+		 * @brief Draw a quad.
+		 *
+		 * @param position The center of the quad.
+		 * @param size The width and height of the quad.
+		 * @param rotation The counter-clockwise rotation of the quad around its center, in radians.
+		 * @param color The color of the quad.
+		 * @param layer The layer of the quad.
+		 */
+		auto Quad(
+			const glm::vec2& position,
+			const glm::vec2& size,
+			F32 rotation = .0F,
+			const glm::vec4& color = kWhite,
+			I32 layer = 0
+		) -> void;
+
+		/**
+		 * @brief Reserve space for @p nSprites quads.
+		 *
+		 * Worth calling once with the expected quad count when submitting many
+		 * quads per frame; the storage is kept across frames.
+		 */
+		auto Reserve(std::size_t nSprites) -> void;
+		/**
+		 * @brief Order the quads by layer, keeping submission order within a layer.
+		 *
+		 * Does nothing if the quads were submitted in non-decreasing layer order.
+		 */
+		auto Sort() -> void;
+		/**
+		 * @brief Discard all quads.
+		 */
+		auto Clear() noexcept -> void;
+
+		/**
+		 * @brief Return the quads.
+		 */
+		[[nodiscard]] auto Sprites() const noexcept -> const std::vector<Sprite>&;
+
+	private:
+		std::vector<Sprite> m_Sprites;
+		bool                m_IsSorted = true;
+	};
+
+	inline auto SpriteBatch::Sprites() const noexcept -> const std::vector<Sprite>&
+	{
+		return m_Sprites;
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Bounds.hpp"
+#include "GFX/Light.hpp"
+#include "GFX/Material.hpp"
+#include "GFX/Object.hpp"
+
+#include "Geometry/Mesh.hpp"
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Gaze::GFX {
+	class Renderer;
+
+	/**
+	 * @brief Merges static objects into large, pre-transformed batches.
+	 *
+	 * Objects that never move and share a material are merged into a single
+	 * mesh whose vertices are already in world space, so that they can be
+	 * rendered with a single draw call and an identity model matrix.
+	 *
+	 * Batches are split along a uniform grid so that they can still be frustum
+	 * culled. An object belongs to the cell containing the center of its world
+	 * space bounds.
+	 *
+	 * Adding or removing objects only marks the affected batches as dirty. The
+	 * dirty batches are re-merged on the next call to @ref Build().
+	 */
+	class StaticBatcher
+	{
+	public:
+		/**
+		 * @brief Identifies an object added to the batcher.
+		 */
+		using ObjectID = U32;
+
+		/**
+		 * @brief A merged batch of static objects.
+		 */
+		struct Batch
+		{
+			Object object; /**< The merged object, with an identity transform */
+			AABB   bounds; /**< The world space bounds of the batch */
+		};
+
+	public:
+		/**
+		 * @brief Construct a new StaticBatcher.
+		 *
+		 * @param cellSize The size of the grid cells used to split batches, in
+		 *                 world units.
+		 */
+		explicit StaticBatcher(F32 cellSize = 32.F) noexcept;
+
+		/**
+		 * @brief Add an object to the batcher.
+		 *
+		 * The object's mesh is transformed into world space immediately. Later
+		 * changes to the object are not reflected in the batch; remove and
+		 * re-add the object instead.
+		 *
+		 * @param object The object to add. Must be marked as static.
+		 *
+		 * @return The ID of the object within the batcher.
+		 */
+		auto Add(const Object& object) -> ObjectID;
+		/**
+		 * @brief Remove an object from the batcher.
+		 *
+		 * @param id The ID returned by @ref Add().
+		 */
+		auto Remove(ObjectID id) -> void;
+		/**
+		 * @brief Remove all objects from the batcher.
+		 */
+		auto Clear() noexcept -> void;
+
+		/**
+		 * @brief Re-merge the batches affected by any additions or removals.
+		 *
+		 * Called automatically by @ref Submit(). Call it explicitly to move the
+		 * merging cost to load time.
+		 */
+		auto Build() -> void;
+
+		/**
+		 * @brief Submit the batches that intersect the given frustum.
+		 *
+		 * @param renderer The renderer to submit to.
+		 * @param frustum The frustum used for culling.
+		 * @param lights The lights to use.
+		 * @param nLights The number of lights.
+		 *
+		 * @return The number of batches submitted.
+		 */
+		auto Submit(Renderer& renderer, const Frustum& frustum, const Light lights[], I32 nLights) -> I32;
+		/**
+		 * @brief Submit the batches that intersect the given frustum, lit by the renderer's scene lights.
+		 *
+		 * @param renderer The renderer to submit to.
+		 * @param frustum The frustum used for culling.
+		 *
+		 * @return The number of batches submitted.
+		 */
+		auto Submit(Renderer& renderer, const Frustum& frustum) -> I32;
+
+		/**
+		 * @brief Return the current batches.
+		 *
+		 * Call @ref Build() first to make sure the batches are up to date.
+		 */
+		[[nodiscard]] auto Batches() const noexcept -> std::vector<const Batch*>;
+		/**
+		 * @brief Return a counter that is incremented every time the batches change.
+		 *
+		 * Useful to invalidate caches that depend on the static geometry.
+		 */
+		[[nodiscard]] auto Version() const noexcept -> U64;
+
+	private:
+		/**
+		 * @brief A cell of the grid, per material.
+		 */
+		struct CellKey
+		{
+			U32 material;
+			I32 x;
+			I32 y;
+			I32 z;
+
+			auto operator==(const CellKey&) const noexcept -> bool = default;
+		};
+
+		struct CellKeyHash
+		{
+			auto operator()(const CellKey& key) const noexcept -> std::size_t;
+		};
+
+		struct Member
+		{
+			CellKey                       cell;
+			std::vector<Geometry::Vertex> vertices; /**< Pre-transformed vertices */
+			std::vector<Geometry::Index>  indices;
+			AABB                          bounds;
+		};
+
+		struct Cell
+		{
+			std::vector<ObjectID> members;
+			std::optional<Batch>  batch;
+			U32                   material;
+			bool                  isDirty = true;
+		};
+
+		[[nodiscard]] auto FindOrAddMaterial(const Material& material) -> U32;
+		[[nodiscard]] auto ComputeCellKey(const AABB& bounds, U32 material) const noexcept -> CellKey;
+		auto Rebuild(Cell& cell) -> void;
+
+	private:
+		F32                                            m_CellSize;
+		std::vector<Material>                          m_Materials;
+		std::unordered_map<ObjectID, Member>           m_Members;
+		std::unordered_map<CellKey, Cell, CellKeyHash> m_Cells;
+		ObjectID                                       m_NextID = 0;
+		U64                                            m_Version = 0;
+		bool                                           m_IsDirty = false;
+	};
+
+	inline auto StaticBatcher::Version() const noexcept -> U64
+	{
+		return m_Version;
+	}
+}
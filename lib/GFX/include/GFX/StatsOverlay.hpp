@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Overlay.hpp"
+#include "GFX/Renderer.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief A panel showing the renderer's stats, with frame time graphs
+	 *
+	 * Record() the stats once per frame, then Draw() the panel into the
+	 * renderer's overlay. Nothing is drawn while the overlay is hidden.
+	 */
+	class StatsOverlay
+	{
+	public:
+		static constexpr auto kHistorySize = std::size_t(120); /**< Frames shown by the graphs */
+
+	public:
+		/**
+		 * @brief Record the stats of the last frame.
+		 */
+		auto Record(const Renderer::RenderStats& stats) noexcept -> void;
+		/**
+		 * @brief Draw the panel.
+		 *
+		 * @param overlay The overlay to draw into.
+		 * @param position The top-left corner of the panel, in pixels.
+		 * @param extraLines Lines of text appended to the panel, e.g. network stats.
+		 */
+		auto Draw(
+			Overlay& overlay,
+			const glm::vec2& position = { 8.F, 8.F },
+			std::span<const std::string> extraLines = {}
+		) const -> void;
+
+	private:
+		/**
+		 * @brief Copy a history, oldest first.
+		 */
+		auto Unroll(const std::array<F32, kHistorySize>& history, std::array<F32, kHistorySize>& out) const noexcept -> void;
+
+	private:
+		Renderer::RenderStats             m_Last{};
+		std::array<F32, kHistorySize>     m_FrameTimes{};
+		std::array<F32, kHistorySize>     m_Latencies{};
+		std::size_t                       m_Next  = 0;
+		std::size_t                       m_Count = 0;
+	};
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Two-Level Segregated Fit allocator over an abstract range of offsets
+	 *
+	 * Only does the bookkeeping: the memory itself (typically a GPU buffer)
+	 * lives elsewhere and is addressed with the returned offsets. Allocating
+	 * and freeing are O(1): free blocks are kept in lists bucketed by size
+	 * class (a power of two, split linearly into 16 sub-classes) and two
+	 * levels of bitmaps locate a large enough non-empty list in constant time.
+	 * Freed blocks are immediately merged with free neighbours.
+	 *
+	 * Allocations are referred to by handles that stay valid when
+	 * Defragment() moves their data around.
+	 */
+	class TLSFAllocator
+	{
+	public:
+		using Handle = U32;
+
+		static constexpr auto kInvalidHandle = std::numeric_limits<Handle>::max();
+
+		struct Stats
+		{
+			U64 capacity;
+			U64 used;
+			U64 largestFreeBlock;
+			U32 nAllocations;
+			U32 nFreeBlocks;
+			F32 fragmentation; /**< 1 - largest free block / free space; 0 when all free space is contiguous */
+		};
+
+		/**
+		 * @brief Called by Defragment() to move an allocation's data. The ranges never overlap.
+		 */
+		using MoveFn = std::function<void(U64 from, U64 to, U64 size)>;
+
+	public:
+		explicit TLSFAllocator(U64 capacity);
+
+		/**
+		 * @brief Allocate a range.
+		 *
+		 * @param size The size of the range. Must not be 0.
+		 * @param alignment The alignment of the range's offset. Needs not be a power of two.
+		 *
+		 * @return The allocation, or kInvalidHandle if there is no large enough free range.
+		 */
+		[[nodiscard]] auto Allocate(U64 size, U64 alignment = 1) -> Handle;
+		auto Free(Handle handle)                                  -> void;
+
+		[[nodiscard]] auto Offset(Handle handle) const noexcept -> U64;
+		[[nodiscard]] auto Size(Handle handle)   const noexcept -> U64;
+
+		/**
+		 * @brief Move allocations towards the start of the range, to merge free space.
+		 *
+		 * Starting from the end of the range, each allocation that fits in a
+		 * free block lower than its current one is moved there through @p move.
+		 * Only a bounded number of free blocks is examined per allocation, so
+		 * a pass is not guaranteed to find every possible move.
+		 *
+		 * @param budget Stop once this many bytes were moved.
+		 * @param move Copies the data.
+		 *
+		 * @return The number of bytes moved.
+		 */
+		auto Defragment(U64 budget, const MoveFn& move) -> U64;
+
+		[[nodiscard]] auto GetStats() const noexcept -> Stats;
+		[[nodiscard]] auto Capacity() const noexcept -> U64;
+		[[nodiscard]] auto IsEmpty()  const noexcept -> bool;
+
+	private:
+		using BlockIndex = U32;
+
+		static constexpr auto kNullBlock = std::numeric_limits<BlockIndex>::max();
+		static constexpr auto kSLBits    = 4U;
+		static constexpr auto kSLCount   = 1U << kSLBits;
+		static constexpr auto kFLShift   = kSLBits; /**< Sizes below 2^kFLShift all go to the first level */
+		static constexpr auto kFLCount   = 64U - kFLShift + 1U;
+
+		struct Block
+		{
+			U64        offset;
+			U64        size;
+			U64        alignment;
+			BlockIndex prevPhysical;
+			BlockIndex nextPhysical;
+			BlockIndex prevFree;
+			BlockIndex nextFree;
+			Handle     handle; /**< kInvalidHandle if the block is free */
+		};
+
+		struct Mapping
+		{
+			U32 fl;
+			U32 sl;
+		};
+
+		[[nodiscard]] static auto MapInsert(U64 size) noexcept -> Mapping;
+		[[nodiscard]] static auto MapSearch(U64 size) noexcept -> Mapping;
+
+		[[nodiscard]] auto FindFree(Mapping mapping)          const noexcept -> BlockIndex;
+		/**
+		 * @brief Find a free block of at least @p size bytes starting below @p limit, if one is easy to find.
+		 */
+		[[nodiscard]] auto FindFreeBelow(U64 size, U64 limit) const noexcept -> BlockIndex;
+		/**
+		 * @brief Allocate an aligned range from the free block @p block.
+		 */
+		auto Carve(BlockIndex block, U64 size, U64 alignment)          -> Handle;
+		auto InsertFree(BlockIndex block)                     noexcept -> void;
+		auto RemoveFree(BlockIndex block)                     noexcept -> void;
+		/**
+		 * @brief Split the tail of @p block, from @p size on, into a new free block.
+		 */
+		auto SplitFree(BlockIndex block, U64 size)                     -> void;
+		auto NewBlock()                                                -> BlockIndex;
+		auto NewHandle(BlockIndex block)                               -> Handle;
+
+	private:
+		U64                                                    m_Capacity;
+		U64                                                    m_Used = 0;
+		std::vector<Block>                                     m_Blocks;
+		std::vector<BlockIndex>                                m_FreeRecords;
+		std::vector<BlockIndex>                                m_Handles;     /**< Handle -> block, kNullBlock if unused */
+		std::vector<Handle>                                    m_FreeHandles;
+		U64                                                    m_FLBitmap = 0;
+		std::array<U32, kFLCount>                              m_SLBitmaps{};
+		std::array<std::array<BlockIndex, kSLCount>, kFLCount> m_Heads;
+	};
+
+	inline auto TLSFAllocator::Capacity() const noexcept -> U64
+	{
+		return m_Capacity;
+	}
+
+	inline auto TLSFAllocator::IsEmpty() const noexcept -> bool
+	{
+		return m_Used == 0;
+	}
+}
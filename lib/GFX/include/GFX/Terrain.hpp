@@ -0,0 +1,277 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Bounds.hpp"
+#include "GFX/Material.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Heightmap terrain, streamed in tiles around the camera
+	 *
+	 * The world is a grid of square tiles, loaded from disk (or generated)
+	 * on demand through a TileLoader. Tiles within a radius of the camera are
+	 * kept resident, at most Settings::maxResidentTiles of them, so memory
+	 * stays bounded however large the world is.
+	 *
+	 * Each tile is split into chunks, drawn with geomipmapping: a chunk picks
+	 * a level of detail from its distance to the camera, each level skipping
+	 * every other vertex of the previous one. Neighbouring chunks differ by
+	 * at most one level, and the finer chunk stitches its edge to the coarser
+	 * one, so there are no cracks. Since every chunk indexes into its tile's
+	 * vertex grid the same way, index buffers are shared by all chunks of a
+	 * level, see BuildChunkIndices().
+	 *
+	 * Update() streams the tiles and picks the levels of detail once per
+	 * frame, then Select() culls the chunks against a frustum.
+	 *
+	 * @see Renderer::SubmitTerrain()
+	 */
+	class Terrain
+	{
+	public:
+		/**
+		 * @brief Returns the heights of a tile, empty if there is no such tile.
+		 *
+		 * The heights are in world units, (tileResolution + 1)^2 of them, row
+		 * by row along +z. Tiles share their edge samples with their
+		 * neighbours. Called from worker threads when the terrain has a pool.
+		 */
+		using TileLoader = std::function<std::vector<F32>(glm::ivec2 tile)>;
+
+		struct Settings
+		{
+			TileLoader loader;
+			I32        tileResolution   = 256;    /**< Quads along a tile's side. A power of two */
+			I32        chunkResolution  = 32;     /**< Quads along a chunk's side. A power of two, at most tileResolution */
+			F32        tileSize         = 256.F;  /**< World units along a tile's side. Tile (x, z) starts at (x, z) * tileSize */
+			F32        lodDistance      = 96.F;   /**< Chunks closer than this are drawn at full detail, each level doubles it */
+			I32        loadRadius       = 2;      /**< Tiles kept resident in each direction around the camera's tile */
+			I32        maxResidentTiles = 36;     /**< Bounds the terrain's memory, and the renderer's */
+			I32        maxPendingLoads  = 4;      /**< Tiles loading at once */
+			Material   material         = {};
+		};
+
+		/**
+		 * @brief A vertex of a tile, in world space.
+		 */
+		struct Vertex
+		{
+			glm::vec3         position;
+			std::array<I8, 4> normal;   /**< Signed normalized, the last component is padding */
+		};
+
+		/**
+		 * @brief A resident tile.
+		 */
+		struct Tile
+		{
+			glm::ivec2          coords;
+			I32                 slot;     /**< In [0, maxResidentTiles), reused once the tile is evicted */
+			U64                 version;  /**< Unique per load, changes whenever the slot's contents do */
+			std::vector<Vertex> vertices; /**< (tileResolution + 1)^2, row by row along +z */
+			std::vector<AABB>   bounds;   /**< Per chunk, row by row along +z */
+			std::vector<U8>     lods;     /**< Per chunk, picked by Update() */
+			std::vector<U8>     stitches; /**< Per chunk, sides with a coarser neighbour, see Side */
+		};
+
+		/**
+		 * @brief The sides of a chunk, as stitching flags.
+		 */
+		enum Side : U8
+		{
+			kNegativeX = 1 << 0,
+			kPositiveX = 1 << 1,
+			kNegativeZ = 1 << 2,
+			kPositiveZ = 1 << 3,
+		};
+
+		static constexpr auto kStitchVariants = 16;
+
+		/**
+		 * @brief A chunk to draw, as returned by Select().
+		 */
+		struct ChunkDraw
+		{
+			I32  slot;        /**< Of the chunk's tile */
+			I32  firstVertex; /**< Of the chunk in its tile */
+			U8   lod;
+			U8   stitches;
+			AABB bounds;
+		};
+
+		/**
+		 * @brief The vertices of a resident tile, to upload into its slot.
+		 */
+		struct TileUpload
+		{
+			I32                     slot;
+			U64                     version;  /**< Skipped by renderers that already uploaded it */
+			std::span<const Vertex> vertices;
+		};
+
+		/**
+		 * @brief What a renderer reads of a terrain to draw it in a frame.
+		 *
+		 * Refers to the terrain's memory, or to a copy for renderers drawing it
+		 * later, see ThreadedRenderer. Everything else in the terrain can
+		 * change once the snapshot is submitted.
+		 *
+		 * @see Renderer::SubmitTerrain()
+		 */
+		struct Snapshot
+		{
+			I32                         tileResolution;
+			I32                         chunkResolution;
+			I32                         maxResidentTiles;
+			Material                    material;
+			std::span<const TileUpload> tiles;  /**< The resident tiles, or at least those not handed to the renderer yet */
+			std::span<const ChunkDraw>  chunks; /**< To draw, as returned by Select() */
+		};
+
+	public:
+		/**
+		 * @brief Construct a terrain. Nothing is loaded until Update().
+		 *
+		 * @param settings The settings. Requires a loader
+		 * @param pool The pool tiles are loaded on. Tiles are loaded on the
+		 *             calling thread, within Update(), if null. Must outlive
+		 *             the terrain
+		 */
+		explicit Terrain(Settings settings, Jobs::ThreadPool* pool = nullptr);
+		/**
+		 * @brief Destroy the terrain, after waiting for the tiles still loading.
+		 */
+		~Terrain();
+
+		Terrain(const Terrain&) = delete;
+		Terrain(Terrain&&) = delete;
+		auto operator=(const Terrain&) = delete;
+		auto operator=(Terrain&&) = delete;
+
+		/**
+		 * @brief Stream tiles around the camera and pick the chunks' levels of detail.
+		 *
+		 * Finished loads become resident, tiles out of range are evicted and
+		 * the missing tiles nearest to the camera start loading.
+		 *
+		 * @param camera The camera's position.
+		 */
+		auto Update(const glm::vec3& camera) -> void;
+		/**
+		 * @brief Collect the resident chunks intersecting a frustum.
+		 *
+		 * @param frustum The frustum.
+		 * @param out Receives the chunks. Cleared first.
+		 */
+		auto Select(const Frustum& frustum, std::vector<ChunkDraw>& out) const -> void;
+		/**
+		 * @brief Sample the terrain's height, bilinearly.
+		 *
+		 * @return The height, or nothing if the tile under the point isn't resident.
+		 */
+		[[nodiscard]] auto HeightAt(F32 x, F32 z) const noexcept -> std::optional<F32>;
+
+		[[nodiscard]] auto GetSettings()   const noexcept -> const Settings&;
+		[[nodiscard]] auto Tiles()         const noexcept -> const std::vector<Tile>&;
+		/**
+		 * @brief Return the number of levels of detail: log2(chunkResolution) + 1.
+		 */
+		[[nodiscard]] auto LodCount()      const noexcept -> I32;
+		/**
+		 * @brief Return the number of levels of detail of chunks with @p chunkResolution quads along a side.
+		 */
+		[[nodiscard]] static auto LodCount(I32 chunkResolution) noexcept -> I32;
+		[[nodiscard]] auto PendingLoads()  const noexcept -> I32;
+
+		/**
+		 * @brief Build the triangle list of a chunk.
+		 *
+		 * At level @p lod, the chunk is a grid of chunkResolution >> lod quads.
+		 * Sides flagged in @p stitches skip their odd vertices, matching a
+		 * neighbour one level coarser.
+		 *
+		 * @param chunkResolution Quads along a chunk's side.
+		 * @param rowStride Vertices per row of the tile.
+		 * @param lod The level of detail.
+		 * @param stitches The sides to stitch, see Side.
+		 *
+		 * @return Indices relative to the chunk's first vertex, counter-clockwise seen from above.
+		 */
+		[[nodiscard]] static auto BuildChunkIndices(I32 chunkResolution, I32 rowStride, I32 lod, U8 stitches) -> std::vector<U32>;
+		/**
+		 * @brief Return a tile loader reading raw heightmaps.
+		 *
+		 * Tile (x, z) is read from "<directory>/<x>_<z>.r16": (resolution + 1)^2
+		 * little-endian unsigned 16-bit samples, mapped to [0, heightScale].
+		 */
+		[[nodiscard]] static auto RawTileLoader(std::filesystem::path directory, I32 resolution, F32 heightScale) -> TileLoader;
+
+	private:
+		/**
+		 * @brief A tile being loaded, into a reserved slot.
+		 */
+		struct PendingLoad
+		{
+			glm::ivec2        coords;
+			I32               slot;
+			Unique<Tile>      tile;   /**< Filled by the load */
+			std::future<void> done;
+		};
+
+		auto Load(Tile& tile) const -> void;
+		auto Evict(std::size_t index) -> void;
+		auto PickLods(const glm::vec3& camera) -> void;
+
+		[[nodiscard]] auto TileAt(glm::ivec2 coords) const noexcept -> const Tile*;
+		[[nodiscard]] auto ChunksPerTile() const noexcept -> I32;
+
+		[[nodiscard]] static auto Key(glm::ivec2 coords) noexcept -> U64;
+
+	private:
+		Settings                             m_Settings;
+		Jobs::ThreadPool*                    m_Pool;
+		std::vector<Tile>                    m_Tiles;
+		std::unordered_map<U64, std::size_t> m_TileIndices; /**< Into m_Tiles */
+		std::vector<PendingLoad>             m_Pending;
+		std::vector<glm::ivec2>              m_Missing;     /**< Tiles the loader has nothing for, forgotten once out of range */
+		std::vector<I32>                     m_FreeSlots;
+		U64                                  m_NextVersion = 1;
+	};
+
+	inline auto Terrain::GetSettings() const noexcept -> const Settings&
+	{
+		return m_Settings;
+	}
+
+	inline auto Terrain::Tiles() const noexcept -> const std::vector<Tile>&
+	{
+		return m_Tiles;
+	}
+
+	inline auto Terrain::PendingLoads() const noexcept -> I32
+	{
+		return I32(m_Pending.size());
+	}
+
+	inline auto Terrain::ChunksPerTile() const noexcept -> I32
+	{
+		return m_Settings.tileResolution / m_Settings.chunkResolution;
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/TextureImage.hpp"
+
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Places textures into layers of texture arrays, and decides which of their mip levels to upload
+	 *
+	 * Textures of the same shape (format, encoding, size and level count)
+	 * share an array, one layer each, so draws with different textures can
+	 * still be batched: a shader picks the texture by array and layer rather
+	 * than by binding. Arrays are created as shapes come in, up to
+	 * kMaxArrays, each with kLayersPerArray layers.
+	 *
+	 * A texture's levels are streamed in from the coarsest one. Those no
+	 * larger than kTailSize texels are uploaded as soon as the texture is
+	 * added, so it can be drawn right away. Finer levels are only uploaded
+	 * once a draw needs them, see Request(), one level per texture per frame
+	 * and within a byte budget, see Stream(). Shaders clamp the level they
+	 * sample to the finest one resident.
+	 *
+	 * Streaming only goes one way. Levels stay resident when a texture gets
+	 * smaller on screen or is no longer drawn, and nothing is evicted under
+	 * memory pressure: the arrays have immutable storage, so memory is
+	 * allocated for every level of every layer up front, resident or not.
+	 * Remove() is the only way to free a layer for another texture.
+	 *
+	 * The class is renderer agnostic: it only does the bookkeeping. The
+	 * renderer creates the arrays and uploads the levels, see
+	 * Renderer::LoadTexture().
+	 */
+	class TextureArrays
+	{
+	public:
+		static constexpr auto kMaxArrays      = 8;
+		static constexpr auto kLayersPerArray = 64;
+		static constexpr auto kTailSize       = 64;
+
+		/**
+		 * @brief What textures must have in common to share an array.
+		 */
+		struct Shape
+		{
+			TextureImage::Format format;
+			bool                 isSRGB;
+			I32                  width;
+			I32                  height;
+			I32                  levels;
+
+			auto operator==(const Shape&) const noexcept -> bool = default;
+		};
+
+		struct Slot
+		{
+			I32 array;
+			I32 layer;
+		};
+
+		/**
+		 * @brief Where a texture is, and how much of it can be sampled.
+		 */
+		struct Residency
+		{
+			Slot slot;
+			I32  minLevel; /**< The finest level uploaded; levels from it to the coarsest are */
+		};
+
+		/**
+		 * @brief A mip level to copy into its layer.
+		 */
+		struct Upload
+		{
+			TextureID texture;
+			Slot      slot;
+			I32       level;
+		};
+
+	public:
+		/**
+		 * @brief Give a texture a layer, in an array of its shape.
+		 *
+		 * @return The layer, or std::nullopt if the arrays of its shape are
+		 *         full and no more arrays can be created.
+		 */
+		[[nodiscard]] auto Add(TextureID texture, const Shape& shape) -> std::optional<Slot>;
+		/**
+		 * @brief Give back a texture's layer, once the texture is gone.
+		 */
+		auto Remove(TextureID texture) -> void;
+		/**
+		 * @brief Find a texture.
+		 *
+		 * @return Its residency, or std::nullopt if it wasn't added or has no level uploaded yet.
+		 */
+		[[nodiscard]] auto Find(TextureID texture) const noexcept -> std::optional<Residency>;
+
+		/**
+		 * @brief Compute the level a texture should be sampled at, when drawn across a number of pixels.
+		 *
+		 * @param size The texture's larger dimension, in texels.
+		 * @param screenSize How many pixels it spans on screen.
+		 * @param levels The texture's level count.
+		 */
+		[[nodiscard]] static auto WantedLevel(I32 size, F32 screenSize, I32 levels) noexcept -> I32;
+		/**
+		 * @brief Note that a texture is drawn this frame.
+		 *
+		 * The finest level it is requested at over the frame is streamed in,
+		 * see WantedLevel().
+		 *
+		 * @param screenSize How many pixels the texture spans on screen.
+		 */
+		auto Request(TextureID texture, F32 screenSize) noexcept -> void;
+		/**
+		 * @brief Pick the levels to upload this frame, and mark them as resident.
+		 *
+		 * Missing tails come first, whatever the budget. Then textures whose
+		 * requested level is finer than their resident one get their next
+		 * finer level, the least resident textures first, as long as the
+		 * budget allows. The requests are cleared for the next frame.
+		 *
+		 * @param budget In bytes.
+		 *
+		 * @return The uploads, coarse levels before fine ones; valid until the next call.
+		 */
+		[[nodiscard]] auto Stream(I64 budget) -> std::span<const Upload>;
+
+		[[nodiscard]] auto Arrays() const noexcept -> I32 { return I32(m_Arrays.size()); }
+		/**
+		 * @brief Get the shape of an array, to create it with.
+		 */
+		[[nodiscard]] auto ArrayShape(I32 array) const noexcept -> const Shape&;
+
+	private:
+		struct Array
+		{
+			Shape            shape;
+			std::vector<I32> freeLayers;
+		};
+
+		struct Entry
+		{
+			Slot slot;
+			I32  minLevel;  /**< The shape's level count while nothing is resident */
+			I32  wanted;    /**< The finest level requested this frame; the level count if none */
+		};
+
+	private:
+		[[nodiscard]] static auto TailLevel(const Shape& shape) noexcept -> I32;
+
+	private:
+		std::vector<Array>                    m_Arrays;
+		std::unordered_map<TextureID, Entry>  m_Entries;
+		std::vector<Upload>                   m_Uploads;
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Identifies a texture image. Never reused within a process.
+	 */
+	using TextureID = U32;
+
+	static constexpr auto kInvalidTextureID = TextureID(0);
+
+	/**
+	 * @brief A block-compressed image with its mip levels, as stored in a DDS container
+	 *
+	 * The levels are kept compressed, exactly as read, so they can be handed
+	 * to the GPU as they are. Only 2D images are supported, in BC1, BC3, BC5
+	 * or BC7, from either the legacy header (DXT1, DXT5, ATI2 or BC5U) or
+	 * the DX10 extension. Images whose file holds fewer levels than the full
+	 * chain keep the levels it holds.
+	 *
+	 * Each image gets its own ID, by which materials refer to it, see
+	 * Material::texture.
+	 */
+	class TextureImage
+	{
+	public:
+		enum class Format : U8
+		{
+			BC1, /**< RGB, 1-bit alpha. 8 bytes per 4x4 block */
+			BC3, /**< RGBA. 16 bytes per block */
+			BC5, /**< Two channels, e.g. tangent space normals. 16 bytes per block */
+			BC7, /**< High quality RGBA. 16 bytes per block */
+		};
+
+		static constexpr auto kMaxLevels = 16;
+
+	public:
+		/**
+		 * @brief Read an image from the contents of a DDS file.
+		 *
+		 * @return The image, or std::nullopt if the data isn't a DDS file, is
+		 *         truncated, or holds something else than a 2D image in one of
+		 *         the supported formats.
+		 */
+		[[nodiscard]] static auto Parse(std::vector<std::byte> data) -> std::optional<TextureImage>;
+		/**
+		 * @brief Read an image from a DDS file.
+		 *
+		 * @return The image, or std::nullopt if the file can't be read or Parse() fails.
+		 */
+		[[nodiscard]] static auto Load(const std::filesystem::path& path) -> std::optional<TextureImage>;
+
+		/**
+		 * @brief Get the size of a 4x4 block, in bytes.
+		 */
+		[[nodiscard]] static auto BlockSize(Format format) noexcept -> I32;
+		/**
+		 * @brief Get the size of a mip level, in bytes.
+		 *
+		 * @param width, height Of the base level, in texels.
+		 */
+		[[nodiscard]] static auto LevelSize(Format format, I32 width, I32 height, I32 level) noexcept -> I64;
+
+		[[nodiscard]] auto ID()        const noexcept -> TextureID { return m_ID; }
+		[[nodiscard]] auto GetFormat() const noexcept -> Format    { return m_Format; }
+		/**
+		 * @brief Whether the color channels are sRGB encoded, to be decoded into linear values when sampled.
+		 */
+		[[nodiscard]] auto IsSRGB() const noexcept -> bool { return m_IsSRGB; }
+		[[nodiscard]] auto Width()  const noexcept -> I32 { return m_Width; }
+		[[nodiscard]] auto Height() const noexcept -> I32 { return m_Height; }
+		[[nodiscard]] auto Levels() const noexcept -> I32 { return I32(m_LevelOffsets.size()); }
+		/**
+		 * @brief Get the compressed blocks of a mip level, row by row.
+		 */
+		[[nodiscard]] auto Level(I32 level) const noexcept -> std::span<const std::byte>;
+
+	private:
+		TextureImage() = default;
+
+		[[nodiscard]] static auto NextID() noexcept -> TextureID;
+
+	private:
+		std::vector<std::byte>   m_Data;         /**< The whole file */
+		std::vector<std::size_t> m_LevelOffsets; /**< Into m_Data, one per level */
+		TextureID                m_ID     = kInvalidTextureID;
+		Format                   m_Format = Format::BC1;
+		bool                     m_IsSRGB = false;
+		I32                      m_Width  = 0;
+		I32                      m_Height = 0;
+	};
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Renderer.hpp"
+
+#include <span>
+
+namespace Gaze::GFX {
+	/**
+	 * @brief Drives another renderer from a dedicated render thread
+	 *
+	 * The calls made to it are recorded into a frame packet instead of being
+	 * carried out. Render() hands the packet to the render thread, which owns
+	 * the wrapped renderer's context and replays the packet against it, so
+	 * the driver's time overlaps the recording of the next frame. There are
+	 * two packets, see FrameHandoff: Render() only blocks while the render
+	 * thread is still on the frame before the one it hands off.
+	 *
+	 * What a call is given is copied into the packet: objects, lights,
+	 * palettes, particles, debug shapes, sprites and the overlay. The camera
+	 * is copied once per frame, when the first call of the frame is recorded,
+	 * and whenever SetCamera() is called. Terrains are copied as snapshots:
+	 * the chunks in the camera's view, and the tiles whose version wasn't
+	 * handed to the render thread yet. Static shadow casters are copied
+	 * whenever their version changes, checked by Render(). Only the skinning
+	 * pool is not copied: see Synchronize().
+	 *
+	 * Stats() returns the stats of the last frame the render thread drew.
+	 * MakeContextCurrent() does nothing, the context stays on the render
+	 * thread.
+	 */
+	class ThreadedRenderer : public Renderer
+	{
+	public:
+		/**
+		 * @brief Start the render thread.
+		 *
+		 * @param window The window @p renderer renders to
+		 * @param renderer The renderer to drive. Its context is moved to the
+		 *                 render thread, and back when this is destroyed
+		 */
+		ThreadedRenderer(Shared<WM::Window> window, Unique<Renderer> renderer);
+		/**
+		 * @brief Stop the render thread, after the frames it was handed, and destroy the wrapped renderer.
+		 */
+		~ThreadedRenderer() override;
+
+		ThreadedRenderer(const ThreadedRenderer&) = delete;
+		ThreadedRenderer(ThreadedRenderer&&) = delete;
+		auto operator=(const ThreadedRenderer&) = delete;
+		auto operator=(ThreadedRenderer&&) = delete;
+
+		auto SetClearColor(F32 r, F32 g, F32 b, F32 a)        noexcept -> void override;
+		auto Clear(Buffer buffer)                             noexcept -> void override;
+		auto Flush()                                          noexcept -> void override;
+		auto Render()                                         noexcept -> void override;
+		auto SetResolveMode(ResolveMode mode, I32 samples)    noexcept -> void override;
+		auto SetVSync(VSyncMode mode)                         noexcept -> void override;
+		auto SetMaxFramesInFlight(I32 nFrames)                noexcept -> void override;
+		auto SetVertexPulling(bool enabled)                   noexcept -> void override;
+		auto SetVisibilityBuffer(bool enabled)                noexcept -> void override;
+		auto SetDeferredShading(bool enabled)                 noexcept -> void override;
+		auto SetSkinning(SkinningMode mode, Jobs::ThreadPool* pool) noexcept -> void override;
+		auto SetShadows(std::optional<ShadowCache::Settings> settings) -> void override;
+		auto SetStaticShadowCasters(const StaticBatcher* batcher) noexcept -> void override;
+		auto SetImpostors(std::optional<ImpostorAtlas::Settings> settings) -> void override;
+		auto LoadTexture(const Shared<const TextureImage>& image)       -> void override;
+		auto CaptureFrame(CaptureCallback callback)                    -> void override;
+		auto MakeContextCurrent()                             noexcept -> void override;
+		auto ReleaseContext()                                 noexcept -> void override;
+		auto Synchronize()                                    noexcept -> void override;
+		auto Stats()                                          noexcept -> RenderStats override;
+		auto SetViewport(I32 x, I32 y, I32 width, I32 height) noexcept -> void override;
+		auto SetCamera(Shared<Camera> camera)                 noexcept -> void override;
+		auto DrawMesh(const Mesh& mesh, PrimitiveMode mode)            -> void override;
+		auto DrawMesh(
+			const Mesh& mesh,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode
+		) -> void override;
+		auto SetLights(const struct Light lights[], I32 nLights)       -> void override;
+		auto SubmitObject(const Object& object, PrimitiveMode mode)    -> void override;
+		auto SubmitObject(const Object& object, const glm::mat4& transform, PrimitiveMode mode) -> void override;
+		auto SubmitSkinned(
+			const Object& object,
+			const glm::mat4& transform,
+			std::span<const glm::mat4> palette,
+			PrimitiveMode mode
+		) -> void override;
+		auto SubmitWithImpostor(const Object& object, const glm::mat4& transform) -> void override;
+		auto SubmitObject(
+			const Object& object,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode
+		) -> void override;
+		auto SubmitObject(
+			const Object& object,
+			const glm::mat4& transform,
+			const struct Light lights[],
+			I32 nLights,
+			PrimitiveMode mode
+		) -> void override;
+		auto SubmitParticles(const ParticleEmitter& emitter)           -> void override;
+		auto SubmitParticles(std::span<const ParticleEmitter::Instance> instances) -> void override;
+		auto SubmitTerrain(const Terrain& terrain)                     -> void override;
+		auto SubmitTerrain(const Terrain::Snapshot& snapshot)          -> void override;
+
+	private:
+		/**
+		 * @brief Replay the packets handed off, until the handoff is closed. Runs on the render thread.
+		 */
+		auto RenderLoop() noexcept -> void;
+
+	private:
+		struct Impl;
+		Unique<Impl> m_pImpl;
+	};
+}
@@ -0,0 +1,82 @@
+#include "GFX/Bounds.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+
+#include <limits>
+
+namespace Gaze::GFX {
+	auto ComputeBounds(const Geometry::Mesh& mesh) noexcept -> AABB
+	{
+		constexpr auto kMax = std::numeric_limits<F32>::max();
+
+		auto box = AABB{ glm::vec3(kMax), glm::vec3(-kMax) };
+		auto isEmpty = true;
+
+		for (const auto& prim : mesh.Primitives()) {
+			for (const auto& vert : prim.vertices) {
+				const auto pos = glm::vec3(vert.x, vert.y, vert.z);
+
+				box.min = glm::min(box.min, pos);
+				box.max = glm::max(box.max, pos);
+				isEmpty = false;
+			}
+		}
+
+		return isEmpty ? AABB{ glm::vec3(.0F), glm::vec3(.0F) } : box;
+	}
+
+	auto TransformBounds(const AABB& box, const glm::mat4& transform) noexcept -> AABB
+	{
+		// Arvo's method: Transform the center, then project the extents onto
+		// each of the transformed axes.
+		const auto center  = glm::vec3(transform * glm::vec4(box.Center(), 1.F));
+		const auto extents = box.Extents();
+
+		auto newExtents = glm::vec3(.0F);
+		for (auto i = 0; i < 3; i++) {
+			newExtents += glm::abs(glm::vec3(transform[i])) * extents[i];
+		}
+
+		return { center - newExtents, center + newExtents };
+	}
+
+	auto MergeBounds(const AABB& a, const AABB& b) noexcept -> AABB
+	{
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	Frustum::Frustum(const glm::mat4& viewProjection) noexcept
+	{
+		// Gribb & Hartmann plane extraction. glm matrices are column-major,
+		// so row `i` is made up of the i-th component of each column.
+		const auto row = [&viewProjection](int i) {
+			return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		};
+
+		m_Planes[0] = row(3) + row(0); // Left
+		m_Planes[1] = row(3) - row(0); // Right
+		m_Planes[2] = row(3) + row(1); // Bottom
+		m_Planes[3] = row(3) - row(1); // Top
+		m_Planes[4] = row(3) + row(2); // Near
+		m_Planes[5] = row(3) - row(2); // Far
+	}
+
+	auto Frustum::Intersects(const AABB& box) const noexcept -> bool
+	{
+		const auto center  = box.Center();
+		const auto extents = box.Extents();
+
+		for (const auto& plane : m_Planes) {
+			const auto normal   = glm::vec3(plane);
+			const auto distance = glm::dot(normal, center) + plane.w;
+			const auto radius   = glm::dot(glm::abs(normal), extents);
+
+			if (distance + radius < .0F) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,117 @@
+#include "GFX/DebugDraw.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <array>
+#include <cmath>
+
+namespace Gaze::GFX {
+	auto DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color) -> void
+	{
+		const auto packed = PackColor(color);
+
+		m_Lines.push_back({ from, packed });
+		m_Lines.push_back({ to, packed });
+	}
+
+	auto DebugDraw::Box(const AABB& box, const glm::vec4& color) -> void
+	{
+		auto transform = glm::mat4(1.F);
+		transform[3] = glm::vec4(box.Center(), 1.F);
+
+		Box(transform, box.Extents(), color);
+	}
+
+	auto DebugDraw::Box(const glm::mat4& transform, const glm::vec3& halfExtents, const glm::vec4& color) -> void
+	{
+		static constexpr int kEdges[12][2] = {
+			{ 0, 1 }, { 1, 3 }, { 3, 2 }, { 2, 0 }, // Bottom
+			{ 4, 5 }, { 5, 7 }, { 7, 6 }, { 6, 4 }, // Top
+			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }, // Sides
+		};
+
+		auto corners = std::array<glm::vec3, 8>();
+		for (auto i = 0U; i < corners.size(); i++) {
+			const auto local = glm::vec3(
+				(i & 1) ? halfExtents.x : -halfExtents.x,
+				(i & 4) ? halfExtents.y : -halfExtents.y,
+				(i & 2) ? halfExtents.z : -halfExtents.z
+			);
+			corners[i] = glm::vec3(transform * glm::vec4(local, 1.F));
+		}
+
+		const auto packed = PackColor(color);
+		for (const auto& edge : kEdges) {
+			m_Lines.push_back({ corners[std::size_t(edge[0])], packed });
+			m_Lines.push_back({ corners[std::size_t(edge[1])], packed });
+		}
+	}
+
+	auto DebugDraw::Sphere(const glm::vec3& center, F32 radius, const glm::vec4& color, I32 nSegments) -> void
+	{
+		const auto packed = PackColor(color);
+		const auto step   = glm::two_pi<F32>() / F32(nSegments);
+
+		m_Lines.reserve(m_Lines.size() + std::size_t(nSegments) * 6);
+
+		for (auto i = 0; i < nSegments; i++) {
+			const auto a0 = step * F32(i);
+			const auto a1 = step * F32(i + 1);
+			const auto c0 = std::cos(a0) * radius;
+			const auto s0 = std::sin(a0) * radius;
+			const auto c1 = std::cos(a1) * radius;
+			const auto s1 = std::sin(a1) * radius;
+
+			m_Lines.push_back({ center + glm::vec3(c0, s0, .0F), packed }); // XY
+			m_Lines.push_back({ center + glm::vec3(c1, s1, .0F), packed });
+			m_Lines.push_back({ center + glm::vec3(c0, .0F, s0), packed }); // XZ
+			m_Lines.push_back({ center + glm::vec3(c1, .0F, s1), packed });
+			m_Lines.push_back({ center + glm::vec3(.0F, c0, s0), packed }); // YZ
+			m_Lines.push_back({ center + glm::vec3(.0F, c1, s1), packed });
+		}
+	}
+
+	auto DebugDraw::Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, F32 headSize) -> void
+	{
+		Line(from, to, color);
+
+		const auto shaft = to - from;
+		const auto len   = glm::length(shaft);
+		if (len <= .0F) {
+			return;
+		}
+
+		const auto dir   = shaft / len;
+		const auto up    = std::abs(dir.y) < .99F ? glm::vec3(.0F, 1.F, .0F) : glm::vec3(1.F, .0F, .0F);
+		const auto right = glm::normalize(glm::cross(dir, up)) * headSize * .5F;
+		const auto upDir = glm::normalize(glm::cross(right, dir)) * headSize * .5F;
+		const auto base  = to - dir * headSize;
+
+		Line(to, base + right, color);
+		Line(to, base - right, color);
+		Line(to, base + upDir, color);
+		Line(to, base - upDir, color);
+	}
+
+	auto DebugDraw::Point(const glm::vec3& position, const glm::vec4& color) -> void
+	{
+		m_Points.push_back({ position, PackColor(color) });
+	}
+
+	auto DebugDraw::Clear() noexcept -> void
+	{
+		m_Lines.clear();
+		m_Points.clear();
+	}
+
+	auto DebugDraw::PackColor(const glm::vec4& color) noexcept -> U32
+	{
+		const auto channel = [](F32 val) {
+			return U32(std::lround(glm::clamp(val, .0F, 1.F) * 255.F));
+		};
+
+		return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+	}
+}
@@ -0,0 +1,152 @@
+#include "GFX/ImpostorAtlas.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Gaze::GFX {
+	namespace {
+		const auto kUp = glm::vec3(0.F, 1.F, 0.F);
+	}
+
+	ImpostorAtlas::ImpostorAtlas(Settings settings) noexcept
+		: m_Settings(settings)
+	{
+		GAZE_ASSERT(settings.nYaw > 0 && settings.nPitch > 0, "Impostors need at least one view");
+		GAZE_ASSERT(settings.cellResolution > 0 && settings.maxImpostors > 0, "Impostor atlas dimensions must be positive");
+		GAZE_ASSERT(settings.switchSize >= 0.F && settings.fadeSize >= 0.F, "Impostor thresholds must not be negative");
+
+		// Handed out from the back, lowest first
+		m_FreeSlots.reserve(std::size_t(settings.maxImpostors));
+		for (auto slot = settings.maxImpostors - 1; slot >= 0; slot--) {
+			m_FreeSlots.push_back(slot);
+		}
+	}
+
+	auto ImpostorAtlas::Acquire() -> std::optional<I32>
+	{
+		if (m_FreeSlots.empty()) {
+			return std::nullopt;
+		}
+
+		const auto slot = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+
+		return slot;
+	}
+
+	auto ImpostorAtlas::Release(I32 slot) -> void
+	{
+		GAZE_ASSERT(slot >= 0 && slot < m_Settings.maxImpostors, "Impostor slot out of range");
+		GAZE_ASSERT(std::find(m_FreeSlots.begin(), m_FreeSlots.end(), slot) == m_FreeSlots.end(), "Impostor slot released twice");
+
+		m_FreeSlots.push_back(slot);
+	}
+
+	auto ImpostorAtlas::ScreenSize(F32 radius, F32 distance, F32 projectionScale, F32 viewportHeight) noexcept -> F32
+	{
+		if (distance <= radius) {
+			return std::numeric_limits<F32>::infinity();
+		}
+
+		// The diameter over the height the view covers at that distance, 2 * distance / projectionScale
+		return radius * projectionScale * viewportHeight / distance;
+	}
+
+	auto ImpostorAtlas::Blend(F32 screenSize) const noexcept -> Weights
+	{
+		auto mesh = screenSize >= m_Settings.switchSize ? 1.F : 0.F;
+		if (m_Settings.fadeSize > 0.F) {
+			mesh = std::clamp((screenSize - m_Settings.switchSize) / m_Settings.fadeSize, 0.F, 1.F);
+		}
+
+		return { mesh, 1.F - mesh };
+	}
+
+	auto ImpostorAtlas::CellDirection(glm::ivec2 cell) const noexcept -> glm::vec3
+	{
+		GAZE_ASSERT(cell.x >= 0 && cell.x < m_Settings.nYaw && cell.y >= 0 && cell.y < m_Settings.nPitch, "Impostor cell out of range");
+
+		// Elevations are at the middle of their band, so no view looks straight along the up axis
+		const auto yaw   = glm::two_pi<F32>() * F32(cell.x) / F32(m_Settings.nYaw);
+		const auto pitch = glm::pi<F32>() * ((F32(cell.y) + .5F) / F32(m_Settings.nPitch) - .5F);
+
+		return { std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw) };
+	}
+
+	auto ImpostorAtlas::SelectCell(const glm::vec3& toViewer) const noexcept -> glm::ivec2
+	{
+		const auto length = glm::length(toViewer);
+		if (length <= 0.F) {
+			return { 0, m_Settings.nPitch / 2 };
+		}
+
+		const auto direction = toViewer / length;
+		const auto yawStep   = glm::two_pi<F32>() / F32(m_Settings.nYaw);
+
+		auto yaw = std::atan2(direction.x, direction.z);
+		if (yaw < 0.F) {
+			yaw += glm::two_pi<F32>();
+		}
+		const auto pitch = std::asin(std::clamp(direction.y, -1.F, 1.F));
+
+		const auto x = I32(std::lround(yaw / yawStep)) % m_Settings.nYaw;
+		const auto y = std::clamp(I32(std::floor((pitch / glm::pi<F32>() + .5F) * F32(m_Settings.nPitch))), 0, m_Settings.nPitch - 1);
+
+		return { x, y };
+	}
+
+	auto ImpostorAtlas::BakeViewProjection(glm::ivec2 cell, const glm::vec3& center, F32 radius) const noexcept -> glm::mat4
+	{
+		GAZE_ASSERT(radius > 0.F, "Impostors need a bounding sphere");
+
+		// The sphere exactly fills the cell, from a camera outside of it
+		const auto eye  = center + CellDirection(cell) * (2.F * radius);
+		const auto view = glm::lookAt(eye, center, kUp);
+
+		return glm::ortho(-radius, radius, -radius, radius, radius, 3.F * radius) * view;
+	}
+
+	auto ImpostorAtlas::MakeBillboard(const glm::mat4& model, const glm::vec3& center, F32 radius, const glm::vec3& viewer) const noexcept -> Billboard
+	{
+		const auto axisX = glm::vec3(model[0]);
+		const auto axisY = glm::vec3(model[1]);
+		const auto axisZ = glm::vec3(model[2]);
+		const auto scale = std::sqrt(std::max({ glm::dot(axisX, axisX), glm::dot(axisY, axisY), glm::dot(axisZ, axisZ) }));
+
+		const auto worldCenter = glm::vec3(model * glm::vec4(center, 1.F));
+		const auto toViewer    = viewer - worldCenter;
+
+		// Back to model space through the transposed axes, which only holds without shear
+		const auto local = glm::vec3(
+			glm::dot(toViewer, axisX) / glm::dot(axisX, axisX),
+			glm::dot(toViewer, axisY) / glm::dot(axisY, axisY),
+			glm::dot(toViewer, axisZ) / glm::dot(axisZ, axisZ)
+		);
+
+		// Built like the bake's look-at view, so the quad and its cell line up
+		const auto forward = glm::dot(toViewer, toViewer) > 0.F ? -glm::normalize(toViewer) : -glm::normalize(axisZ);
+		auto right = glm::cross(forward, glm::normalize(axisY));
+		right = glm::dot(right, right) > 1e-6F ? glm::normalize(right) : glm::normalize(axisX);
+		const auto up = glm::cross(right, forward);
+
+		return {
+			.center = worldCenter,
+			.right  = right * (radius * scale),
+			.up     = up * (radius * scale),
+			.cell   = SelectCell(local),
+		};
+	}
+
+	auto ImpostorAtlas::SlotSize() const noexcept -> glm::ivec2
+	{
+		return { m_Settings.nYaw * m_Settings.cellResolution, m_Settings.nPitch * m_Settings.cellResolution };
+	}
+}
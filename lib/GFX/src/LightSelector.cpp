@@ -0,0 +1,156 @@
+#include "GFX/LightSelector.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAZE_LIGHT_SELECTOR_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Gaze::GFX {
+	namespace {
+		/**
+		 * @brief The best candidates so far, sorted by decreasing score.
+		 */
+		struct TopLights
+		{
+			std::array<F32, 8> scores;
+			std::array<I32, 8> indices;
+			I32                count;
+			I32                capacity;
+
+			/**
+			 * @brief The score a light must beat to be selected.
+			 */
+			[[nodiscard]] auto Threshold() const noexcept -> F32
+			{
+				return count < capacity ? LightSelector::kMinContribution : scores[std::size_t(count - 1)];
+			}
+
+			auto Insert(F32 score, I32 index) noexcept -> void
+			{
+				if (score <= Threshold()) {
+					return;
+				}
+
+				auto slot = std::min(count, capacity - 1);
+				while (slot > 0 && scores[std::size_t(slot - 1)] < score) {
+					scores[std::size_t(slot)]  = scores[std::size_t(slot - 1)];
+					indices[std::size_t(slot)] = indices[std::size_t(slot - 1)];
+					slot--;
+				}
+
+				scores[std::size_t(slot)]  = score;
+				indices[std::size_t(slot)] = index;
+				count = std::min(count + 1, capacity);
+			}
+		};
+	}
+
+	auto LightSelector::SetLights(const Light lights[], I32 nLights) -> void
+	{
+		GAZE_ASSERT(nLights >= 0, "Light count must not be negative");
+		GAZE_ASSERT(nLights == 0 || lights != nullptr, "Missing lights");
+
+		m_Lights.assign(lights, lights + nLights);
+
+		const auto padded = std::size_t((nLights + kLaneCount - 1) / kLaneCount * kLaneCount);
+		for (auto* lane : { &m_X, &m_Y, &m_Z, &m_Luminance, &m_Ambient, &m_Attenuation }) {
+			lane->assign(padded, 0.F);
+		}
+
+		for (auto i = std::size_t(0); i < m_Lights.size(); i++) {
+			const auto& light = m_Lights[i];
+
+			m_X[i]           = light.position.x;
+			m_Y[i]           = light.position.y;
+			m_Z[i]           = light.position.z;
+			m_Luminance[i]   = glm::dot(light.diffuse, glm::vec3(.2126F, .7152F, .0722F));
+			m_Ambient[i]     = light.ambientCoefficient;
+			m_Attenuation[i] = light.IsDirectional() ? 0.F : light.attenuation; // Equally strong everywhere
+		}
+	}
+
+	auto LightSelector::Select(const AABB& bounds, I32 maxLights, Light selected[]) const noexcept -> I32
+	{
+		GAZE_ASSERT(maxLights >= 0 && maxLights <= kMaxSelectable, "Can only select up to 8 lights");
+
+		if (maxLights == 0 || m_Lights.empty()) {
+			return 0;
+		}
+
+		// contribution ~ luminance * (ambient + 1 / (1 + attenuation * d^2)),
+		// with d the distance from the light to the closest point of the bounds
+		auto top = TopLights{ .scores = {}, .indices = {}, .count = 0, .capacity = maxLights };
+
+		const auto center  = bounds.Center();
+		const auto extents = bounds.Extents();
+		const auto padded  = I32(m_X.size());
+
+#if defined(GAZE_LIGHT_SELECTOR_SSE)
+		const auto cx = _mm_set1_ps(center.x);
+		const auto cy = _mm_set1_ps(center.y);
+		const auto cz = _mm_set1_ps(center.z);
+		const auto ex = _mm_set1_ps(extents.x);
+		const auto ey = _mm_set1_ps(extents.y);
+		const auto ez = _mm_set1_ps(extents.z);
+		const auto zero = _mm_setzero_ps();
+		const auto one = _mm_set1_ps(1.F);
+		const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+		// Distance from the light to the box along one axis, 0 when within its slab
+		const auto axisDistance = [&](const F32* position, __m128 c, __m128 e) {
+			const auto d = _mm_sub_ps(_mm_and_ps(_mm_sub_ps(_mm_loadu_ps(position), c), absMask), e);
+			return _mm_max_ps(d, zero);
+		};
+
+		for (auto i = 0; i < padded; i += kLaneCount) {
+			const auto idx = std::size_t(i);
+
+			const auto dx = axisDistance(&m_X[idx], cx, ex);
+			const auto dy = axisDistance(&m_Y[idx], cy, ey);
+			const auto dz = axisDistance(&m_Z[idx], cz, ez);
+			const auto d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+			const auto falloff = _mm_div_ps(one, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&m_Attenuation[idx]), d2)));
+			const auto score   = _mm_mul_ps(_mm_loadu_ps(&m_Luminance[idx]), _mm_add_ps(_mm_loadu_ps(&m_Ambient[idx]), falloff));
+
+			// Most lights do not make the cut; skip them without leaving the registers
+			const auto beats = _mm_movemask_ps(_mm_cmpgt_ps(score, _mm_set1_ps(top.Threshold())));
+			if (beats == 0) {
+				continue;
+			}
+
+			alignas(16) F32 scores[kLaneCount];
+			_mm_store_ps(scores, score);
+			for (auto lane = 0; lane < kLaneCount; lane++) {
+				if ((beats & (1 << lane)) != 0) {
+					top.Insert(scores[lane], i + lane);
+				}
+			}
+		}
+#else
+		for (auto i = 0; i < padded; i++) {
+			const auto idx = std::size_t(i);
+
+			const auto position = glm::vec3(m_X[idx], m_Y[idx], m_Z[idx]);
+			const auto d        = glm::max(glm::abs(position - center) - extents, glm::vec3(0.F));
+			const auto falloff  = 1.F / (1.F + m_Attenuation[idx] * glm::dot(d, d));
+
+			top.Insert(m_Luminance[idx] * (m_Ambient[idx] + falloff), i);
+		}
+#endif
+
+		for (auto i = 0; i < top.count; i++) {
+			selected[i] = m_Lights[std::size_t(top.indices[std::size_t(i)])];
+		}
+
+		return top.count;
+	}
+}
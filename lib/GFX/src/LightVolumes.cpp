@@ -0,0 +1,52 @@
+#include "GFX/LightVolumes.hpp"
+#include "GFX/LightSelector.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace Gaze::GFX {
+	auto LightVolumes::Build(std::span<const Light> lights, const glm::vec3& viewPos, F32 nearReach) -> void
+	{
+		m_Volumes.clear();
+		m_Ambient = glm::vec3(0.F);
+
+		for (auto i = std::size_t(0); i < lights.size(); i++) {
+			const auto& light = lights[i];
+			m_Ambient += light.ambientCoefficient * light.diffuse;
+
+			const auto radius = Radius(light);
+			if (radius <= 0.F) {
+				continue;
+			}
+
+			if (std::isinf(radius)) {
+				m_Volumes.push_back({ .light = I32(i), .shape = Shape::FullScreen, .radius = radius, .containsView = true });
+				continue;
+			}
+
+			m_Volumes.push_back({
+				.light        = I32(i),
+				.shape        = Shape::Sphere,
+				.radius       = radius,
+				.containsView = glm::distance(viewPos, light.position) < radius + nearReach,
+			});
+		}
+	}
+
+	auto LightVolumes::Radius(const Light& light) noexcept -> F32
+	{
+		// Solve max(diffuse) / (1 + attenuation * r^2) = kMinContribution for r
+		const auto brightest = glm::max(light.diffuse.r, glm::max(light.diffuse.g, light.diffuse.b));
+		if (brightest <= LightSelector::kMinContribution) {
+			return 0.F;
+		}
+		if (light.IsDirectional() || light.attenuation <= 0.F) {
+			return std::numeric_limits<F32>::infinity();
+		}
+
+		return std::sqrt((brightest / LightSelector::kMinContribution - 1.F) / light.attenuation);
+	}
+}
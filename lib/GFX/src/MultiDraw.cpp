@@ -0,0 +1,23 @@
+#include "GFX/MultiDraw.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+
+namespace Gaze::GFX {
+	auto SplitMultiDraws(std::span<const std::size_t> groupEnds, std::size_t maxDraws, std::vector<MultiDraw>& out) -> void
+	{
+		GAZE_ASSERT(maxDraws > 0, "Multi-draws need room for at least one draw");
+
+		out.clear();
+
+		auto first = std::size_t(0);
+		for (const auto end : groupEnds) {
+			GAZE_ASSERT(end >= first, "Group ends must be increasing");
+
+			for (; first < end; first += std::min(maxDraws, end - first)) {
+				out.push_back({ first, std::min(maxDraws, end - first) });
+			}
+		}
+	}
+}
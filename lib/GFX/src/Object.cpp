@@ -1,5 +1,7 @@
 #include "GFX/Object.hpp"
 
+#include "Debug/Assert.hpp"
+
 namespace Gaze::GFX {
 	Object::Object(Geometry::Mesh mesh)
 		: Object(std::move(mesh), Properties({ .transform = glm::mat4(1.0F), .material = {} }))
@@ -7,9 +9,20 @@ namespace Gaze::GFX {
 	}
 
 	Object::Object(Geometry::Mesh mesh, struct Properties props)
+		: Object(Geometry::MeshHandle(std::move(mesh)), std::move(props))
+	{
+	}
+
+	Object::Object(Geometry::MeshHandle mesh)
+		: Object(std::move(mesh), Properties({ .transform = glm::mat4(1.0F), .material = {} }))
+	{
+	}
+
+	Object::Object(Geometry::MeshHandle mesh, struct Properties props)
 		: m_Mesh(std::move(mesh))
 		, m_Properties(std::move(props))
 	{
+		GAZE_ASSERT(bool(m_Mesh), "Object requires a mesh");
 	}
 
 	auto Object::SetPosition(const glm::vec3& pos) -> void
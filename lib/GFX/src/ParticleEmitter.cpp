@@ -0,0 +1,261 @@
+#include "GFX/ParticleEmitter.hpp"
+
+#include "GFX/DebugDraw.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAZE_PARTICLES_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Gaze::GFX {
+	namespace {
+		constexpr auto kParallelGrainSize = std::size_t(4096); // In blocks of 4 particles
+
+		constexpr auto RoundUp4(std::size_t n) noexcept -> std::size_t
+		{
+			return (n + 3) & ~std::size_t(3);
+		}
+	}
+
+	ParticleEmitter::ParticleEmitter(const Settings& settings, U32 seed)
+		: m_Random(seed != 0 ? seed : 1)
+	{
+		SetSettings(settings);
+	}
+
+	auto ParticleEmitter::SetSettings(const Settings& settings) -> void
+	{
+		m_Count = std::min(m_Count, settings.maxParticles);
+
+		const auto stride = RoundUp4(settings.maxParticles);
+		if (stride != m_Stride) {
+			auto data = std::vector<F32>(kAttributeCount * stride, 0.F);
+
+			for (auto attribute = std::size_t(0); attribute < kAttributeCount; attribute++) {
+				const auto* from = Lane(Attribute(attribute));
+				std::copy(from, from + m_Count, data.data() + attribute * stride);
+			}
+
+			m_Data   = std::move(data);
+			m_Stride = stride;
+		}
+
+		m_Settings = settings;
+	}
+
+	auto ParticleEmitter::Emit(std::size_t count) noexcept -> std::size_t
+	{
+		const auto& s = m_Settings;
+
+		count = std::min(count, s.maxParticles - m_Count);
+
+		auto* px = Lane(kPositionX);
+		auto* py = Lane(kPositionY);
+		auto* pz = Lane(kPositionZ);
+		auto* vx = Lane(kVelocityX);
+		auto* vy = Lane(kVelocityY);
+		auto* vz = Lane(kVelocityZ);
+		auto* age     = Lane(kAge);
+		auto* ageRate = Lane(kAgeRate);
+
+		const auto signedRandom = [this] { return Random() * 2.F - 1.F; };
+
+		for (auto i = m_Count; i < m_Count + count; i++) {
+			px[i] = s.position.x + s.spawnExtent.x * signedRandom();
+			py[i] = s.position.y + s.spawnExtent.y * signedRandom();
+			pz[i] = s.position.z + s.spawnExtent.z * signedRandom();
+			vx[i] = s.velocity.x + s.velocitySpread.x * signedRandom();
+			vy[i] = s.velocity.y + s.velocitySpread.y * signedRandom();
+			vz[i] = s.velocity.z + s.velocitySpread.z * signedRandom();
+
+			const auto lifetime = glm::mix(s.minLifetime, s.maxLifetime, Random());
+			age[i]     = 0.F;
+			ageRate[i] = lifetime > 0.F ? 1.F / lifetime : 1.F;
+		}
+
+		m_Count += count;
+
+		return count;
+	}
+
+	auto ParticleEmitter::Update(F32 dt, Jobs::ThreadPool* pool) noexcept -> void
+	{
+		if (m_Count > 0) {
+			// Padding particles are simulated too, it is cheaper than a scalar tail
+			const auto end = RoundUp4(m_Count);
+
+			if (pool != nullptr) {
+				pool->ParallelFor(end / 4, kParallelGrainSize, [this, dt](std::size_t begin, std::size_t last) {
+					Simulate(begin * 4, last * 4, dt);
+				});
+			} else {
+				Simulate(0, end, dt);
+			}
+
+			Compact();
+		}
+
+		m_Pending += m_Settings.rate * dt;
+		const auto nSpawned = std::size_t(std::max(m_Pending, 0.F));
+		m_Pending -= F32(nSpawned);
+
+		Emit(nSpawned);
+	}
+
+	auto ParticleEmitter::Simulate(std::size_t first, std::size_t last, F32 dt) noexcept -> void
+	{
+		const auto& s = m_Settings;
+
+		const auto damping = std::max(1.F - s.drag * dt, 0.F);
+		const auto dv      = s.gravity * dt;
+
+		auto* px = Lane(kPositionX);
+		auto* py = Lane(kPositionY);
+		auto* pz = Lane(kPositionZ);
+		auto* vx = Lane(kVelocityX);
+		auto* vy = Lane(kVelocityY);
+		auto* vz = Lane(kVelocityZ);
+		auto* age           = Lane(kAge);
+		const auto* ageRate = Lane(kAgeRate);
+
+#if defined(GAZE_PARTICLES_SSE)
+		const auto vDamping = _mm_set1_ps(damping);
+		const auto vDt      = _mm_set1_ps(dt);
+
+		const auto integrate = [&](F32* position, F32* velocity, __m128 delta, std::size_t i) {
+			const auto v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velocity + i), vDamping), delta);
+			_mm_storeu_ps(velocity + i, v);
+			_mm_storeu_ps(position + i, _mm_add_ps(_mm_loadu_ps(position + i), _mm_mul_ps(v, vDt)));
+		};
+
+		const auto dvx = _mm_set1_ps(dv.x);
+		const auto dvy = _mm_set1_ps(dv.y);
+		const auto dvz = _mm_set1_ps(dv.z);
+		for (auto i = first; i < last; i += 4) {
+			integrate(px, vx, dvx, i);
+			integrate(py, vy, dvy, i);
+			integrate(pz, vz, dvz, i);
+			_mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(ageRate + i), vDt)));
+		}
+#else
+		for (auto i = first; i < last; i++) {
+			vx[i] = vx[i] * damping + dv.x;
+			vy[i] = vy[i] * damping + dv.y;
+			vz[i] = vz[i] * damping + dv.z;
+			px[i] += vx[i] * dt;
+			py[i] += vy[i] * dt;
+			pz[i] += vz[i] * dt;
+			age[i] += ageRate[i] * dt;
+		}
+#endif
+	}
+
+	auto ParticleEmitter::Compact() noexcept -> void
+	{
+		const auto* age = Lane(kAge);
+
+		auto i = std::size_t(0);
+		while (i < m_Count) {
+#if defined(GAZE_PARTICLES_SSE)
+			// Most particles live on, skip them 4 at a time
+			if (i % 4 == 0 && i + 4 <= m_Count) {
+				if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(age + i), _mm_set1_ps(1.F))) == 0) {
+					i += 4;
+					continue;
+				}
+			}
+#endif
+			if (age[i] < 1.F) {
+				i++;
+				continue;
+			}
+
+			// The particle moved in may be dead as well, so check the same slot again
+			m_Count--;
+			for (auto attribute = std::size_t(0); attribute < kAttributeCount; attribute++) {
+				auto* lane = Lane(Attribute(attribute));
+				lane[i] = lane[m_Count];
+			}
+		}
+	}
+
+	auto ParticleEmitter::WriteInstances(std::span<Instance> out) const noexcept -> std::size_t
+	{
+		const auto& s = m_Settings;
+
+		const auto count = std::min(m_Count, out.size());
+
+		const auto* px  = Lane(kPositionX);
+		const auto* py  = Lane(kPositionY);
+		const auto* pz  = Lane(kPositionZ);
+		const auto* age = Lane(kAge);
+
+#if defined(GAZE_PARTICLES_SSE)
+		const auto startColor = glm::clamp(s.startColor, 0.F, 1.F) * 255.F;
+		const auto colorDelta = glm::clamp(s.endColor, 0.F, 1.F) * 255.F - startColor;
+
+		const auto zero = _mm_setzero_ps();
+		const auto one  = _mm_set1_ps(1.F);
+		const auto half = _mm_set1_ps(.5F);
+
+		const auto channel = [&](__m128 t, F32 start, F32 delta, int shift) {
+			const auto value = _mm_add_ps(_mm_add_ps(_mm_set1_ps(start), _mm_mul_ps(_mm_set1_ps(delta), t)), half);
+			return _mm_slli_epi32(_mm_cvttps_epi32(value), shift);
+		};
+
+		// The padding past the last particle is readable, so the tail is computed 4 wide as well
+		for (auto i = std::size_t(0); i < count; i += 4) {
+			const auto t    = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(age + i), zero), one);
+			const auto size = _mm_add_ps(_mm_set1_ps(s.startSize), _mm_mul_ps(_mm_set1_ps(s.endSize - s.startSize), t));
+			const auto rgba = _mm_or_si128(
+				_mm_or_si128(channel(t, startColor.r, colorDelta.r, 0), channel(t, startColor.g, colorDelta.g, 8)),
+				_mm_or_si128(channel(t, startColor.b, colorDelta.b, 16), channel(t, startColor.a, colorDelta.a, 24))
+			);
+
+			alignas(16) F32 sizes[4];
+			alignas(16) U32 colors[4];
+			_mm_store_ps(sizes, size);
+			_mm_store_si128(reinterpret_cast<__m128i*>(colors), rgba);
+
+			const auto n = std::min(count - i, std::size_t(4));
+			for (auto k = std::size_t(0); k < n; k++) {
+				out[i + k] = { { px[i + k], py[i + k], pz[i + k] }, sizes[k], colors[k] };
+			}
+		}
+#else
+		for (auto i = std::size_t(0); i < count; i++) {
+			const auto t = glm::clamp(age[i], 0.F, 1.F);
+
+			out[i] = {
+				{ px[i], py[i], pz[i] },
+				glm::mix(s.startSize, s.endSize, t),
+				DebugDraw::PackColor(glm::mix(s.startColor, s.endColor, t))
+			};
+		}
+#endif
+
+		return count;
+	}
+
+	auto ParticleEmitter::Clear() noexcept -> void
+	{
+		m_Count   = 0;
+		m_Pending = 0.F;
+	}
+
+	auto ParticleEmitter::Random() noexcept -> F32
+	{
+		// xorshift32, plenty for visual noise
+		m_Random ^= m_Random << 13;
+		m_Random ^= m_Random >> 17;
+		m_Random ^= m_Random << 5;
+
+		return F32(m_Random >> 8) * (1.F / 16'777'216.F);
+	}
+}
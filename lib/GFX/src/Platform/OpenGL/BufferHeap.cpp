@@ -0,0 +1,116 @@
+#include "GFX/Platform/OpenGL/BufferHeap.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	BufferHeap::BufferHeap(I64 pageSize) noexcept
+		: m_PageSize(pageSize)
+	{
+		GAZE_ASSERT(pageSize > 0, "Page size must be positive");
+	}
+
+	auto BufferHeap::Allocate(I64 size, I64 alignment) -> Allocation
+	{
+		GAZE_ASSERT(size > 0, "Cannot allocate 0 bytes");
+		GAZE_ASSERT(alignment > 0, "Alignment must be positive");
+
+		for (auto i = 0U; i < m_Pages.size(); i++) {
+			if (m_Pages[i] == nullptr) {
+				continue;
+			}
+
+			const auto handle = m_Pages[i]->allocator.Allocate(U64(size), U64(alignment));
+			if (handle != TLSFAllocator::kInvalidHandle) {
+				return { i, handle };
+			}
+		}
+
+		const auto pageSize = std::max(m_PageSize, size);
+		auto page = MakeUnique<Page>(Page{ Objects::Buffer(pageSize), TLSFAllocator(U64(pageSize)) });
+
+		const auto handle = page->allocator.Allocate(U64(size), U64(alignment));
+		GAZE_ASSERT(handle != TLSFAllocator::kInvalidHandle, "Fresh page too small");
+
+		// Reuse the slot of a released page, if any
+		auto slot = std::find(m_Pages.begin(), m_Pages.end(), nullptr);
+		if (slot == m_Pages.end()) {
+			slot = m_Pages.insert(m_Pages.end(), nullptr);
+		}
+		*slot = std::move(page);
+
+		return { U32(std::distance(m_Pages.begin(), slot)), handle };
+	}
+
+	auto BufferHeap::Free(Allocation allocation) -> void
+	{
+		auto& page = m_Pages[allocation.page];
+		GAZE_ASSERT(page != nullptr, "Invalid page");
+
+		page->allocator.Free(allocation.handle);
+
+		if (page->allocator.IsEmpty() && page->buffer.Size() > m_PageSize) {
+			page.reset();
+		}
+	}
+
+	auto BufferHeap::Upload(Allocation allocation, const void* data) noexcept -> void
+	{
+		auto& page = *m_Pages[allocation.page];
+
+		page.buffer.Upload(data, I64(page.allocator.Size(allocation.handle)), I64(page.allocator.Offset(allocation.handle)));
+	}
+
+	auto BufferHeap::Offset(Allocation allocation) const noexcept -> I64
+	{
+		return I64(m_Pages[allocation.page]->allocator.Offset(allocation.handle));
+	}
+
+	auto BufferHeap::PageBuffer(U32 page) const noexcept -> const Objects::Buffer&
+	{
+		return m_Pages[page]->buffer;
+	}
+
+	auto BufferHeap::Defragment(I64 budget) -> I64
+	{
+		auto moved = I64(0);
+
+		for (auto& page : m_Pages) {
+			if (moved >= budget) {
+				break;
+			}
+			if (page == nullptr || page->allocator.GetStats().fragmentation < kDefragmentThreshold) {
+				continue;
+			}
+
+			const auto& buffer = page->buffer;
+			moved += I64(page->allocator.Defragment(U64(budget - moved), [&buffer](U64 from, U64 to, U64 size) {
+				buffer.CopyTo(buffer, I64(from), I64(to), I64(size));
+			}));
+		}
+
+		return moved;
+	}
+
+	auto BufferHeap::GetStats() const noexcept -> Stats
+	{
+		auto stats = Stats{};
+
+		for (const auto& page : m_Pages) {
+			if (page == nullptr) {
+				continue;
+			}
+
+			const auto pageStats = page->allocator.GetStats();
+			stats.capacity         += I64(pageStats.capacity);
+			stats.used             += I64(pageStats.used);
+			stats.largestFreeBlock  = std::max(stats.largestFreeBlock, I64(pageStats.largestFreeBlock));
+			stats.nPages++;
+			stats.nAllocations     += I32(pageStats.nAllocations);
+			stats.fragmentation     = std::max(stats.fragmentation, pageStats.fragmentation);
+		}
+
+		return stats;
+	}
+}
@@ -0,0 +1,134 @@
+#include "GFX/Platform/OpenGL/FrameCapturer.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <cstring>
+
+namespace Gaze::GFX::Platform::OpenGL {
+	static constexpr auto kBytesPerPixel = I64(4); // RGBA8
+
+	FrameCapturer::FrameCapturer(I32 nSlots)
+	{
+		GAZE_ASSERT(nSlots > 0, "At least one slot is required");
+
+		m_Slots.reserve(std::size_t(nSlots));
+		for (auto i = 0; i < nSlots; i++) {
+			m_Slots.push_back(MakeUnique<Slot>());
+		}
+
+		m_Worker = std::jthread([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+	}
+
+	FrameCapturer::~FrameCapturer()
+	{
+		Dispatch(true);
+
+		// The worker drains its queue before stopping, and must be done with
+		// the mappings before the buffers go away
+		m_Worker.request_stop();
+		m_CV.notify_all();
+		m_Worker.join();
+	}
+
+	auto FrameCapturer::Capture(I32 width, I32 height, U64 frame, Callback callback) -> bool
+	{
+		GAZE_ASSERT(width > 0 && height > 0, "Capture size must be positive");
+
+		auto* slot = static_cast<Slot*>(nullptr);
+		for (auto& candidate : m_Slots) {
+			if (!candidate->isBusy.load(std::memory_order_acquire)) {
+				slot = candidate.get();
+				break;
+			}
+		}
+		if (slot == nullptr) {
+			return false;
+		}
+
+		const auto size = I64(width) * I64(height) * kBytesPerPixel;
+		if (slot->buffer == nullptr || slot->buffer->Size() < size) {
+			slot->buffer = MakeUnique<Objects::ReadbackBuffer>(size);
+		}
+
+		slot->isBusy.store(true, std::memory_order_relaxed);
+		slot->width    = width;
+		slot->height   = height;
+		slot->frame    = frame;
+		slot->callback = std::move(callback);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer->ID());
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_Pending.push_back(slot);
+
+		return true;
+	}
+
+	auto FrameCapturer::Poll() -> void
+	{
+		Dispatch(false);
+	}
+
+	auto FrameCapturer::Dispatch(bool wait) -> void
+	{
+		static constexpr auto kFenceTimeout = GLuint64(1'000'000'000); // 1s, in nanoseconds
+
+		auto nDispatched = 0;
+		while (!m_Pending.empty()) {
+			auto* slot = m_Pending.front();
+
+			auto status = glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? kFenceTimeout : 0);
+			while (wait && status == GL_TIMEOUT_EXPIRED) {
+				status = glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeout);
+			}
+			if (status == GL_TIMEOUT_EXPIRED) {
+				break;
+			}
+
+			glDeleteSync(slot->fence);
+			slot->fence = nullptr;
+			m_Pending.pop_front();
+
+			{
+				auto lock = std::scoped_lock(m_Mutex);
+				m_Queue.push_back(slot);
+			}
+			nDispatched++;
+		}
+
+		if (nDispatched > 0) {
+			m_CV.notify_one();
+		}
+	}
+
+	auto FrameCapturer::WorkerLoop(std::stop_token stopToken) -> void
+	{
+		while (true) {
+			auto lock = std::unique_lock(m_Mutex);
+			m_CV.wait(lock, stopToken, [this] { return !m_Queue.empty(); });
+			if (m_Queue.empty()) { // Stop requested, nothing left to deliver
+				return;
+			}
+
+			auto* slot = m_Queue.front();
+			m_Queue.pop_front();
+			lock.unlock();
+
+			auto capture = GFX::Renderer::FrameCapture{
+				.frame  = slot->frame,
+				.width  = slot->width,
+				.height = slot->height,
+				.pixels = std::vector<Byte>(std::size_t(I64(slot->width) * I64(slot->height) * kBytesPerPixel)),
+			};
+			std::memcpy(capture.pixels.data(), slot->buffer->Data(), capture.pixels.size());
+
+			auto callback = std::move(slot->callback);
+			slot->isBusy.store(false, std::memory_order_release);
+
+			callback(std::move(capture));
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#include "GFX/Platform/OpenGL/Objects/Buffer.hpp"
+
+#include "glad/gl.h"
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	Buffer::Buffer(I64 size) noexcept
+		: Object([] { GLID id; glCreateBuffers(1, &id); return id; }())
+		, m_Size(size)
+	{
+		glNamedBufferStorage(ID(), size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+
+	auto Buffer::Release(GLID& id) noexcept -> void
+	{
+		glDeleteBuffers(1, &id);
+		id = 0;
+	}
+
+	auto Buffer::Upload(const void* data, I64 size, I64 offset) noexcept -> void
+	{
+		glNamedBufferSubData(ID(), offset, size, data);
+	}
+
+	auto Buffer::CopyTo(const Buffer& target, I64 readOffset, I64 writeOffset, I64 size) const noexcept -> void
+	{
+		glCopyNamedBufferSubData(ID(), target.ID(), readOffset, writeOffset, size);
+	}
+}
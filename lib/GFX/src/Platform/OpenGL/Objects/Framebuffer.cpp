@@ -1,15 +1,26 @@
 #include "GFX/Platform/OpenGL/Objects/Framebuffer.hpp"
+#include "GFX/Platform/OpenGL/Objects/Texture.hpp"
 
 
 #include "Debug/Assert.hpp"
 
 namespace Gaze::GFX::Platform::OpenGL::Objects {
-	FramebufferAttachment::FramebufferAttachment(I32 width, I32 height)
-		: Object([] { GLID id; glCreateTextures(GL_TEXTURE_2D, 1, &id); return id; }())
+	FramebufferAttachment::FramebufferAttachment(I32 width, I32 height, I32 samples /*= 1*/)
+		: Object([samples] {
+			GLID id;
+			glCreateTextures(samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, 1, &id);
+			return id;
+		}())
 	{
+		// RGBA8 like the window's framebuffer: a multisample resolve blit needs matching formats
+		if (samples > 1) {
+			glTextureStorage2DMultisample(ID(), samples, GL_RGBA8, width, height, GL_TRUE);
+			return;
+		}
+
 		glTextureParameteri(ID(), GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTextureParameteri(ID(), GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTextureStorage2D(ID(), 1, GL_RGB8, width, height);
+		glTextureStorage2D(ID(), 1, GL_RGBA8, width, height);
 	}
 
 	auto FramebufferAttachment::Release(GLID& id) noexcept -> void
@@ -17,10 +28,14 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 		glDeleteTextures(1, &id);
 	}
 
-	Renderbuffer::Renderbuffer(I32 width, I32 height)
+	Renderbuffer::Renderbuffer(I32 width, I32 height, I32 samples /*= 1*/)
 		: Object([] { GLID id; glCreateRenderbuffers(1, &id); return id; }())
 	{
-		glNamedRenderbufferStorage(ID(), GL_DEPTH24_STENCIL8, width, height);
+		if (samples > 1) {
+			glNamedRenderbufferStorageMultisample(ID(), samples, GL_DEPTH24_STENCIL8, width, height);
+		} else {
+			glNamedRenderbufferStorage(ID(), GL_DEPTH24_STENCIL8, width, height);
+		}
 	}
 
 	auto Renderbuffer::Release(GLID& id) noexcept -> void
@@ -28,10 +43,13 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 		glDeleteRenderbuffers(1, &id);
 	}
 
-	Framebuffer::Framebuffer(I32 width, I32 height)
+	Framebuffer::Framebuffer(I32 width, I32 height, I32 samples /*= 1*/)
 		: Object([]{ GLID id; glCreateFramebuffers(1, &id); return id; }())
-		, m_ColorAttachment(width, height)
-		, m_DepthStencilAttachment(width, height)
+		, m_ColorAttachment(width, height, samples)
+		, m_DepthStencilAttachment(width, height, samples)
+		, m_Width(width)
+		, m_Height(height)
+		, m_Samples(samples)
 	{
 		glNamedFramebufferTexture(ID(), GL_COLOR_ATTACHMENT0, m_ColorAttachment.ID(), 0);
 		glNamedFramebufferRenderbuffer(ID(), GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilAttachment.ID());
@@ -50,8 +68,88 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 		glBindFramebuffer(GL_FRAMEBUFFER, ID());
 	}
 
+	auto Framebuffer::BlitTo(GLID target) const noexcept -> void
+	{
+		glBlitNamedFramebuffer(
+			ID(),
+			target,
+			0, 0, m_Width, m_Height,
+			0, 0, m_Width, m_Height,
+			GL_COLOR_BUFFER_BIT,
+			GL_NEAREST
+		);
+	}
+
 	auto Framebuffer::Unbind() noexcept -> void
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
+
+	DepthFramebuffer::DepthFramebuffer()
+		: Object([]{ GLID id; glCreateFramebuffers(1, &id); return id; }())
+	{
+		glNamedFramebufferDrawBuffer(ID(), GL_NONE);
+		glNamedFramebufferReadBuffer(ID(), GL_NONE);
+	}
+
+	auto DepthFramebuffer::Release(GLID& id) noexcept -> void
+	{
+		glDeleteFramebuffers(1, &id);
+		id = 0;
+	}
+
+	auto DepthFramebuffer::AttachLayer(const Texture& texture, I32 layer) noexcept -> void
+	{
+		GAZE_ASSERT(layer >= 0 && layer < texture.Layers(), "Layer out of range");
+
+		glNamedFramebufferTextureLayer(ID(), GL_DEPTH_ATTACHMENT, texture.ID(), 0, layer);
+	}
+
+	LayerFramebuffer::LayerFramebuffer(I32 width, I32 height)
+		: Object([]{ GLID id; glCreateFramebuffers(1, &id); return id; }())
+		, m_DepthStencilAttachment(width, height)
+	{
+		glNamedFramebufferRenderbuffer(ID(), GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilAttachment.ID());
+	}
+
+	auto LayerFramebuffer::Release(GLID& id) noexcept -> void
+	{
+		glDeleteFramebuffers(1, &id);
+		id = 0;
+	}
+
+	auto LayerFramebuffer::AttachLayer(const Texture& texture, I32 layer) noexcept -> void
+	{
+		GAZE_ASSERT(layer >= 0 && layer < texture.Layers(), "Layer out of range");
+
+		glNamedFramebufferTextureLayer(ID(), GL_COLOR_ATTACHMENT0, texture.ID(), 0, layer);
+		GAZE_ASSERT(glCheckNamedFramebufferStatus(ID(), GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer incomplete");
+	}
+
+	TextureFramebuffer::TextureFramebuffer()
+		: Object([]{ GLID id; glCreateFramebuffers(1, &id); return id; }())
+	{
+	}
+
+	auto TextureFramebuffer::Release(GLID& id) noexcept -> void
+	{
+		glDeleteFramebuffers(1, &id);
+		id = 0;
+	}
+
+	auto TextureFramebuffer::Attach(GLenum attachment, const Texture& texture) noexcept -> void
+	{
+		glNamedFramebufferTexture(ID(), attachment, texture.ID(), 0);
+	}
+
+	auto TextureFramebuffer::Attach(GLenum attachment, const Renderbuffer& renderbuffer) noexcept -> void
+	{
+		glNamedFramebufferRenderbuffer(ID(), attachment, GL_RENDERBUFFER, renderbuffer.ID());
+	}
+
+	auto TextureFramebuffer::SetDrawBuffers(std::initializer_list<GLenum> attachments) noexcept -> void
+	{
+		glNamedFramebufferDrawBuffers(ID(), GLsizei(attachments.size()), attachments.begin());
+		GAZE_ASSERT(glCheckNamedFramebufferStatus(ID(), GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer incomplete");
+	}
 }
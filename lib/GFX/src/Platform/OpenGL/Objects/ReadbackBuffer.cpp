@@ -0,0 +1,25 @@
+#include "GFX/Platform/OpenGL/Objects/ReadbackBuffer.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	static constexpr auto kMapFlags = GLbitfield(GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+	ReadbackBuffer::ReadbackBuffer(I64 size) noexcept
+		: Object([] { GLID id; glCreateBuffers(1, &id); return id; }())
+		, m_Mapping(nullptr)
+		, m_Size(size)
+	{
+		GAZE_ASSERT(size > 0, "Size must be positive");
+
+		glNamedBufferStorage(ID(), size, nullptr, kMapFlags);
+		m_Mapping = static_cast<const Byte*>(glMapNamedBufferRange(ID(), 0, size, kMapFlags));
+
+		GAZE_ASSERT(m_Mapping != nullptr, "Failed to map readback buffer");
+	}
+
+	auto ReadbackBuffer::Release(GLID& id) noexcept -> void
+	{
+		// Deleting the buffer implicitly unmaps it
+		glDeleteBuffers(1, &id);
+		id = 0;
+	}
+}
@@ -128,6 +128,18 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 		return true;
 	}
 
+	auto ShaderProgram::UploadUniform2FV(const std::string& name, const float vec[2]) noexcept -> bool
+	{
+		const auto location = RetreiveUniformLocation(name);
+		if (location == -1) {
+			return false;
+		}
+
+		glProgramUniform2fv(ID(), location, 1, vec);
+
+		return true;
+	}
+
 	auto ShaderProgram::UploadUniform3FV(const std::string& name, const float vec[3]) noexcept -> bool
 	{
 		const auto location = RetreiveUniformLocation(name);
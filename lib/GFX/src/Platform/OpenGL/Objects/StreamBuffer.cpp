@@ -0,0 +1,70 @@
+#include "GFX/Platform/OpenGL/Objects/StreamBuffer.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	static constexpr auto kMapFlags = GLbitfield(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+	StreamBuffer::StreamBuffer(I64 regionSize, I32 nRegions /*= 3*/) noexcept
+		: Object([] { GLID id; glCreateBuffers(1, &id); return id; }())
+		, m_Mapping(nullptr)
+		, m_RegionSize(regionSize)
+		, m_Cursor(0)
+		, m_Region(0)
+		, m_Fences(std::size_t(nRegions), nullptr)
+	{
+		GAZE_ASSERT(regionSize > 0, "Region size must be positive");
+		GAZE_ASSERT(nRegions > 0, "At least one region is required");
+
+		const auto size = regionSize * nRegions;
+		glNamedBufferStorage(ID(), size, nullptr, kMapFlags);
+		m_Mapping = static_cast<Byte*>(glMapNamedBufferRange(ID(), 0, size, kMapFlags));
+
+		GAZE_ASSERT(m_Mapping != nullptr, "Failed to map stream buffer");
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		for (auto fence : m_Fences) {
+			if (fence != nullptr) {
+				glDeleteSync(fence);
+			}
+		}
+	}
+
+	auto StreamBuffer::Release(GLID& id) noexcept -> void
+	{
+		// Deleting the buffer implicitly unmaps it
+		glDeleteBuffers(1, &id);
+		id = 0;
+	}
+
+	auto StreamBuffer::Allocate(I64 size, I64 alignment) noexcept -> std::optional<Allocation>
+	{
+		const auto regionBase = I64(m_Region) * m_RegionSize;
+		const auto aligned    = ((regionBase + m_Cursor + alignment - 1) / alignment) * alignment - regionBase;
+
+		if (aligned + size > m_RegionSize) {
+			return std::nullopt;
+		}
+
+		m_Cursor = aligned + size;
+
+		return Allocation{ m_Mapping + regionBase + aligned, regionBase + aligned };
+	}
+
+	auto StreamBuffer::EndFrame() noexcept -> void
+	{
+		static constexpr auto kFenceTimeout = GLuint64(1'000'000'000); // 1s, in nanoseconds
+
+		m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_Region = (m_Region + 1) % m_Fences.size();
+		m_Cursor = 0;
+
+		if (auto& fence = m_Fences[m_Region]; fence != nullptr) {
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeout) == GL_TIMEOUT_EXPIRED) {
+			}
+
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#include "GFX/Platform/OpenGL/Objects/Texture.hpp"
+
+#include <algorithm>
+
+namespace Gaze::GFX::Platform::OpenGL::Objects {
+	Texture::Texture(I32 width, I32 height, GLenum internalFormat, I32 levels /*= 1*/) noexcept
+		: Object([] { GLID id; glCreateTextures(GL_TEXTURE_2D, 1, &id); return id; }())
+		, m_Width(width)
+		, m_Height(height)
+		, m_Layers(1)
+		, m_Target(GL_TEXTURE_2D)
+		, m_InternalFormat(internalFormat)
+	{
+		GAZE_ASSERT(width > 0 && height > 0 && levels > 0, "Invalid texture dimensions");
+
+		glTextureStorage2D(ID(), levels, internalFormat, width, height);
+	}
+
+	Texture::Texture(GLenum target, I32 width, I32 height, I32 layers, GLenum internalFormat, I32 levels /*= 1*/) noexcept
+		: Object([target] { GLID id; glCreateTextures(target, 1, &id); return id; }())
+		, m_Width(width)
+		, m_Height(height)
+		, m_Layers(layers)
+		, m_Target(target)
+		, m_InternalFormat(internalFormat)
+	{
+		GAZE_ASSERT(width > 0 && height > 0 && layers > 0 && levels > 0, "Invalid texture dimensions");
+		GAZE_ASSERT(target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY, "Unsupported texture target");
+		GAZE_ASSERT(target != GL_TEXTURE_CUBE_MAP_ARRAY || layers % 6 == 0, "Cube map arrays have six layers per cube");
+
+		glTextureStorage3D(ID(), levels, internalFormat, width, height, layers);
+	}
+
+	auto Texture::Release(GLID& id) noexcept -> void
+	{
+		glDeleteTextures(1, &id);
+	}
+
+	auto Texture::Upload(I32 level, GLenum format, GLenum type, const void* pixels) noexcept -> void
+	{
+		const auto width  = std::max(m_Width >> level, 1);
+		const auto height = std::max(m_Height >> level, 1);
+
+		// Rows of single-byte formats are not 4-byte aligned in general
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(ID(), level, 0, 0, width, height, format, type, pixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	auto Texture::UploadCompressed(I32 level, I32 layer, std::span<const std::byte> blocks) noexcept -> void
+	{
+		GAZE_ASSERT(layer >= 0 && layer < m_Layers, "Texture layer out of range");
+
+		const auto width  = std::max(m_Width >> level, 1);
+		const auto height = std::max(m_Height >> level, 1);
+
+		if (m_Target == GL_TEXTURE_2D) {
+			glCompressedTextureSubImage2D(ID(), level, 0, 0, width, height, m_InternalFormat, GLsizei(blocks.size()), blocks.data());
+		} else {
+			glCompressedTextureSubImage3D(ID(), level, 0, 0, layer, width, height, 1, m_InternalFormat, GLsizei(blocks.size()), blocks.data());
+		}
+	}
+
+	auto Texture::SetFilter(GLenum minFilter, GLenum magFilter) noexcept -> void
+	{
+		glTextureParameteri(ID(), GL_TEXTURE_MIN_FILTER, GLint(minFilter));
+		glTextureParameteri(ID(), GL_TEXTURE_MAG_FILTER, GLint(magFilter));
+	}
+
+	auto Texture::SetWrap(GLenum wrap) noexcept -> void
+	{
+		glTextureParameteri(ID(), GL_TEXTURE_WRAP_S, GLint(wrap));
+		glTextureParameteri(ID(), GL_TEXTURE_WRAP_T, GLint(wrap));
+	}
+
+	auto Texture::SetSwizzle(GLenum r, GLenum g, GLenum b, GLenum a) noexcept -> void
+	{
+		const GLint swizzle[] = { GLint(r), GLint(g), GLint(b), GLint(a) };
+		glTextureParameteriv(ID(), GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+	}
+
+	auto Texture::SetCompare(GLenum func) noexcept -> void
+	{
+		glTextureParameteri(ID(), GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTextureParameteri(ID(), GL_TEXTURE_COMPARE_FUNC, GLint(func));
+	}
+
+	auto Texture::GenerateMipmaps() noexcept -> void
+	{
+		glGenerateTextureMipmap(ID());
+	}
+}
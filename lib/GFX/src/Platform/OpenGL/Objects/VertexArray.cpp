@@ -36,13 +36,16 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 		using DataType = VertexArray::Layout::DataType;
 
 		switch (type) {
-		case DataType::Byte:      return GL_BYTE;
-		case DataType::Short:     return GL_SHORT;
-		case DataType::Int:       return GL_INT;
-		case DataType::Fixed:     return GL_FIXED;
-		case DataType::Float:     return GL_FLOAT;
-		case DataType::HalfFloat: return GL_HALF_FLOAT;
-		case DataType::Double:    return GL_DOUBLE;
+		case DataType::Byte:          return GL_BYTE;
+		case DataType::UnsignedByte:  return GL_UNSIGNED_BYTE;
+		case DataType::Short:         return GL_SHORT;
+		case DataType::UnsignedShort: return GL_UNSIGNED_SHORT;
+		case DataType::Int:           return GL_INT;
+		case DataType::UnsignedInt:   return GL_UNSIGNED_INT;
+		case DataType::Fixed:         return GL_FIXED;
+		case DataType::Float:         return GL_FLOAT;
+		case DataType::HalfFloat:     return GL_HALF_FLOAT;
+		case DataType::Double:        return GL_DOUBLE;
 		}
 
 		GAZE_UNREACHABLE();
@@ -52,14 +55,24 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 	{
 		for (auto i = 0UL; i < layout.size(); i++) {
 			const auto& elem = *(layout.begin() + i);
-			glVertexArrayAttribFormat(
-				ID(),
-				GLuint(i),
-				elem.componentCount.Value(),
-				ToOpenGLType(elem.type),
-				elem.normalized.Value() ? GL_TRUE : GL_FALSE,
-				elem.relativeOffset.Value()
-			);
+			if (elem.integer.Value()) {
+				glVertexArrayAttribIFormat(
+					ID(),
+					GLuint(i),
+					elem.componentCount.Value(),
+					ToOpenGLType(elem.type),
+					elem.relativeOffset.Value()
+				);
+			} else {
+				glVertexArrayAttribFormat(
+					ID(),
+					GLuint(i),
+					elem.componentCount.Value(),
+					ToOpenGLType(elem.type),
+					elem.normalized.Value() ? GL_TRUE : GL_FALSE,
+					elem.relativeOffset.Value()
+				);
+			}
 			glEnableVertexArrayAttrib(ID(), GLuint(i));
 			glVertexArrayAttribBinding(ID(), GLuint(i), elem.bufferBinding.Value());
 		}
@@ -69,4 +82,9 @@ namespace Gaze::GFX::Platform::OpenGL::Objects {
 	{
 		glVertexArrayElementBuffer(ID(), buffer->ID());
 	}
+
+	auto VertexArray::SetBindingDivisor(BufferBinding binding, U32 divisor) noexcept -> void
+	{
+		glVertexArrayBindingDivisor(ID(), binding.Value(), divisor);
+	}
 }
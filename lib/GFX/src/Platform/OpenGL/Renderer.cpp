@@ -1,13 +1,30 @@
 #include "GFX/Platform/OpenGL/Renderer.hpp"
+#include "GFX/Platform/OpenGL/BufferHeap.hpp"
+#include "GFX/Platform/OpenGL/FrameCapturer.hpp"
+#include "GFX/Platform/OpenGL/ShaderPermutations.hpp"
+#include "GFX/Platform/OpenGL/StateCache.hpp"
 
 #include "GFX/Platform/OpenGL/Objects/Framebuffer.hpp"
 #include "GFX/Platform/OpenGL/Objects/IndexBuffer.hpp"
 #include "GFX/Platform/OpenGL/Objects/Object.hpp"
 #include "GFX/Platform/OpenGL/Objects/Shader.hpp"
+#include "GFX/Platform/OpenGL/Objects/StreamBuffer.hpp"
+#include "GFX/Platform/OpenGL/Objects/Texture.hpp"
 #include "GFX/Platform/OpenGL/Objects/VertexBuffer.hpp"
 #include "GFX/Platform/OpenGL/Objects/VertexArray.hpp"
 
+#include "GFX/Bounds.hpp"
+#include "GFX/ImpostorAtlas.hpp"
 #include "GFX/Light.hpp"
+#include "GFX/LightSelector.hpp"
+#include "GFX/LightVolumes.hpp"
+#include "GFX/MultiDraw.hpp"
+#include "GFX/ShadowCache.hpp"
+#include "GFX/Skinning.hpp"
+#include "GFX/StaticBatcher.hpp"
+#include "GFX/TextureArrays.hpp"
+
+#include "Jobs/ThreadPool.hpp"
 
 #include "Log/Logger.hpp"
 
@@ -15,7 +32,16 @@
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <deque>
 #include <format>
+#include <numeric>
+#include <optional>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 
@@ -94,401 +120,4186 @@ namespace Gaze::GFX::Platform::OpenGL {
 
 	static constexpr auto kMaxLights = 8;
 
+	/**
+	 * @brief The stride of the vertices in the mesh heaps and the skinned stream.
+	 */
+	static constexpr auto kVertexSize = I32(Geometry::Mesh::kVertexSize);
+
+	/**
+	 * @brief Where the skinning of a section comes from.
+	 */
+	enum class SkinSource : U8
+	{
+		None, /**< Rigid */
+		GPU,  /**< Skin weights in the skin heap, joint matrices in the palette stream */
+		CPU,  /**< Vertices skinned before the draw into the skinned vertex stream */
+	};
+
+	struct SkinSection
+	{
+		SkinSource source;
+		I32        offset;        /**< GPU: of the skin weights in their heap page. CPU: of the skinned vertices in their stream */
+		U32        page;          /**< GPU: heap page of the skin weights */
+		I64        paletteOffset; /**< GPU: of the joint matrices in the palette stream */
+		I64        paletteSize;
+	};
+
 	struct BufferSection
 	{
 		I32 offset;
 		I32 size;
+		U32 page;
 
 		Renderer::PrimitiveMode mode;
 		Object::Properties      properties;
 		Light                   lights[kMaxLights];
 		I32                     nLights;
+		SkinSection             skin;
+		AABB                    bounds;  /**< World space, of the whole object */
+		F32                     fade;    /**< Below 1 while cross-fading into an impostor: the share of pixels drawn */
+		U32                     texture; /**< The material's, packed, see PackTexture(); 0 if untextured or not resident yet */
 	};
 
-	struct ScreenQuadVertex
+	/**
+	 * @brief Where a primitive of a resident mesh lives in the mesh heaps.
+	 */
+	struct ResidentPrimitive
 	{
-		float x, y, z;
-		float u, v;
+		BufferHeap::Allocation                vertices;
+		BufferHeap::Allocation                indices;
+		std::optional<BufferHeap::Allocation> skin; /**< Skinned primitives only */
+		I32                                   vertexSize;
+		I32                                   indexSize;
+		std::size_t                           index; /**< In the mesh's primitives, which may include empty ones */
 	};
 
-	struct Renderer::Impl
+	/**
+	 * @brief A primitive to skin on the CPU before the next draw.
+	 */
+	struct SkinJob
 	{
-		Objects::VertexArray                 vertexArray;
-		Objects::VertexArray                 screenVA;
-		Objects::VertexBuffer                screenVB;
-		Objects::IndexBuffer                 screenIB;
-		Objects::ShaderProgram               program;
-		Objects::ShaderProgram               screenProgram;
-		Objects::VertexBuffer                vertexBuf;
-		Objects::IndexBuffer                 indexBuf;
-		Objects::Framebuffer                 framebuffer;
-		std::vector<BufferSection>           vertexBufSects;
-		std::vector<BufferSection>::iterator vertexBufSectsCursor;
-		std::vector<BufferSection>           indexBufSects;
-		std::vector<BufferSection>::iterator indexBufSectsCursor;
-		Shared<Camera>                       camera;
-		RenderStats                          stats;
-		RenderStats                          statsCurrent;
-		Log::Logger                          logger;
+		Geometry::MeshHandle mesh;      /**< Keeps the bind pose alive until the flush */
+		std::size_t          primitive;
+		std::size_t          palette;   /**< Index of the first joint matrix in Impl::cpuPalettes */
+		std::size_t          nJoints;
+		Geometry::Vertex*    out;       /**< Into the skinned vertex stream */
 	};
 
-	static constexpr auto kStaticBufferSize = 8 * 1024 * 1024; // 8 MiB
+	/**
+	 * @brief Particles written to the particle stream, drawn in Render().
+	 */
+	struct ParticleDraw
+	{
+		I64 first; /**< Index of the first instance in the stream */
+		I64 count;
+	};
 
-	Renderer::Renderer(Shared<WM::Window> window) noexcept
-		: GFX::Renderer(std::move(window))
-		, m_pImpl(nullptr)
+	struct ResidentMesh
 	{
-		auto* oldCurrentContext = glfwGetCurrentContext();
-		glfwMakeContextCurrent(static_cast<GLFWwindow*>(Window().Handle()));
+		std::weak_ptr<const Geometry::Mesh> mesh; /**< Expires when the last handle goes away */
+		std::vector<ResidentPrimitive>      primitives;
+		AABB                                bounds;   /**< Model space, for light selection */
+		std::optional<I32>                  impostor; /**< Slot in the impostor atlas, once an instance needed one */
+		bool                                impostorBaked;
+		std::size_t                         nJoints;  /**< Palette size the skin weights need: highest joint index + 1 */
+	};
 
-		gladLoadGL(static_cast<GLADloadfunc>(glfwGetProcAddress));
+	/**
+	 * @brief Per-draw data of the vertex pulling path, laid out as the DrawRecord SSBO element (std430).
+	 *
+	 * Vertex and index offsets are in elements of the heap page bound as
+	 * storage buffer, which is read as plain floats and indices, so any
+	 * vertex layout can be described with a stride and attribute offsets.
+	 */
+	struct PulledDraw
+	{
+		struct PackedLight
+		{
+			glm::vec4 position; /**< w: ambient coefficient */
+			glm::vec4 diffuse;  /**< w: attenuation */
+		};
 
-#ifndef NDEBUG
-		EnableDebugOutput();
-#endif
+		glm::mat4   model;
+		glm::vec4   diffuse;      /**< w: shininess */
+		glm::vec4   specular;     /**< w: fade, see BufferSection::fade */
+		U32         vertexOffset;
+		U32         vertexStride;
+		U32         normalOffset; /**< Relative to the vertex */
+		U32         indexOffset;
+		I32         nLights;
+		U32         lightFlags;   /**< 4 bits per light, see PackLightFlags() */
+		U32         uvOffset;     /**< Relative to the vertex */
+		U32         texture;      /**< See PackTexture() */
+		PackedLight lights[kMaxLights];
+	};
+	static_assert(sizeof(PulledDraw) == 384, "PulledDraw must match the std430 layout of DrawRecord");
 
-		const auto* vertexSource = R"(
-			#version 330 core
-			layout (location = 0) in vec3 a_Position;
-			layout (location = 1) in vec3 a_Normal;
+	struct DrawArraysIndirectCommand
+	{
+		U32 count;
+		U32 instanceCount;
+		U32 first;
+		U32 baseInstance;
+	};
 
-			uniform mat4 u_model;
-			uniform mat4 u_vp;
+	struct DrawElementsIndirectCommand
+	{
+		U32 count;
+		U32 instanceCount;
+		U32 firstIndex;
+		I32 baseVertex;
+		U32 baseInstance;
+	};
 
-			out vec3 normal;
-			out vec3 surfacePos;
+	/**
+	 * @brief The GPU copy of a terrain: a vertex slot per resident tile, and the chunk index lists shared by every tile.
+	 */
+	struct TerrainResources
+	{
+		struct IndexRange
+		{
+			U32 first;
+			U32 count;
+		};
 
-			void main()
-			{
-				gl_Position = u_vp * u_model * vec4(a_Position, 1.0);
+		I32                     tileResolution;
+		I32                     chunkResolution;
+		I32                     maxResidentTiles;
+		Objects::VertexArray    vertexArray;
+		Objects::VertexBuffer   vertices;
+		Objects::IndexBuffer    indices;
+		std::vector<IndexRange> ranges;       /**< By lod * Terrain::kStitchVariants + stitches */
+		std::vector<U64>        slotVersions; /**< Of the tile uploaded to each slot, 0 for none */
+	};
 
-				normal = a_Normal;
-				surfacePos = vec3(u_model * vec4(a_Position, 1.0));
-			}
-		)";
-		const auto* fragmentSource = R"(
-			#version 330 core
+	/**
+	 * @brief Terrain chunks written to the indirect stream, drawn with the objects.
+	 */
+	struct TerrainDraw
+	{
+		I64      commandOffset; /**< In the indirect stream */
+		I64      count;
+		Material material;
+		Light    lights[kMaxLights];
+		I32      nLights;
+	};
 
-			struct Material
-			{
-				vec3 diffuse;
-				vec3 specular;
-				float shininess;
-			};
+	/**
+	 * @brief A billboard standing in for an instance, laid out as the ImpostorInstance SSBO element (std430).
+	 */
+	struct ImpostorInstance
+	{
+		glm::vec4 center; /**< w: the impostor's share of the cross-fade */
+		glm::vec4 right;  /**< Scaled to half the quad's width. w: atlas layer */
+		glm::vec4 up;     /**< Scaled to half the quad's height */
+		glm::vec4 cell;   /**< xy: texture coordinates of the cell's corner, zw: its size */
+	};
 
-			struct Light
-			{
-				vec3 position;
-				vec3 diffuse;
-				float ambientCoefficient;
-				float attenuation;
-			};
-			const int kMaxLights = 8;
+	/**
+	 * @brief An impostor submitted since the last flush, drawn with the objects.
+	 */
+	struct ImpostorDraw
+	{
+		glm::mat4        model;
+		Material         material;
+		Light            lights[kMaxLights];
+		I32              nLights;
+		ImpostorInstance instance;
+	};
 
-			out vec4 FragColor;
+	/**
+	 * @brief The impostor atlas, and the meshes waiting to be rendered into it.
+	 */
+	struct ImpostorResources
+	{
+		ImpostorAtlas                 atlas;
+		Objects::Texture              texture;     /**< A layer per slot. rgb: model space normals, a: coverage */
+		Objects::LayerFramebuffer     framebuffer;
+		Objects::ShaderProgram        bakeProgram;
+		std::vector<Geometry::MeshID> pending;     /**< Meshes with a slot, not baked yet */
+		std::vector<ImpostorDraw>     draws;
+	};
 
-			uniform Material u_Material;
-			uniform Light u_Light;
-			uniform Light u_Lights[kMaxLights];
-			uniform int u_nLights;
-			uniform vec3 u_ViewPos;
+	/**
+	 * @brief The visibility buffer: per pixel, the draw and triangle covering it, and their depth.
+	 */
+	struct VisibilityResources
+	{
+		Objects::ShaderProgram      program;     /**< Rasterizes pulled triangles into the buffer */
+		Objects::Texture            ids;         /**< x: draw + 1, 0 for none. y: triangle in the draw */
+		Objects::Texture            depth;
+		Objects::TextureFramebuffer framebuffer;
+		std::vector<std::size_t>    sections;    /**< Scratch: the sections shaded from the buffer, by heap pages */
+		std::vector<std::size_t>    groupEnds;   /**< Scratch: where each run of sections pulled from the same pages ends */
+		std::vector<MultiDraw>      multiDraws;  /**< Scratch: the visibility pass's multi-draws */
+	};
 
-			in vec3 normal;
-			in vec3 surfacePos;
+	/**
+	 * @brief The G-buffer, the light accumulation buffer, and the programs that aren't mesh shader variants.
+	 */
+	struct DeferredResources
+	{
+		Objects::ShaderProgram      stencilProgram;   /**< Marks the pixels inside a light volume */
+		Objects::ShaderProgram      compositeProgram; /**< Adds the ambient term and applies gamma */
+		Objects::Texture            albedo;           /**< a: 1 if lit, 0 if the albedo is the final color */
+		Objects::Texture            normals;
+		Objects::Texture            specular;         /**< a: shininess / 256 */
+		Objects::Texture            depth;            /**< With the stencil, unused by the G-buffer pass */
+		Objects::Texture            light;            /**< The lights' diffuse and specular terms, summed */
+		Objects::Renderbuffer       lightDepth;       /**< A copy of the G-buffer's, tested and stenciled against */
+		Objects::TextureFramebuffer gbuffer;
+		Objects::TextureFramebuffer lightBuffer;
+		LightVolumes                volumes;
+	};
 
-			vec3 ComputeLight(Light light, vec3 normal, vec3 surfacePos, vec3 surfaceToView)
-			{
-				vec3 surfaceToLight = normalize(light.position - surfacePos);
-				float diffuseCoefficient = max(dot(normal, surfaceToLight), 0.0);
-				vec3 diffuse = diffuseCoefficient * u_Material.diffuse * light.diffuse;
+	static constexpr auto kPullVertexBinding = 0U;
+	static constexpr auto kPullIndexBinding  = 1U;
+	static constexpr auto kPullDrawBinding   = 2U;
+	static constexpr auto kPaletteBinding    = 3U;
+	static constexpr auto kImpostorBinding   = 4U;
+	static constexpr auto kMaxPulledDraws    = std::size_t(4096); /**< Per multi-draw, bounded by the draw ID buffer */
 
-				vec3 specular = vec3(0);
-				if (diffuseCoefficient > 0) {
-					float specularCoefficient = pow(max(0.0, dot(surfaceToView, reflect(-surfaceToLight, normal))), u_Material.shininess);
-					specular = specularCoefficient * u_Material.specular * light.diffuse;
-				}
+	static constexpr auto kCascadeTextureUnit     = 1U;
+	static constexpr auto kPointShadowTextureUnit = 2U;
+	static constexpr auto kImpostorTextureUnit    = 3U;
+	static constexpr auto kVisibilityTextureUnit  = 4U;
+	static constexpr auto kVisibilityDepthUnit    = 5U;
+	static constexpr auto kGAlbedoTextureUnit     = 6U;
+	static constexpr auto kGNormalTextureUnit     = 7U;
+	static constexpr auto kGSpecularTextureUnit   = 8U;
+	static constexpr auto kGDepthTextureUnit      = 9U;
+	static constexpr auto kLightTextureUnit       = 10U;
+	static constexpr auto kMaterialTextureUnit    = 11U; /**< The first of TextureArrays::kMaxArrays */
+
+	/**
+	 * @brief Get the size of a window's default framebuffer, in pixels.
+	 *
+	 * On HiDPI displays it is larger than the window, which is measured in screen coordinates.
+	 */
+	static auto FramebufferSize(const WM::Window& window) noexcept -> glm::ivec2
+	{
+		auto size = glm::ivec2();
+		glfwGetFramebufferSize(static_cast<GLFWwindow*>(window.Handle()), &size.x, &size.y);
 
-				vec3 ambient = light.ambientCoefficient * light.diffuse * u_Material.diffuse.rgb;
-				float attenuation = 1.0 / (1.0 + light.attenuation * pow(length(light.position - surfacePos), 2));
+		return size;
+	}
 
-				return ambient + attenuation * (diffuse + specular);
-			}
+	/**
+	 * @brief Check whether a projection matrix is a perspective one.
+	 *
+	 * Perspective projections carry the view depth into w, orthographic ones leave w at 1.
+	 */
+	static auto IsPerspective(const glm::mat4& projection) noexcept -> bool
+	{
+		return std::abs(projection[2][3]) > 0.F;
+	}
+
+	/**
+	 * @brief Compute how many pixels a sphere spans on screen, vertically.
+	 *
+	 * Orthographic projections keep sizes at any distance.
+	 */
+	static auto ProjectedSize(const Camera& camera, glm::vec3 center, F32 radius, F32 viewportHeight) noexcept -> F32
+	{
+		const auto projection = camera.ComputeProjectionMatrix();
+
+		return IsPerspective(projection)
+			? ImpostorAtlas::ScreenSize(radius, glm::distance(camera.Position(), center), projection[1][1], viewportHeight)
+			: radius * projection[1][1] * viewportHeight;
+	}
+
+	/**
+	 * @brief Round a light count up to the nearest mesh shader variant: 0 (unlit), 1, 2, 4 or 8.
+	 */
+	static auto LightBucket(I32 nLights) noexcept -> I32
+	{
+		auto bucket = 0;
+		while (bucket < std::min(nLights, kMaxLights)) {
+			bucket = bucket == 0 ? 1 : bucket * 2;
+		}
+
+		return bucket;
+	}
+
+	/**
+	 * @brief Whether a material needs the specular term; black specular contributes nothing.
+	 */
+	static auto NeedsSpecular(const Material& material) noexcept -> bool
+	{
+		return material.specular != glm::vec3(0.F);
+	}
+
+	/**
+	 * @brief What lights scenes without any lights: white, from the origin.
+	 */
+	static auto DefaultLight() noexcept -> Light
+	{
+		return Light {
+			.position           = { 0.F, 0.F, 0.F },
+			.direction          = {},
+			.diffuse            = { 1.F, 1.F, 1.F },
+			.ambientCoefficient = 1.F,
+			.attenuation        = 1.F
+		};
+	}
+
+	/**
+	 * @brief Set by UseMeshShader() on lit variants while shadows are enabled.
+	 */
+	static constexpr auto kShadowsKeyBit = 1U << 7;
+
+	/**
+	 * @brief Set on mesh shader variants sampling their material's texture.
+	 */
+	static constexpr auto kTexturedKeyBit = 1U << 10;
+
+	/**
+	 * @brief Set on mesh shader variants drawing instances of one primitive, each with its own draw record.
+	 */
+	static constexpr auto kInstancedKeyBit = 1U << 11;
+
+	/**
+	 * @brief Pack the features of a mesh shader variant: light bucket in bits 0-3, then specular, vertex pulling, skinning and, past the shadows bit, fading, texturing and instancing.
+	 */
+	static auto MeshShaderKey(
+		I32 maxLights,
+		bool specular,
+		bool vertexPulling,
+		bool skinning = false,
+		bool fade = false,
+		bool textured = false,
+		bool instanced = false
+	) noexcept -> ShaderPermutations::Key
+	{
+		return ShaderPermutations::Key(maxLights) |
+			(specular ? 1U << 4 : 0U) |
+			(vertexPulling ? 1U << 5 : 0U) |
+			(skinning ? 1U << 6 : 0U) |
+			(fade ? 1U << 8 : 0U) |
+			(textured ? kTexturedKeyBit : 0U) |
+			(instanced ? kInstancedKeyBit : 0U);
+	}
+
+	static auto MeshShaderDefines(ShaderPermutations::Key key) -> std::string
+	{
+		auto defines = std::format("#define MAX_LIGHTS {}\n", key & 0xFU);
+		if ((key & (1U << 4)) != 0) {
+			defines += "#define SPECULAR\n";
+		}
+		if ((key & (1U << 5)) != 0) {
+			defines += "#define VERTEX_PULLING\n";
+		}
+		if ((key & (1U << 6)) != 0) {
+			defines += "#define SKINNING\n";
+		}
+		if ((key & (1U << 8)) != 0) {
+			defines += "#define FADE\n";
+		}
+		if ((key & kTexturedKeyBit) != 0) {
+			defines += std::format("#define TEXTURED\n#define MAX_TEXTURE_ARRAYS {}\n", TextureArrays::kMaxArrays);
+		}
+		if ((key & kInstancedKeyBit) != 0) {
+			defines += "#define INSTANCED\n";
+		}
+		if ((key & kShadowsKeyBit) != 0) {
+			defines += std::format(
+				"#define SHADOWS\n#define MAX_CASCADES {}\n#define MAX_POINT_SHADOWS {}\n#define CASCADED {}\n",
+				ShadowCache::kMaxCascades,
+				ShadowCache::kMaxPointLights,
+				ShadowCache::kCascaded
+			);
+		}
+
+		return defines;
+	}
+
+	/**
+	 * @brief The impostor shaders: the pulled mesh fragment shader, reading its normals from the atlas.
+	 */
+	static auto ImpostorShaderDefines(ShaderPermutations::Key key) -> std::string
+	{
+		return MeshShaderDefines(key) + "#define IMPOSTOR\n";
+	}
+
+	/**
+	 * @brief The visibility resolve shaders: the pulled mesh fragment shader, reading its surface from the visibility buffer.
+	 */
+	static auto VisibilityShaderDefines(ShaderPermutations::Key key) -> std::string
+	{
+		return MeshShaderDefines(key) + "#define VISIBILITY\n";
+	}
+
+	/**
+	 * @brief The G-buffer shaders: the mesh shaders, writing the surface instead of lighting it.
+	 */
+	static auto GBufferShaderDefines(ShaderPermutations::Key key) -> std::string
+	{
+		return MeshShaderDefines(key) + "#define GBUFFER\n";
+	}
+
+	/**
+	 * @brief Set on light shader variants drawing a full-screen triangle rather than a sphere.
+	 */
+	static constexpr auto kFullScreenKeyBit = 1U << 9;
+
+	/**
+	 * @brief The deferred light shaders: the mesh fragment shader, reading its surface from the G-buffer.
+	 */
+	static auto LightShaderDefines(ShaderPermutations::Key key) -> std::string
+	{
+		auto defines = MeshShaderDefines(key) + "#define DEFERRED\n";
+		if ((key & kFullScreenKeyBit) != 0) {
+			defines += "#define FULL_SCREEN\n";
+		}
+
+		return defines;
+	}
+
+	/**
+	 * @brief Whether a section is shaded from the visibility buffer: rigid, opaque triangles.
+	 */
+	static auto IsVisibilityResolved(const BufferSection& sect) noexcept -> bool
+	{
+		return sect.skin.source == SkinSource::None && sect.mode == Renderer::PrimitiveMode::Triangles && sect.fade >= 1.F;
+	}
+
+	// S3TC is an extension, which the GL headers leave out, although every desktop driver has it
+	static constexpr auto kCompressedRGBAS3TCDXT1      = GLenum(0x83F1);
+	static constexpr auto kCompressedRGBAS3TCDXT5      = GLenum(0x83F3);
+	static constexpr auto kCompressedSRGBAlphaS3TCDXT1 = GLenum(0x8C4D);
+	static constexpr auto kCompressedSRGBAlphaS3TCDXT5 = GLenum(0x8C4F);
+
+	static auto ToGLInternalFormat(TextureImage::Format format, bool isSRGB) noexcept -> GLenum
+	{
+		switch (format) {
+		case TextureImage::Format::BC1: return isSRGB ? kCompressedSRGBAlphaS3TCDXT1 : kCompressedRGBAS3TCDXT1;
+		case TextureImage::Format::BC3: return isSRGB ? kCompressedSRGBAlphaS3TCDXT5 : kCompressedRGBAS3TCDXT5;
+		case TextureImage::Format::BC5: return GL_COMPRESSED_RG_RGTC2;
+		case TextureImage::Format::BC7: return isSRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+
+		GAZE_UNREACHABLE();
+	}
+
+	/**
+	 * @brief Pack where the mesh shaders sample a texture: bits 0-3 its array + 1, bits 4-11 its layer, bits 12-15 its finest resident level.
+	 */
+	static auto PackTexture(const TextureArrays::Residency& residency) noexcept -> U32
+	{
+		static_assert(TextureArrays::kMaxArrays < 16 && TextureArrays::kLayersPerArray <= 256 && TextureImage::kMaxLevels <= 16);
+
+		return U32(residency.slot.array + 1) | (U32(residency.slot.layer) << 4) | (U32(residency.minLevel) << 12);
+	}
+
+	/**
+	 * @brief Pack how the pulled mesh shaders read a light: bit 3 if it is directional, bits 0-2 its shadow index + 1.
+	 */
+	static auto PackLightFlags(const Light& light, const ShadowCache* shadows) noexcept -> U32
+	{
+		const auto shadow = shadows != nullptr ? shadows->ShadowIndex(light) : -1;
+
+		return (light.IsDirectional() ? 8U : 0U) | U32(shadow + 1);
+	}
+
+	/**
+	 * @brief Pack the transform, material and lights of a draw record, leaving its vertex fields to the caller.
+	 *
+	 * @param fade The share of the draw's pixels drawn, see BufferSection::fade.
+	 */
+	static auto PackDraw(
+		const glm::mat4& model,
+		const Material& material,
+		const Light lights[],
+		I32 nLights,
+		F32 fade,
+		const ShadowCache* shadows
+	) noexcept -> PulledDraw
+	{
+		auto draw = PulledDraw{
+			.model        = model,
+			.diffuse      = glm::vec4(material.diffuse, material.shininess),
+			.specular     = glm::vec4(material.specular, fade),
+			.vertexOffset = 0,
+			.vertexStride = 0,
+			.normalOffset = 0,
+			.indexOffset  = 0,
+			.nLights      = nLights,
+			.lightFlags   = 0,
+			.uvOffset     = 0,
+			.texture      = 0,
+			.lights       = {},
+		};
+		for (auto l = 0; l < nLights; l++) {
+			const auto& light = lights[l];
+
+			draw.lights[l].position = glm::vec4(light.IsDirectional() ? light.direction : light.position, light.ambientCoefficient);
+			draw.lights[l].diffuse  = glm::vec4(light.diffuse, light.attenuation);
+			draw.lightFlags        |= PackLightFlags(light, shadows) << (4 * l);
+		}
+
+		return draw;
+	}
+
+	/**
+	 * @brief Upload the lights and material of a draw to a mesh shader variant lit by up to @p maxLights lights.
+	 *
+	 * @param shadows The shadow maps the lights sample, or nullptr without shadows.
+	 */
+	static auto UploadLighting(
+		Objects::ShaderProgram& program,
+		const Material& material,
+		const Light lights[],
+		I32 nLights,
+		I32 maxLights,
+		const ShadowCache* shadows
+	) -> void
+	{
+		for (auto i = 0; i < std::min(nLights, maxLights); i++) {
+			const auto& light   = lights[i];
+			const auto  uniform = std::format("u_Lights[{}]", i);
+
+			program.UploadUniform3FV(std::format("{}.position", uniform), &(light.position[0]));
+			program.UploadUniform3FV(std::format("{}.direction", uniform), &(light.direction[0]));
+			program.UploadUniform3FV(std::format("{}.diffuse", uniform),  &(light.diffuse[0]));
+			program.UploadUniform1F(std::format("{}.ambientCoefficient", uniform), light.ambientCoefficient);
+			program.UploadUniform1F(std::format("{}.attenuation", uniform), light.attenuation);
+			program.UploadUniform1I(std::format("{}.shadow", uniform), shadows != nullptr ? shadows->ShadowIndex(light) : -1);
+		}
+		if (maxLights > 0) {
+			program.UploadUniform1I("u_nLights", nLights);
+		}
+
+		program.UploadUniform3FV("u_Material.diffuse", &(material.diffuse[0]));
+		if (maxLights > 0) {
+			program.UploadUniform3FV("u_Material.specular", &(material.specular[0]));
+			program.UploadUniform1F("u_Material.shininess", material.shininess);
+		}
+	}
+
+	/**
+	 * @brief Upload where the shadow maps were rendered from to a mesh shader variant with shadows.
+	 */
+	static auto UploadShadows(Objects::ShaderProgram& program, const ShadowCache& shadows) -> void
+	{
+		program.UploadUniform1I("u_CascadeMaps", I32(kCascadeTextureUnit));
+		program.UploadUniform1I("u_PointShadowMaps", I32(kPointShadowTextureUnit));
+
+		const auto cascades = shadows.Cascades();
+		program.UploadUniform1I("u_nCascades", I32(cascades.size()));
+		for (auto i = std::size_t(0); i < cascades.size(); i++) {
+			program.UploadUniformMatrix4FV(std::format("u_CascadeMatrices[{}]", i), &(cascades[i][0][0]));
+			program.UploadUniform1F(std::format("u_CascadeTexels[{}]", i), shadows.CascadeTexelSize(I32(i)));
+		}
+
+		const auto points = shadows.PointShadows();
+		for (auto i = std::size_t(0); i < points.size(); i++) {
+			const auto point = glm::vec4(points[i].position, points[i].range);
+			program.UploadUniform4FV(std::format("u_PointShadows[{}]", i), &(point[0]));
+		}
+	}
+
+	/**
+	 * @brief The shadow maps, and what is needed to render them.
+	 *
+	 * Each map comes in two copies: the cache, holding the static casters
+	 * only, and the map the mesh shaders sample, which is the cache with the
+	 * frame's dynamic casters drawn over it.
+	 */
+	struct ShadowResources
+	{
+		ShadowCache               cache;
+		ShaderPermutations        depthShaders;       /**< Bit 0: skinning. Bit 1: distances to a point light */
+		Objects::Texture          cascadeCache;
+		Objects::Texture          cascades;
+		Objects::Texture          pointCache;
+		Objects::Texture          points;
+		Objects::DepthFramebuffer framebuffer;
+		std::vector<bool>         cascadeHadDynamic;  /**< Per layer: the sampled map differs from the cache */
+		std::vector<bool>         pointHadDynamic;    /**< Per cube face, as cascadeHadDynamic */
+
+		/**
+		 * @brief Dynamic casters of the sections flushed before Render(): their index and vertex sections.
+		 */
+		std::vector<std::pair<BufferSection, BufferSection>> flushedCasters;
+		/**
+		 * @brief Scratch: the dynamic casters in a view, as index and vertex sections.
+		 */
+		std::vector<std::pair<const BufferSection*, const BufferSection*>> casters;
+	};
+
+	/**
+	 * @brief Allocate the shadow maps and compile the depth-only shaders.
+	 */
+	static auto MakeShadowResources(const ShadowCache::Settings& settings) -> Unique<ShadowResources>
+	{
+		// Depth only. Point lights store distances instead, divided by their range
+		// so that they are compared in [0, 1], and cube maps are sampled by direction.
+		const auto* depthVertexSource = R"(
+			#version 450 core
+
+			layout (location = 0) in vec3 a_Position;
+
+			#ifdef SKINNING
+			layout (location = 3) in uvec4 a_Joints;
+			layout (location = 4) in vec4  a_Weights;
+
+			layout(std430, binding = 3) readonly buffer Palette { mat4 palette[]; };
+			#endif
+
+			uniform mat4 u_model;
+			uniform mat4 u_vp;
+
+			out vec3 surfacePos;
 
 			void main()
 			{
-				const vec3 gamma = vec3(1.0 / 2.2);
+				vec3 position = a_Position;
+			#ifdef SKINNING
+				mat4 skin =
+					a_Weights.x * palette[a_Joints.x] +
+					a_Weights.y * palette[a_Joints.y] +
+					a_Weights.z * palette[a_Joints.z] +
+					a_Weights.w * palette[a_Joints.w];
 
-				vec3 linearColor = vec3(0);
-				vec3 surfaceToView = normalize(u_ViewPos - surfacePos);
-				for (int i = 0; i < u_nLights; i++) {
-					linearColor += ComputeLight(u_Lights[i], normal, surfacePos, surfaceToView);
-				}
+				position = vec3(skin * vec4(position, 1.0));
+			#endif
 
-				FragColor = vec4(pow(linearColor, gamma), 1.0);
+				surfacePos = vec3(u_model * vec4(position, 1.0));
+				gl_Position = u_vp * vec4(surfacePos, 1.0);
 			}
 		)";
+		const auto* depthFragmentSource = R"(
+			#version 450 core
 
-		const auto* screenQuadVertexSource = R"(
-			#version 330 core
-
-			layout(location = 0) in vec3 a_Position;
-			layout(location = 1) in vec2 a_TextureCoords;
+			#ifdef POINT_SHADOW
+			uniform vec3  u_LightPos;
+			uniform float u_Range;
+			#endif
 
-			out vec2 TextureCoords;
+			in vec3 surfacePos;
 
 			void main()
 			{
-				gl_Position = vec4(a_Position.x, a_Position.y, 0.0, 1.0);
-				TextureCoords = a_TextureCoords;
+			#ifdef POINT_SHADOW
+				gl_FragDepth = length(surfacePos - u_LightPos) / u_Range;
+			#endif
 			}
 		)";
 
-		const auto* screenQuadFragmentSource = R"(
-			#version 330 core
+		const auto depthDefines = [](ShaderPermutations::Key key) {
+			auto defines = std::string();
+			if ((key & 1U) != 0) {
+				defines += "#define SKINNING\n";
+			}
+			if ((key & 2U) != 0) {
+				defines += "#define POINT_SHADOW\n";
+			}
 
-			out vec4 FragColor;
+			return defines;
+		};
 
-			in vec2 TextureCoords;
+		const auto nFaces = ShadowCache::kMaxPointLights * 6;
 
-			uniform sampler2D screenTexture;
+		auto resources = MakeUnique<ShadowResources>(ShadowResources{
+			.cache             = ShadowCache(settings),
+			.depthShaders      = ShaderPermutations(depthVertexSource, depthFragmentSource, depthDefines),
+			.cascadeCache      = Objects::Texture(GL_TEXTURE_2D_ARRAY, settings.cascadeResolution, settings.cascadeResolution, settings.nCascades, GL_DEPTH_COMPONENT32F),
+			.cascades          = Objects::Texture(GL_TEXTURE_2D_ARRAY, settings.cascadeResolution, settings.cascadeResolution, settings.nCascades, GL_DEPTH_COMPONENT32F),
+			.pointCache        = Objects::Texture(GL_TEXTURE_CUBE_MAP_ARRAY, settings.pointResolution, settings.pointResolution, nFaces, GL_DEPTH_COMPONENT32F),
+			.points            = Objects::Texture(GL_TEXTURE_CUBE_MAP_ARRAY, settings.pointResolution, settings.pointResolution, nFaces, GL_DEPTH_COMPONENT32F),
+			.framebuffer       = {},
+			.cascadeHadDynamic = std::vector<bool>(std::size_t(settings.nCascades), false),
+			.pointHadDynamic   = std::vector<bool>(std::size_t(nFaces), false),
+			.flushedCasters    = {},
+			.casters           = {},
+		});
 
-			void main()
-			{
-				FragColor = texture(screenTexture, TextureCoords);
-			}
-		)";
+		// Hardware 2x2 percentage-closer filtering
+		for (auto* map : { &resources->cascades, &resources->points }) {
+			map->SetFilter(GL_LINEAR, GL_LINEAR);
+			map->SetWrap(GL_CLAMP_TO_EDGE);
+			map->SetCompare(GL_LEQUAL);
+		}
 
-		auto vShader = Objects::Shader(Objects::Shader::Type::Vertex, vertexSource);
-		GAZE_ASSERT(vShader.Compile(), "Failed to compile Vertex shader");
-		auto fShader = Objects::Shader(Objects::Shader::Type::Fragment, fragmentSource);
-		GAZE_ASSERT(fShader.Compile(), "Failed to compile Fragment shader");
+		return resources;
+	}
 
-		auto screenVShader = Objects::Shader(Objects::Shader::Type::Vertex, screenQuadVertexSource);
-		GAZE_ASSERT(screenVShader.Compile(), "Failed to compile Screen Vertex shader");
-		auto screenFShader = Objects::Shader(Objects::Shader::Type::Fragment, screenQuadFragmentSource);
-		GAZE_ASSERT(screenFShader.Compile(), "Failed to compile Screen Fragment shader");
+	/**
+	 * @brief Allocate the GPU copy of a terrain, with every level of detail and stitching of a chunk in one index buffer.
+	 */
+	static auto MakeTerrainResources(const Terrain::Snapshot& settings) -> Unique<TerrainResources>
+	{
+		const auto rowStride       = settings.tileResolution + 1;
+		const auto verticesPerTile = I64(rowStride) * rowStride;
 
-		const ScreenQuadVertex screenQuadVertices[4] = {
-			{ -1.0F, -1.0F, 0.0F, 0.0F, 0.0F },
-			{  1.0F, -1.0F, 0.0F, 1.0F, 0.0F },
-			{ -1.0F,  1.0F, 0.0F, 0.0F, 1.0F },
-			{  1.0F,  1.0F, 0.0F, 1.0F, 1.0F },
-		};
-		const U32 screenQuadIndices[6] = {
-			0, 1, 2, 3
-		};
+		auto indices = std::vector<U32>();
+		auto ranges  = std::vector<TerrainResources::IndexRange>();
+		for (auto lod = 0; lod < Terrain::LodCount(settings.chunkResolution); lod++) {
+			for (auto stitches = 0; stitches < Terrain::kStitchVariants; stitches++) {
+				const auto variant = Terrain::BuildChunkIndices(settings.chunkResolution, rowStride, lod, U8(stitches));
 
-		m_pImpl = new Impl({
-			.vertexArray          = {},
-			.screenVA             = {},
-			.screenVB             = Objects::VertexBuffer(screenQuadVertices, sizeof(screenQuadVertices), Objects::BufferUsage::StaticDraw),
-			.screenIB             = Objects::IndexBuffer(screenQuadIndices, sizeof(screenQuadIndices), Objects::BufferUsage::StaticDraw),
-			.program              = { &vShader, &fShader },
-			.screenProgram        = { &screenVShader, &screenFShader },
-			.vertexBuf            = Objects::VertexBuffer(nullptr, kStaticBufferSize, Objects::BufferUsage::DynamicDraw),
-			.indexBuf             = Objects::IndexBuffer(nullptr, kStaticBufferSize, Objects::BufferUsage::DynamicDraw),
-			.framebuffer          = { Window().Width(), Window().Height() },
-			.vertexBufSects       = {},
-			.vertexBufSectsCursor = {},
-			.indexBufSects        = {},
-			.indexBufSectsCursor  = {},
-			.camera               = {
-				MakeShared<PerspectiveCamera>(
-					glm::radians(75.F),
-					F32(Window().Width()) / F32(Window().Height()),
-					.1F,
-					100.F
-				)
-			},
-			.stats                = {},
-			.statsCurrent         = {},
-			.logger               = Log::Logger("Renderer")
-		});
-
-		GAZE_ASSERT(m_pImpl->program.Link(), "Failed to link shader program");
-		GAZE_ASSERT(m_pImpl->screenProgram.Link(), "Failed to link screen shader program");
-		m_pImpl->screenProgram.Use();
-		m_pImpl->screenProgram.UploadUniform1I("screenTexture", 0);
+				ranges.push_back({ U32(indices.size()), U32(variant.size()) });
+				indices.insert(indices.end(), variant.begin(), variant.end());
+			}
+		}
 
-		m_pImpl->vertexBufSects.resize(kStaticBufferSize / sizeof(BufferSection));
-		m_pImpl->vertexBufSectsCursor = m_pImpl->vertexBufSects.begin();
-		m_pImpl->indexBufSects.resize(kStaticBufferSize / sizeof(BufferSection));
-		m_pImpl->indexBufSectsCursor = m_pImpl->indexBufSects.begin();
+		auto resources = MakeUnique<TerrainResources>(TerrainResources{
+			.tileResolution   = settings.tileResolution,
+			.chunkResolution  = settings.chunkResolution,
+			.maxResidentTiles = settings.maxResidentTiles,
+			.vertexArray      = {},
+			.vertices         = Objects::VertexBuffer(
+				nullptr,
+				verticesPerTile * settings.maxResidentTiles * I64(sizeof(Terrain::Vertex)),
+				Objects::BufferUsage::DynamicDraw
+			),
+			.indices          = Objects::IndexBuffer(indices.data(), I64(indices.size() * sizeof(U32))),
+			.ranges           = std::move(ranges),
+			.slotVersions     = std::vector<U64>(std::size_t(settings.maxResidentTiles), 0),
+		});
 
-		m_pImpl->vertexArray.Bind();
-		m_pImpl->vertexArray.SetIndexBuffer(&m_pImpl->indexBuf);
-		m_pImpl->vertexArray.SetLayout({
+		// Laid out like mesh vertices, so the mesh shaders draw terrain as well
+		resources->vertexArray.SetLayout({
 			{
 				Objects::VertexArray::Layout::BufferBinding(0),
 				Objects::VertexArray::Layout::ComponentCount(3),
 				Objects::VertexArray::Layout::DataType::Float,
 				Objects::VertexArray::Layout::Normalized(false),
-				Objects::VertexArray::Layout::RelativeOffset(offsetof(Vertex, position))
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Terrain::Vertex, position))
 			},
 			{
 				Objects::VertexArray::Layout::BufferBinding(0),
 				Objects::VertexArray::Layout::ComponentCount(3),
-				Objects::VertexArray::Layout::DataType::Float,
-				Objects::VertexArray::Layout::Normalized(false),
-				Objects::VertexArray::Layout::RelativeOffset(offsetof(Vertex, normals))
-			},
+				Objects::VertexArray::Layout::DataType::Byte,
+				Objects::VertexArray::Layout::Normalized(true),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Terrain::Vertex, normal))
+			}
 		});
-		m_pImpl->vertexArray.BindVertexBuffer(
-			&m_pImpl->vertexBuf,
-			Objects::VertexArray::Layout::BufferBinding(0),
-			Objects::VertexArray::Offset(0),
-			Objects::VertexArray::Stride(sizeof(Vertex))
-		);
+		glVertexArrayVertexBuffer(resources->vertexArray.ID(), 0, resources->vertices.ID(), 0, sizeof(Terrain::Vertex));
+		resources->vertexArray.SetIndexBuffer(&resources->indices);
 
-		m_pImpl->screenVA.Bind();
-		m_pImpl->screenVA.SetIndexBuffer(&m_pImpl->screenIB);
-		m_pImpl->screenVA.SetLayout({
+		return resources;
+	}
+
+	/**
+	 * @brief Allocate the impostor atlas and compile the shader rendering meshes into it.
+	 */
+	static auto MakeImpostorResources(const ImpostorAtlas::Settings& settings) -> Unique<ImpostorResources>
+	{
+		// Model space normals and coverage, lit when the impostor is drawn
+		const auto* bakeVertexSource = R"(
+			#version 450 core
+
+			layout (location = 0) in vec3 a_Position;
+			layout (location = 1) in vec3 a_Normal;
+
+			uniform mat4 u_vp;
+
+			out vec3 normal;
+
+			void main()
 			{
-				Objects::VertexArray::Layout::BufferBinding(0),
-				Objects::VertexArray::Layout::ComponentCount(3),
-				Objects::VertexArray::Layout::DataType::Float,
-				Objects::VertexArray::Layout::Normalized(false),
-				Objects::VertexArray::Layout::RelativeOffset(offsetof(ScreenQuadVertex, x))
-			},
+				normal = a_Normal;
+				gl_Position = u_vp * vec4(a_Position, 1.0);
+			}
+		)";
+		const auto* bakeFragmentSource = R"(
+			#version 450 core
+
+			in vec3 normal;
+
+			out vec4 FragColor;
+
+			void main()
 			{
-				Objects::VertexArray::Layout::BufferBinding(0),
-				Objects::VertexArray::Layout::ComponentCount(2),
-				Objects::VertexArray::Layout::DataType::Float,
-				Objects::VertexArray::Layout::Normalized(false),
-				Objects::VertexArray::Layout::RelativeOffset(offsetof(ScreenQuadVertex, u))
+				FragColor = vec4(normalize(normal) * 0.5 + 0.5, 1.0);
 			}
+		)";
+
+		auto bakeVShader = Objects::Shader(Objects::Shader::Type::Vertex, bakeVertexSource);
+		GAZE_ASSERT(bakeVShader.Compile(), "Failed to compile Impostor Bake Vertex shader");
+		auto bakeFShader = Objects::Shader(Objects::Shader::Type::Fragment, bakeFragmentSource);
+		GAZE_ASSERT(bakeFShader.Compile(), "Failed to compile Impostor Bake Fragment shader");
+
+		const auto atlas = ImpostorAtlas(settings);
+		const auto size  = atlas.SlotSize();
+		// Down to 8 texels per cell; smaller mips would bleed the neighbouring cells in
+		const auto levels = std::max(I32(std::bit_width(U32(settings.cellResolution))) - 3, 1);
+
+		auto resources = MakeUnique<ImpostorResources>(ImpostorResources{
+			.atlas       = atlas,
+			.texture     = Objects::Texture(GL_TEXTURE_2D_ARRAY, size.x, size.y, settings.maxImpostors, GL_RGBA8, levels),
+			.framebuffer = Objects::LayerFramebuffer(size.x, size.y),
+			.bakeProgram = { &bakeVShader, &bakeFShader },
+			.pending     = {},
+			.draws       = {},
 		});
-		m_pImpl->screenVA.BindVertexBuffer(
-			&m_pImpl->screenVB,
-			Objects::VertexArray::Layout::BufferBinding(0),
-			Objects::VertexArray::Offset(0),
-			Objects::VertexArray::Stride(sizeof(ScreenQuadVertex))
-		);
+		GAZE_ASSERT(resources->bakeProgram.Link(), "Failed to link impostor bake shader program");
+
+		resources->texture.SetFilter(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+		resources->texture.SetWrap(GL_CLAMP_TO_EDGE);
+
+		return resources;
+	}
+
+	/**
+	 * @brief Set up the textures of the visibility buffer and attach them.
+	 */
+	static auto AttachVisibilityTargets(VisibilityResources& resources) -> void
+	{
+		// Only read with texelFetch, but a texture missing the mips its filter needs reads as zero
+		resources.ids.SetFilter(GL_NEAREST, GL_NEAREST);
+		resources.depth.SetFilter(GL_NEAREST, GL_NEAREST);
+
+		resources.framebuffer.Attach(GL_COLOR_ATTACHMENT0, resources.ids);
+		resources.framebuffer.Attach(GL_DEPTH_ATTACHMENT, resources.depth);
+		resources.framebuffer.SetDrawBuffers({ GL_COLOR_ATTACHMENT0 });
+	}
+
+	/**
+	 * @brief Allocate a visibility buffer of @p width by @p height pixels and compile the shader writing it.
+	 */
+	static auto MakeVisibilityResources(I32 width, I32 height) -> Unique<VisibilityResources>
+	{
+		// Positions only; the draw and triangle are all the resolve needs to find the rest
+		const auto* visibilityVertexSource = R"(
+			#version 450 core
+
+			struct PackedLight
+			{
+				vec4 position;
+				vec4 diffuse;
+			};
 
+			struct DrawRecord
+			{
+				mat4 model;
+				vec4 diffuse;
+				vec4 specular;
+				uint vertexOffset;
+				uint vertexStride;
+				uint normalOffset;
+				uint indexOffset;
+				int nLights;
+				uint lightFlags;
+				uint uvOffset;
+				uint texture;
+				PackedLight lights[8];
+			};
+
+			layout(std430, binding = 0) readonly buffer Vertices { float vertices[]; };
+			layout(std430, binding = 1) readonly buffer Indices  { uint indices[]; };
+			layout(std430, binding = 2) readonly buffer Draws    { DrawRecord draws[]; };
+
+			layout(location = 0) in float a_DrawID;
+
+			uniform mat4 u_vp;
+			uniform int  u_DrawBase; // Of the multi-draw, among the draw records bound
+
+			flat out uint drawID;
+
+			void main()
+			{
+				drawID = uint(u_DrawBase) + uint(a_DrawID);
+
+				uint base = draws[drawID].vertexOffset + indices[draws[drawID].indexOffset + gl_VertexID] * draws[drawID].vertexStride;
+				vec3 position = vec3(vertices[base], vertices[base + 1], vertices[base + 2]);
+
+				gl_Position = u_vp * draws[drawID].model * vec4(position, 1.0);
+			}
+		)";
+		const auto* visibilityFragmentSource = R"(
+			#version 450 core
+
+			flat in uint drawID;
+
+			layout(location = 0) out uvec2 Visibility;
+
+			void main()
+			{
+				Visibility = uvec2(drawID + 1u, uint(gl_PrimitiveID));
+			}
+		)";
+
+		auto visibilityVShader = Objects::Shader(Objects::Shader::Type::Vertex, visibilityVertexSource);
+		GAZE_ASSERT(visibilityVShader.Compile(), "Failed to compile Visibility Vertex shader");
+		auto visibilityFShader = Objects::Shader(Objects::Shader::Type::Fragment, visibilityFragmentSource);
+		GAZE_ASSERT(visibilityFShader.Compile(), "Failed to compile Visibility Fragment shader");
+
+		auto resources = MakeUnique<VisibilityResources>(VisibilityResources{
+			.program     = { &visibilityVShader, &visibilityFShader },
+			.ids         = Objects::Texture(width, height, GL_RG32UI),
+			.depth       = Objects::Texture(width, height, GL_DEPTH_COMPONENT32F),
+			.framebuffer = {},
+			.sections    = {},
+			.groupEnds   = {},
+			.multiDraws  = {},
+		});
+		GAZE_ASSERT(resources->program.Link(), "Failed to link visibility shader program");
+
+		AttachVisibilityTargets(*resources);
+
+		return resources;
+	}
+
+	/**
+	 * @brief Bounds a light: a sphere generated from the vertex ID, or a full-screen triangle with FULL_SCREEN.
+	 */
+	static constexpr auto* kLightVolumeVertexSource = R"(
+		#version 450 core
+
+		#define PI     3.14159265
+		#define STACKS 8
+		#define SLICES 16
+
+		uniform mat4  u_vp;
+		uniform vec3  u_VolumeCenter;
+		uniform float u_VolumeRadius;
+
+		void main()
 		{
-			const GLubyte* info[] = {
-				glGetString(GL_VENDOR),
-				glGetString(GL_RENDERER),
-				glGetString(GL_VERSION),
-				glGetString(GL_SHADING_LANGUAGE_VERSION),
+		#ifdef FULL_SCREEN
+			vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+			gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+		#else
+			// Two triangles per quad between stacks and slices, counter-clockwise seen from outside
+			const ivec2 corners[6] = ivec2[6](ivec2(0, 0), ivec2(1, 0), ivec2(1, 1), ivec2(0, 0), ivec2(1, 1), ivec2(0, 1));
+			int quad = gl_VertexID / 6;
+			ivec2 corner = ivec2(quad % SLICES, quad / SLICES) + corners[gl_VertexID % 6];
+
+			float theta = float(corner.y) / float(STACKS) * PI;
+			float phi = float(corner.x) / float(SLICES) * 2.0 * PI;
+			vec3 direction = vec3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+
+			// Grown so that the middle of the faces, not only their corners, lies on the sphere or outside
+			float hullScale = 1.0 / (cos(PI / float(SLICES)) * cos(PI / float(SLICES)));
+			gl_Position = u_vp * vec4(u_VolumeCenter + direction * u_VolumeRadius * hullScale, 1.0);
+		#endif
+		}
+	)";
+
+	static constexpr auto kLightVolumeVertices = 8 * 16 * 6; /**< STACKS * SLICES * 6 */
+
+	/**
+	 * @brief Set up the textures of the G-buffer and light buffer and attach them.
+	 */
+	static auto AttachDeferredTargets(DeferredResources& resources) -> void
+	{
+		// Only read with texelFetch, but a texture missing the mips its filter needs reads as zero
+		for (auto* texture : { &resources.albedo, &resources.normals, &resources.specular, &resources.depth, &resources.light }) {
+			texture->SetFilter(GL_NEAREST, GL_NEAREST);
+		}
+
+		resources.gbuffer.Attach(GL_COLOR_ATTACHMENT0, resources.albedo);
+		resources.gbuffer.Attach(GL_COLOR_ATTACHMENT1, resources.normals);
+		resources.gbuffer.Attach(GL_COLOR_ATTACHMENT2, resources.specular);
+		resources.gbuffer.Attach(GL_DEPTH_STENCIL_ATTACHMENT, resources.depth);
+		resources.gbuffer.SetDrawBuffers({ GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 });
+
+		resources.lightBuffer.Attach(GL_COLOR_ATTACHMENT0, resources.light);
+		resources.lightBuffer.Attach(GL_DEPTH_STENCIL_ATTACHMENT, resources.lightDepth);
+		resources.lightBuffer.SetDrawBuffers({ GL_COLOR_ATTACHMENT0 });
+	}
+
+	/**
+	 * @brief Allocate a G-buffer of @p width by @p height pixels and compile the programs shading it.
+	 */
+	static auto MakeDeferredResources(I32 width, I32 height) -> Unique<DeferredResources>
+	{
+		// Depth only, the light pass over the same volume reads the stencil it leaves
+		const auto* stencilFragmentSource = R"(
+			#version 450 core
+
+			void main()
+			{
+			}
+		)";
+		const auto* compositeVertexSource = R"(
+			#version 450 core
+
+			void main()
+			{
+				vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+		const auto* compositeFragmentSource = R"(
+			#version 450 core
+
+			uniform sampler2D u_GAlbedo;
+			uniform sampler2D u_GDepth;
+			uniform sampler2D u_Light;
+			uniform vec3 u_Ambient;
+
+			out vec4 FragColor;
+
+			void main()
+			{
+				const vec3 gamma = vec3(1.0 / 2.2);
+
+				ivec2 pixel = ivec2(gl_FragCoord.xy);
+				float depth = texelFetch(u_GDepth, pixel, 0).r;
+				if (depth >= 1.0) {
+					discard;
+				}
+
+				// Unlit surfaces keep their albedo, as forward
+				vec4 albedo = texelFetch(u_GAlbedo, pixel, 0);
+				vec3 linearColor = albedo.a > 0.5 ? texelFetch(u_Light, pixel, 0).rgb + u_Ambient * albedo.rgb : albedo.rgb;
+
+				FragColor = vec4(pow(linearColor, gamma), 1.0);
+				gl_FragDepth = depth;
+			}
+		)";
+
+		auto stencilVShader = Objects::Shader(Objects::Shader::Type::Vertex, kLightVolumeVertexSource);
+		GAZE_ASSERT(stencilVShader.Compile(), "Failed to compile Light Volume Vertex shader");
+		auto stencilFShader = Objects::Shader(Objects::Shader::Type::Fragment, stencilFragmentSource);
+		GAZE_ASSERT(stencilFShader.Compile(), "Failed to compile Stencil Fragment shader");
+		auto compositeVShader = Objects::Shader(Objects::Shader::Type::Vertex, compositeVertexSource);
+		GAZE_ASSERT(compositeVShader.Compile(), "Failed to compile Composite Vertex shader");
+		auto compositeFShader = Objects::Shader(Objects::Shader::Type::Fragment, compositeFragmentSource);
+		GAZE_ASSERT(compositeFShader.Compile(), "Failed to compile Composite Fragment shader");
+
+		auto resources = MakeUnique<DeferredResources>(DeferredResources{
+			.stencilProgram   = { &stencilVShader, &stencilFShader },
+			.compositeProgram = { &compositeVShader, &compositeFShader },
+			.albedo           = Objects::Texture(width, height, GL_RGBA8),
+			.normals          = Objects::Texture(width, height, GL_RGB10_A2),
+			.specular         = Objects::Texture(width, height, GL_RGBA8),
+			.depth            = Objects::Texture(width, height, GL_DEPTH24_STENCIL8),
+			.light            = Objects::Texture(width, height, GL_RGBA16F),
+			.lightDepth       = Objects::Renderbuffer(width, height),
+			.gbuffer          = {},
+			.lightBuffer      = {},
+			.volumes          = {},
+		});
+		GAZE_ASSERT(resources->stencilProgram.Link(), "Failed to link stencil shader program");
+		GAZE_ASSERT(resources->compositeProgram.Link(), "Failed to link composite shader program");
+
+		AttachDeferredTargets(*resources);
+
+		return resources;
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Tracks a frame that was submitted but not yet completed by the GPU.
+	 */
+	struct FrameInFlight
+	{
+		GLsync            fence;
+		U32               timestampQuery; /**< GPU timestamp written right after the swap */
+		Clock::time_point submitBegin;    /**< CPU time of the frame's first submission */
+	};
+
+	static auto ToMilliseconds(Clock::duration duration) noexcept -> F64
+	{
+		return std::chrono::duration<F64, std::milli>(duration).count();
+	}
+
+	struct ScreenQuadVertex
+	{
+		float x, y, z;
+		float u, v;
+	};
+
+	struct Renderer::Impl
+	{
+		Objects::VertexArray                 vertexArray;
+		Objects::VertexArray                 screenVA;
+		Objects::VertexBuffer                screenVB;
+		Objects::IndexBuffer                 screenIB;
+		Objects::ShaderProgram               screenProgram;
+		Objects::VertexArray                 debugVA;
+		Objects::ShaderProgram               debugProgram;
+		Objects::StreamBuffer                debugStream;
+		Objects::VertexArray                 spriteVA;
+		Objects::ShaderProgram               spriteProgram;
+		Objects::StreamBuffer                spriteStream;
+		Objects::VertexArray                 particleVA;
+		Objects::ShaderProgram               particleProgram;
+		Objects::StreamBuffer                particleStream;
+		Objects::VertexArray                 overlayVA;
+		Objects::ShaderProgram               overlayProgram;
+		Objects::StreamBuffer                overlayStream;
+		Objects::Texture                     fontAtlas;
+		Objects::VertexArray                 pullVA;
+		ShaderPermutations                   meshShaders;
+		ShaderPermutations                   impostorShaders;
+		ShaderPermutations                   visibilityShaders;
+		ShaderPermutations                   gbufferShaders;
+		ShaderPermutations                   lightShaders;
+		Objects::VertexBuffer                drawIDBuf;
+		Objects::StreamBuffer                drawStream;
+		Objects::StreamBuffer                indirectStream;
+		Objects::VertexArray                 skinnedVA;
+		Objects::StreamBuffer                paletteStream;
+		BufferHeap                           vertexHeap;
+		BufferHeap                           indexHeap;
+		BufferHeap                           skinHeap;
+		Unique<Objects::Framebuffer>         framebuffer;
+		Unique<Objects::Framebuffer>         resolveFramebuffer;
+		ResolveMode                          resolveMode;
+		I32                                  samples;
+		bool                                 vertexPulling;
+		SkinningMode                         skinningMode;
+		Jobs::ThreadPool*                    skinningPool;
+		I64                                  storageAlignment; /**< GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT */
+		std::vector<BufferSection>           vertexBufSects;
+		std::vector<BufferSection>::iterator vertexBufSectsCursor;
+		std::vector<BufferSection>           indexBufSects;
+		std::vector<BufferSection>::iterator indexBufSectsCursor;
+		std::vector<std::size_t>             sectionOrder;  /**< Scratch: the sections drawn by DrawSections(), repeated primitives next to each other */
+		std::unordered_map<Geometry::MeshID, ResidentMesh> residentMeshes;
+		LightSelector                        sceneLights;
+		Unique<Objects::StreamBuffer>        skinnedStream; /**< Created on first use of CPU skinning */
+		std::vector<SkinJob>                 skinJobs;
+		std::vector<glm::mat4>               cpuPalettes;   /**< Joint matrices of the frame's CPU skinned submissions */
+		std::vector<ParticleDraw>            particleDraws;
+		Unique<TerrainResources>             terrain;       /**< Created on the first terrain submission */
+		std::vector<Terrain::TileUpload>     terrainTiles;  /**< Scratch: the tiles of the terrain being submitted */
+		std::vector<Terrain::ChunkDraw>      terrainChunks;
+		std::vector<TerrainDraw>             terrainDraws;
+		Unique<ShadowResources>              shadows;       /**< Created by SetShadows() */
+		const StaticBatcher*                 shadowCasters;
+		Unique<ImpostorResources>            impostors;     /**< Created by SetImpostors() */
+		Unique<VisibilityResources>          visibility;    /**< Created by SetVisibilityBuffer() */
+		Unique<DeferredResources>            deferred;      /**< Created by SetDeferredShading() */
+		TextureArrays                        textures;
+		std::vector<Objects::Texture>        textureArrays; /**< One per array of textures, created as they come */
+		std::unordered_map<TextureID, std::weak_ptr<const TextureImage>> textureImages; /**< Loaded with LoadTexture(), dropped once expired */
+		std::array<I32, 4>                   viewport;      /**< Set with SetViewport(), restored after the shadow passes */
+		Shared<Camera>                       camera;
+		RenderStats                          stats;
+		RenderStats                          statsCurrent;
+		Log::Logger                          logger;
+		std::deque<FrameInFlight>            framesInFlight;
+		std::vector<U32>                     freeTimestampQueries;
+		I32                                  maxFramesInFlight;
+		std::optional<Clock::time_point>     frameBegin;
+		std::optional<Clock::time_point>     lastRender;
+		StateCache                           state;
+		Unique<FrameCapturer>                capturer;
+		std::vector<CaptureCallback>         captureRequests; /**< For the frame being rendered */
+		U64                                  frameIndex;
+	};
+
+	static constexpr auto kDefaultMaxFramesInFlight = 2;
+
+	static constexpr auto kStaticBufferSize = 8 * 1024 * 1024; // 8 MiB
+	static constexpr auto kSpriteBufferSize = 16 * 1024 * 1024; // 16 MiB, ~600k quads per frame
+	static constexpr auto kMeshHeapPageSize = 32 * 1024 * 1024; // 32 MiB
+	static constexpr auto kDefragmentBudget = 1024 * 1024;      // 1 MiB moved per frame, at most
+	static constexpr auto kTextureStreamBudget = 4 * 1024 * 1024; // 4 MiB of texture levels uploaded per frame, tails aside
+	static constexpr auto kIndirectBufferSize = 1024 * 1024;    // 1 MiB, 64k indirect draws per frame
+	static constexpr auto kPaletteBufferSize  = 4 * 1024 * 1024; // 4 MiB, 64k joint matrices per frame
+	static constexpr auto kSkinHeapPageSize   = 8 * 1024 * 1024; // 8 MiB
+	static constexpr auto kSkinnedBufferSize  = 32 * 1024 * 1024; // 32 MiB, ~1.05M CPU skinned vertices per frame
+	static constexpr auto kParticleBufferSize = 24 * 1024 * 1024; // 24 MiB, ~1.2M particles per frame
+	static constexpr auto kOverlayBufferSize  = 1024 * 1024;      // 1 MiB, ~43k overlay quads per frame
+	static constexpr auto kOverlayTextureUnit = 0U;
+
+	Renderer::Renderer(Shared<WM::Window> window) noexcept
+		: GFX::Renderer(std::move(window))
+		, m_pImpl(nullptr)
+	{
+		auto* oldCurrentContext = glfwGetCurrentContext();
+		glfwMakeContextCurrent(static_cast<GLFWwindow*>(Window().Handle()));
+
+		gladLoadGL(static_cast<GLADloadfunc>(glfwGetProcAddress));
+
+#ifndef NDEBUG
+		EnableDebugOutput();
+#endif
+
+		// The mesh shader is specialized per draw through ShaderPermutations:
+		//   - MAX_LIGHTS bounds the light loop, so it can be unrolled. Unlit
+		//     variants (MAX_LIGHTS 0) output the material's diffuse color.
+		//   - SPECULAR compiles the specular term in.
+		//   - VERTEX_PULLING fetches vertices and indices from the mesh heap
+		//     pages bound as storage buffers, so draws of any vertex layout can
+		//     be merged into one multi-draw. The draw ID comes in as an instanced
+		//     attribute, offset per draw by the indirect command's baseInstance.
+		//   - SKINNING blends each vertex by up to four joint matrices, read
+		//     from the palette bound as storage buffer. Not combined with
+		//     VERTEX_PULLING: skinned sections are drawn one by one.
+		//   - SHADOWS attenuates the lights casting shadows by their shadow
+		//     maps: the directional light's cascades or a point light's cube.
+		//   - FADE leaves out a dithered share of the pixels, while the object
+		//     cross-fades into its impostor which covers the others.
+		//   - IMPOSTOR, with the impostor vertex shader only, lights billboards
+		//     from the normals rendered into the impostor atlas.
+		//   - VISIBILITY, with the full-screen resolve vertex shader only,
+		//     shades each pixel once from the triangle the visibility buffer
+		//     holds for it, reconstructing its position and normal.
+		//   - GBUFFER writes the surface's albedo, normal and specular into the
+		//     G-buffer instead of lighting it; lit variants flag it as lit.
+		//   - DEFERRED, with the light volume vertex shader only, adds one
+		//     light's contribution to the pixels of the G-buffer it covers.
+		//   - TEXTURED multiplies the diffuse color by the material's texture,
+		//     sampled from the texture arrays no finer than its resident levels.
+		//   - INSTANCED draws instances of one primitive from the vertex array,
+		//     each reading its transform, material and lights from a draw record
+		//     as VERTEX_PULLING does, selected by the instanced draw ID at
+		//     location 3. Not combined with VERTEX_PULLING nor SKINNING.
+		const auto* meshVertexSource = R"(
+			#version 450 core
+
+			#if defined(VERTEX_PULLING) || defined(INSTANCED)
+			struct PackedLight
+			{
+				vec4 position;
+				vec4 diffuse;
 			};
 
-			m_pImpl->logger.Info(
-				"OpenGL Info:\n  - Vendor: {}\n  - Renderer: {}\n  - Version: {}\n  - GLSL Version: {}",
-				info[0] ? reinterpret_cast<const char*>(info[0]) : "Unknown",
-				info[1] ? reinterpret_cast<const char*>(info[1]) : "Unknown",
-				info[2] ? reinterpret_cast<const char*>(info[2]) : "Unknown",
-				info[3] ? reinterpret_cast<const char*>(info[3]) : "Unknown"
-			);
+			struct DrawRecord
+			{
+				mat4 model;
+				vec4 diffuse;
+				vec4 specular;
+				uint vertexOffset;
+				uint vertexStride;
+				uint normalOffset;
+				uint indexOffset;
+				int nLights;
+				uint lightFlags;
+				uint uvOffset;
+				uint texture;
+				PackedLight lights[8];
+			};
+
+			layout(std430, binding = 2) readonly buffer Draws { DrawRecord draws[]; };
+
+			flat out uint drawID;
+			#endif
+
+			#ifdef VERTEX_PULLING
+			layout(std430, binding = 0) readonly buffer Vertices { float vertices[]; };
+			layout(std430, binding = 1) readonly buffer Indices  { uint indices[]; };
+
+			layout(location = 0) in float a_DrawID;
+
+			vec3 Fetch(uint offset)
+			{
+				return vec3(vertices[offset], vertices[offset + 1], vertices[offset + 2]);
+			}
+			#else
+			layout (location = 0) in vec3 a_Position;
+			layout (location = 1) in vec3 a_Normal;
+			#ifdef TEXTURED
+			layout (location = 2) in vec2 a_TexCoords;
+			#endif
+
+			#ifdef SKINNING
+			layout (location = 3) in uvec4 a_Joints;
+			layout (location = 4) in vec4  a_Weights;
+
+			layout(std430, binding = 3) readonly buffer Palette { mat4 palette[]; };
+			#endif
+
+			#ifdef INSTANCED
+			layout (location = 3) in float a_DrawID;
+			#else
+			uniform mat4 u_model;
+			#endif
+			#endif
+
+			uniform mat4 u_vp;
+
+			out vec3 normal;
+			out vec3 surfacePos;
+			#ifdef TEXTURED
+			out vec2 texCoords;
+			#endif
+
+			void main()
+			{
+			#ifdef VERTEX_PULLING
+				drawID = uint(a_DrawID);
+
+				uint base = draws[drawID].vertexOffset + indices[draws[drawID].indexOffset + gl_VertexID] * draws[drawID].vertexStride;
+				vec3 position = Fetch(base);
+				mat4 model = draws[drawID].model;
+
+				normal = Fetch(base + draws[drawID].normalOffset);
+			#ifdef TEXTURED
+				uint uv = base + draws[drawID].uvOffset;
+				texCoords = vec2(vertices[uv], vertices[uv + 1]);
+			#endif
+			#else
+				vec3 position = a_Position;
+			#ifdef INSTANCED
+				drawID = uint(a_DrawID);
+
+				mat4 model = draws[drawID].model;
+			#else
+				mat4 model = u_model;
+			#endif
+
+				normal = a_Normal;
+			#ifdef TEXTURED
+				texCoords = a_TexCoords;
+			#endif
+			#endif
+
+			#ifdef SKINNING
+				mat4 skin =
+					a_Weights.x * palette[a_Joints.x] +
+					a_Weights.y * palette[a_Joints.y] +
+					a_Weights.z * palette[a_Joints.z] +
+					a_Weights.w * palette[a_Joints.w];
+
+				position = vec3(skin * vec4(position, 1.0));
+				normal = normalize(mat3(skin) * normal);
+			#endif
+
+				gl_Position = u_vp * model * vec4(position, 1.0);
+				surfacePos = vec3(model * vec4(position, 1.0));
+			}
+		)";
+		const auto* meshFragmentSource = R"(
+			#version 450 core
+
+			struct Material
+			{
+				vec3 diffuse;
+				vec3 specular;
+				float shininess;
+			};
+
+			struct Light
+			{
+				vec3 position;
+				vec3 direction; // Zero for point lights
+				vec3 diffuse;
+				float ambientCoefficient;
+				float attenuation;
+				int shadow;     // -1 for none
+			};
+
+			#if defined(VERTEX_PULLING) || defined(INSTANCED)
+			struct PackedLight
+			{
+				vec4 position;
+				vec4 diffuse;
+			};
+
+			struct DrawRecord
+			{
+				mat4 model;
+				vec4 diffuse;
+				vec4 specular;
+				uint vertexOffset;
+				uint vertexStride;
+				uint normalOffset;
+				uint indexOffset;
+				int nLights;
+				uint lightFlags;
+				uint uvOffset;
+				uint texture;
+				PackedLight lights[8];
+			};
+
+			layout(std430, binding = 2) readonly buffer Draws { DrawRecord draws[]; };
+
+			#ifdef VISIBILITY
+			uint drawID;
+			#else
+			flat in uint drawID;
+			#endif
+
+			Material LoadMaterial()
+			{
+				return Material(draws[drawID].diffuse.rgb, draws[drawID].specular.rgb, draws[drawID].diffuse.w);
+			}
+
+			float LoadFade()
+			{
+				return draws[drawID].specular.w;
+			}
+
+			int LightCount()
+			{
+				return draws[drawID].nLights;
+			}
+
+			#ifdef TEXTURED
+			uint LoadTexture()
+			{
+				return draws[drawID].texture;
+			}
+			#endif
+
+			Light LoadLight(int i)
+			{
+				// Bit 3: directional, with its direction in place of the position. Bits 0-2: shadow + 1
+				PackedLight light = draws[drawID].lights[i];
+				uint flags = (draws[drawID].lightFlags >> uint(4 * i)) & 0xFu;
+				bool directional = (flags & 8u) != 0u;
+
+				return Light(
+					directional ? vec3(0) : light.position.xyz,
+					directional ? light.position.xyz : vec3(0),
+					light.diffuse.rgb,
+					light.position.w,
+					light.diffuse.w,
+					int(flags & 7u) - 1
+				);
+			}
+			#else
+			#ifdef DEFERRED
+			Material gbufferMaterial; // Set by ResolveGBuffer()
+			#else
+			uniform Material u_Material;
+			#endif
+			#if MAX_LIGHTS > 0
+			uniform Light u_Lights[MAX_LIGHTS];
+			#endif
+			uniform int u_nLights;
+			uniform float u_Fade;
+
+			Material LoadMaterial()
+			{
+			#ifdef DEFERRED
+				return gbufferMaterial;
+			#else
+				return u_Material;
+			#endif
+			}
+
+			float LoadFade()
+			{
+				return u_Fade;
+			}
+
+			int LightCount()
+			{
+				return u_nLights;
+			}
+
+			#ifdef TEXTURED
+			uniform int u_Texture;
+
+			uint LoadTexture()
+			{
+				return uint(u_Texture);
+			}
+			#endif
+
+			#if MAX_LIGHTS > 0
+			Light LoadLight(int i)
+			{
+				return u_Lights[i];
+			}
+			#endif
+			#endif
+
+			#ifdef GBUFFER
+			layout(location = 0) out vec4 GAlbedo;   // a: 1 if lit
+			layout(location = 1) out vec4 GNormal;   // xyz: normal * 0.5 + 0.5
+			layout(location = 2) out vec4 GSpecular; // a: shininess / 256
+			#else
+			out vec4 FragColor;
+			#endif
+
+			uniform vec3 u_ViewPos;
+
+			#ifdef IMPOSTOR
+			uniform sampler2DArray u_ImpostorAtlas;
+
+			in vec3 atlasCoords; // xy: texture coordinates, z: layer
+			flat in float impostorFade;
+
+			vec3 normal;
+			in vec3 surfacePos;
+			#elif defined(VISIBILITY) || defined(DEFERRED)
+			vec3 normal;
+			vec3 surfacePos;
+			#else
+			in vec3 normal;
+			in vec3 surfacePos;
+			#endif
+
+			#ifdef TEXTURED
+			#ifdef VISIBILITY
+			vec2 texCoords;
+			#else
+			in vec2 texCoords;
+			#endif
+			vec2 texCoordsDx; // Across a pixel, to pick the mip level
+			vec2 texCoordsDy;
+			#endif
+
+			#ifdef VISIBILITY
+			layout(std430, binding = 0) readonly buffer Vertices { float vertices[]; };
+			layout(std430, binding = 1) readonly buffer Indices  { uint indices[]; };
+
+			uniform usampler2D u_Visibility;      // x: draw + 1, 0 for none. y: triangle in the draw
+			uniform sampler2D  u_VisibilityDepth;
+			uniform mat4 u_InverseVP;
+			uniform vec4 u_Viewport;
+			uniform int  u_FirstDraw;             // The draws pulled from the bound heap pages
+			uniform int  u_EndDraw;
+
+			vec3 Fetch(uint offset)
+			{
+				return vec3(vertices[offset], vertices[offset + 1], vertices[offset + 2]);
+			}
+
+			// Barycentrics of where the ray through a point of the screen hits a triangle's plane (Moller-Trumbore),
+			// perspective-correct by construction. Seen edge-on, any point of the triangle does
+			vec3 HitWeights(vec2 fragCoord, vec3 positions[3])
+			{
+				vec2 ndc = (fragCoord - u_Viewport.xy) / u_Viewport.zw * 2.0 - 1.0;
+				vec4 nearPoint = u_InverseVP * vec4(ndc, -1.0, 1.0);
+				vec4 farPoint = u_InverseVP * vec4(ndc, 1.0, 1.0);
+				vec3 origin = nearPoint.xyz / nearPoint.w;
+				vec3 direction = farPoint.xyz / farPoint.w - origin;
+
+				vec3 edge1 = positions[1] - positions[0];
+				vec3 edge2 = positions[2] - positions[0];
+				vec3 p = cross(direction, edge2);
+				float det = dot(edge1, p);
+				if (abs(det) <= 1e-12) {
+					return vec3(1.0 / 3.0);
+				}
+
+				vec3 t = origin - positions[0];
+				float u = dot(t, p) / det;
+				float v = dot(direction, cross(t, edge1)) / det;
+
+				return vec3(1.0 - u - v, u, v);
+			}
+
+			// Reconstruct the surface behind the pixel: where the ray through it hits the triangle the visibility buffer holds
+			bool ResolveVisibility()
+			{
+				ivec2 pixel = ivec2(gl_FragCoord.xy);
+				uvec2 texel = texelFetch(u_Visibility, pixel, 0).xy;
+				if (texel.x == 0u || int(texel.x) - 1 < u_FirstDraw || int(texel.x) - 1 >= u_EndDraw) {
+					return false;
+				}
+
+				drawID = texel.x - 1u;
+				mat4 model = draws[drawID].model;
+				uint first = draws[drawID].indexOffset + texel.y * 3u;
+
+				vec3 positions[3];
+				vec3 normals[3];
+				uint bases[3];
+				for (int i = 0; i < 3; i++) {
+					bases[i] = draws[drawID].vertexOffset + indices[first + uint(i)] * draws[drawID].vertexStride;
+					positions[i] = vec3(model * vec4(Fetch(bases[i]), 1.0));
+					normals[i] = Fetch(bases[i] + draws[drawID].normalOffset);
+				}
+
+				vec3 weights = HitWeights(gl_FragCoord.xy, positions);
+				surfacePos = weights.x * positions[0] + weights.y * positions[1] + weights.z * positions[2];
+				normal = weights.x * normals[0] + weights.y * normals[1] + weights.z * normals[2];
+				gl_FragDepth = texelFetch(u_VisibilityDepth, pixel, 0).r;
+
+			#ifdef TEXTURED
+				// The neighbouring pixels may hold other triangles, so the derivatives come from this one's plane instead
+				mat3x2 uvs;
+				for (int i = 0; i < 3; i++) {
+					uint uv = bases[i] + draws[drawID].uvOffset;
+					uvs[i] = vec2(vertices[uv], vertices[uv + 1]);
+				}
+				texCoords = uvs * weights;
+				texCoordsDx = uvs * HitWeights(gl_FragCoord.xy + vec2(1.0, 0.0), positions) - texCoords;
+				texCoordsDy = uvs * HitWeights(gl_FragCoord.xy + vec2(0.0, 1.0), positions) - texCoords;
+			#endif
+
+				return true;
+			}
+			#endif
+
+			#ifdef DEFERRED
+			uniform sampler2D u_GAlbedo;
+			uniform sampler2D u_GNormal;
+			uniform sampler2D u_GSpecular;
+			uniform sampler2D u_GDepth;
+			uniform mat4 u_InverseVP;
+			uniform vec4 u_Viewport;
+
+			// Read back the surface behind the pixel, its position from the depth it was rasterized at
+			bool ResolveGBuffer()
+			{
+				ivec2 pixel = ivec2(gl_FragCoord.xy);
+				vec4 albedo = texelFetch(u_GAlbedo, pixel, 0);
+				float depth = texelFetch(u_GDepth, pixel, 0).r;
+				if (albedo.a < 0.5 || depth >= 1.0) {
+					return false;
+				}
+
+				vec4 specular = texelFetch(u_GSpecular, pixel, 0);
+				gbufferMaterial = Material(albedo.rgb, specular.rgb, specular.a * 256.0);
+				normal = texelFetch(u_GNormal, pixel, 0).xyz * 2.0 - 1.0;
+
+				vec2 ndc = (gl_FragCoord.xy - u_Viewport.xy) / u_Viewport.zw * 2.0 - 1.0;
+				vec4 position = u_InverseVP * vec4(ndc, depth * 2.0 - 1.0, 1.0);
+				surfacePos = position.xyz / position.w;
+
+				return true;
+			}
+			#endif
+
+			#if defined(FADE) || defined(IMPOSTOR)
+			// Ordered 4x4 thresholds. An object and its impostor keep complementary pixels, so they never overlap nor leave holes
+			float Dither()
+			{
+				const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+				ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+
+				return (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+			}
+			#endif
+
+			#ifdef SHADOWS
+			uniform sampler2DArrayShadow   u_CascadeMaps;
+			uniform samplerCubeArrayShadow u_PointShadowMaps;
+			uniform mat4  u_CascadeMatrices[MAX_CASCADES];
+			uniform float u_CascadeTexels[MAX_CASCADES];
+			uniform int   u_nCascades;
+			uniform vec4  u_PointShadows[MAX_POINT_SHADOWS]; // xyz: position, w: range
+
+			float CascadeShadow(vec3 normal, vec3 surfacePos)
+			{
+				// The nearest cascade covering the surface has the smallest texels
+				for (int i = 0; i < MAX_CASCADES; i++) {
+					if (i >= u_nCascades) {
+						break;
+					}
+
+					// Offset along the normal, by about a texel, against self-shadowing
+					vec4 coords = u_CascadeMatrices[i] * vec4(surfacePos + normal * u_CascadeTexels[i] * 1.5, 1.0);
+					if (all(greaterThan(coords.xyz, vec3(0.0))) && all(lessThan(coords.xyz, vec3(1.0)))) {
+						return texture(u_CascadeMaps, vec4(coords.xy, float(i), coords.z));
+					}
+				}
+
+				return 1.0;
+			}
+
+			float PointShadow(int slot, vec3 normal, vec3 surfacePos)
+			{
+				vec4 light = u_PointShadows[slot];
+				vec3 lightToSurface = surfacePos + normal * 0.02 - light.xyz;
+				float depth = length(lightToSurface) / light.w;
+				if (depth >= 1.0) {
+					return 1.0;
+				}
+
+				return texture(u_PointShadowMaps, vec4(lightToSurface, float(slot)), depth - 0.002);
+			}
+
+			float Shadow(Light light, vec3 normal, vec3 surfacePos)
+			{
+				if (light.shadow < 0) {
+					return 1.0;
+				}
+
+				normal = normalize(normal);
+				return light.shadow == CASCADED ? CascadeShadow(normal, surfacePos) : PointShadow(light.shadow, normal, surfacePos);
+			}
+			#else
+			float Shadow(Light light, vec3 normal, vec3 surfacePos)
+			{
+				return 1.0;
+			}
+			#endif
+
+			#ifdef TEXTURED
+			uniform sampler2DArray u_MaterialTextures[MAX_TEXTURE_ARRAYS];
+
+			// Bits 0-3: array + 1, 0 for none. Bits 4-11: layer. Bits 12-15: the finest level resident, which bounds the level sampled
+			vec4 SampleTexture(uint texture)
+			{
+				vec4 color = vec4(1.0);
+				for (int i = 0; i < MAX_TEXTURE_ARRAYS; i++) {
+					// Sampler arrays only take uniform indices, and the texture may change from pixel to pixel
+					if (uint(i) + 1u == (texture & 0xFu)) {
+						vec2 size = vec2(textureSize(u_MaterialTextures[i], 0).xy);
+						vec2 dx = texCoordsDx * size;
+						vec2 dy = texCoordsDy * size;
+						float lod = 0.5 * log2(max(dot(dx, dx), dot(dy, dy)));
+
+						color = textureLod(u_MaterialTextures[i], vec3(texCoords, float((texture >> 4) & 0xFFu)), max(lod, float(texture >> 12)));
+					}
+				}
+
+				return color;
+			}
+			#endif
+
+			vec3 ComputeLight(Material material, Light light, vec3 normal, vec3 surfacePos, vec3 surfaceToView)
+			{
+				// Directional lights are infinitely far away: same direction everywhere, no attenuation
+				bool directional = light.direction != vec3(0);
+				vec3 surfaceToLight = directional ? normalize(-light.direction) : normalize(light.position - surfacePos);
+				float diffuseCoefficient = max(dot(normal, surfaceToLight), 0.0);
+				vec3 diffuse = diffuseCoefficient * material.diffuse * light.diffuse;
+
+				vec3 specular = vec3(0);
+			#ifdef SPECULAR
+				if (diffuseCoefficient > 0) {
+					float specularCoefficient = pow(max(0.0, dot(surfaceToView, reflect(-surfaceToLight, normal))), material.shininess);
+					specular = specularCoefficient * material.specular * light.diffuse;
+				}
+			#endif
+
+				vec3 ambient = light.ambientCoefficient * light.diffuse * material.diffuse.rgb;
+				float attenuation = directional ? 1.0 : 1.0 / (1.0 + light.attenuation * pow(length(light.position - surfacePos), 2));
+
+				return ambient + attenuation * Shadow(light, normal, surfacePos) * (diffuse + specular);
+			}
+
+			void main()
+			{
+				const vec3 gamma = vec3(1.0 / 2.2);
+
+			#if defined(TEXTURED) && !defined(VISIBILITY)
+				// Ahead of any discard, while every pixel of the quad still runs
+				texCoordsDx = dFdx(texCoords);
+				texCoordsDy = dFdy(texCoords);
+			#endif
+			#ifdef VISIBILITY
+				if (!ResolveVisibility()) {
+					discard;
+				}
+			#endif
+			#ifdef DEFERRED
+				if (!ResolveGBuffer()) {
+					discard;
+				}
+			#endif
+			#ifdef FADE
+				if (Dither() >= LoadFade()) {
+					discard;
+				}
+			#endif
+			#ifdef IMPOSTOR
+				vec4 texel = texture(u_ImpostorAtlas, atlasCoords);
+				if (texel.a < 0.5 || Dither() < 1.0 - impostorFade) {
+					discard;
+				}
+				normal = normalize(mat3(draws[drawID].model) * (texel.xyz * 2.0 - 1.0));
+			#endif
+
+				Material material = LoadMaterial();
+			#ifdef TEXTURED
+				material.diffuse *= SampleTexture(LoadTexture()).rgb;
+			#endif
+
+			#ifdef GBUFFER
+				GAlbedo   = vec4(material.diffuse, MAX_LIGHTS > 0 ? 1.0 : 0.0);
+				GNormal   = vec4(normalize(normal) * 0.5 + 0.5, 0.0);
+				GSpecular = vec4(material.specular, material.shininess / 256.0);
+			#else
+			#if MAX_LIGHTS > 0
+				vec3 linearColor = vec3(0);
+				vec3 surfaceToView = normalize(u_ViewPos - surfacePos);
+				int nLights = min(LightCount(), MAX_LIGHTS);
+				for (int i = 0; i < MAX_LIGHTS; i++) {
+					if (i >= nLights) {
+						break;
+					}
+					linearColor += ComputeLight(material, LoadLight(i), normal, surfacePos, surfaceToView);
+				}
+			#ifdef VISIBILITY
+				// A resolve pass shades lit and unlit draws alike
+				if (nLights == 0) {
+					linearColor = material.diffuse;
+				}
+			#endif
+			#else
+				vec3 linearColor = material.diffuse;
+			#endif
+
+			#ifdef DEFERRED
+				// Accumulated over the lights, the composite applies gamma
+				FragColor = vec4(linearColor, 1.0);
+			#else
+				FragColor = vec4(pow(linearColor, gamma), 1.0);
+			#endif
+			#endif
+			}
+		)";
+
+		// Billboards expanded from the impostor instances, with the draw records
+		// of the pulled mesh shaders for their lights and material
+		const auto* impostorVertexSource = R"(
+			#version 450 core
+
+			struct ImpostorInstance
+			{
+				vec4 center; // w: the impostor's share of the cross-fade
+				vec4 right;  // w: atlas layer
+				vec4 up;
+				vec4 cell;   // xy: texture coordinates of the cell's corner, zw: its size
+			};
+
+			layout(std430, binding = 4) readonly buffer Impostors { ImpostorInstance impostors[]; };
+
+			uniform mat4 u_vp;
+
+			flat out uint drawID;
+			flat out float impostorFade;
+			out vec3 atlasCoords;
+			out vec3 surfacePos;
+
+			void main()
+			{
+				// Triangle strip corners, along the billboard's axes
+				vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+				ImpostorInstance impostor = impostors[gl_InstanceID];
+
+				drawID = uint(gl_InstanceID);
+				impostorFade = impostor.center.w;
+				atlasCoords = vec3(impostor.cell.xy + (corner * 0.5 + 0.5) * impostor.cell.zw, impostor.right.w);
+				surfacePos = impostor.center.xyz + impostor.right.xyz * corner.x + impostor.up.xyz * corner.y;
+				gl_Position = u_vp * vec4(surfacePos, 1.0);
+			}
+		)";
+
+		// A triangle covering the screen, resolved pixel by pixel from the visibility buffer
+		const auto* visibilityResolveVertexSource = R"(
+			#version 450 core
+
+			void main()
+			{
+				vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+
+		const auto* screenQuadVertexSource = R"(
+			#version 330 core
+
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec2 a_TextureCoords;
+
+			out vec2 TextureCoords;
+
+			void main()
+			{
+				gl_Position = vec4(a_Position.x, a_Position.y, 0.0, 1.0);
+				TextureCoords = a_TextureCoords;
+			}
+		)";
+
+		const auto* screenQuadFragmentSource = R"(
+			#version 330 core
+
+			out vec4 FragColor;
+
+			in vec2 TextureCoords;
+
+			uniform sampler2D screenTexture;
+
+			void main()
+			{
+				FragColor = texture(screenTexture, TextureCoords);
+			}
+		)";
+
+		const auto* debugVertexSource = R"(
+			#version 330 core
+
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec4 a_Color;
+
+			uniform mat4 u_vp;
+
+			out vec4 color;
+
+			void main()
+			{
+				gl_Position = u_vp * vec4(a_Position, 1.0);
+				gl_PointSize = 4.0;
+				color = a_Color;
+			}
+		)";
+
+		const auto* debugFragmentSource = R"(
+			#version 330 core
+
+			out vec4 FragColor;
+
+			in vec4 color;
+
+			void main()
+			{
+				FragColor = color;
+			}
+		)";
+
+		const auto* spriteVertexSource = R"(
+			#version 330 core
+
+			// Per-instance
+			layout(location = 0) in vec2  a_Position;
+			layout(location = 1) in vec2  a_Size;
+			layout(location = 2) in float a_Rotation;
+			layout(location = 3) in vec4  a_Color;
+
+			uniform mat4 u_vp;
+
+			out vec4 color;
+
+			void main()
+			{
+				// Triangle strip corners: (-.5, -.5), (.5, -.5), (-.5, .5), (.5, .5)
+				vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - 0.5;
+				float s = sin(a_Rotation);
+				float c = cos(a_Rotation);
+				vec2 local = corner * a_Size;
+
+				gl_Position = u_vp * vec4(a_Position + vec2(c * local.x - s * local.y, s * local.x + c * local.y), 0.0, 1.0);
+				color = a_Color;
+			}
+		)";
+
+		const auto* particleVertexSource = R"(
+			#version 330 core
+
+			// Per-instance
+			layout(location = 0) in vec3  a_Position;
+			layout(location = 1) in float a_Size;
+			layout(location = 2) in vec4  a_Color;
+
+			uniform mat4 u_vp;
+			uniform vec3 u_cameraRight;
+			uniform vec3 u_cameraUp;
+
+			out vec4 color;
+			out vec2 corner;
+
+			void main()
+			{
+				// Triangle strip corners, expanded along the camera's axes to face it
+				corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - 0.5;
+				vec3 offset = (u_cameraRight * corner.x + u_cameraUp * corner.y) * a_Size;
+
+				gl_Position = u_vp * vec4(a_Position + offset, 1.0);
+				color = a_Color;
+			}
+		)";
+
+		const auto* particleFragmentSource = R"(
+			#version 330 core
+
+			out vec4 FragColor;
+
+			in vec4 color;
+			in vec2 corner;
+
+			void main()
+			{
+				// Round, soft-edged particles
+				float falloff = 1.0 - smoothstep(0.25, 0.5, length(corner));
+				FragColor = vec4(color.rgb, color.a * falloff);
+			}
+		)";
+
+		const auto* overlayVertexSource = R"(
+			#version 330 core
+
+			// Per-instance
+			layout(location = 0) in vec2 a_Position;
+			layout(location = 1) in vec2 a_Size;
+			layout(location = 2) in uint a_Glyph;
+			layout(location = 3) in vec4 a_Color;
+
+			uniform vec2 u_screenSize;
+			uniform vec2 u_atlasCells;
+
+			out vec2 atlasCoords;
+			out vec4 color;
+
+			void main()
+			{
+				// Positions are in pixels from the top-left corner
+				vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+				vec2 pixel  = a_Position + corner * a_Size;
+				gl_Position = vec4(pixel.x / u_screenSize.x * 2.0 - 1.0, 1.0 - pixel.y / u_screenSize.y * 2.0, 0.0, 1.0);
+
+				uint columns = uint(u_atlasCells.x);
+				atlasCoords = (vec2(a_Glyph % columns, a_Glyph / columns) + corner) / u_atlasCells;
+				color = a_Color;
+			}
+		)";
+
+		const auto* overlayFragmentSource = R"(
+			#version 330 core
+
+			out vec4 FragColor;
+
+			in vec2 atlasCoords;
+			in vec4 color;
+
+			uniform sampler2D u_atlas;
+
+			void main()
+			{
+				FragColor = vec4(color.rgb, color.a * texture(u_atlas, atlasCoords).r);
+			}
+		)";
+
+		auto screenVShader = Objects::Shader(Objects::Shader::Type::Vertex, screenQuadVertexSource);
+		GAZE_ASSERT(screenVShader.Compile(), "Failed to compile Screen Vertex shader");
+		auto screenFShader = Objects::Shader(Objects::Shader::Type::Fragment, screenQuadFragmentSource);
+		GAZE_ASSERT(screenFShader.Compile(), "Failed to compile Screen Fragment shader");
+
+		auto debugVShader = Objects::Shader(Objects::Shader::Type::Vertex, debugVertexSource);
+		GAZE_ASSERT(debugVShader.Compile(), "Failed to compile Debug Vertex shader");
+		auto debugFShader = Objects::Shader(Objects::Shader::Type::Fragment, debugFragmentSource);
+		GAZE_ASSERT(debugFShader.Compile(), "Failed to compile Debug Fragment shader");
+
+		// Sprites are unlit and flat-colored, same as debug shapes
+		auto spriteVShader = Objects::Shader(Objects::Shader::Type::Vertex, spriteVertexSource);
+		GAZE_ASSERT(spriteVShader.Compile(), "Failed to compile Sprite Vertex shader");
+		auto spriteFShader = Objects::Shader(Objects::Shader::Type::Fragment, debugFragmentSource);
+		GAZE_ASSERT(spriteFShader.Compile(), "Failed to compile Sprite Fragment shader");
+
+		auto particleVShader = Objects::Shader(Objects::Shader::Type::Vertex, particleVertexSource);
+		GAZE_ASSERT(particleVShader.Compile(), "Failed to compile Particle Vertex shader");
+		auto particleFShader = Objects::Shader(Objects::Shader::Type::Fragment, particleFragmentSource);
+		GAZE_ASSERT(particleFShader.Compile(), "Failed to compile Particle Fragment shader");
+
+		auto overlayVShader = Objects::Shader(Objects::Shader::Type::Vertex, overlayVertexSource);
+		GAZE_ASSERT(overlayVShader.Compile(), "Failed to compile Overlay Vertex shader");
+		auto overlayFShader = Objects::Shader(Objects::Shader::Type::Fragment, overlayFragmentSource);
+		GAZE_ASSERT(overlayFShader.Compile(), "Failed to compile Overlay Fragment shader");
+
+		auto drawIDs = std::vector<F32>(kMaxPulledDraws);
+		for (auto i = std::size_t(0); i < drawIDs.size(); i++) {
+			drawIDs[i] = F32(i);
+		}
+
+		const ScreenQuadVertex screenQuadVertices[4] = {
+			{ -1.0F, -1.0F, 0.0F, 0.0F, 0.0F },
+			{  1.0F, -1.0F, 0.0F, 1.0F, 0.0F },
+			{ -1.0F,  1.0F, 0.0F, 0.0F, 1.0F },
+			{  1.0F,  1.0F, 0.0F, 1.0F, 1.0F },
+		};
+		const U32 screenQuadIndices[6] = {
+			0, 1, 2, 3
+		};
+
+		m_pImpl = new Impl({
+			.vertexArray          = {},
+			.screenVA             = {},
+			.screenVB             = Objects::VertexBuffer(screenQuadVertices, sizeof(screenQuadVertices), Objects::BufferUsage::StaticDraw),
+			.screenIB             = Objects::IndexBuffer(screenQuadIndices, sizeof(screenQuadIndices), Objects::BufferUsage::StaticDraw),
+			.screenProgram        = { &screenVShader, &screenFShader },
+			.debugVA              = {},
+			.debugProgram         = { &debugVShader, &debugFShader },
+			.debugStream          = Objects::StreamBuffer(kStaticBufferSize),
+			.spriteVA             = {},
+			.spriteProgram        = { &spriteVShader, &spriteFShader },
+			.spriteStream         = Objects::StreamBuffer(kSpriteBufferSize),
+			.particleVA           = {},
+			.particleProgram      = { &particleVShader, &particleFShader },
+			.particleStream       = Objects::StreamBuffer(kParticleBufferSize),
+			.overlayVA            = {},
+			.overlayProgram       = { &overlayVShader, &overlayFShader },
+			.overlayStream        = Objects::StreamBuffer(kOverlayBufferSize),
+			.fontAtlas            = Objects::Texture(Overlay::kAtlasWidth, Overlay::kAtlasHeight, GL_R8),
+			.pullVA               = {},
+			.meshShaders          = ShaderPermutations(meshVertexSource, meshFragmentSource, MeshShaderDefines),
+			.impostorShaders      = ShaderPermutations(impostorVertexSource, meshFragmentSource, ImpostorShaderDefines),
+			.visibilityShaders    = ShaderPermutations(visibilityResolveVertexSource, meshFragmentSource, VisibilityShaderDefines),
+			.gbufferShaders       = ShaderPermutations(meshVertexSource, meshFragmentSource, GBufferShaderDefines),
+			.lightShaders         = ShaderPermutations(kLightVolumeVertexSource, meshFragmentSource, LightShaderDefines),
+			.drawIDBuf            = Objects::VertexBuffer(drawIDs.data(), I64(drawIDs.size() * sizeof(F32)), Objects::BufferUsage::StaticDraw),
+			.drawStream           = Objects::StreamBuffer(kStaticBufferSize),
+			.indirectStream       = Objects::StreamBuffer(kIndirectBufferSize),
+			.skinnedVA            = {},
+			.paletteStream        = Objects::StreamBuffer(kPaletteBufferSize),
+			.vertexHeap           = BufferHeap(kMeshHeapPageSize),
+			.indexHeap            = BufferHeap(kMeshHeapPageSize),
+			.skinHeap             = BufferHeap(kSkinHeapPageSize),
+			.framebuffer          = {},
+			.resolveFramebuffer   = {},
+			.resolveMode          = ResolveMode::Direct,
+			.samples              = 1,
+			.vertexPulling        = false,
+			.skinningMode         = SkinningMode::GPU,
+			.skinningPool         = nullptr,
+			.storageAlignment     = 1,
+			.vertexBufSects       = {},
+			.vertexBufSectsCursor = {},
+			.indexBufSects        = {},
+			.indexBufSectsCursor  = {},
+			.sectionOrder         = {},
+			.residentMeshes       = {},
+			.sceneLights          = {},
+			.skinnedStream        = {},
+			.skinJobs             = {},
+			.cpuPalettes          = {},
+			.particleDraws        = {},
+			.terrain              = {},
+			.terrainTiles         = {},
+			.terrainChunks        = {},
+			.terrainDraws         = {},
+			.shadows              = {},
+			.shadowCasters        = nullptr,
+			.impostors            = {},
+			.visibility           = {},
+			.deferred             = {},
+			.textures             = {},
+			.textureArrays        = {},
+			.textureImages        = {},
+			.viewport             = { 0, 0, Window().Width(), Window().Height() },
+			.camera               = {
+				MakeShared<PerspectiveCamera>(
+					glm::radians(75.F),
+					F32(Window().Width()) / F32(Window().Height()),
+					.1F,
+					100.F
+				)
+			},
+			.stats                = {},
+			.statsCurrent         = {},
+			.logger               = Log::Logger("Renderer"),
+			.framesInFlight       = {},
+			.freeTimestampQueries = {},
+			.maxFramesInFlight    = kDefaultMaxFramesInFlight,
+			.frameBegin           = {},
+			.lastRender           = {},
+			.state                = {},
+			.capturer             = MakeUnique<FrameCapturer>(),
+			.captureRequests      = {},
+			.frameIndex           = 0
+		});
+
+		GAZE_ASSERT(m_pImpl->screenProgram.Link(), "Failed to link screen shader program");
+		GAZE_ASSERT(m_pImpl->debugProgram.Link(), "Failed to link debug shader program");
+		GAZE_ASSERT(m_pImpl->spriteProgram.Link(), "Failed to link sprite shader program");
+		GAZE_ASSERT(m_pImpl->particleProgram.Link(), "Failed to link particle shader program");
+		GAZE_ASSERT(m_pImpl->overlayProgram.Link(), "Failed to link overlay shader program");
+
+		// Compile the common variants up front, so they don't stall the first frames
+		for (const auto vertexPulling : { false, true }) {
+			m_pImpl->meshShaders.Get(MeshShaderKey(1, true, vertexPulling));
+			m_pImpl->meshShaders.Get(MeshShaderKey(kMaxLights, true, vertexPulling));
+		}
+		m_pImpl->meshShaders.Get(MeshShaderKey(kMaxLights, true, false, true));
+		m_pImpl->screenProgram.UploadUniform1I("screenTexture", 0);
+
+		m_pImpl->vertexBufSects.resize(kStaticBufferSize / sizeof(BufferSection));
+		m_pImpl->vertexBufSectsCursor = m_pImpl->vertexBufSects.begin();
+		m_pImpl->indexBufSects.resize(kStaticBufferSize / sizeof(BufferSection));
+		m_pImpl->indexBufSectsCursor = m_pImpl->indexBufSects.begin();
+
+		m_pImpl->vertexArray.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, x))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, nx))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, u))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(1),
+				Objects::VertexArray::Layout::ComponentCount(1),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(0)
+			},
+		});
+
+		// Skin weights come from a second buffer, bound per draw along with the vertices
+		m_pImpl->skinnedVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, x))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, nx))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::Vertex, u))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(1),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::UnsignedShort,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::SkinWeights, joints)),
+				Objects::VertexArray::Layout::Integer(true)
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(1),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Geometry::SkinWeights, weights))
+			},
+		});
+
+		m_pImpl->debugVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(DebugDraw::Vertex, position))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::UnsignedByte,
+				Objects::VertexArray::Layout::Normalized(true),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(DebugDraw::Vertex, color))
+			}
+		});
+		glVertexArrayVertexBuffer(
+			m_pImpl->debugVA.ID(),
+			0,
+			m_pImpl->debugStream.ID(),
+			0,
+			sizeof(DebugDraw::Vertex)
+		);
+
+		m_pImpl->spriteVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(SpriteBatch::Sprite, position))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(SpriteBatch::Sprite, size))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(1),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(SpriteBatch::Sprite, rotation))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::UnsignedByte,
+				Objects::VertexArray::Layout::Normalized(true),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(SpriteBatch::Sprite, color))
+			}
+		});
+		glVertexArrayVertexBuffer(
+			m_pImpl->spriteVA.ID(),
+			0,
+			m_pImpl->spriteStream.ID(),
+			0,
+			sizeof(SpriteBatch::Sprite)
+		);
+		m_pImpl->spriteVA.SetBindingDivisor(Objects::VertexArray::BufferBinding(0), 1);
+
+		m_pImpl->particleVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(ParticleEmitter::Instance, position))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(1),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(ParticleEmitter::Instance, size))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::UnsignedByte,
+				Objects::VertexArray::Layout::Normalized(true),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(ParticleEmitter::Instance, color))
+			}
+		});
+		glVertexArrayVertexBuffer(
+			m_pImpl->particleVA.ID(),
+			0,
+			m_pImpl->particleStream.ID(),
+			0,
+			sizeof(ParticleEmitter::Instance)
+		);
+		m_pImpl->particleVA.SetBindingDivisor(Objects::VertexArray::BufferBinding(0), 1);
+
+		m_pImpl->overlayVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Overlay::Quad, position))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Overlay::Quad, size))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(1),
+				Objects::VertexArray::Layout::DataType::UnsignedInt,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Overlay::Quad, glyph)),
+				Objects::VertexArray::Layout::Integer(true)
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(4),
+				Objects::VertexArray::Layout::DataType::UnsignedByte,
+				Objects::VertexArray::Layout::Normalized(true),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(Overlay::Quad, color))
+			}
+		});
+		glVertexArrayVertexBuffer(
+			m_pImpl->overlayVA.ID(),
+			0,
+			m_pImpl->overlayStream.ID(),
+			0,
+			sizeof(Overlay::Quad)
+		);
+		m_pImpl->overlayVA.SetBindingDivisor(Objects::VertexArray::BufferBinding(0), 1);
+
+		// Glyphs are magnified by whole pixels, nearest filtering keeps them crisp
+		const auto atlas = Overlay::BuildFontAtlas();
+		m_pImpl->fontAtlas.Upload(0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+		m_pImpl->fontAtlas.SetFilter(GL_NEAREST, GL_NEAREST);
+		m_pImpl->fontAtlas.SetWrap(GL_CLAMP_TO_EDGE);
+
+		m_pImpl->overlayProgram.UploadUniform1I("u_atlas", I32(kOverlayTextureUnit));
+		const F32 atlasCells[] = { F32(Overlay::kAtlasColumns), F32(Overlay::kAtlasRows) };
+		m_pImpl->overlayProgram.UploadUniform2FV("u_atlasCells", atlasCells);
+
+		m_pImpl->pullVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(1),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(0)
+			}
+		});
+		glVertexArrayVertexBuffer(m_pImpl->pullVA.ID(), 0, m_pImpl->drawIDBuf.ID(), 0, sizeof(F32));
+		m_pImpl->pullVA.SetBindingDivisor(Objects::VertexArray::BufferBinding(0), 1);
+
+		// The instanced mesh shaders read their draw ID next to the vertices
+		glVertexArrayVertexBuffer(m_pImpl->vertexArray.ID(), 1, m_pImpl->drawIDBuf.ID(), 0, sizeof(F32));
+		m_pImpl->vertexArray.SetBindingDivisor(Objects::VertexArray::BufferBinding(1), 1);
+
+		{
+			GLint alignment = 1;
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			m_pImpl->storageAlignment = std::max(I64(alignment), I64(1));
+		}
+
+		m_pImpl->state.SetEnabled(StateCache::Capability::ProgramPointSize, true);
+
+		m_pImpl->screenVA.SetIndexBuffer(&m_pImpl->screenIB);
+		m_pImpl->screenVA.SetLayout({
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(3),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(ScreenQuadVertex, x))
+			},
+			{
+				Objects::VertexArray::Layout::BufferBinding(0),
+				Objects::VertexArray::Layout::ComponentCount(2),
+				Objects::VertexArray::Layout::DataType::Float,
+				Objects::VertexArray::Layout::Normalized(false),
+				Objects::VertexArray::Layout::RelativeOffset(offsetof(ScreenQuadVertex, u))
+			}
+		});
+		m_pImpl->screenVA.BindVertexBuffer(
+			&m_pImpl->screenVB,
+			Objects::VertexArray::Layout::BufferBinding(0),
+			Objects::VertexArray::Offset(0),
+			Objects::VertexArray::Stride(sizeof(ScreenQuadVertex))
+		);
+
+		{
+			const GLubyte* info[] = {
+				glGetString(GL_VENDOR),
+				glGetString(GL_RENDERER),
+				glGetString(GL_VERSION),
+				glGetString(GL_SHADING_LANGUAGE_VERSION),
+			};
+
+			m_pImpl->logger.Info(
+				"OpenGL Info:\n  - Vendor: {}\n  - Renderer: {}\n  - Version: {}\n  - GLSL Version: {}",
+				info[0] ? reinterpret_cast<const char*>(info[0]) : "Unknown",
+				info[1] ? reinterpret_cast<const char*>(info[1]) : "Unknown",
+				info[2] ? reinterpret_cast<const char*>(info[2]) : "Unknown",
+				info[3] ? reinterpret_cast<const char*>(info[3]) : "Unknown"
+			);
+		}
+
+		if (oldCurrentContext) {
+			glfwMakeContextCurrent(oldCurrentContext);
+		}
+	}
+
+	Renderer::~Renderer()
+	{
+		for (auto& frame : m_pImpl->framesInFlight) {
+			glDeleteSync(frame.fence);
+			m_pImpl->freeTimestampQueries.push_back(frame.timestampQuery);
+		}
+		glDeleteQueries(GLsizei(m_pImpl->freeTimestampQueries.size()), m_pImpl->freeTimestampQueries.data());
+
+		delete m_pImpl;
+	}
+
+	auto Renderer::SetClearColor(F32 r, F32 g, F32 b, F32 a) noexcept -> void
+	{
+		glClearColor(r, g, b, a);
+	}
+
+	auto Renderer::Clear(Buffer buffer) noexcept -> void
+	{
+		auto bufferBits = 0U;
+
+		if (buffer & Buffer::kColorBuffer) {
+			bufferBits |= GL_COLOR_BUFFER_BIT;
+		}
+		if (buffer & Buffer::kDepthBuffer) {
+			bufferBits |= GL_DEPTH_BUFFER_BIT;
+		}
+		if (buffer & Buffer::kStencilBuffer) {
+			bufferBits |= GL_STENCIL_BUFFER_BIT;
+		}
+
+		BeginFrame();
+
+		BindRenderTarget();
+		glClear(bufferBits);
+	}
+
+	static auto ToGLPrimitiveMode(Renderer::PrimitiveMode mode) noexcept -> GLenum
+	{
+		using PrimitiveMode = Renderer::PrimitiveMode;
+
+		switch (mode) {
+		case PrimitiveMode::Points:        return GL_POINTS;
+		case PrimitiveMode::Lines:         return GL_LINES;
+		case PrimitiveMode::LineLoop:      return GL_LINE_LOOP;
+		case PrimitiveMode::LineStrip:     return GL_LINE_STRIP;
+		case PrimitiveMode::Triangles:     return GL_TRIANGLES;
+		case PrimitiveMode::TriangleStrip: return GL_TRIANGLE_STRIP;
+		case PrimitiveMode::TriangleFan:   return GL_TRIANGLE_FAN;
+		default:                           return GL_TRIANGLES;
+		}
+	}
+
+	/**
+	 * @brief Whether primitives drawn with a mode cover an area, and so cast shadows.
+	 */
+	static auto CastsShadows(Renderer::PrimitiveMode mode) noexcept -> bool
+	{
+		using PrimitiveMode = Renderer::PrimitiveMode;
+
+		return mode == PrimitiveMode::Triangles || mode == PrimitiveMode::TriangleStrip || mode == PrimitiveMode::TriangleFan;
+	}
+
+	/**
+	 * @brief Whether a section is drawn into the shadow maps each frame, rather than cached with the static casters.
+	 */
+	static auto IsDynamicCaster(const BufferSection& sect) noexcept -> bool
+	{
+		return !sect.properties.isStatic && CastsShadows(sect.mode);
+	}
+
+	auto Renderer::Flush() noexcept -> void
+	{
+		// The shadow maps are rendered by Render(), once every caster is known.
+		// Until then, sections are lit by the last frame's maps, and keep
+		// casting shadows into this frame's.
+		KeepShadowCasters();
+		DrawQueued();
+	}
+
+	auto Renderer::KeepShadowCasters() -> void
+	{
+		if (!m_pImpl->shadows) {
+			return;
+		}
+
+		const auto count = std::size_t(std::distance(m_pImpl->indexBufSects.begin(), m_pImpl->indexBufSectsCursor));
+		for (auto idx = std::size_t(0); idx < count; idx++) {
+			if (IsDynamicCaster(m_pImpl->indexBufSects[idx])) {
+				m_pImpl->shadows->flushedCasters.emplace_back(m_pImpl->indexBufSects[idx], m_pImpl->vertexBufSects[idx]);
+			}
+		}
+	}
+
+	auto Renderer::DrawQueued() noexcept -> void
+	{
+		SkinOnCPU();
+		BakeImpostors();
+		FlushTerrain();
+		FlushImpostors();
+
+		if (m_pImpl->indexBufSectsCursor == m_pImpl->indexBufSects.begin()) {
+			return;
+		}
+
+		const auto count    = std::size_t(std::distance(m_pImpl->indexBufSects.begin(), m_pImpl->indexBufSectsCursor));
+		const auto resolved = m_pImpl->visibility && DrawVisibility(count);
+
+		// Deferred, the remaining sections only write their surfaces, lit by ShadeDeferred()
+		auto& shaders = m_pImpl->deferred ? m_pImpl->gbufferShaders : m_pImpl->meshShaders;
+		if (m_pImpl->deferred) {
+			BindGBuffer();
+		} else {
+			BindRenderTarget();
+		}
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+
+		if (!resolved) {
+			DrawForward(shaders, 0, count);
+		} else {
+			// The runs of sections between those resolved from the visibility buffer
+			auto first = std::size_t(0);
+			while (first < count) {
+				if (IsVisibilityResolved(m_pImpl->indexBufSects[first])) {
+					first++;
+					continue;
+				}
+
+				auto last = first + 1;
+				while (last < count && !IsVisibilityResolved(m_pImpl->indexBufSects[last])) {
+					last++;
+				}
+
+				DrawForward(shaders, first, last);
+				first = last;
+			}
+		}
+
+		if (m_pImpl->deferred) {
+			ShadeDeferred();
+		}
+
+		m_pImpl->vertexBufSectsCursor = m_pImpl->vertexBufSects.begin();
+		m_pImpl->indexBufSectsCursor = m_pImpl->indexBufSects.begin();
+	}
+
+	auto Renderer::DrawForward(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> void
+	{
+		if (!m_pImpl->vertexPulling) {
+			DrawSections(shaders, first, last);
+			return;
+		}
+
+		// Skinned sections are drawn one by one; the rigid runs between them are pulled
+		const auto isSkinned = [this](std::size_t idx) {
+			return m_pImpl->indexBufSects[idx].skin.source != SkinSource::None;
+		};
+
+		while (first < last) {
+			auto end = first + 1;
+			while (end < last && isSkinned(end) == isSkinned(first)) {
+				end++;
+			}
+
+			DrawSections(shaders, isSkinned(first) ? first : DrawSectionsPulled(shaders, first, end), end);
+			first = end;
+		}
+	}
+
+	auto Renderer::DrawVisibility(std::size_t count) noexcept -> bool
+	{
+		static constexpr auto   kFloatSize   = I32(sizeof(F32));
+		static constexpr auto   kCommandSize = I64(sizeof(DrawArraysIndirectCommand));
+		static constexpr GLuint kClearIDs[]  = { 0, 0, 0, 0 };
+		static constexpr F32    kClearDepth  = 1.F;
+
+		auto& visibility = *m_pImpl->visibility;
+		auto& sections   = visibility.sections;
+		auto& groupEnds  = visibility.groupEnds;
+
+		// Grouped by the heap pages they are pulled from, bound as storage buffers by both passes
+		const auto pages = [this](std::size_t idx) {
+			return std::pair(m_pImpl->vertexBufSects[idx].page, m_pImpl->indexBufSects[idx].page);
+		};
+
+		sections.clear();
+		for (auto idx = std::size_t(0); idx < count; idx++) {
+			if (IsVisibilityResolved(m_pImpl->indexBufSects[idx])) {
+				sections.push_back(idx);
+			}
+		}
+		if (sections.empty()) {
+			return false;
+		}
+		std::ranges::stable_sort(sections, {}, pages);
+
+		const auto nDraws   = I64(sections.size());
+		const auto draws    = m_pImpl->drawStream.Allocate(nDraws * I64(sizeof(PulledDraw)), m_pImpl->storageAlignment);
+		const auto commands = m_pImpl->indirectStream.Allocate(nDraws * kCommandSize, kCommandSize);
+		if (!draws || !commands) {
+			m_pImpl->logger.Warn("Vertex pulling buffers are full, drawing {} sections forward", nDraws);
+			return false;
+		}
+
+		groupEnds.clear();
+		for (auto i = std::size_t(1); i <= sections.size(); i++) {
+			if (i == sections.size() || pages(sections[i]) != pages(sections[i - 1])) {
+				groupEnds.push_back(i);
+			}
+		}
+		SplitMultiDraws(groupEnds, kMaxPulledDraws, visibility.multiDraws);
+
+		const auto bindPages = [this](std::size_t idx) {
+			const auto& vertices = m_pImpl->vertexHeap.PageBuffer(m_pImpl->vertexBufSects[idx].page);
+			const auto& indices  = m_pImpl->indexHeap.PageBuffer(m_pImpl->indexBufSects[idx].page);
+
+			m_pImpl->state.BindStorageBuffer(kPullVertexBinding, vertices.ID(), 0, vertices.Size());
+			m_pImpl->state.BindStorageBuffer(kPullIndexBinding, indices.ID(), 0, indices.Size());
+		};
+
+		// Follows the viewport, which covers the render target
+		const auto& viewport = m_pImpl->viewport;
+		const auto  width    = viewport[0] + viewport[2];
+		const auto  height   = viewport[1] + viewport[3];
+		if (visibility.ids.Width() != width || visibility.ids.Height() != height) {
+			visibility.ids   = Objects::Texture(width, height, GL_RG32UI);
+			visibility.depth = Objects::Texture(width, height, GL_DEPTH_COMPONENT32F);
+			AttachVisibilityTargets(visibility);
+			// The old textures may still be cached as bound
+			m_pImpl->state.Invalidate();
+		}
+
+		const auto* shadows = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+		const auto  vp      = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+
+		auto* outDraws    = static_cast<PulledDraw*>(draws->data);
+		auto* outCommands = static_cast<DrawArraysIndirectCommand*>(commands->data);
+		for (const auto& multiDraw : visibility.multiDraws) {
+			for (auto i = multiDraw.first; i < multiDraw.first + multiDraw.count; i++) {
+				const auto& vertexSect = m_pImpl->vertexBufSects[sections[i]];
+				const auto& indexSect  = m_pImpl->indexBufSects[sections[i]];
+
+				auto draw = PackDraw(
+					indexSect.properties.transform,
+					indexSect.properties.material,
+					indexSect.lights,
+					indexSect.nLights,
+					indexSect.fade,
+					shadows
+				);
+				draw.vertexOffset = U32(vertexSect.offset / kFloatSize);
+				draw.vertexStride = U32(kVertexSize / kFloatSize);
+				draw.normalOffset = U32(offsetof(Geometry::Vertex, nx) / sizeof(F32));
+				draw.indexOffset  = U32(indexSect.offset / Mesh::kIndexSize);
+				draw.uvOffset     = U32(offsetof(Geometry::Vertex, u) / sizeof(F32));
+				draw.texture      = indexSect.texture;
+
+				outDraws[i]    = draw;
+				outCommands[i] = {
+					.count         = U32(indexSect.size / Mesh::kIndexSize),
+					.instanceCount = 1,
+					.first         = 0,
+					.baseInstance  = U32(i - multiDraw.first), // Offset by u_DrawBase, the multi-draw's first draw
+				};
+			}
+		}
+
+		// Draw and triangle IDs only: no lighting, however many layers overlap
+		m_pImpl->state.BindFramebuffer(visibility.framebuffer);
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+		m_pImpl->state.SetDepthMask(true);
+		glClearNamedFramebufferuiv(visibility.framebuffer.ID(), GL_COLOR, 0, kClearIDs);
+		glClearNamedFramebufferfv(visibility.framebuffer.ID(), GL_DEPTH, 0, &kClearDepth);
+
+		m_pImpl->state.UseProgram(visibility.program);
+		m_pImpl->state.BindVertexArray(m_pImpl->pullVA);
+		m_pImpl->state.BindStorageBuffer(kPullDrawBinding, m_pImpl->drawStream.ID(), draws->offset, nDraws * I64(sizeof(PulledDraw)));
+		m_pImpl->state.BindDrawIndirectBuffer(m_pImpl->indirectStream.ID());
+		visibility.program.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+
+		// Multi-draws stay within a group, so the group's pages are bound again only when it changes
+		for (const auto& multiDraw : visibility.multiDraws) {
+			bindPages(sections[multiDraw.first]);
+
+			visibility.program.UploadUniform1I("u_DrawBase", I32(multiDraw.first));
+			glMultiDrawArraysIndirect(
+				GL_TRIANGLES,
+				reinterpret_cast<const void*>(commands->offset + I64(multiDraw.first) * kCommandSize),
+				GLsizei(multiDraw.count),
+				0
+			);
+			m_pImpl->statsCurrent.nDrawCalls++;
+		}
+
+		// Shade every covered pixel once, writing the depth of its surface for what is drawn after
+		const auto inverseVP      = glm::inverse(vp);
+		const F32  viewportRect[] = { F32(viewport[0]), F32(viewport[1]), F32(viewport[2]), F32(viewport[3]) };
+
+		BindRenderTarget();
+		m_pImpl->state.BindTextureUnit(kVisibilityTextureUnit, visibility.ids.ID());
+		m_pImpl->state.BindTextureUnit(kVisibilityDepthUnit, visibility.depth.ID());
+
+		for (auto first = std::size_t(0); const auto end : groupEnds) {
+			bindPages(sections[first]);
+
+			// One variant per pass, covering the largest light count and any specular or textured material of its draws
+			auto maxLights = 0;
+			auto specular  = false;
+			auto textured  = false;
+			for (auto i = first; i < end; i++) {
+				const auto& sect = m_pImpl->indexBufSects[sections[i]];
+
+				maxLights = std::max(maxLights, LightBucket(sect.nLights));
+				specular  = specular || (sect.nLights > 0 && NeedsSpecular(sect.properties.material));
+				textured  = textured || sect.texture != 0;
+			}
+
+			auto& program = UseMeshShader(m_pImpl->visibilityShaders, MeshShaderKey(maxLights, specular, true, false, false, textured));
+			program.UploadUniform1I("u_Visibility", I32(kVisibilityTextureUnit));
+			program.UploadUniform1I("u_VisibilityDepth", I32(kVisibilityDepthUnit));
+			program.UploadUniformMatrix4FV("u_InverseVP", &(inverseVP[0][0]));
+			program.UploadUniform4FV("u_Viewport", viewportRect);
+			program.UploadUniform1I("u_FirstDraw", I32(first));
+			program.UploadUniform1I("u_EndDraw", I32(end));
+
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+			m_pImpl->statsCurrent.nDrawCalls++;
+
+			first = end;
+		}
+
+		return true;
+	}
+
+	auto Renderer::BindGBuffer() noexcept -> void
+	{
+		static constexpr F32 kClearAlbedo[] = { 0.F, 0.F, 0.F, 0.F };
+
+		auto& deferred = *m_pImpl->deferred;
+
+		// Follows the viewport, which covers the render target
+		const auto& viewport = m_pImpl->viewport;
+		const auto  width    = viewport[0] + viewport[2];
+		const auto  height   = viewport[1] + viewport[3];
+		if (deferred.albedo.Width() != width || deferred.albedo.Height() != height) {
+			deferred.albedo     = Objects::Texture(width, height, GL_RGBA8);
+			deferred.normals    = Objects::Texture(width, height, GL_RGB10_A2);
+			deferred.specular   = Objects::Texture(width, height, GL_RGBA8);
+			deferred.depth      = Objects::Texture(width, height, GL_DEPTH24_STENCIL8);
+			deferred.light      = Objects::Texture(width, height, GL_RGBA16F);
+			deferred.lightDepth = Objects::Renderbuffer(width, height);
+			AttachDeferredTargets(deferred);
+			// The old textures may still be cached as bound
+			m_pImpl->state.Invalidate();
+		}
+
+		// Only the albedo's lit flag and the depth are tested, the other targets are overwritten where they are
+		m_pImpl->state.BindFramebuffer(deferred.gbuffer);
+		m_pImpl->state.SetDepthMask(true);
+		glClearNamedFramebufferfv(deferred.gbuffer.ID(), GL_COLOR, 0, kClearAlbedo);
+		glClearNamedFramebufferfi(deferred.gbuffer.ID(), GL_DEPTH_STENCIL, 0, 1.F, 0);
+	}
+
+	auto Renderer::ShadeDeferred() noexcept -> void
+	{
+		static constexpr F32 kClearLight[] = { 0.F, 0.F, 0.F, 0.F };
+
+		using Capability = StateCache::Capability;
+
+		auto& deferred = *m_pImpl->deferred;
+		auto& state    = m_pImpl->state;
+
+		const auto& camera         = *m_pImpl->camera;
+		const auto& viewport       = m_pImpl->viewport;
+		const auto  vp             = camera.ComputeProjectionMatrix() * camera.ComputeViewMatrix();
+		const auto  inverseVP      = glm::inverse(vp);
+		const F32   viewportRect[] = { F32(viewport[0]), F32(viewport[1]), F32(viewport[2]), F32(viewport[3]) };
+
+		// A sphere reaching closer to the camera than its near plane's corners may be cut by it
+		auto nearReach = 0.F;
+		for (const auto x : { -1.F, 1.F }) {
+			for (const auto y : { -1.F, 1.F }) {
+				const auto corner = inverseVP * glm::vec4(x, y, -1.F, 1.F);
+				nearReach = std::max(nearReach, glm::distance(glm::vec3(corner) / corner.w, camera.Position()));
+			}
+		}
+
+		const auto defaultLight = DefaultLight();
+		const auto lights       = m_pImpl->sceneLights.IsEmpty() ? std::span<const Light>(&defaultLight, 1) : m_pImpl->sceneLights.Lights();
+		deferred.volumes.Build(lights, camera.Position(), nearReach);
+
+		// The lights test against and stencil a copy of the G-buffer's depth, which they read
+		const auto width  = deferred.albedo.Width();
+		const auto height = deferred.albedo.Height();
+		glBlitNamedFramebuffer(
+			deferred.gbuffer.ID(),
+			deferred.lightBuffer.ID(),
+			0, 0, width, height,
+			0, 0, width, height,
+			GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT,
+			GL_NEAREST
+		);
+		glClearNamedFramebufferfv(deferred.lightBuffer.ID(), GL_COLOR, 0, kClearLight);
+
+		state.BindFramebuffer(deferred.lightBuffer);
+		state.BindVertexArray(m_pImpl->pullVA); // Volumes are generated from the vertex ID, without attributes
+		state.BindTextureUnit(kGAlbedoTextureUnit, deferred.albedo.ID());
+		state.BindTextureUnit(kGNormalTextureUnit, deferred.normals.ID());
+		state.BindTextureUnit(kGSpecularTextureUnit, deferred.specular.ID());
+		state.BindTextureUnit(kGDepthTextureUnit, deferred.depth.ID());
+		state.SetEnabled(Capability::Blend, true);
+		state.SetBlendFunc(GL_ONE, GL_ONE);
+		state.SetDepthMask(false);
+		// Back faces beyond the far plane still bound what lies in front of them
+		state.SetEnabled(Capability::DepthClamp, true);
+
+		// One light at a time, with the specular term compiled in for any material of the G-buffer
+		const auto* shadows           = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+		auto&       sphereProgram     = UseMeshShader(m_pImpl->lightShaders, MeshShaderKey(1, true, false));
+		auto&       fullScreenProgram = UseMeshShader(m_pImpl->lightShaders, MeshShaderKey(1, true, false) | kFullScreenKeyBit);
+		for (auto* program : { &sphereProgram, &fullScreenProgram }) {
+			program->UploadUniform1I("u_GAlbedo", I32(kGAlbedoTextureUnit));
+			program->UploadUniform1I("u_GNormal", I32(kGNormalTextureUnit));
+			program->UploadUniform1I("u_GSpecular", I32(kGSpecularTextureUnit));
+			program->UploadUniform1I("u_GDepth", I32(kGDepthTextureUnit));
+			program->UploadUniformMatrix4FV("u_InverseVP", &(inverseVP[0][0]));
+			program->UploadUniform4FV("u_Viewport", viewportRect);
+		}
+		deferred.stencilProgram.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+
+		for (const auto& volume : deferred.volumes.Volumes()) {
+			// The ambient terms are added once, by the composite
+			auto light = lights[std::size_t(volume.light)];
+			light.ambientCoefficient = 0.F;
+
+			if (volume.shape == LightVolumes::Shape::FullScreen) {
+				state.SetEnabled(Capability::StencilTest, false);
+				state.SetEnabled(Capability::DepthTest, false);
+				state.SetEnabled(Capability::CullFace, false);
+				state.UseProgram(fullScreenProgram);
+				UploadLighting(fullScreenProgram, {}, &light, 1, 1, shadows);
+
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+				m_pImpl->statsCurrent.nDrawCalls++;
+				continue;
+			}
+
+			if (!volume.containsView) {
+				// Count the faces behind the surface: back ones up, front ones down. Nonzero where the surface is inside
+				state.SetEnabled(Capability::StencilTest, true);
+				state.SetEnabled(Capability::DepthTest, true);
+				state.SetDepthFunc(GL_LESS);
+				state.SetEnabled(Capability::CullFace, false);
+				state.UseProgram(deferred.stencilProgram);
+				deferred.stencilProgram.UploadUniform3FV("u_VolumeCenter", &(light.position[0]));
+				deferred.stencilProgram.UploadUniform1F("u_VolumeRadius", volume.radius);
+				glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+				glStencilFunc(GL_ALWAYS, 0, 0xFF);
+				glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+				glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+
+				glDrawArrays(GL_TRIANGLES, 0, kLightVolumeVertices);
+				m_pImpl->statsCurrent.nDrawCalls++;
+
+				// Shade each marked pixel once, from the back faces, clearing its stencil for the next light
+				glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+				glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
+				glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+				state.SetEnabled(Capability::DepthTest, false);
+			} else {
+				// The near plane may clip the front faces: shade the surfaces in front of the back faces instead
+				state.SetEnabled(Capability::StencilTest, false);
+				state.SetEnabled(Capability::DepthTest, true);
+				state.SetDepthFunc(GL_GEQUAL);
+			}
+
+			state.SetEnabled(Capability::CullFace, true);
+			state.SetCullFace(GL_FRONT);
+			state.UseProgram(sphereProgram);
+			sphereProgram.UploadUniform3FV("u_VolumeCenter", &(light.position[0]));
+			sphereProgram.UploadUniform1F("u_VolumeRadius", volume.radius);
+			UploadLighting(sphereProgram, {}, &light, 1, 1, shadows);
+
+			glDrawArrays(GL_TRIANGLES, 0, kLightVolumeVertices);
+			m_pImpl->statsCurrent.nDrawCalls++;
+		}
+
+		state.SetEnabled(Capability::StencilTest, false);
+		state.SetEnabled(Capability::CullFace, false);
+		state.SetEnabled(Capability::DepthClamp, false);
+		state.SetEnabled(Capability::Blend, false);
+		state.SetCullFace(GL_BACK);
+		state.SetDepthFunc(GL_LESS);
+		state.SetDepthMask(true);
+
+		// Over what was drawn forward, at the depth of the G-buffer's surfaces
+		BindRenderTarget();
+		state.SetEnabled(Capability::DepthTest, true);
+		state.UseProgram(deferred.compositeProgram);
+		state.BindTextureUnit(kLightTextureUnit, deferred.light.ID());
+		deferred.compositeProgram.UploadUniform1I("u_GAlbedo", I32(kGAlbedoTextureUnit));
+		deferred.compositeProgram.UploadUniform1I("u_GDepth", I32(kGDepthTextureUnit));
+		deferred.compositeProgram.UploadUniform1I("u_Light", I32(kLightTextureUnit));
+		deferred.compositeProgram.UploadUniform3FV("u_Ambient", &(deferred.volumes.Ambient()[0]));
+
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		m_pImpl->statsCurrent.nDrawCalls++;
+	}
+
+	auto Renderer::DrawSections(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> void
+	{
+		if (first == last) {
+			return;
+		}
+
+		const auto* shadows = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+
+		// Pick the tightest variant: lights beyond the section's bucket are neither uploaded nor looped over
+		const auto variantOf = [this](std::size_t idx) {
+			const auto& sect      = m_pImpl->indexBufSects[idx];
+			const auto  maxLights = LightBucket(sect.nLights);
+
+			return MeshShaderKey(
+				maxLights,
+				maxLights > 0 && NeedsSpecular(sect.properties.material),
+				false,
+				sect.skin.source == SkinSource::GPU,
+				sect.fade < 1.F,
+				sect.texture != 0
+			);
+		};
+		// Where a section's vertices and indices are; rigid sections drawing the same primitive share it
+		const auto primitiveOf = [this](std::size_t idx) {
+			const auto& sect       = m_pImpl->indexBufSects[idx];
+			const auto& vertexSect = m_pImpl->vertexBufSects[idx];
+
+			return std::tuple(vertexSect.page, vertexSect.offset, sect.page, sect.offset, sect.size, sect.mode);
+		};
+		const auto isInstanceOf = [&](std::size_t idx, std::size_t head) {
+			const auto isRigid = [this](std::size_t i) { return m_pImpl->indexBufSects[i].skin.source == SkinSource::None; };
+
+			return isRigid(idx) && isRigid(head) && variantOf(idx) == variantOf(head) && primitiveOf(idx) == primitiveOf(head);
+		};
+
+		// Grouped by variant, then by primitive: the same primitive submitted
+		// several times is drawn once, instanced, and the buffers switch less
+		auto& order = m_pImpl->sectionOrder;
+		order.resize(last - first);
+		std::iota(order.begin(), order.end(), first);
+		std::ranges::stable_sort(order, {}, [&](std::size_t idx) { return std::pair(variantOf(idx), primitiveOf(idx)); });
+
+		auto boundVertexBuffer = std::optional<U32>();
+		auto boundIndexPage    = std::optional<U32>();
+		auto boundVariant      = std::optional<ShaderPermutations::Key>();
+		auto* program          = static_cast<Objects::ShaderProgram*>(nullptr);
+
+		for (auto i = std::size_t(0); i < order.size();) {
+			auto end = i + 1;
+			while (end < order.size() && end - i < kMaxPulledDraws && isInstanceOf(order[end], order[i])) {
+				end++;
+			}
+
+			const auto& head       = m_pImpl->indexBufSects[order[i]];
+			const auto  nInstances = I64(end - i);
+			const auto  records    = nInstances > 1
+				? m_pImpl->drawStream.Allocate(nInstances * I64(sizeof(PulledDraw)), m_pImpl->storageAlignment)
+				: std::nullopt;
+			if (nInstances > 1 && !records) {
+				m_pImpl->logger.Warn("Vertex pulling buffers are full, drawing {} instances one by one", nInstances);
+			}
+
+			// Instanced, every section's transform, material and lights go into its draw record
+			if (records) {
+				auto* outRecords = static_cast<PulledDraw*>(records->data);
+				for (auto j = i; j < end; j++) {
+					const auto& sect = m_pImpl->indexBufSects[order[j]];
+
+					outRecords[j - i] = PackDraw(
+						sect.properties.transform,
+						sect.properties.material,
+						sect.lights,
+						sect.nLights,
+						sect.fade,
+						shadows
+					);
+					outRecords[j - i].texture = sect.texture;
+				}
+
+				const auto variant = variantOf(order[i]) | kInstancedKeyBit;
+				if (boundVariant != variant) {
+					program = &UseMeshShader(shaders, variant);
+					boundVariant = variant;
+				}
+
+				const auto baseVertex = BindSection(order[i], boundVertexBuffer, boundIndexPage);
+				m_pImpl->state.BindStorageBuffer(kPullDrawBinding, m_pImpl->drawStream.ID(), records->offset, nInstances * I64(sizeof(PulledDraw)));
+
+				glDrawElementsInstancedBaseVertex(
+					ToGLPrimitiveMode(head.mode),
+					head.size / Mesh::kIndexSize,
+					GL_UNSIGNED_INT,
+					reinterpret_cast<void*>(head.offset),
+					GLsizei(nInstances),
+					baseVertex
+				);
+				m_pImpl->statsCurrent.nDrawCalls++;
+				m_pImpl->statsCurrent.nInstancesMerged += I32(nInstances - 1);
+
+				i = end;
+				continue;
+			}
+
+			for (; i < end; i++) {
+				const auto  idx       = order[i];
+				const auto& sect      = m_pImpl->indexBufSects[idx];
+				const auto  maxLights = LightBucket(sect.nLights);
+				const auto  variant   = variantOf(idx);
+				if (boundVariant != variant) {
+					program = &UseMeshShader(shaders, variant);
+					boundVariant = variant;
+				}
+
+				const auto baseVertex = BindSection(idx, boundVertexBuffer, boundIndexPage);
+
+				UploadLighting(*program, sect.properties.material, sect.lights, sect.nLights, maxLights, shadows);
+				program->UploadUniformMatrix4FV("u_model", &(sect.properties.transform[0][0]));
+				if (sect.fade < 1.F) {
+					program->UploadUniform1F("u_Fade", sect.fade);
+				}
+				if (sect.texture != 0) {
+					program->UploadUniform1I("u_Texture", I32(sect.texture));
+				}
+
+				glDrawElementsBaseVertex(
+					ToGLPrimitiveMode(sect.mode),
+					sect.size / Mesh::kIndexSize,
+					GL_UNSIGNED_INT,
+					reinterpret_cast<void*>(sect.offset),
+					baseVertex
+				);
+				m_pImpl->statsCurrent.nDrawCalls++;
+			}
+		}
+	}
+
+	auto Renderer::BindSection(std::size_t idx, std::optional<U32>& boundVertexBuffer, std::optional<U32>& boundIndexPage) noexcept -> I32
+	{
+		return BindSection(m_pImpl->indexBufSects[idx], m_pImpl->vertexBufSects[idx], boundVertexBuffer, boundIndexPage);
+	}
+
+	auto Renderer::BindSection(
+		const BufferSection& sect,
+		const BufferSection& vertexSect,
+		std::optional<U32>& boundVertexBuffer,
+		std::optional<U32>& boundIndexPage
+	) noexcept -> I32
+	{
+		const auto& skin = sect.skin;
+
+		if (skin.source == SkinSource::GPU) {
+			// A base vertex would offset the skin weights as well, so both bindings start at the primitive instead
+			m_pImpl->state.BindVertexArray(m_pImpl->skinnedVA);
+			glVertexArrayVertexBuffer(
+				m_pImpl->skinnedVA.ID(),
+				0,
+				m_pImpl->vertexHeap.PageBuffer(vertexSect.page).ID(),
+				vertexSect.offset,
+				kVertexSize
+			);
+			glVertexArrayVertexBuffer(
+				m_pImpl->skinnedVA.ID(),
+				1,
+				m_pImpl->skinHeap.PageBuffer(skin.page).ID(),
+				skin.offset,
+				sizeof(Geometry::SkinWeights)
+			);
+			glVertexArrayElementBuffer(m_pImpl->skinnedVA.ID(), m_pImpl->indexHeap.PageBuffer(sect.page).ID());
+			m_pImpl->state.BindStorageBuffer(kPaletteBinding, m_pImpl->paletteStream.ID(), skin.paletteOffset, skin.paletteSize);
+
+			return 0;
+		}
+
+		m_pImpl->state.BindVertexArray(m_pImpl->vertexArray);
+
+		// CPU skinned vertices are drawn from the stream they were skinned into
+		auto vertexBuffer = m_pImpl->vertexHeap.PageBuffer(vertexSect.page).ID();
+		auto baseVertex   = vertexSect.offset / kVertexSize;
+		if (skin.source == SkinSource::CPU) {
+			vertexBuffer = m_pImpl->skinnedStream->ID();
+			baseVertex   = skin.offset / kVertexSize;
+		}
+
+		// Only switch buffers when the section lives in another one
+		if (boundVertexBuffer != vertexBuffer) {
+			glVertexArrayVertexBuffer(m_pImpl->vertexArray.ID(), 0, vertexBuffer, 0, kVertexSize);
+			boundVertexBuffer = vertexBuffer;
+		}
+		if (boundIndexPage != sect.page) {
+			glVertexArrayElementBuffer(m_pImpl->vertexArray.ID(), m_pImpl->indexHeap.PageBuffer(sect.page).ID());
+			boundIndexPage = sect.page;
+		}
+
+		return baseVertex;
+	}
+
+	auto Renderer::UseMeshShader(U32 variant) noexcept -> Objects::ShaderProgram&
+	{
+		return UseMeshShader(m_pImpl->meshShaders, variant);
+	}
+
+	auto Renderer::UseMeshShader(ShaderPermutations& shaders, U32 variant) noexcept -> Objects::ShaderProgram&
+	{
+		const auto& shadows = m_pImpl->shadows;
+		if (shadows && (variant & 0xFU) != 0) {
+			variant |= kShadowsKeyBit;
+		}
+
+		auto& program = shaders.Get(variant);
+		m_pImpl->state.UseProgram(program);
+
+		const auto vp = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+
+		program.UploadUniform3FV("u_ViewPos", &(m_pImpl->camera->Position()[0]));
+		program.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+
+		if ((variant & kShadowsKeyBit) != 0) {
+			UploadShadows(program, shadows->cache);
+			m_pImpl->state.BindTextureUnit(kCascadeTextureUnit, shadows->cascades.ID());
+			m_pImpl->state.BindTextureUnit(kPointShadowTextureUnit, shadows->points.ID());
+		}
+		if ((variant & kTexturedKeyBit) != 0) {
+			for (auto i = 0; i < TextureArrays::kMaxArrays; i++) {
+				program.UploadUniform1I(std::format("u_MaterialTextures[{}]", i), I32(kMaterialTextureUnit) + i);
+			}
+			for (auto i = std::size_t(0); i < m_pImpl->textureArrays.size(); i++) {
+				m_pImpl->state.BindTextureUnit(kMaterialTextureUnit + U32(i), m_pImpl->textureArrays[i].ID());
+			}
+		}
+
+		return program;
+	}
+
+	auto Renderer::DrawSectionsPulled(ShaderPermutations& shaders, std::size_t first, std::size_t last) noexcept -> std::size_t
+	{
+		static constexpr auto kFloatSize = I32(sizeof(F32));
+
+		m_pImpl->state.BindVertexArray(m_pImpl->pullVA);
+
+		const auto* shadows = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+
+		auto boundVariant = std::optional<ShaderPermutations::Key>();
+
+		while (first < last) {
+			const auto& head = m_pImpl->indexBufSects[first];
+
+			// A multi-draw shares its primitive mode, the heap pages bound as
+			// storage buffers and whether it is lit. Its shader variant covers
+			// the largest light count and any specular or textured material in
+			// the batch.
+			const auto isLit = [](const BufferSection& sect) { return sect.nLights > 0; };
+
+			auto maxLights = LightBucket(head.nLights);
+			auto specular  = isLit(head) && NeedsSpecular(head.properties.material);
+			auto fade      = head.fade < 1.F;
+			auto textured  = head.texture != 0;
+			auto end       = first + 1;
+			while (
+				end < last &&
+				end - first < kMaxPulledDraws &&
+				m_pImpl->indexBufSects[end].mode == head.mode &&
+				m_pImpl->indexBufSects[end].page == head.page &&
+				m_pImpl->vertexBufSects[end].page == m_pImpl->vertexBufSects[first].page &&
+				isLit(m_pImpl->indexBufSects[end]) == isLit(head)
+			) {
+				const auto& sect = m_pImpl->indexBufSects[end];
+
+				maxLights = std::max(maxLights, LightBucket(sect.nLights));
+				specular  = specular || (isLit(sect) && NeedsSpecular(sect.properties.material));
+				fade      = fade || sect.fade < 1.F;
+				textured  = textured || sect.texture != 0;
+				end++;
+			}
+
+			const auto nDraws   = I64(end - first);
+			const auto draws    = m_pImpl->drawStream.Allocate(nDraws * I64(sizeof(PulledDraw)), m_pImpl->storageAlignment);
+			const auto commands = m_pImpl->indirectStream.Allocate(nDraws * I64(sizeof(DrawArraysIndirectCommand)), I64(sizeof(DrawArraysIndirectCommand)));
+			if (!draws || !commands) {
+				m_pImpl->logger.Warn("Vertex pulling buffers are full, drawing the remaining {} sections one by one", last - first);
+				break;
+			}
+
+			auto* outDraws    = static_cast<PulledDraw*>(draws->data);
+			auto* outCommands = static_cast<DrawArraysIndirectCommand*>(commands->data);
+			for (auto i = first; i < end; i++) {
+				const auto& vertexSect = m_pImpl->vertexBufSects[i];
+				const auto& indexSect  = m_pImpl->indexBufSects[i];
+
+				auto draw = PackDraw(
+					indexSect.properties.transform,
+					indexSect.properties.material,
+					indexSect.lights,
+					indexSect.nLights,
+					indexSect.fade,
+					shadows
+				);
+				draw.vertexOffset = U32(vertexSect.offset / kFloatSize);
+				draw.vertexStride = U32(kVertexSize / kFloatSize);
+				draw.normalOffset = U32(offsetof(Geometry::Vertex, nx) / sizeof(F32));
+				draw.indexOffset  = U32(indexSect.offset / Mesh::kIndexSize);
+				draw.uvOffset     = U32(offsetof(Geometry::Vertex, u) / sizeof(F32));
+				draw.texture      = indexSect.texture;
+
+				outDraws[i - first]    = draw;
+				outCommands[i - first] = {
+					.count         = U32(indexSect.size / Mesh::kIndexSize),
+					.instanceCount = 1,
+					.first         = 0,
+					.baseInstance  = U32(i - first), // Selects the draw record through the instanced draw ID attribute
+				};
+			}
+
+			const auto& vertices = m_pImpl->vertexHeap.PageBuffer(m_pImpl->vertexBufSects[first].page);
+			const auto& indices  = m_pImpl->indexHeap.PageBuffer(head.page);
+
+			m_pImpl->state.BindStorageBuffer(kPullVertexBinding, vertices.ID(), 0, vertices.Size());
+			m_pImpl->state.BindStorageBuffer(kPullIndexBinding, indices.ID(), 0, indices.Size());
+			m_pImpl->state.BindStorageBuffer(kPullDrawBinding, m_pImpl->drawStream.ID(), draws->offset, nDraws * I64(sizeof(PulledDraw)));
+			m_pImpl->state.BindDrawIndirectBuffer(m_pImpl->indirectStream.ID());
+
+			const auto variant = MeshShaderKey(maxLights, specular, true, false, fade, textured);
+			if (boundVariant != variant) {
+				UseMeshShader(shaders, variant);
+				boundVariant = variant;
+			}
+
+			glMultiDrawArraysIndirect(ToGLPrimitiveMode(head.mode), reinterpret_cast<const void*>(commands->offset), GLsizei(nDraws), 0);
+			m_pImpl->statsCurrent.nDrawCalls++;
+
+			first = end;
+		}
+
+		return first;
+	}
+
+	auto Renderer::Render() noexcept -> void
+	{
+		// Every caster of the frame is known: skinned ones cast shadows in their pose
+		BeginFrame();
+		SkinOnCPU();
+		RenderShadows();
+		DrawQueued();
+		m_pImpl->drawStream.EndFrame();
+		m_pImpl->indirectStream.EndFrame();
+		m_pImpl->paletteStream.EndFrame();
+		if (m_pImpl->skinnedStream) {
+			m_pImpl->skinnedStream->EndFrame();
+		}
+		m_pImpl->cpuPalettes.clear();
+		FlushParticles();
+		FlushSprites();
+		FlushDebugDraw();
+		Resolve();
+		CaptureRequestedFrames();
+		FlushOverlay();
+		glfwSwapBuffers(static_cast<GLFWwindow*>(Window().Handle()));
+		PaceFrames();
+		MaintainMeshHeaps();
+		StreamTextures();
+		m_pImpl->capturer->Poll();
+
+		const auto stateCounters = m_pImpl->state.GetCounters();
+		m_pImpl->statsCurrent.nStateChanges       = I32(stateCounters.issued);
+		m_pImpl->statsCurrent.nStateChangesElided = I32(stateCounters.elided);
+		m_pImpl->state.ResetCounters();
+
+		m_pImpl->stats = m_pImpl->statsCurrent;
+		m_pImpl->statsCurrent = RenderStats();
+		m_pImpl->frameIndex++;
+	}
+
+	auto Renderer::SetResolveMode(ResolveMode mode, I32 samples) noexcept -> void
+	{
+		GAZE_ASSERT(samples > 0, "Sample count must be positive");
+
+		m_pImpl->resolveMode = mode;
+		m_pImpl->samples     = samples;
+		m_pImpl->framebuffer.reset();
+		m_pImpl->resolveFramebuffer.reset();
+		// Deleting the bound framebuffer silently rebinds the default one
+		m_pImpl->state.Invalidate();
+
+		if (mode == ResolveMode::Direct) {
+			if (samples > 1) {
+				m_pImpl->logger.Warn("Multisampling is not supported with ResolveMode::Direct. Ignoring.");
+			}
+			return;
+		}
+
+		const auto size = FramebufferSize(Window());
+		m_pImpl->framebuffer = MakeUnique<Objects::Framebuffer>(size.x, size.y, samples);
+
+		// The screen pass samples the color attachment as a regular texture, so
+		// multisampled targets have to be resolved into an intermediate one first.
+		if (mode == ResolveMode::ScreenPass && samples > 1) {
+			m_pImpl->resolveFramebuffer = MakeUnique<Objects::Framebuffer>(size.x, size.y);
+		}
+	}
+
+	auto Renderer::SetVSync(VSyncMode mode) noexcept -> void
+	{
+		auto* oldCurrentContext = glfwGetCurrentContext();
+		MakeContextCurrent();
+
+		auto interval = 0;
+		switch (mode) {
+		case VSyncMode::Off:
+			interval = 0;
+			break;
+		case VSyncMode::On:
+			interval = 1;
+			break;
+		case VSyncMode::Adaptive:
+			if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+				interval = -1;
+			} else {
+				m_pImpl->logger.Warn("Adaptive VSync is not supported. Falling back to VSync On.");
+				interval = 1;
+			}
+			break;
+		}
+		glfwSwapInterval(interval);
+
+		if (oldCurrentContext) {
+			glfwMakeContextCurrent(oldCurrentContext);
+		}
+	}
+
+	auto Renderer::SetVertexPulling(bool enabled) noexcept -> void
+	{
+		m_pImpl->vertexPulling = enabled;
+	}
+
+	auto Renderer::SetVisibilityBuffer(bool enabled) noexcept -> void
+	{
+		if (!enabled) {
+			m_pImpl->visibility.reset();
+			// Deleting the bound framebuffer silently rebinds the default one
+			m_pImpl->state.Invalidate();
+			return;
+		}
+
+		if (!m_pImpl->visibility) {
+			const auto& viewport = m_pImpl->viewport;
+			m_pImpl->visibility = MakeVisibilityResources(viewport[0] + viewport[2], viewport[1] + viewport[3]);
+		}
+	}
+
+	auto Renderer::SetDeferredShading(bool enabled) noexcept -> void
+	{
+		if (!enabled) {
+			m_pImpl->deferred.reset();
+			// Deleting the bound framebuffer silently rebinds the default one
+			m_pImpl->state.Invalidate();
+			return;
+		}
+
+		if (!m_pImpl->deferred) {
+			const auto& viewport = m_pImpl->viewport;
+			m_pImpl->deferred = MakeDeferredResources(viewport[0] + viewport[2], viewport[1] + viewport[3]);
+		}
+	}
+
+	auto Renderer::SetSkinning(SkinningMode mode, Jobs::ThreadPool* pool) noexcept -> void
+	{
+		// Sections already queued keep the mode they were submitted with
+		m_pImpl->skinningMode = mode;
+		m_pImpl->skinningPool = pool;
+
+		if (mode == SkinningMode::CPU && !m_pImpl->skinnedStream) {
+			m_pImpl->skinnedStream = MakeUnique<Objects::StreamBuffer>(kSkinnedBufferSize);
+		}
+	}
+
+	auto Renderer::SetShadows(std::optional<ShadowCache::Settings> settings) -> void
+	{
+		m_pImpl->shadows.reset();
+		// Deleting the bound framebuffer silently rebinds the default one
+		m_pImpl->state.Invalidate();
+
+		if (settings) {
+			m_pImpl->shadows = MakeShadowResources(*settings);
+		}
+	}
+
+	auto Renderer::SetStaticShadowCasters(const StaticBatcher* batcher) noexcept -> void
+	{
+		// Another batcher may well be at the same version
+		if (batcher != m_pImpl->shadowCasters && m_pImpl->shadows) {
+			m_pImpl->shadows->cache.Invalidate();
+		}
+
+		m_pImpl->shadowCasters = batcher;
+	}
+
+	auto Renderer::RenderShadows() noexcept -> void
+	{
+		auto* shadows = m_pImpl->shadows.get();
+		if (!shadows) {
+			return;
+		}
+
+		auto&       cache   = shadows->cache;
+		const auto* casters = m_pImpl->shadowCasters;
+		const auto  vp      = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+
+		cache.SetLights(m_pImpl->sceneLights.Lights());
+		cache.Update(vp, m_pImpl->camera->Position(), casters != nullptr ? casters->Version() : 0, m_pImpl->frameIndex);
+		if (cache.Views().empty()) {
+			shadows->flushedCasters.clear();
+			return;
+		}
+
+		const auto count   = std::size_t(std::distance(m_pImpl->indexBufSects.begin(), m_pImpl->indexBufSectsCursor));
+		const auto batches = casters != nullptr ? casters->Batches() : std::vector<const StaticBatcher::Batch*>();
+
+		m_pImpl->state.BindFramebuffer(shadows->framebuffer);
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+		m_pImpl->state.SetDepthMask(true);
+		// Against self-shadowing; cube maps store distances, biased when sampled instead
+		glPolygonOffset(2.F, 4.F);
+
+		for (const auto& view : cache.Views()) {
+			const auto  isCascade  = view.target == ShadowCache::Target::Cascade;
+			const auto  layer      = std::size_t(view.layer);
+			const auto& cached     = isCascade ? shadows->cascadeCache : shadows->pointCache;
+			const auto& sampled    = isCascade ? shadows->cascades : shadows->points;
+			auto&       hadDynamic = isCascade ? shadows->cascadeHadDynamic : shadows->pointHadDynamic;
+			const auto  frustum    = Frustum(view.viewProjection);
+
+			auto& dynamic = shadows->casters;
+			dynamic.clear();
+			for (const auto& [sect, vertexSect] : shadows->flushedCasters) {
+				if (frustum.Intersects(sect.bounds)) {
+					dynamic.emplace_back(&sect, &vertexSect);
+				}
+			}
+			for (auto idx = std::size_t(0); idx < count; idx++) {
+				const auto& sect = m_pImpl->indexBufSects[idx];
+				if (IsDynamicCaster(sect) && frustum.Intersects(sect.bounds)) {
+					dynamic.emplace_back(&sect, &m_pImpl->vertexBufSects[idx]);
+				}
+			}
+
+			// The sampled map already is the cache
+			if (!view.redrawStatic && dynamic.empty() && !hadDynamic[layer]) {
+				continue;
+			}
+
+			auto boundVariant = std::optional<ShaderPermutations::Key>();
+			auto* program     = static_cast<Objects::ShaderProgram*>(nullptr);
+			const auto useDepthShader = [&](bool skinned) {
+				const auto variant = (skinned ? 1U : 0U) | (isCascade ? 0U : 2U);
+				if (boundVariant == variant) {
+					return;
+				}
+
+				program = &shadows->depthShaders.Get(variant);
+				m_pImpl->state.UseProgram(*program);
+				program->UploadUniformMatrix4FV("u_vp", &(view.viewProjection[0][0]));
+				if (!isCascade) {
+					const auto& light = cache.PointShadows()[layer / 6];
+					program->UploadUniform3FV("u_LightPos", &(light.position[0]));
+					program->UploadUniform1F("u_Range", light.range);
+				}
+				boundVariant = variant;
+			};
+
+			m_pImpl->state.SetViewport(0, 0, cached.Width(), cached.Height());
+			m_pImpl->state.SetEnabled(StateCache::Capability::PolygonOffsetFill, isCascade);
+
+			if (view.redrawStatic) {
+				shadows->framebuffer.AttachLayer(cached, view.layer);
+				glClear(GL_DEPTH_BUFFER_BIT);
+
+				useDepthShader(false);
+				for (const auto* batch : batches) {
+					if (!frustum.Intersects(batch->bounds)) {
+						continue;
+					}
+
+					program->UploadUniformMatrix4FV("u_model", &(batch->object.GetProperties().transform[0][0]));
+					DrawResident(MakeResident(batch->object.SharedMesh()));
+				}
+				m_pImpl->statsCurrent.nShadowStaticRedraws++;
+			}
+
+			const auto target = GLenum(isCascade ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_CUBE_MAP_ARRAY);
+			glCopyImageSubData(
+				cached.ID(), target, 0, 0, 0, view.layer,
+				sampled.ID(), target, 0, 0, 0, view.layer,
+				cached.Width(), cached.Height(), 1
+			);
+
+			if (!dynamic.empty()) {
+				shadows->framebuffer.AttachLayer(sampled, view.layer);
+
+				auto boundVertexBuffer = std::optional<U32>();
+				auto boundIndexPage    = std::optional<U32>();
+				for (const auto& [sect, vertexSect] : dynamic) {
+					useDepthShader(sect->skin.source == SkinSource::GPU);
+					const auto baseVertex = BindSection(*sect, *vertexSect, boundVertexBuffer, boundIndexPage);
+					program->UploadUniformMatrix4FV("u_model", &(sect->properties.transform[0][0]));
+
+					glDrawElementsBaseVertex(
+						ToGLPrimitiveMode(sect->mode),
+						sect->size / Mesh::kIndexSize,
+						GL_UNSIGNED_INT,
+						reinterpret_cast<void*>(sect->offset),
+						baseVertex
+					);
+					m_pImpl->statsCurrent.nDrawCalls++;
+				}
+			}
+			hadDynamic[layer] = !dynamic.empty();
+		}
+
+		m_pImpl->state.SetEnabled(StateCache::Capability::PolygonOffsetFill, false);
+		shadows->flushedCasters.clear();
+		const auto& viewport = m_pImpl->viewport;
+		m_pImpl->state.SetViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	}
+
+	auto Renderer::DrawResident(const ResidentMesh& resident) noexcept -> void
+	{
+		m_pImpl->state.BindVertexArray(m_pImpl->vertexArray);
+
+		for (const auto& prim : resident.primitives) {
+			glVertexArrayVertexBuffer(
+				m_pImpl->vertexArray.ID(),
+				0,
+				m_pImpl->vertexHeap.PageBuffer(prim.vertices.page).ID(),
+				0,
+				kVertexSize
+			);
+			glVertexArrayElementBuffer(m_pImpl->vertexArray.ID(), m_pImpl->indexHeap.PageBuffer(prim.indices.page).ID());
+			glDrawElementsBaseVertex(
+				GL_TRIANGLES,
+				prim.indexSize / Mesh::kIndexSize,
+				GL_UNSIGNED_INT,
+				reinterpret_cast<void*>(m_pImpl->indexHeap.Offset(prim.indices)),
+				I32(m_pImpl->vertexHeap.Offset(prim.vertices) / kVertexSize)
+			);
+			m_pImpl->statsCurrent.nDrawCalls++;
+		}
+	}
+
+	auto Renderer::LoadTexture(const Shared<const TextureImage>& image) -> void
+	{
+		GAZE_ASSERT(image != nullptr, "Missing texture image");
+
+		if (m_pImpl->textureImages.contains(image->ID())) {
+			return;
+		}
+
+		const auto shape = TextureArrays::Shape{ image->GetFormat(), image->IsSRGB(), image->Width(), image->Height(), image->Levels() };
+		if (!m_pImpl->textures.Add(image->ID(), shape)) {
+			m_pImpl->logger.Warn("Texture arrays are full, texture {} is drawn untextured", image->ID());
+			return;
+		}
+
+		// Arrays are created with the first texture of their shape, with storage for every layer
+		auto& arrays = m_pImpl->textureArrays;
+		while (I32(arrays.size()) < m_pImpl->textures.Arrays()) {
+			const auto& arrayShape = m_pImpl->textures.ArrayShape(I32(arrays.size()));
+			auto&       array      = arrays.emplace_back(
+				GL_TEXTURE_2D_ARRAY,
+				arrayShape.width,
+				arrayShape.height,
+				TextureArrays::kLayersPerArray,
+				ToGLInternalFormat(arrayShape.format, arrayShape.isSRGB),
+				arrayShape.levels
+			);
+			array.SetFilter(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+			array.SetWrap(GL_REPEAT);
+		}
+
+		m_pImpl->textureImages.emplace(image->ID(), image);
+	}
+
+	auto Renderer::StreamTextures() noexcept -> void
+	{
+		// Released images give their layer back
+		std::erase_if(m_pImpl->textureImages, [this](const auto& entry) {
+			if (!entry.second.expired()) {
+				return false;
+			}
+
+			m_pImpl->textures.Remove(entry.first);
+			return true;
+		});
+
+		for (const auto& upload : m_pImpl->textures.Stream(kTextureStreamBudget)) {
+			const auto entry = m_pImpl->textureImages.find(upload.texture);
+			const auto image = entry != m_pImpl->textureImages.end() ? entry->second.lock() : nullptr;
+			if (!image) {
+				continue; // Released meanwhile, removed next frame
+			}
+
+			m_pImpl->textureArrays[std::size_t(upload.slot.array)].UploadCompressed(upload.level, upload.slot.layer, image->Level(upload.level));
+		}
+	}
+
+	auto Renderer::RequestTexture(TextureID texture, const AABB& bounds) noexcept -> U32
+	{
+		if (texture == kInvalidTextureID) {
+			return 0;
+		}
+
+		const auto residency = m_pImpl->textures.Find(texture);
+
+		// How large the object's bounding sphere is on screen, as for impostors; the texture is assumed to span it
+		const auto screenSize = ProjectedSize(*m_pImpl->camera, bounds.Center(), glm::length(bounds.Extents()), F32(m_pImpl->viewport[3]));
+		m_pImpl->textures.Request(texture, screenSize);
+
+		return residency ? PackTexture(*residency) : 0U;
+	}
+
+	auto Renderer::SetImpostors(std::optional<ImpostorAtlas::Settings> settings) -> void
+	{
+		m_pImpl->impostors.reset();
+		// Deleting the bound framebuffer silently rebinds the default one
+		m_pImpl->state.Invalidate();
+
+		// The slots went with the atlas
+		for (auto& [id, resident] : m_pImpl->residentMeshes) {
+			resident.impostor.reset();
+			resident.impostorBaked = false;
+		}
+
+		if (settings) {
+			m_pImpl->impostors = MakeImpostorResources(*settings);
+		}
+	}
+
+	auto Renderer::BakeImpostors() noexcept -> void
+	{
+		auto* impostors = m_pImpl->impostors.get();
+		if (!impostors || impostors->pending.empty()) {
+			return;
+		}
+
+		static constexpr F32 kClearColor[] = { .5F, .5F, .5F, 0.F }; // No coverage
+		static constexpr F32 kClearDepth   = 1.F;
+
+		const auto& atlas    = impostors->atlas;
+		const auto& settings = atlas.GetSettings();
+		const auto  cell     = settings.cellResolution;
+		const auto  nBakes   = std::min(impostors->pending.size(), std::size_t(settings.maxBakesPerFrame));
+
+		auto& program = impostors->bakeProgram;
+		m_pImpl->state.BindFramebuffer(impostors->framebuffer);
+		m_pImpl->state.UseProgram(program);
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+		m_pImpl->state.SetDepthMask(true);
+
+		for (auto i = std::size_t(0); i < nBakes; i++) {
+			// Gone since, along with its slot
+			const auto it = m_pImpl->residentMeshes.find(impostors->pending[i]);
+			if (it == m_pImpl->residentMeshes.end() || !it->second.impostor) {
+				continue;
+			}
+
+			auto&      resident = it->second;
+			const auto center   = resident.bounds.Center();
+			const auto radius   = glm::length(resident.bounds.Extents());
+
+			impostors->framebuffer.AttachLayer(impostors->texture, *resident.impostor);
+			glClearNamedFramebufferfv(impostors->framebuffer.ID(), GL_COLOR, 0, kClearColor);
+			glClearNamedFramebufferfv(impostors->framebuffer.ID(), GL_DEPTH, 0, &kClearDepth);
+
+			// Every view in its cell; they don't overlap, so they share the depth buffer
+			for (auto pitch = 0; pitch < settings.nPitch; pitch++) {
+				for (auto yaw = 0; yaw < settings.nYaw; yaw++) {
+					const auto vp = atlas.BakeViewProjection({ yaw, pitch }, center, radius);
+
+					m_pImpl->state.SetViewport(yaw * cell, pitch * cell, cell, cell);
+					program.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+					DrawResident(resident);
+				}
+			}
+			resident.impostorBaked = true;
+		}
+		impostors->pending.erase(impostors->pending.begin(), impostors->pending.begin() + std::ptrdiff_t(nBakes));
+
+		impostors->texture.GenerateMipmaps();
+
+		const auto& viewport = m_pImpl->viewport;
+		m_pImpl->state.SetViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	}
+
+	auto Renderer::FlushImpostors() noexcept -> void
+	{
+		auto* impostors = m_pImpl->impostors.get();
+		if (!impostors || impostors->draws.empty()) {
+			return;
+		}
+
+		const auto& queued    = impostors->draws;
+		const auto  count     = I64(queued.size());
+		const auto  draws     = m_pImpl->drawStream.Allocate(count * I64(sizeof(PulledDraw)), m_pImpl->storageAlignment);
+		const auto  instances = m_pImpl->drawStream.Allocate(count * I64(sizeof(ImpostorInstance)), m_pImpl->storageAlignment);
+		if (!draws || !instances) {
+			m_pImpl->logger.Warn("Vertex pulling buffers are full. Dropping {} impostors.", count);
+			impostors->draws.clear();
+			return;
+		}
+
+		const auto* shadows = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+
+		// One variant for the whole batch, covering its largest light count and any specular material
+		auto maxLights = 0;
+		auto specular  = false;
+		auto* outDraws     = static_cast<PulledDraw*>(draws->data);
+		auto* outInstances = static_cast<ImpostorInstance*>(instances->data);
+		for (const auto& draw : queued) {
+			*outDraws++     = PackDraw(draw.model, draw.material, draw.lights, draw.nLights, 1.F, shadows);
+			*outInstances++ = draw.instance;
+
+			maxLights = std::max(maxLights, LightBucket(draw.nLights));
+			specular  = specular || (draw.nLights > 0 && NeedsSpecular(draw.material));
+		}
+
+		BindRenderTarget();
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+		// The quads are expanded from the instances alone, any vertex array does
+		m_pImpl->state.BindVertexArray(m_pImpl->pullVA);
+		m_pImpl->state.BindStorageBuffer(kPullDrawBinding, m_pImpl->drawStream.ID(), draws->offset, count * I64(sizeof(PulledDraw)));
+		m_pImpl->state.BindStorageBuffer(kImpostorBinding, m_pImpl->drawStream.ID(), instances->offset, count * I64(sizeof(ImpostorInstance)));
+		m_pImpl->state.BindTextureUnit(kImpostorTextureUnit, impostors->texture.ID());
+
+		auto& program = UseMeshShader(m_pImpl->impostorShaders, MeshShaderKey(maxLights, specular, true));
+		program.UploadUniform1I("u_ImpostorAtlas", I32(kImpostorTextureUnit));
+
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(count));
+		m_pImpl->statsCurrent.nDrawCalls++;
+		m_pImpl->statsCurrent.nImpostors += I32(count);
+
+		impostors->draws.clear();
+	}
+
+	auto Renderer::SkinOnCPU() noexcept -> void
+	{
+		static constexpr auto kGrainSize = std::size_t(1);
+
+		auto& jobs = m_pImpl->skinJobs;
+		if (jobs.empty()) {
+			return;
+		}
+
+		const auto skin = [this](std::size_t begin, std::size_t end) {
+			for (auto i = begin; i < end; i++) {
+				const auto& job  = m_pImpl->skinJobs[i];
+				const auto& prim = job.mesh->Primitives()[job.primitive];
+
+				SkinVertices(
+					prim.vertices,
+					prim.skin,
+					std::span(m_pImpl->cpuPalettes).subspan(job.palette, job.nJoints),
+					std::span(job.out, prim.vertices.size())
+				);
+			}
+		};
+
+		// Each job writes its own range of the stream, so they can run in any order
+		if (m_pImpl->skinningPool != nullptr && jobs.size() > 1) {
+			m_pImpl->skinningPool->ParallelFor(jobs.size(), kGrainSize, skin);
+		} else {
+			skin(0, jobs.size());
+		}
+
+		jobs.clear();
+	}
+
+	auto Renderer::CaptureFrame(CaptureCallback callback) -> void
+	{
+		m_pImpl->captureRequests.push_back(std::move(callback));
+	}
+
+	auto Renderer::CaptureRequestedFrames() noexcept -> void
+	{
+		if (m_pImpl->captureRequests.empty()) {
+			return;
 		}
 
-		if (oldCurrentContext) {
-			glfwMakeContextCurrent(oldCurrentContext);
+		// The final image is in the window's back buffer, whatever the resolve mode
+		m_pImpl->state.BindFramebuffer(nullptr);
+
+		const auto size = FramebufferSize(Window());
+		for (auto& callback : m_pImpl->captureRequests) {
+			if (!m_pImpl->capturer->Capture(size.x, size.y, m_pImpl->frameIndex, std::move(callback))) {
+				m_pImpl->logger.Warn("Dropping capture of frame {}: too many captures in flight", m_pImpl->frameIndex);
+			}
 		}
+		m_pImpl->captureRequests.clear();
 	}
 
-	Renderer::~Renderer()
+	auto Renderer::SetMaxFramesInFlight(I32 nFrames) noexcept -> void
 	{
-		delete m_pImpl;
+		GAZE_ASSERT(nFrames > 0, "At least one frame must be allowed in flight");
+
+		m_pImpl->maxFramesInFlight = nFrames;
 	}
 
-	auto Renderer::SetClearColor(F32 r, F32 g, F32 b, F32 a) noexcept -> void
+	auto Renderer::BeginFrame() noexcept -> void
 	{
-		glClearColor(r, g, b, a);
+		if (!m_pImpl->frameBegin) {
+			m_pImpl->frameBegin = Clock::now();
+		}
 	}
 
-	auto Renderer::Clear(Buffer buffer) noexcept -> void
+	auto Renderer::PaceFrames() noexcept -> void
 	{
-		auto bufferBits = 0U;
+		static constexpr auto kFenceTimeout = GLuint64(1'000'000'000); // 1s, in nanoseconds
 
-		if (buffer & Buffer::kColorBuffer) {
-			bufferBits |= GL_COLOR_BUFFER_BIT;
+		auto& frames = m_pImpl->framesInFlight;
+		auto& stats  = m_pImpl->statsCurrent;
+		const auto now = Clock::now();
+
+		if (m_pImpl->lastRender) {
+			stats.frameTimeMs = ToMilliseconds(now - *m_pImpl->lastRender);
 		}
-		if (buffer & Buffer::kDepthBuffer) {
-			bufferBits |= GL_DEPTH_BUFFER_BIT;
+		m_pImpl->lastRender = now;
+		stats.presentLatencyMs = m_pImpl->stats.presentLatencyMs;
+
+		auto query = 0U;
+		if (m_pImpl->freeTimestampQueries.empty()) {
+			glCreateQueries(GL_TIMESTAMP, 1, &query);
+		} else {
+			query = m_pImpl->freeTimestampQueries.back();
+			m_pImpl->freeTimestampQueries.pop_back();
 		}
-		if (buffer & Buffer::kStencilBuffer) {
-			bufferBits |= GL_STENCIL_BUFFER_BIT;
+		glQueryCounter(query, GL_TIMESTAMP);
+
+		frames.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), query, m_pImpl->frameBegin.value_or(now) });
+		m_pImpl->frameBegin.reset();
+
+		// A failed wait says nothing about the frame, so it stays in flight
+		auto waitFailed = false;
+		const auto retireOldest = [&](GLuint64 timeout) {
+			const auto& frame  = frames.front();
+			const auto  status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			if (status == GL_WAIT_FAILED && !waitFailed) {
+				m_pImpl->logger.Error("Waiting for frame fence failed, {} frames in flight", frames.size());
+				waitFailed = true;
+			}
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+				return false;
+			}
+
+			// Polling only notices completion some time after the fact, so the
+			// GPU timestamp is converted to CPU time using the current offset
+			// between the two clocks.
+			auto gpuCompleted = GLint64();
+			auto gpuNow       = GLint64();
+			glGetQueryObjecti64v(frame.timestampQuery, GL_QUERY_RESULT, &gpuCompleted);
+			glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+
+			const auto completed = Clock::now() - std::chrono::nanoseconds(std::max(GLint64(0), gpuNow - gpuCompleted));
+			stats.presentLatencyMs = ToMilliseconds(completed - frame.submitBegin);
+
+			glDeleteSync(frame.fence);
+			m_pImpl->freeTimestampQueries.push_back(frame.timestampQuery);
+			frames.pop_front();
+
+			return true;
+		};
+
+		while (!frames.empty() && retireOldest(0)) {
 		}
 
-		m_pImpl->framebuffer.Bind();
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		const auto waitBegin = Clock::now();
+		while (!waitFailed && I32(frames.size()) > m_pImpl->maxFramesInFlight) {
+			retireOldest(kFenceTimeout);
+		}
 
-		Objects::Framebuffer::Unbind();
-		glClear(bufferBits);
+		stats.pacingWaitMs    = ToMilliseconds(Clock::now() - waitBegin);
+		stats.nFramesInFlight = I32(frames.size());
 	}
 
-	auto Renderer::Flush() noexcept -> void
+	auto Renderer::FlushParticles() noexcept -> void
 	{
-		m_pImpl->framebuffer.Bind();
-		m_pImpl->vertexArray.Bind();
-		m_pImpl->program.Use();
+		if (!m_pImpl->particleDraws.empty()) {
+			BindRenderTarget();
+			m_pImpl->state.BindVertexArray(m_pImpl->particleVA);
+			m_pImpl->state.UseProgram(m_pImpl->particleProgram);
 
-		const auto vp = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+			const auto view  = m_pImpl->camera->ComputeViewMatrix();
+			const auto vp    = m_pImpl->camera->ComputeProjectionMatrix() * view;
+			const auto right = glm::vec3(view[0][0], view[1][0], view[2][0]);
+			const auto up    = glm::vec3(view[0][1], view[1][1], view[2][1]);
+			m_pImpl->particleProgram.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+			m_pImpl->particleProgram.UploadUniform3FV("u_cameraRight", &right[0]);
+			m_pImpl->particleProgram.UploadUniform3FV("u_cameraUp", &up[0]);
+
+			// Hidden by objects, but unsorted particles must not hide each other
+			m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+			m_pImpl->state.SetDepthMask(false);
+			m_pImpl->state.SetEnabled(StateCache::Capability::Blend, true);
+			m_pImpl->state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+			for (const auto& draw : m_pImpl->particleDraws) {
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, GLsizei(draw.count), GLuint(draw.first));
+				m_pImpl->statsCurrent.nDrawCalls++;
+			}
+
+			// Clear() needs depth writes
+			m_pImpl->state.SetDepthMask(true);
+		}
 
-		m_pImpl->program.UploadUniform3FV("u_ViewPos", &(m_pImpl->camera->Position()[0]));
-		m_pImpl->program.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+		m_pImpl->particleStream.EndFrame();
+		m_pImpl->particleDraws.clear();
+	}
+
+	auto Renderer::FlushSprites() noexcept -> void
+	{
+		static constexpr auto kStride = I64(sizeof(SpriteBatch::Sprite));
+
+		auto& sprites = Sprites();
 
-		for (auto it = m_pImpl->indexBufSects.cbegin(); it != m_pImpl->indexBufSectsCursor; ++it) {
-			const auto& sect = *it;
-			auto drawMode = GLenum();
+		if (!sprites.Sprites().empty()) {
+			sprites.Sort();
 
-			switch (sect.mode) {
-			case PrimitiveMode::Points:        drawMode = GL_POINTS;         break;
-			case PrimitiveMode::Lines:         drawMode = GL_LINES;          break;
-			case PrimitiveMode::LineLoop:      drawMode = GL_LINE_LOOP;      break;
-			case PrimitiveMode::LineStrip:     drawMode = GL_LINE_STRIP;     break;
-			case PrimitiveMode::Triangles:     drawMode = GL_TRIANGLES;      break;
-			case PrimitiveMode::TriangleStrip: drawMode = GL_TRIANGLE_STRIP; break;
-			case PrimitiveMode::TriangleFan:   drawMode = GL_TRIANGLE_FAN;   break;
-			default:                           drawMode = GL_TRIANGLES;      break;
+			const auto& quads = sprites.Sprites();
+			const auto  count = std::min(I64(quads.size()), m_pImpl->spriteStream.Remaining(kStride) / kStride);
+			if (count < I64(quads.size())) {
+				m_pImpl->logger.Warn("Sprite buffer full. Dropping {} quads.", I64(quads.size()) - count);
 			}
 
-			for (auto i = 0; const auto& light : sect.lights) {
-				const auto uniform = std::format("u_Lights[{}]", i++);
+			const auto alloc = m_pImpl->spriteStream.Allocate(count * kStride, kStride);
+			if (alloc && count > 0) {
+				memcpy(alloc->data, quads.data(), std::size_t(count * kStride));
 
-				m_pImpl->program.UploadUniform3FV(std::format("{}.position", uniform), &(light.position[0]));
-				m_pImpl->program.UploadUniform3FV(std::format("{}.diffuse", uniform),  &(light.diffuse[0]));
-				m_pImpl->program.UploadUniform1F(std::format("{}.ambientCoefficient", uniform), light.ambientCoefficient);
-				m_pImpl->program.UploadUniform1F(std::format("{}.attenuation", uniform), light.attenuation);
+				BindRenderTarget();
+				m_pImpl->state.BindVertexArray(m_pImpl->spriteVA);
+				m_pImpl->state.UseProgram(m_pImpl->spriteProgram);
+
+				const auto vp = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+				m_pImpl->spriteProgram.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+
+				// Layer order alone decides what ends up on top
+				m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, false);
+				m_pImpl->state.SetEnabled(StateCache::Capability::Blend, true);
+				m_pImpl->state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, GLsizei(count), GLuint(alloc->offset / kStride));
+				m_pImpl->statsCurrent.nDrawCalls++;
 			}
-			m_pImpl->program.UploadUniform1I("u_nLights", sect.nLights);
+		}
 
-			m_pImpl->program.UploadUniformMatrix4FV("u_model", &(sect.properties.transform[0][0]));
-			m_pImpl->program.UploadUniform3FV("u_Material.diffuse", &(sect.properties.material.diffuse[0]));
-			m_pImpl->program.UploadUniform3FV("u_Material.specular", &(sect.properties.material.specular[0]));
-			m_pImpl->program.UploadUniform1F("u_Material.shininess", sect.properties.material.shininess);
+		m_pImpl->spriteStream.EndFrame();
+		sprites.Clear();
+	}
 
-			const auto idx = std::size_t(std::distance(m_pImpl->indexBufSects.cbegin(), it));
-			glDrawElementsBaseVertex(
-				drawMode,
-				sect.size / Mesh::kIndexSize,
-				GL_UNSIGNED_INT,
-				reinterpret_cast<void*>(sect.offset),
-				m_pImpl->vertexBufSects[idx].offset / Mesh::kVertexSize
-			);
-			m_pImpl->statsCurrent.nDrawCalls++;
+	auto Renderer::FlushDebugDraw() noexcept -> void
+	{
+		auto& debug = Debug();
+
+		if (!debug.Lines().empty() || !debug.Points().empty()) {
+			BindRenderTarget();
+			m_pImpl->state.BindVertexArray(m_pImpl->debugVA);
+			m_pImpl->state.UseProgram(m_pImpl->debugProgram);
+			m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+			m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+
+			const auto vp = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+			m_pImpl->debugProgram.UploadUniformMatrix4FV("u_vp", &(vp[0][0]));
+
+			const auto draw = [this](const std::vector<DebugDraw::Vertex>& vertices, GLenum mode, I64 nVerticesPerPrimitive) {
+				static constexpr auto kStride = I64(sizeof(DebugDraw::Vertex));
+
+				if (vertices.empty()) {
+					return;
+				}
+
+				auto count = std::min(I64(vertices.size()), m_pImpl->debugStream.Remaining(kStride) / kStride);
+				count -= count % nVerticesPerPrimitive;
+				if (count < I64(vertices.size())) {
+					m_pImpl->logger.Warn("Debug draw buffer full. Dropping {} vertices.", I64(vertices.size()) - count);
+				}
+
+				const auto alloc = m_pImpl->debugStream.Allocate(count * kStride, kStride);
+				if (!alloc || count == 0) {
+					return;
+				}
+
+				memcpy(alloc->data, vertices.data(), std::size_t(count * kStride));
+				glDrawArrays(mode, GLint(alloc->offset / kStride), GLsizei(count));
+				m_pImpl->statsCurrent.nDrawCalls++;
+			};
+
+			draw(debug.Lines(), GL_LINES, 2);
+			draw(debug.Points(), GL_POINTS, 1);
 		}
-		Objects::Framebuffer::Unbind();
-		glDisable(GL_DEPTH_TEST);
 
-		m_pImpl->screenVA.Bind();
-		m_pImpl->screenProgram.Use();
-		glBindTextureUnit(0, m_pImpl->framebuffer.ColorAttachmentID());
-		glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_INT, 0);
-		glEnable(GL_DEPTH_TEST);
+		m_pImpl->debugStream.EndFrame();
+		debug.Clear();
+	}
 
-		m_pImpl->vertexBufSectsCursor = m_pImpl->vertexBufSects.begin();
-		m_pImpl->indexBufSectsCursor = m_pImpl->indexBufSects.begin();
+	auto Renderer::FlushOverlay() noexcept -> void
+	{
+		static constexpr auto kStride = I64(sizeof(Overlay::Quad));
+
+		auto& overlay = Overlay();
+
+		if (overlay.IsVisible() && !overlay.Quads().empty()) {
+			const auto& quads = overlay.Quads();
+			const auto  count = std::min(I64(quads.size()), m_pImpl->overlayStream.Remaining(kStride) / kStride);
+			if (count < I64(quads.size())) {
+				m_pImpl->logger.Warn("Overlay buffer full. Dropping {} quads.", I64(quads.size()) - count);
+			}
+
+			const auto alloc = m_pImpl->overlayStream.Allocate(count * kStride, kStride);
+			if (alloc && count > 0) {
+				memcpy(alloc->data, quads.data(), std::size_t(count * kStride));
+
+				// Drawn straight into the window, over the resolved frame
+				m_pImpl->state.BindFramebuffer(nullptr);
+				m_pImpl->state.BindVertexArray(m_pImpl->overlayVA);
+				m_pImpl->state.UseProgram(m_pImpl->overlayProgram);
+				m_pImpl->state.BindTextureUnit(kOverlayTextureUnit, m_pImpl->fontAtlas.ID());
+
+				const auto size         = FramebufferSize(Window());
+				const F32  screenSize[] = { F32(size.x), F32(size.y) };
+				m_pImpl->overlayProgram.UploadUniform2FV("u_screenSize", screenSize);
+
+				m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, false);
+				m_pImpl->state.SetEnabled(StateCache::Capability::Blend, true);
+				m_pImpl->state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, GLsizei(count), GLuint(alloc->offset / kStride));
+				m_pImpl->statsCurrent.nDrawCalls++;
+			}
+		}
+
+		m_pImpl->overlayStream.EndFrame();
+		overlay.Clear();
 	}
 
-	auto Renderer::Render() noexcept -> void
+	auto Renderer::MaintainMeshHeaps() noexcept -> void
 	{
-		Flush();
-		glfwSwapBuffers(static_cast<GLFWwindow*>(Window().Handle()));
+		// Nothing refers to heap offsets anymore at this point, so meshes can
+		// be released and the rest moved around
+		std::erase_if(m_pImpl->residentMeshes, [this](const auto& entry) {
+			if (!entry.second.mesh.expired()) {
+				return false;
+			}
 
-		m_pImpl->stats = m_pImpl->statsCurrent;
-		m_pImpl->statsCurrent = RenderStats();
+			if (entry.second.impostor) {
+				m_pImpl->impostors->atlas.Release(*entry.second.impostor);
+			}
+			for (const auto& prim : entry.second.primitives) {
+				m_pImpl->vertexHeap.Free(prim.vertices);
+				m_pImpl->indexHeap.Free(prim.indices);
+				if (prim.skin) {
+					m_pImpl->skinHeap.Free(*prim.skin);
+				}
+			}
+			return true;
+		});
+
+		auto budget = I64(kDefragmentBudget);
+		budget -= m_pImpl->vertexHeap.Defragment(budget);
+		budget -= m_pImpl->indexHeap.Defragment(budget);
+		m_pImpl->skinHeap.Defragment(budget);
+
+		const auto vertexStats = m_pImpl->vertexHeap.GetStats();
+		const auto indexStats  = m_pImpl->indexHeap.GetStats();
+		const auto skinStats   = m_pImpl->skinHeap.GetStats();
+		m_pImpl->statsCurrent.meshMemoryBytes         = vertexStats.used + indexStats.used + skinStats.used;
+		m_pImpl->statsCurrent.meshMemoryFragmentation = std::max({
+			vertexStats.fragmentation,
+			indexStats.fragmentation,
+			skinStats.fragmentation
+		});
+	}
+
+	auto Renderer::BindRenderTarget() noexcept -> void
+	{
+		m_pImpl->state.BindFramebuffer(m_pImpl->framebuffer.get());
+	}
+
+	auto Renderer::Resolve() noexcept -> void
+	{
+		switch (m_pImpl->resolveMode) {
+		case ResolveMode::Direct:
+			break;
+		case ResolveMode::Blit:
+			m_pImpl->framebuffer->BlitTo(0);
+			break;
+		case ResolveMode::ScreenPass: {
+			auto colorAttachment = m_pImpl->framebuffer->ColorAttachmentID();
+			if (m_pImpl->resolveFramebuffer) {
+				m_pImpl->framebuffer->BlitTo(m_pImpl->resolveFramebuffer->ID());
+				colorAttachment = m_pImpl->resolveFramebuffer->ColorAttachmentID();
+			}
+
+			m_pImpl->state.BindFramebuffer(nullptr);
+			m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, false);
+			m_pImpl->state.BindVertexArray(m_pImpl->screenVA);
+			m_pImpl->state.UseProgram(m_pImpl->screenProgram);
+			m_pImpl->state.BindTextureUnit(0, colorAttachment);
+			glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_INT, 0);
+			break;
+		}
+		}
 	}
 
 	auto Renderer::MakeContextCurrent() noexcept -> void
@@ -496,6 +4307,18 @@ namespace Gaze::GFX::Platform::OpenGL {
 		glfwMakeContextCurrent(static_cast<GLFWwindow*>(Window().Handle()));
 	}
 
+	auto Renderer::ReleaseContext() noexcept -> void
+	{
+		if (glfwGetCurrentContext() == static_cast<GLFWwindow*>(Window().Handle())) {
+			glfwMakeContextCurrent(nullptr);
+		}
+	}
+
+	auto Renderer::Synchronize() noexcept -> void
+	{
+		// Everything is drawn as it is submitted, on the calling thread
+	}
+
 	auto Renderer::Stats() noexcept -> RenderStats
 	{
 		return m_pImpl->stats;
@@ -503,7 +4326,8 @@ namespace Gaze::GFX::Platform::OpenGL {
 
 	auto Renderer::SetViewport(I32 x, I32 y, I32 width, I32 height) noexcept -> void
 	{
-		glViewport(x, y, width, height);
+		m_pImpl->viewport = { x, y, width, height };
+		m_pImpl->state.SetViewport(x, y, width, height);
 	}
 
 	auto Renderer::SetCamera(Shared<Camera> camera) noexcept -> void
@@ -515,6 +4339,7 @@ namespace Gaze::GFX::Platform::OpenGL {
 	{
 		const auto lights = Light {
 			.position           = { 0.F, 0.F, 0.F },
+			.direction          = {},
 			.diffuse            = { 1.F, 1.F, 1.F },
 			.ambientCoefficient = 1.F,
 			.attenuation        = 1.F
@@ -536,10 +4361,12 @@ namespace Gaze::GFX::Platform::OpenGL {
 					.z = vert.position.z,
 					.nx = vert.normals.x,
 					.ny = vert.normals.y,
-					.nz = vert.normals.z
+					.nz = vert.normals.z,
+					.u = 0.F,
+					.v = 0.F
 				});
 			}
-			primitives.emplace_back(Geometry::Primitive { std::move(vertices), prim.indices });
+			primitives.emplace_back(Geometry::Primitive { std::move(vertices), prim.indices, {} });
 		}
 
 		SubmitObject(
@@ -554,100 +4381,465 @@ namespace Gaze::GFX::Platform::OpenGL {
 		);
 	}
 
+	auto Renderer::SetLights(const Light lights[], I32 nLights) -> void
+	{
+		m_pImpl->sceneLights.SetLights(lights, nLights);
+	}
+
 	auto Renderer::SubmitObject(const Object& object, PrimitiveMode mode) -> void
 	{
-		const auto lights = Light {
-			.position           = { 0.F, 0.F, 0.F },
-			.diffuse            = { 1.F, 1.F, 1.F },
-			.ambientCoefficient = 1.F,
-			.attenuation        = 1.F
+		SubmitObject(object, object.GetProperties().transform, mode);
+	}
+
+	auto Renderer::SubmitObject(const Object& object, const glm::mat4& transform, PrimitiveMode mode) -> void
+	{
+		Light lights[kMaxLights];
+		const auto nLights = SelectLights(TransformBounds(MakeResident(object.SharedMesh()).bounds, transform), lights);
+
+		SubmitObject(object, transform, lights, nLights, mode);
+	}
+
+	auto Renderer::SubmitSkinned(
+		const Object& object,
+		const glm::mat4& transform,
+		std::span<const glm::mat4> palette,
+		PrimitiveMode mode
+	) -> void
+	{
+		const auto& resident = MakeResident(object.SharedMesh());
+
+		Light lights[kMaxLights];
+		const auto nLights = SelectLights(TransformBounds(resident.bounds, transform), lights);
+
+		// Both skinning paths index the palette with the weights' joints unchecked
+		if (palette.size() < resident.nJoints) {
+			m_pImpl->logger.Warn("Skinning palette has {} joints, mesh {} needs {}. Drawing in bind pose.", palette.size(), object.SharedMesh().ID(), resident.nJoints);
+			palette = {};
+		}
+
+		Submit(object, transform, lights, nLights, mode, palette);
+	}
+
+	auto Renderer::SubmitWithImpostor(const Object& object, const glm::mat4& transform) -> void
+	{
+		auto*      impostors = m_pImpl->impostors.get();
+		auto&      resident  = MakeResident(object.SharedMesh());
+		const auto center    = resident.bounds.Center();
+		const auto radius    = glm::length(resident.bounds.Extents());
+		if (!impostors || radius <= 0.F) {
+			SubmitObject(object, transform, PrimitiveMode::Triangles);
+			return;
+		}
+
+		auto&       atlas      = impostors->atlas;
+		const auto& camera     = *m_pImpl->camera;
+		const auto  billboard  = atlas.MakeBillboard(transform, center, radius, camera.Position());
+		const auto  screenSize = ProjectedSize(camera, billboard.center, glm::length(billboard.up), F32(m_pImpl->viewport[3]));
+
+		// Drawn as a mesh until its impostor is baked
+		auto weights = atlas.Blend(screenSize);
+		if (weights.impostor > 0.F && !resident.impostorBaked) {
+			if (!resident.impostor) {
+				resident.impostor = atlas.Acquire();
+				if (resident.impostor) {
+					impostors->pending.push_back(object.SharedMesh().ID());
+				}
+			}
+			weights = { 1.F, 0.F };
+		}
+
+		Light lights[kMaxLights];
+		const auto nLights = SelectLights(TransformBounds(resident.bounds, transform), lights);
+
+		if (weights.mesh > 0.F) {
+			Submit(object, transform, lights, nLights, PrimitiveMode::Triangles, {}, weights.mesh);
+		}
+		if (weights.impostor > 0.F) {
+			const auto& settings = atlas.GetSettings();
+			const auto  cellSize = glm::vec2(1.F / F32(settings.nYaw), 1.F / F32(settings.nPitch));
+			const auto  corner   = glm::vec2(billboard.cell) * cellSize;
+
+			auto draw = ImpostorDraw{
+				.model    = transform,
+				.material = object.GetProperties().material,
+				.lights   = {},
+				.nLights  = nLights,
+				.instance = {
+					.center = glm::vec4(billboard.center, weights.impostor),
+					.right  = glm::vec4(billboard.right, F32(*resident.impostor)),
+					.up     = glm::vec4(billboard.up, 0.F),
+					.cell   = glm::vec4(corner.x, corner.y, cellSize.x, cellSize.y),
+				},
+			};
+			std::copy_n(lights, nLights, draw.lights);
+
+			impostors->draws.push_back(draw);
+		}
+	}
+
+	auto Renderer::SubmitParticles(const ParticleEmitter& emitter) -> void
+	{
+		// Straight into the mapping, the particles are never copied on the CPU
+		const auto instances = AllocateParticles(emitter.Count());
+		if (!instances.empty()) {
+			emitter.WriteInstances(instances);
+		}
+	}
+
+	auto Renderer::SubmitParticles(std::span<const ParticleEmitter::Instance> instances) -> void
+	{
+		const auto out = AllocateParticles(instances.size());
+		std::copy_n(instances.begin(), out.size(), out.begin());
+	}
+
+	auto Renderer::AllocateParticles(std::size_t count) -> std::span<ParticleEmitter::Instance>
+	{
+		static constexpr auto kStride = I64(sizeof(ParticleEmitter::Instance));
+
+		const auto total     = I64(count);
+		const auto allocated = std::min(total, m_pImpl->particleStream.Remaining(kStride) / kStride);
+		if (allocated < total) {
+			m_pImpl->logger.Warn("Particle buffer full. Dropping {} particles.", total - allocated);
+		}
+
+		const auto alloc = m_pImpl->particleStream.Allocate(allocated * kStride, kStride);
+		if (!alloc || allocated == 0) {
+			return {};
+		}
+
+		m_pImpl->particleDraws.push_back({ alloc->offset / kStride, allocated });
+		return { static_cast<ParticleEmitter::Instance*>(alloc->data), std::size_t(allocated) };
+	}
+
+	auto Renderer::SubmitTerrain(const Terrain& terrain) -> void
+	{
+		const auto& settings = terrain.GetSettings();
+
+		// Every resident tile, those already uploaded are skipped by their version
+		auto& tiles = m_pImpl->terrainTiles;
+		tiles.clear();
+		for (const auto& tile : terrain.Tiles()) {
+			tiles.push_back({ tile.slot, tile.version, tile.vertices });
+		}
+
+		const auto vp = m_pImpl->camera->ComputeProjectionMatrix() * m_pImpl->camera->ComputeViewMatrix();
+		terrain.Select(Frustum(vp), m_pImpl->terrainChunks);
+
+		SubmitTerrain(Terrain::Snapshot{
+			.tileResolution   = settings.tileResolution,
+			.chunkResolution  = settings.chunkResolution,
+			.maxResidentTiles = settings.maxResidentTiles,
+			.material         = settings.material,
+			.tiles            = tiles,
+			.chunks           = m_pImpl->terrainChunks,
+		});
+	}
+
+	auto Renderer::SubmitTerrain(const Terrain::Snapshot& snapshot) -> void
+	{
+		static constexpr auto kStride = I64(sizeof(DrawElementsIndirectCommand));
+
+		// One terrain at a time; another layout replaces the GPU copy
+		auto& gpu = m_pImpl->terrain;
+		if (
+			!gpu ||
+			gpu->tileResolution != snapshot.tileResolution ||
+			gpu->chunkResolution != snapshot.chunkResolution ||
+			gpu->maxResidentTiles != snapshot.maxResidentTiles
+		) {
+			gpu = MakeTerrainResources(snapshot);
+		}
+
+		const auto verticesPerTile = I64(snapshot.tileResolution + 1) * (snapshot.tileResolution + 1);
+		const auto slotSize        = verticesPerTile * I64(sizeof(Terrain::Vertex));
+		for (const auto& tile : snapshot.tiles) {
+			GAZE_ASSERT(I64(tile.vertices.size()) == verticesPerTile, "Terrain tile of the wrong size");
+
+			auto& uploaded = gpu->slotVersions[std::size_t(tile.slot)];
+			if (uploaded != tile.version) {
+				gpu->vertices.Upload(tile.vertices.data(), slotSize, tile.slot * slotSize);
+				uploaded = tile.version;
+				m_pImpl->statsCurrent.uploadedBytes += slotSize;
+			}
+		}
+
+		const auto& chunks = snapshot.chunks;
+		if (chunks.empty()) {
+			return;
+		}
+
+		const auto count    = I64(chunks.size());
+		const auto commands = m_pImpl->indirectStream.Allocate(count * kStride, I64(sizeof(U32)));
+		if (!commands) {
+			m_pImpl->logger.Warn("Indirect buffer full. Dropping {} terrain chunks.", count);
+			return;
+		}
+
+		auto* out    = static_cast<DrawElementsIndirectCommand*>(commands->data);
+		auto  bounds = chunks.front().bounds;
+		for (const auto& chunk : chunks) {
+			const auto& range = gpu->ranges[std::size_t(chunk.lod * Terrain::kStitchVariants + chunk.stitches)];
+
+			*out++ = {
+				.count         = range.count,
+				.instanceCount = 1,
+				.firstIndex    = range.first,
+				.baseVertex    = I32(chunk.slot * verticesPerTile + chunk.firstVertex),
+				.baseInstance  = 0,
+			};
+			bounds = MergeBounds(bounds, chunk.bounds);
+		}
+
+		auto draw = TerrainDraw{
+			.commandOffset = commands->offset,
+			.count         = count,
+			.material      = snapshot.material,
+			.lights        = {},
+			.nLights       = 0,
 		};
+		draw.nLights = SelectLights(bounds, draw.lights);
+
+		m_pImpl->terrainDraws.push_back(draw);
+	}
 
-		SubmitObject(object, &lights, 1, mode);
+	auto Renderer::FlushTerrain() noexcept -> void
+	{
+		if (m_pImpl->terrainDraws.empty()) {
+			return;
+		}
+
+		BindRenderTarget();
+		m_pImpl->state.SetEnabled(StateCache::Capability::DepthTest, true);
+		m_pImpl->state.SetEnabled(StateCache::Capability::Blend, false);
+		m_pImpl->state.BindVertexArray(m_pImpl->terrain->vertexArray);
+		m_pImpl->state.BindDrawIndirectBuffer(m_pImpl->indirectStream.ID());
+
+		static const auto kIdentity = glm::mat4(1.F);
+
+		const auto* shadows = m_pImpl->shadows ? &m_pImpl->shadows->cache : nullptr;
+
+		for (const auto& draw : m_pImpl->terrainDraws) {
+			const auto maxLights = LightBucket(draw.nLights);
+
+			auto& program = UseMeshShader(MeshShaderKey(maxLights, maxLights > 0 && NeedsSpecular(draw.material), false));
+			UploadLighting(program, draw.material, draw.lights, draw.nLights, maxLights, shadows);
+			program.UploadUniformMatrix4FV("u_model", &(kIdentity[0][0]));
+
+			// Every chunk of the terrain, at any level of detail, in a single call
+			glMultiDrawElementsIndirect(
+				GL_TRIANGLES,
+				GL_UNSIGNED_INT,
+				reinterpret_cast<const void*>(draw.commandOffset),
+				GLsizei(draw.count),
+				0
+			);
+			m_pImpl->statsCurrent.nDrawCalls++;
+		}
+
+		m_pImpl->terrainDraws.clear();
+	}
+
+	auto Renderer::SelectLights(const AABB& bounds, Light lights[]) const noexcept -> I32
+	{
+		if (m_pImpl->sceneLights.IsEmpty()) {
+			lights[0] = DefaultLight();
+
+			return 1;
+		}
+
+		return m_pImpl->sceneLights.Select(bounds, kMaxLights, lights);
 	}
 
 	auto Renderer::SubmitObject(const Object& object, const Light lights[], I32 nLights, PrimitiveMode mode) -> void
 	{
-		GAZE_ASSERT(lights != nullptr, "Missing lights");
-		GAZE_ASSERT(nLights > 0, "Must provide at least 1 light source");
+		SubmitObject(object, object.GetProperties().transform, lights, nLights, mode);
+	}
+
+	auto Renderer::SubmitObject(
+		const Object& object,
+		const glm::mat4& transform,
+		const Light lights[],
+		I32 nLights,
+		PrimitiveMode mode
+	) -> void
+	{
+		Submit(object, transform, lights, nLights, mode, {});
+	}
+
+	auto Renderer::Submit(
+		const Object& object,
+		const glm::mat4& transform,
+		const Light lights[],
+		I32 nLights,
+		PrimitiveMode mode,
+		std::span<const glm::mat4> palette,
+		F32 fade
+	) -> void
+	{
+		GAZE_ASSERT(nLights == 0 || lights != nullptr, "Missing lights");
+		GAZE_ASSERT(nLights >= 0, "Light count must not be negative");
 		GAZE_ASSERT(nLights <= 8, "Each Mesh may have a maximum of 8 light sources influencing it");
 
-		const auto& mesh = object.Mesh();
+		BeginFrame();
 
-		{
-			auto offset = 0;
+		const auto& mesh = object.SharedMesh();
 
-			for (auto it = mesh.Primitives().cbegin(); it != mesh.Primitives().cend(); ++it) {
-				const auto& prim = *it;
+		auto props = object.GetProperties();
+		props.transform = transform;
 
-				if (m_pImpl->vertexBufSectsCursor != m_pImpl->vertexBufSects.begin()) {
-					const auto& last = m_pImpl->vertexBufSectsCursor - 1;
-					offset = last->offset + last->size;
-				}
+		static_assert(std::is_standard_layout_v<Light> && std::is_trivially_copyable_v<Light>);
+
+		const auto isSkinned   = !palette.empty() && mesh->IsSkinned();
+		const auto skinOnGPU   = m_pImpl->skinningMode == SkinningMode::GPU;
+		const auto paletteSize = I64(palette.size_bytes());
+
+		// The object's primitives share one copy of the joint matrices
+		auto gpuPalette = std::optional<Objects::StreamBuffer::Allocation>();
+		auto cpuPalette = m_pImpl->cpuPalettes.size();
+		if (isSkinned && skinOnGPU) {
+			gpuPalette = m_pImpl->paletteStream.Allocate(paletteSize, m_pImpl->storageAlignment);
+			if (gpuPalette) {
+				memcpy(gpuPalette->data, palette.data(), palette.size_bytes());
+			} else {
+				m_pImpl->logger.Warn("Skinning palette buffer full. Drawing in bind pose.");
+			}
+		} else if (isSkinned) {
+			m_pImpl->cpuPalettes.insert(m_pImpl->cpuPalettes.end(), palette.begin(), palette.end());
+		}
 
-				if (offset > m_pImpl->vertexBufSects.size()) {
-					Flush();
-					offset = 0;
+		const auto skinSection = [&](const ResidentPrimitive& prim) {
+			auto skin = SkinSection{ SkinSource::None, 0, 0, 0, 0 };
+			if (!isSkinned || !prim.skin) {
+				return skin;
+			}
+
+			if (skinOnGPU) {
+				if (gpuPalette) {
+					skin = SkinSection{
+						SkinSource::GPU,
+						I32(m_pImpl->skinHeap.Offset(*prim.skin)),
+						prim.skin->page,
+						gpuPalette->offset,
+						paletteSize
+					};
 				}
+				return skin;
+			}
 
-				auto sect = BufferSection{
-					offset,
-					I32(prim.vertices.size() * mesh.kVertexSize),
-					mode,
-					object.GetProperties(),
-					{},
-					nLights
-				};
-				static_assert(std::is_standard_layout_v<Light> && std::is_trivially_copyable_v<Light>);
-				memcpy(sect.lights, lights, size_t(nLights) * sizeof(Light));
+			// Skinned when flushed, all of the flush's jobs at once
+			const auto out = m_pImpl->skinnedStream->Allocate(prim.vertexSize, kVertexSize);
+			if (!out) {
+				m_pImpl->logger.Warn("Skinned vertex buffer full. Drawing in bind pose.");
+				return skin;
+			}
 
-				*m_pImpl->vertexBufSectsCursor = sect;
-				m_pImpl->vertexBufSectsCursor++;
+			m_pImpl->skinJobs.push_back({ mesh, prim.index, cpuPalette, palette.size(), static_cast<Geometry::Vertex*>(out->data) });
+			skin.source = SkinSource::CPU;
+			skin.offset = I32(out->offset);
 
-				m_pImpl->vertexBuf.Upload(
-					prim.vertices.data(),
-					I32(prim.vertices.size() * mesh.kVertexSize),
-					offset
-				);
+			return skin;
+		};
+
+		const auto& resident = MakeResident(mesh);
+		const auto  bounds   = TransformBounds(resident.bounds, transform);
+		const auto  texture  = RequestTexture(props.material.texture, bounds);
+
+		const auto pushSection = [&](const ResidentPrimitive& prim) {
+			// Both buffers are flushed together
+			if (m_pImpl->indexBufSectsCursor == m_pImpl->indexBufSects.end()) {
+				Flush();
+			}
+
+			auto sect = BufferSection{
+				I32(m_pImpl->vertexHeap.Offset(prim.vertices)),
+				prim.vertexSize,
+				prim.vertices.page,
+				mode,
+				props,
+				{},
+				nLights,
+				skinSection(prim),
+				bounds,
+				fade,
+				texture
+			};
+			if (nLights > 0) {
+				memcpy(sect.lights, lights, size_t(nLights) * sizeof(Light));
 			}
+
+			*m_pImpl->vertexBufSectsCursor = sect;
+			m_pImpl->vertexBufSectsCursor++;
+
+			sect.offset = I32(m_pImpl->indexHeap.Offset(prim.indices));
+			sect.size   = prim.indexSize;
+			sect.page   = prim.indices.page;
+
+			*m_pImpl->indexBufSectsCursor = sect;
+			m_pImpl->indexBufSectsCursor++;
+		};
+
+		for (const auto& prim : resident.primitives) {
+			pushSection(prim);
 		}
+	}
 
-		{
-			auto offset = 0;
+	auto Renderer::MakeResident(const Geometry::MeshHandle& mesh) -> ResidentMesh&
+	{
+		// Objects sharing a mesh only upload it once; it stays in the heaps
+		// until the mesh itself goes away
+		auto [it, isNew] = m_pImpl->residentMeshes.try_emplace(mesh.ID());
+		auto& resident = it->second;
 
-			for (auto it = mesh.Primitives().cbegin(); it != mesh.Primitives().cend(); ++it) {
-				const auto& prim = *it;
+		if (isNew) {
+			resident.mesh   = mesh.WeakRef();
+			resident.bounds = ComputeBounds(*mesh);
+			resident.primitives.reserve(mesh->Primitives().size());
 
-				if (m_pImpl->indexBufSectsCursor != m_pImpl->indexBufSects.begin()) {
-					const auto& last = m_pImpl->indexBufSectsCursor - 1;
-					offset = last->offset + last->size;
-				}
+			for (auto i = std::size_t(0); i < mesh->Primitives().size(); i++) {
+				const auto& prim = mesh->Primitives()[i];
 
-				if (offset > m_pImpl->vertexBufSects.size()) {
-					Flush();
-					offset = 0;
+				// Nothing to draw, and the heaps can't hold empty allocations
+				if (prim.vertices.empty() || prim.indices.empty()) {
+					continue;
 				}
 
-				auto sect = BufferSection{
-					offset,
-					I32(prim.indices.size() * mesh.kIndexSize),
-					mode,
-					object.GetProperties(),
-					{},
-					nLights
+				const auto vertexSize = I32(prim.vertices.size() * mesh->kVertexSize);
+				const auto indexSize  = I32(prim.indices.size() * mesh->kIndexSize);
+
+				// Vertex offsets are turned into a base vertex, so they have to be a multiple of the vertex size
+				auto placed = ResidentPrimitive{
+					m_pImpl->vertexHeap.Allocate(vertexSize, I64(mesh->kVertexSize)),
+					m_pImpl->indexHeap.Allocate(indexSize, I64(mesh->kIndexSize)),
+					std::nullopt,
+					vertexSize,
+					indexSize,
+					i
 				};
-				static_assert(std::is_standard_layout_v<Light> && std::is_trivially_copyable_v<Light>);
-				memcpy(sect.lights, lights, size_t(nLights) * sizeof(Light));
 
-				*m_pImpl->indexBufSectsCursor = sect;
-				m_pImpl->indexBufSectsCursor++;
+				m_pImpl->vertexHeap.Upload(placed.vertices, prim.vertices.data());
+				m_pImpl->indexHeap.Upload(placed.indices, prim.indices.data());
+				m_pImpl->statsCurrent.uploadedBytes += vertexSize + indexSize;
 
-				m_pImpl->indexBuf.Upload(
-					prim.indices.data(),
-					I32(prim.indices.size() * Mesh::kIndexSize),
-					offset
-				);
+				if (!prim.skin.empty()) {
+					GAZE_ASSERT(prim.skin.size() == prim.vertices.size(), "Skinned primitives need one set of skin weights per vertex");
+
+					const auto skinSize = I64(prim.skin.size() * sizeof(Geometry::SkinWeights));
+
+					placed.skin = m_pImpl->skinHeap.Allocate(skinSize, I64(sizeof(Geometry::SkinWeights)));
+					m_pImpl->skinHeap.Upload(*placed.skin, prim.skin.data());
+					m_pImpl->statsCurrent.uploadedBytes += skinSize;
+
+					// The GPU path reads every joint, weighted or not
+					for (const auto& weights : prim.skin) {
+						const auto highest = *std::max_element(weights.joints.begin(), weights.joints.end());
+						resident.nJoints   = std::max(resident.nJoints, std::size_t(highest) + 1);
+					}
+				}
+
+				resident.primitives.push_back(placed);
 			}
 		}
+
+		return resident;
 	}
 }
@@ -0,0 +1,54 @@
+#include "GFX/Platform/OpenGL/ShaderPermutations.hpp"
+
+#include "Debug/Assert.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL {
+	ShaderPermutations::ShaderPermutations(std::string vertexSource, std::string fragmentSource, DefinesFn defines) noexcept
+		: m_VertexSource(std::move(vertexSource))
+		, m_FragmentSource(std::move(fragmentSource))
+		, m_Defines(std::move(defines))
+	{
+	}
+
+	auto ShaderPermutations::Get(Key key) -> Objects::ShaderProgram&
+	{
+		if (const auto it = m_Variants.find(key); it != m_Variants.end()) {
+			return *it->second;
+		}
+
+		const auto defines = m_Defines(key);
+		const auto vertexSource = Specialize(m_VertexSource, defines);
+		const auto fragmentSource = Specialize(m_FragmentSource, defines);
+
+		auto vShader = Objects::Shader(Objects::Shader::Type::Vertex, vertexSource);
+		GAZE_ASSERT(vShader.Compile(), "Failed to compile Vertex shader variant");
+		auto fShader = Objects::Shader(Objects::Shader::Type::Fragment, fragmentSource);
+		GAZE_ASSERT(fShader.Compile(), "Failed to compile Fragment shader variant");
+
+		auto program = MakeUnique<Objects::ShaderProgram>(std::initializer_list<const Objects::Shader*>{ &vShader, &fShader });
+		GAZE_ASSERT(program->Link(), "Failed to link shader program variant");
+
+		return *m_Variants.emplace(key, std::move(program)).first->second;
+	}
+
+	auto ShaderPermutations::Specialize(std::string_view source, std::string_view defines) -> std::string
+	{
+		// #version must stay the first directive, so the defines go right after its line
+		const auto version = source.find("#version");
+		GAZE_ASSERT(version != std::string_view::npos, "Shader source has no #version directive");
+
+		const auto lineEnd = source.find('\n', version);
+		const auto split = lineEnd == std::string_view::npos ? source.size() : lineEnd + 1;
+
+		auto specialized = std::string();
+		specialized.reserve(source.size() + defines.size() + 1);
+		specialized.append(source.substr(0, split));
+		if (lineEnd == std::string_view::npos) {
+			specialized.push_back('\n');
+		}
+		specialized.append(defines);
+		specialized.append(source.substr(split));
+
+		return specialized;
+	}
+}
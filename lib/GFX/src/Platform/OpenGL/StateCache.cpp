@@ -0,0 +1,178 @@
+#include "GFX/Platform/OpenGL/StateCache.hpp"
+
+#include "GFX/Platform/OpenGL/Objects/Framebuffer.hpp"
+#include "GFX/Platform/OpenGL/Objects/Shader.hpp"
+#include "GFX/Platform/OpenGL/Objects/VertexArray.hpp"
+
+#include "Core/PlatformUtils.hpp"
+
+namespace Gaze::GFX::Platform::OpenGL {
+	static auto ToGLCapability(StateCache::Capability capability) noexcept -> GLenum
+	{
+		using Capability = StateCache::Capability;
+
+		switch (capability) {
+		case Capability::DepthTest:         return GL_DEPTH_TEST;
+		case Capability::Blend:             return GL_BLEND;
+		case Capability::CullFace:          return GL_CULL_FACE;
+		case Capability::ProgramPointSize:  return GL_PROGRAM_POINT_SIZE;
+		case Capability::StencilTest:       return GL_STENCIL_TEST;
+		case Capability::DepthClamp:        return GL_DEPTH_CLAMP;
+		case Capability::PolygonOffsetFill: return GL_POLYGON_OFFSET_FILL;
+		case Capability::Count:             break;
+		}
+
+		GAZE_UNREACHABLE();
+	}
+
+	auto StateCache::UseProgram(const Objects::ShaderProgram& program) noexcept -> void
+	{
+		if (Update(m_Program, program.ID())) {
+			glUseProgram(program.ID());
+		}
+	}
+
+	auto StateCache::BindVertexArray(const Objects::VertexArray& array) noexcept -> void
+	{
+		if (Update(m_VertexArray, array.ID())) {
+			glBindVertexArray(array.ID());
+		}
+	}
+
+	auto StateCache::BindFramebuffer(const Objects::Framebuffer* framebuffer) noexcept -> void
+	{
+		const auto id = framebuffer != nullptr ? framebuffer->ID() : 0U;
+
+		if (Update(m_Framebuffer, id)) {
+			glBindFramebuffer(GL_FRAMEBUFFER, id);
+		}
+	}
+
+	auto StateCache::BindFramebuffer(const Objects::DepthFramebuffer& framebuffer) noexcept -> void
+	{
+		if (Update(m_Framebuffer, framebuffer.ID())) {
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.ID());
+		}
+	}
+
+	auto StateCache::BindFramebuffer(const Objects::LayerFramebuffer& framebuffer) noexcept -> void
+	{
+		if (Update(m_Framebuffer, framebuffer.ID())) {
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.ID());
+		}
+	}
+
+	auto StateCache::BindFramebuffer(const Objects::TextureFramebuffer& framebuffer) noexcept -> void
+	{
+		if (Update(m_Framebuffer, framebuffer.ID())) {
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.ID());
+		}
+	}
+
+	auto StateCache::BindTextureUnit(U32 unit, U32 texture) noexcept -> void
+	{
+		if (unit >= kMaxTextureUnits) {
+			m_Counters.issued++;
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (Update(m_Textures[unit], texture)) {
+			glBindTextureUnit(unit, texture);
+		}
+	}
+
+	auto StateCache::BindStorageBuffer(U32 index, U32 buffer, I64 offset, I64 size) noexcept -> void
+	{
+		if (index >= kMaxStorageBufferBindings) {
+			m_Counters.issued++;
+			glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index, buffer, offset, size);
+			return;
+		}
+
+		if (Update(m_StorageBuffers[index], BufferRange{ buffer, offset, size })) {
+			glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index, buffer, offset, size);
+		}
+	}
+
+	auto StateCache::BindDrawIndirectBuffer(U32 buffer) noexcept -> void
+	{
+		if (Update(m_DrawIndirectBuffer, buffer)) {
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+		}
+	}
+
+	auto StateCache::SetEnabled(Capability capability, bool enabled) noexcept -> void
+	{
+		if (!Update(m_Capabilities[std::size_t(capability)], enabled)) {
+			return;
+		}
+
+		if (enabled) {
+			glEnable(ToGLCapability(capability));
+		} else {
+			glDisable(ToGLCapability(capability));
+		}
+	}
+
+	auto StateCache::SetBlendFunc(GLenum source, GLenum destination) noexcept -> void
+	{
+		if (Update(m_BlendFunc, BlendFunc{ source, destination })) {
+			glBlendFunc(source, destination);
+		}
+	}
+
+	auto StateCache::SetDepthFunc(GLenum func) noexcept -> void
+	{
+		if (Update(m_DepthFunc, func)) {
+			glDepthFunc(func);
+		}
+	}
+
+	auto StateCache::SetDepthMask(bool enabled) noexcept -> void
+	{
+		if (Update(m_DepthMask, enabled)) {
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+		}
+	}
+
+	auto StateCache::SetCullFace(GLenum face) noexcept -> void
+	{
+		if (Update(m_CullFace, face)) {
+			glCullFace(face);
+		}
+	}
+
+	auto StateCache::SetViewport(I32 x, I32 y, I32 width, I32 height) noexcept -> void
+	{
+		if (Update(m_Viewport, Viewport{ x, y, width, height })) {
+			glViewport(x, y, width, height);
+		}
+	}
+
+	auto StateCache::Invalidate() noexcept -> void
+	{
+		m_Program.reset();
+		m_VertexArray.reset();
+		m_Framebuffer.reset();
+		m_Textures.fill(std::nullopt);
+		m_StorageBuffers.fill(std::nullopt);
+		m_DrawIndirectBuffer.reset();
+		m_Capabilities.fill(std::nullopt);
+		m_BlendFunc.reset();
+		m_DepthFunc.reset();
+		m_DepthMask.reset();
+		m_CullFace.reset();
+		m_Viewport.reset();
+	}
+
+	auto StateCache::GetCounters() const noexcept -> Counters
+	{
+		return m_Counters;
+	}
+
+	auto StateCache::ResetCounters() noexcept -> void
+	{
+		m_Counters = {};
+	}
+}
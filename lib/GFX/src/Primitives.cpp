@@ -7,7 +7,7 @@ namespace Gaze::GFX {
 	namespace Primitives {
 		auto CreatePoint(glm::vec3 point) -> Object
 		{
-			return Object(Geometry::Mesh{ { Geometry::Vertex{ point.x, point.y, point.z, .0F, .0F, .0F }}, { Geometry::Index(0) } });
+			return Object(Geometry::Mesh{ { Geometry::Vertex{ point.x, point.y, point.z, .0F, .0F, .0F, .0F, .0F }}, { Geometry::Index(0) } });
 		}
 
 		auto CreateLine(glm::vec3 start, glm::vec3 end) -> Object
@@ -15,8 +15,8 @@ namespace Gaze::GFX {
 			return Object(
 				Geometry::Mesh{
 					{
-						Geometry::Vertex{ start.x, start.y, start.z, .0F, .0F, .0F },
-						Geometry::Vertex{ end.x, end.y, end.z, .0F, .0F, .0F }
+						Geometry::Vertex{ start.x, start.y, start.z, .0F, .0F, .0F, .0F, .0F },
+						Geometry::Vertex{ end.x, end.y, end.z, .0F, .0F, .0F, 1.F, .0F }
 					},
 					{
 						Geometry::Index(0),
@@ -32,9 +32,9 @@ namespace Gaze::GFX {
 			return Object(
 				Geometry::Mesh{
 					{
-						Geometry::Vertex{ points[0].x, points[0].y, points[0].z, normals.x, normals.y, normals.z },
-						Geometry::Vertex{ points[1].x, points[1].y, points[1].z, normals.x, normals.y, normals.z },
-						Geometry::Vertex{ points[2].x, points[2].y, points[2].z, normals.x, normals.y, normals.z },
+						Geometry::Vertex{ points[0].x, points[0].y, points[0].z, normals.x, normals.y, normals.z, .0F, .0F },
+						Geometry::Vertex{ points[1].x, points[1].y, points[1].z, normals.x, normals.y, normals.z, 1.F, .0F },
+						Geometry::Vertex{ points[2].x, points[2].y, points[2].z, normals.x, normals.y, normals.z, .0F, 1.F },
 					},
 					{
 						Geometry::Index(0),
@@ -56,10 +56,10 @@ namespace Gaze::GFX {
 			return Object(
 				Geometry::Mesh{
 					{
-						Geometry::Vertex{ v1.x, v1.y, v1.z, normals.x, normals.y, normals.z },
-						Geometry::Vertex{ v2.x, v2.y, v2.z, normals.x, normals.y, normals.z },
-						Geometry::Vertex{ v3.x, v3.y, v3.z, normals.x, normals.y, normals.z },
-						Geometry::Vertex{ v4.x, v4.y, v4.z, normals.x, normals.y, normals.z },
+						Geometry::Vertex{ v1.x, v1.y, v1.z, normals.x, normals.y, normals.z, .0F, .0F },
+						Geometry::Vertex{ v2.x, v2.y, v2.z, normals.x, normals.y, normals.z, .0F, 1.F },
+						Geometry::Vertex{ v3.x, v3.y, v3.z, normals.x, normals.y, normals.z, 1.F, 1.F },
+						Geometry::Vertex{ v4.x, v4.y, v4.z, normals.x, normals.y, normals.z, 1.F, .0F },
 					},
 					{
 						Geometry::Index(0),
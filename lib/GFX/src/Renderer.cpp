@@ -4,6 +4,7 @@
 #include "Core/PlatformUtils.hpp"
 
 #include "GFX/API.hpp"
+#include "GFX/ThreadedRenderer.hpp"
 #include "GFX/Platform/OpenGL/Renderer.hpp"
 
 namespace Gaze::GFX {
@@ -12,12 +13,24 @@ namespace Gaze::GFX {
 	{
 	}
 
-	auto CreateRenderer(Shared<WM::Window> window) -> Unique<Renderer>
+	namespace {
+		auto CreateAPIRenderer(Shared<WM::Window> window) -> Unique<Renderer>
+		{
+			switch (GetAPI()) {
+			case API::kOpenGL: return MakeUnique<Platform::OpenGL::Renderer>(std::move(window));
+			}
+
+			GAZE_UNREACHABLE();
+		}
+	}
+
+	auto CreateRenderer(Shared<WM::Window> window, bool renderThread) -> Unique<Renderer>
 	{
-		switch (GetAPI()) {
-		case API::kOpenGL: return MakeUnique<Platform::OpenGL::Renderer>(std::move(window));
+		auto renderer = CreateAPIRenderer(window);
+		if (!renderThread) {
+			return renderer;
 		}
 
-		GAZE_UNREACHABLE();
+		return MakeUnique<ThreadedRenderer>(std::move(window), std::move(renderer));
 	}
 }
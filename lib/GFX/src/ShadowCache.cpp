@@ -0,0 +1,304 @@
+#include "GFX/ShadowCache.hpp"
+
+#include "GFX/LightSelector.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Gaze::GFX {
+	namespace {
+		constexpr auto kPointNear = .05F;
+
+		/**
+		 * @brief The faces of a cube map, in layer order, as seen from its center.
+		 */
+		struct CubeFace
+		{
+			glm::vec3 direction;
+			glm::vec3 up;
+		};
+
+		const CubeFace kCubeFaces[] = {
+			{ {  1.F,  0.F,  0.F }, { 0.F, -1.F,  0.F } },
+			{ { -1.F,  0.F,  0.F }, { 0.F, -1.F,  0.F } },
+			{ {  0.F,  1.F,  0.F }, { 0.F,  0.F,  1.F } },
+			{ {  0.F, -1.F,  0.F }, { 0.F,  0.F, -1.F } },
+			{ {  0.F,  0.F,  1.F }, { 0.F, -1.F,  0.F } },
+			{ {  0.F,  0.F, -1.F }, { 0.F, -1.F,  0.F } },
+		};
+
+		/**
+		 * @brief Map clip space to [0, 1] shadow map coordinates and depths.
+		 */
+		const auto kClipToTexture = glm::mat4(
+			glm::vec4(.5F, 0.F, 0.F, 0.F),
+			glm::vec4(0.F, .5F, 0.F, 0.F),
+			glm::vec4(0.F, 0.F, .5F, 0.F),
+			glm::vec4(.5F, .5F, .5F, 1.F)
+		);
+
+		/**
+		 * @brief Whether a cached refit input differs from the current one, bit for bit.
+		 */
+		auto Differs(F32 cached, F32 current) noexcept -> bool
+		{
+			return std::bit_cast<U32>(cached) != std::bit_cast<U32>(current);
+		}
+	}
+
+	ShadowCache::ShadowCache(Settings settings) noexcept
+		: m_Settings(settings)
+	{
+		GAZE_ASSERT(settings.nCascades > 0 && settings.nCascades <= kMaxCascades, "Unsupported cascade count");
+		GAZE_ASSERT(settings.cascadeResolution > 0 && settings.pointResolution > 0, "Shadow map resolutions must be positive");
+		GAZE_ASSERT(settings.cascadeDistance > 0.F && settings.pointRange > kPointNear, "Shadow distances must be positive");
+	}
+
+	auto ShadowCache::SetLights(std::span<const Light> lights) -> void
+	{
+		m_Sun.reset();
+		m_PointLights.clear();
+
+		for (const auto& light : lights) {
+			if (!light.castsShadows) {
+				continue;
+			}
+
+			if (light.IsDirectional()) {
+				if (!m_Sun) {
+					m_Sun = light;
+				}
+			} else if (m_PointLights.size() < std::size_t(kMaxPointLights)) {
+				m_PointLights.push_back(light);
+			}
+		}
+
+		if (!m_Sun) {
+			m_Cascades.clear();
+			m_CascadeMatrices.clear();
+		}
+		// Slots compare their light on the next update, lights that didn't move keep their cache
+		m_PointSlots.resize(m_PointLights.size(), PointSlot{ .light = {}, .staticVersion = 0, .isDirty = true });
+	}
+
+	auto ShadowCache::Update(const glm::mat4& cameraViewProjection, const glm::vec3& cameraPosition, U64 staticVersion, U64 frame) -> void
+	{
+		m_Views.clear();
+
+		if (m_Sun) {
+			UpdateCascades(cameraViewProjection, cameraPosition, staticVersion, frame);
+		}
+		UpdatePointLights(staticVersion);
+	}
+
+	auto ShadowCache::Invalidate() noexcept -> void
+	{
+		for (auto& cascade : m_Cascades) {
+			cascade.isDirty = true;
+		}
+		for (auto& slot : m_PointSlots) {
+			slot.isDirty = true;
+		}
+	}
+
+	auto ShadowCache::ShadowIndex(const Light& light) const noexcept -> I32
+	{
+		if (!light.castsShadows) {
+			return -1;
+		}
+
+		if (light.IsDirectional()) {
+			const auto isSun = m_Sun && m_Sun->direction == light.direction && !m_CascadeMatrices.empty();
+			return isSun ? kCascaded : -1;
+		}
+
+		for (auto i = std::size_t(0); i < m_PointShadows.size(); i++) {
+			if (m_PointShadows[i].position == light.position) {
+				return I32(i);
+			}
+		}
+
+		return -1;
+	}
+
+	auto ShadowCache::CascadeTexelSize(I32 cascade) const noexcept -> F32
+	{
+		return 2.F * m_Cascades[std::size_t(cascade)].radius / F32(m_Settings.cascadeResolution);
+	}
+
+	auto ShadowCache::IsCascadeDue(I32 cascade, U64 frame) noexcept -> bool
+	{
+		return cascade == 0 || (frame != 0 && std::countr_zero(frame) == cascade - 1);
+	}
+
+	auto ShadowCache::UpdateCascades(const glm::mat4& cameraViewProjection, const glm::vec3& cameraPosition, U64 staticVersion, U64 frame) -> void
+	{
+		const auto direction = m_Sun->direction;
+		const auto inverse   = glm::inverse(cameraViewProjection);
+
+		// The camera frustum's corners, on the near and far planes
+		glm::vec3 nearCorners[4];
+		glm::vec3 farCorners[4];
+		auto nearCenter = glm::vec3(0.F);
+		auto farCenter  = glm::vec3(0.F);
+		for (auto i = 0; i < 4; i++) {
+			const auto x = (i & 1) != 0 ? 1.F : -1.F;
+			const auto y = (i & 2) != 0 ? 1.F : -1.F;
+
+			const auto nearCorner = inverse * glm::vec4(x, y, -1.F, 1.F);
+			const auto farCorner  = inverse * glm::vec4(x, y, 1.F, 1.F);
+
+			nearCorners[i] = glm::vec3(nearCorner) / nearCorner.w;
+			farCorners[i]  = glm::vec3(farCorner) / farCorner.w;
+			nearCenter += nearCorners[i] * .25F;
+			farCenter  += farCorners[i] * .25F;
+		}
+
+		const auto front     = glm::normalize(farCenter - nearCenter);
+		const auto nearDepth = glm::dot(nearCenter - cameraPosition, front);
+		const auto farDepth  = glm::dot(farCenter - cameraPosition, front);
+		const auto maxDepth  = std::min(farDepth, m_Settings.cascadeDistance);
+
+		const auto nCascades = m_Settings.nCascades;
+		const auto splitAt   = [&](I32 i) {
+			const auto fraction    = F32(i) / F32(nCascades);
+			const auto uniform     = nearDepth + (maxDepth - nearDepth) * fraction;
+			const auto logarithmic = nearDepth > 0.F ? nearDepth * std::pow(maxDepth / nearDepth, fraction) : uniform;
+
+			return uniform + (logarithmic - uniform) * m_Settings.splitLambda;
+		};
+
+		// Cascades are fitted all at once the first time, then on their schedule
+		const auto isFirstFit = m_Cascades.empty();
+		m_Cascades.resize(std::size_t(nCascades));
+		m_CascadeMatrices.resize(std::size_t(nCascades));
+
+		for (auto i = 0; i < nCascades; i++) {
+			if (!isFirstFit && !IsCascadeDue(i, frame)) {
+				continue;
+			}
+
+			// Bounding sphere of the slice, its radius rounded up so that it doesn't jitter as the camera turns
+			const auto begin = (splitAt(i) - nearDepth) / (farDepth - nearDepth);
+			const auto end   = (splitAt(i + 1) - nearDepth) / (farDepth - nearDepth);
+
+			glm::vec3 corners[8];
+			auto center = glm::vec3(0.F);
+			for (auto c = 0; c < 4; c++) {
+				corners[c]     = nearCorners[c] + (farCorners[c] - nearCorners[c]) * begin;
+				corners[c + 4] = nearCorners[c] + (farCorners[c] - nearCorners[c]) * end;
+				center += (corners[c] + corners[c + 4]) * .125F;
+			}
+
+			auto radius = 0.F;
+			for (const auto& corner : corners) {
+				radius = std::max(radius, glm::length(corner - center));
+			}
+			radius = std::ceil(radius * 16.F) / 16.F;
+
+			auto&      cascade = m_Cascades[std::size_t(i)];
+			const auto covered = radius * (1.F + m_Settings.cascadeMargin);
+			const auto refit   =
+				isFirstFit ||
+				cascade.direction != direction ||
+				Differs(cascade.radius, covered) ||
+				glm::length(center - cascade.center) > covered - radius;
+
+			if (refit) {
+				cascade = FitCascade(center, covered, direction);
+			}
+
+			const auto redrawStatic = cascade.isDirty || cascade.staticVersion != staticVersion;
+			cascade.isDirty       = false;
+			cascade.staticVersion = staticVersion;
+
+			m_CascadeMatrices[std::size_t(i)] = kClipToTexture * cascade.viewProjection;
+			m_Views.push_back({
+				.viewProjection = cascade.viewProjection,
+				.target         = Target::Cascade,
+				.layer          = i,
+				.redrawStatic   = redrawStatic,
+			});
+		}
+	}
+
+	auto ShadowCache::UpdatePointLights(U64 staticVersion) -> void
+	{
+		m_PointShadows.clear();
+
+		for (auto i = std::size_t(0); i < m_PointLights.size(); i++) {
+			const auto shadow = PointShadow{ .position = m_PointLights[i].position, .range = PointRange(m_PointLights[i]) };
+
+			auto&      slot         = m_PointSlots[i];
+			const auto redrawStatic =
+				slot.isDirty ||
+				slot.staticVersion != staticVersion ||
+				slot.light.position != shadow.position ||
+				Differs(slot.light.range, shadow.range);
+
+			slot = PointSlot{ .light = shadow, .staticVersion = staticVersion, .isDirty = false };
+			m_PointShadows.push_back(shadow);
+
+			const auto projection = glm::perspective(glm::half_pi<F32>(), 1.F, kPointNear, shadow.range);
+			for (auto face = 0; face < 6; face++) {
+				const auto& cubeFace = kCubeFaces[face];
+
+				m_Views.push_back({
+					.viewProjection = projection * glm::lookAt(shadow.position, shadow.position + cubeFace.direction, cubeFace.up),
+					.target         = Target::CubeFace,
+					.layer          = I32(i) * 6 + face,
+					.redrawStatic   = redrawStatic,
+				});
+			}
+		}
+	}
+
+	auto ShadowCache::FitCascade(const glm::vec3& center, F32 radius, const glm::vec3& direction) const noexcept -> Cascade
+	{
+		const auto forward = glm::normalize(direction);
+		const auto up      = std::abs(forward.y) > .99F ? glm::vec3(1.F, 0.F, 0.F) : glm::vec3(0.F, 1.F, 0.F);
+		const auto right   = glm::normalize(glm::cross(forward, up));
+		const auto upward  = glm::cross(right, forward);
+
+		// Whole texels across the light, so that the texels cover the same areas wherever the cascade is
+		const auto texel   = 2.F * radius / F32(m_Settings.cascadeResolution);
+		const auto snapped =
+			right * (std::round(glm::dot(center, right) / texel) * texel) +
+			upward * (std::round(glm::dot(center, upward) / texel) * texel) +
+			forward * glm::dot(center, forward);
+
+		// Casters up to casterDistance in front of the covered sphere, towards the light, are kept
+		const auto eye        = snapped - forward * (radius + m_Settings.casterDistance);
+		const auto view       = glm::lookAt(eye, snapped, upward);
+		const auto projection = glm::ortho(-radius, radius, -radius, radius, 0.F, 2.F * radius + m_Settings.casterDistance);
+
+		return Cascade{
+			.center         = snapped,
+			.radius         = radius,
+			.direction      = direction,
+			.viewProjection = projection * view,
+			.staticVersion  = 0,
+			.isDirty        = true,
+		};
+	}
+
+	auto ShadowCache::PointRange(const Light& light) const noexcept -> F32
+	{
+		if (light.attenuation <= 0.F) {
+			return m_Settings.pointRange;
+		}
+
+		// Where 1 / (1 + attenuation * d^2) drops below the contribution lights are ignored at
+		const auto range = std::sqrt((1.F / LightSelector::kMinContribution - 1.F) / light.attenuation);
+		return std::clamp(range, 1.F, m_Settings.pointRange);
+	}
+}
@@ -0,0 +1,86 @@
+#include "GFX/Skinning.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/vec4.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAZE_SKINNING_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Gaze::GFX {
+	auto SkinVertices(
+		std::span<const Geometry::Vertex> vertices,
+		std::span<const Geometry::SkinWeights> skin,
+		std::span<const glm::mat4> palette,
+		std::span<Geometry::Vertex> out
+	) noexcept -> void
+	{
+		GAZE_ASSERT(skin.size() == vertices.size(), "Skinned vertices need one set of skin weights each");
+		GAZE_ASSERT(out.size() >= vertices.size(), "Output is too small");
+
+		for (auto i = std::size_t(0); i < vertices.size(); i++) {
+			const auto  vertex  = vertices[i];
+			const auto& weights = skin[i];
+
+#if defined(GAZE_SKINNING_SSE)
+			// Blend the joint matrices one column at a time
+			__m128 columns[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+			for (auto k = std::size_t(0); k < 4; k++) {
+				if (weights.weights[k] <= 0.F) {
+					continue;
+				}
+				GAZE_ASSERT(weights.joints[k] < palette.size(), "Skin weights refer to a joint outside the palette");
+
+				const auto& joint = palette[weights.joints[k]];
+				const auto  w     = _mm_set1_ps(weights.weights[k]);
+				for (auto c = 0; c < 4; c++) {
+					columns[c] = _mm_add_ps(columns[c], _mm_mul_ps(_mm_loadu_ps(&joint[c][0]), w));
+				}
+			}
+
+			const auto transform = [&columns](F32 x, F32 y, F32 z) {
+				return _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(x)), _mm_mul_ps(columns[1], _mm_set1_ps(y))),
+					_mm_mul_ps(columns[2], _mm_set1_ps(z))
+				);
+			};
+
+			alignas(16) F32 position[4];
+			alignas(16) F32 normal[4];
+			_mm_store_ps(position, _mm_add_ps(transform(vertex.x, vertex.y, vertex.z), columns[3]));
+			_mm_store_ps(normal, transform(vertex.nx, vertex.ny, vertex.nz));
+#else
+			auto blended = glm::mat4(0.F);
+			for (auto k = std::size_t(0); k < 4; k++) {
+				if (weights.weights[k] <= 0.F) {
+					continue;
+				}
+				GAZE_ASSERT(weights.joints[k] < palette.size(), "Skin weights refer to a joint outside the palette");
+
+				blended = blended + palette[weights.joints[k]] * weights.weights[k];
+			}
+
+			const auto position = blended * glm::vec4(vertex.x, vertex.y, vertex.z, 1.F);
+			const auto normal   = blended * glm::vec4(vertex.nx, vertex.ny, vertex.nz, 0.F);
+#endif
+
+			const auto length   = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			const auto invScale = length > 0.F ? 1.F / length : 0.F;
+
+			out[i] = Geometry::Vertex{
+				.x  = position[0],
+				.y  = position[1],
+				.z  = position[2],
+				.nx = normal[0] * invScale,
+				.ny = normal[1] * invScale,
+				.nz = normal[2] * invScale,
+				.u  = vertex.u,
+				.v  = vertex.v,
+			};
+		}
+	}
+}
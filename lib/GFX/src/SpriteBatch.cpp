@@ -0,0 +1,45 @@
+#include "GFX/SpriteBatch.hpp"
+
+#include "GFX/DebugDraw.hpp"
+
+#include <algorithm>
+
+namespace Gaze::GFX {
+	auto SpriteBatch::Quad(
+		const glm::vec2& position,
+		const glm::vec2& size,
+		F32 rotation,
+		const glm::vec4& color,
+		I32 layer
+	) -> void
+	{
+		if (!m_Sprites.empty() && layer < m_Sprites.back().layer) {
+			m_IsSorted = false;
+		}
+
+		m_Sprites.push_back({ position, size, rotation, DebugDraw::PackColor(color), layer });
+	}
+
+	auto SpriteBatch::Reserve(std::size_t nSprites) -> void
+	{
+		m_Sprites.reserve(nSprites);
+	}
+
+	auto SpriteBatch::Sort() -> void
+	{
+		if (m_IsSorted) {
+			return;
+		}
+
+		std::stable_sort(m_Sprites.begin(), m_Sprites.end(), [](const Sprite& lhs, const Sprite& rhs) {
+			return lhs.layer < rhs.layer;
+		});
+		m_IsSorted = true;
+	}
+
+	auto SpriteBatch::Clear() noexcept -> void
+	{
+		m_Sprites.clear();
+		m_IsSorted = true;
+	}
+}
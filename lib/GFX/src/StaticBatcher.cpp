@@ -0,0 +1,233 @@
+#include "GFX/StaticBatcher.hpp"
+
+#include "GFX/Renderer.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Gaze::GFX {
+	StaticBatcher::StaticBatcher(F32 cellSize) noexcept
+		: m_CellSize(cellSize)
+	{
+		GAZE_ASSERT(cellSize > .0F, "Cell size must be positive");
+	}
+
+	auto StaticBatcher::Add(const Object& object) -> ObjectID
+	{
+		GAZE_ASSERT(object.IsStatic(), "Only static objects may be batched");
+
+		const auto& transform = object.GetProperties().transform;
+		const auto normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+
+		auto member = Member();
+		for (const auto& prim : object.Mesh().Primitives()) {
+			const auto base = Geometry::Index(member.vertices.size());
+
+			for (const auto& vert : prim.vertices) {
+				const auto pos    = glm::vec3(transform * glm::vec4(vert.x, vert.y, vert.z, 1.F));
+				auto       normal = normalMatrix * glm::vec3(vert.nx, vert.ny, vert.nz);
+
+				if (glm::dot(normal, normal) > .0F) {
+					normal = glm::normalize(normal);
+				}
+
+				member.vertices.push_back({ pos.x, pos.y, pos.z, normal.x, normal.y, normal.z, vert.u, vert.v });
+			}
+			for (const auto idx : prim.indices) {
+				member.indices.push_back(base + idx);
+			}
+		}
+		member.bounds = TransformBounds(ComputeBounds(object.Mesh()), transform);
+		member.cell   = ComputeCellKey(member.bounds, FindOrAddMaterial(object.GetProperties().material));
+
+		const auto id = m_NextID++;
+		auto& cell = m_Cells[member.cell];
+		cell.members.push_back(id);
+		cell.material = member.cell.material;
+		cell.isDirty = true;
+		m_IsDirty = true;
+
+		m_Members.emplace(id, std::move(member));
+
+		return id;
+	}
+
+	auto StaticBatcher::Remove(ObjectID id) -> void
+	{
+		const auto it = m_Members.find(id);
+		if (it == m_Members.end()) {
+			return;
+		}
+
+		auto& cell = m_Cells[it->second.cell];
+		std::erase(cell.members, id);
+		cell.isDirty = true;
+		m_IsDirty = true;
+
+		m_Members.erase(it);
+	}
+
+	auto StaticBatcher::Clear() noexcept -> void
+	{
+		m_Members.clear();
+		m_Cells.clear();
+		m_Version++;
+		m_IsDirty = false;
+	}
+
+	auto StaticBatcher::Build() -> void
+	{
+		if (!m_IsDirty) {
+			return;
+		}
+
+		for (auto it = m_Cells.begin(); it != m_Cells.end();) {
+			auto& cell = it->second;
+
+			if (cell.members.empty()) {
+				it = m_Cells.erase(it);
+				continue;
+			}
+			if (cell.isDirty) {
+				Rebuild(cell);
+			}
+			++it;
+		}
+
+		m_Version++;
+		m_IsDirty = false;
+	}
+
+	auto StaticBatcher::Submit(Renderer& renderer, const Frustum& frustum, const Light lights[], I32 nLights) -> I32
+	{
+		Build();
+
+		auto nSubmitted = 0;
+		for (const auto& [key, cell] : m_Cells) {
+			if (!cell.batch || !frustum.Intersects(cell.batch->bounds)) {
+				continue;
+			}
+
+			renderer.SubmitObject(cell.batch->object, lights, nLights, Renderer::PrimitiveMode::Triangles);
+			nSubmitted++;
+		}
+
+		return nSubmitted;
+	}
+
+	auto StaticBatcher::Submit(Renderer& renderer, const Frustum& frustum) -> I32
+	{
+		Build();
+
+		auto nSubmitted = 0;
+		for (const auto& [key, cell] : m_Cells) {
+			if (!cell.batch || !frustum.Intersects(cell.batch->bounds)) {
+				continue;
+			}
+
+			renderer.SubmitObject(cell.batch->object, Renderer::PrimitiveMode::Triangles);
+			nSubmitted++;
+		}
+
+		return nSubmitted;
+	}
+
+	auto StaticBatcher::Batches() const noexcept -> std::vector<const Batch*>
+	{
+		auto batches = std::vector<const Batch*>();
+		batches.reserve(m_Cells.size());
+
+		for (const auto& [key, cell] : m_Cells) {
+			if (cell.batch) {
+				batches.push_back(&*cell.batch);
+			}
+		}
+
+		return batches;
+	}
+
+	auto StaticBatcher::FindOrAddMaterial(const Material& material) -> U32
+	{
+		// Materials are compared bitwise; batching only merges objects whose
+		// materials are exactly identical.
+		static_assert(std::is_trivially_copyable_v<Material>);
+
+		for (auto i = 0U; i < m_Materials.size(); i++) {
+			if (std::memcmp(&m_Materials[i], &material, sizeof(Material)) == 0) {
+				return i;
+			}
+		}
+
+		m_Materials.push_back(material);
+		return U32(m_Materials.size() - 1);
+	}
+
+	auto StaticBatcher::ComputeCellKey(const AABB& bounds, U32 material) const noexcept -> CellKey
+	{
+		// Clamped so the conversion stays defined; cells that far out share the outermost ones
+		static constexpr auto kMaxCoord = F32(1 << 30);
+
+		const auto center = bounds.Center() / m_CellSize;
+		const auto coord  = [](F32 val) {
+			return I32(std::clamp(std::floor(val), -kMaxCoord, kMaxCoord));
+		};
+
+		return { material, coord(center.x), coord(center.y), coord(center.z) };
+	}
+
+	auto StaticBatcher::CellKeyHash::operator()(const CellKey& key) const noexcept -> std::size_t
+	{
+		// FNV-1a over the fields
+		auto hash = U64(14695981039346656037ULL);
+		for (const auto field : { key.material, U32(key.x), U32(key.y), U32(key.z) }) {
+			hash = (hash ^ field) * 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	auto StaticBatcher::Rebuild(Cell& cell) -> void
+	{
+		auto vertices = std::vector<Geometry::Vertex>();
+		auto indices  = std::vector<Geometry::Index>();
+		auto bounds   = m_Members.at(cell.members.front()).bounds;
+
+		auto nVertices = std::size_t(0);
+		auto nIndices  = std::size_t(0);
+		for (const auto id : cell.members) {
+			const auto& member = m_Members.at(id);
+
+			nVertices += member.vertices.size();
+			nIndices  += member.indices.size();
+		}
+		vertices.reserve(nVertices);
+		indices.reserve(nIndices);
+
+		for (const auto id : cell.members) {
+			const auto& member = m_Members.at(id);
+			const auto  base   = Geometry::Index(vertices.size());
+
+			vertices.insert(vertices.end(), member.vertices.cbegin(), member.vertices.cend());
+			for (const auto idx : member.indices) {
+				indices.push_back(base + idx);
+			}
+			bounds = MergeBounds(bounds, member.bounds);
+		}
+
+		auto object = Object(
+			Geometry::Mesh(std::move(vertices), std::move(indices)),
+			{ .transform = glm::mat4(1.F), .material = m_Materials[cell.material], .isStatic = true }
+		);
+
+		cell.batch.emplace(Batch{ std::move(object), bounds });
+		cell.isDirty = false;
+	}
+}
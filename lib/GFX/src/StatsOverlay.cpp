@@ -0,0 +1,121 @@
+#include "GFX/StatsOverlay.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string_view>
+
+namespace Gaze::GFX {
+	namespace {
+		constexpr auto kPadding    = 6.F;
+		constexpr auto kLineHeight = F32(Overlay::kGlyphSize) + 2.F;
+		const auto     kGraphSize  = glm::vec2(F32(StatsOverlay::kHistorySize) * 2.F, 32.F);
+
+		const auto kBackground = glm::vec4(0.F, 0.F, 0.F, .6F);
+		const auto kTextColor  = glm::vec4(1.F, 1.F, 1.F, 1.F);
+		const auto kLabelColor = glm::vec4(.7F, .7F, .7F, 1.F);
+		const auto kFrameColor = glm::vec4(.3F, .9F, .4F, .9F);
+		const auto kGPUColor   = glm::vec4(1.F, .6F, .2F, .9F);
+
+		/**
+		 * @brief A line of text formatted without allocating.
+		 */
+		class Line
+		{
+		public:
+			template<typename... Args>
+			Line(std::format_string<Args...> fmt, Args&&... args)
+				: m_Size(std::size_t(std::format_to_n(m_Buffer.data(), std::ptrdiff_t(m_Buffer.size()), fmt, std::forward<Args>(args)...).size))
+			{
+				m_Size = std::min(m_Size, m_Buffer.size());
+			}
+
+			[[nodiscard]] auto View() const noexcept -> std::string_view
+			{
+				return { m_Buffer.data(), m_Size };
+			}
+
+		private:
+			std::array<char, 96> m_Buffer;
+			std::size_t          m_Size;
+		};
+	}
+
+	auto StatsOverlay::Record(const Renderer::RenderStats& stats) noexcept -> void
+	{
+		m_Last = stats;
+
+		m_FrameTimes[m_Next] = F32(stats.frameTimeMs);
+		m_Latencies[m_Next]  = F32(stats.presentLatencyMs);
+		m_Next  = (m_Next + 1) % kHistorySize;
+		m_Count = std::min(m_Count + 1, kHistorySize);
+	}
+
+	auto StatsOverlay::Draw(Overlay& overlay, const glm::vec2& position, std::span<const std::string> extraLines) const -> void
+	{
+		if (!overlay.IsVisible()) {
+			return;
+		}
+
+		auto frameTimes = std::array<F32, kHistorySize>();
+		auto latencies  = std::array<F32, kHistorySize>();
+		Unroll(m_FrameTimes, frameTimes);
+		Unroll(m_Latencies, latencies);
+
+		const auto recorded = std::span(frameTimes).last(m_Count);
+		const auto maxFrame = recorded.empty() ? 0.F : *std::max_element(recorded.begin(), recorded.end());
+
+		const Line lines[] = {
+			Line("FPS {:.0f}  frame {:.2f} ms (max {:.2f})", m_Last.frameTimeMs > 0. ? 1000. / m_Last.frameTimeMs : 0., m_Last.frameTimeMs, maxFrame),
+			Line("Latency {:.2f} ms  in flight {}  paced {:.2f} ms", m_Last.presentLatencyMs, m_Last.nFramesInFlight, m_Last.pacingWaitMs),
+			Line("Draws {} (+{} instanced)  state changes {} (+{} elided)", m_Last.nDrawCalls, m_Last.nInstancesMerged, m_Last.nStateChanges, m_Last.nStateChangesElided),
+			Line(
+				"Uploaded {} KiB  meshes {:.1f} MiB ({:.0f}% frag.)",
+				m_Last.uploadedBytes / 1024,
+				F64(m_Last.meshMemoryBytes) / (1024. * 1024.),
+				m_Last.meshMemoryFragmentation * 100.F
+			),
+		};
+
+		auto nColumns = std::size_t(0);
+		for (const auto& line : lines) {
+			nColumns = std::max(nColumns, line.View().size());
+		}
+		for (const auto& line : extraLines) {
+			nColumns = std::max(nColumns, line.size());
+		}
+
+		const auto nLines = std::size(lines) + extraLines.size();
+		const auto width  = std::max(F32(nColumns * Overlay::kGlyphSize), kGraphSize.x) + 2.F * kPadding;
+		const auto height = F32(nLines) * kLineHeight + 2.F * (kLineHeight + kGraphSize.y) + 2.F * kPadding;
+
+		overlay.Rect(position, { width, height }, kBackground);
+
+		auto cursor = position + glm::vec2(kPadding, kPadding);
+		for (const auto& line : lines) {
+			overlay.Text(cursor, line.View(), kTextColor);
+			cursor.y += kLineHeight;
+		}
+		for (const auto& line : extraLines) {
+			overlay.Text(cursor, line, kTextColor);
+			cursor.y += kLineHeight;
+		}
+
+		// Scaled to the worst frame shown, but never below 30 FPS so that a smooth run looks smooth
+		const auto graph = [&](std::string_view label, std::span<const F32> values, const glm::vec4& color) {
+			const auto scale = std::max(*std::max_element(values.begin(), values.end()), 1000.F / 30.F);
+
+			overlay.Text(cursor, Line("{} (0-{:.0f} ms)", label, scale).View(), kLabelColor);
+			cursor.y += kLineHeight;
+			overlay.Graph(cursor, kGraphSize, values, scale, color);
+			cursor.y += kGraphSize.y;
+		};
+		graph("Frame time", frameTimes, kFrameColor);
+		graph("Latency", latencies, kGPUColor);
+	}
+
+	auto StatsOverlay::Unroll(const std::array<F32, kHistorySize>& history, std::array<F32, kHistorySize>& out) const noexcept -> void
+	{
+		// m_Next is the oldest entry once the history is full, and unused slots are zero before that
+		std::rotate_copy(history.begin(), history.begin() + std::ptrdiff_t(m_Next), history.end(), out.begin());
+	}
+}
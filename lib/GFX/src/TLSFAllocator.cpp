@@ -0,0 +1,379 @@
+#include "GFX/TLSFAllocator.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Gaze::GFX {
+	TLSFAllocator::TLSFAllocator(U64 capacity)
+		: m_Capacity(capacity)
+	{
+		GAZE_ASSERT(capacity > 0, "Capacity must not be 0");
+
+		for (auto& level : m_Heads) {
+			level.fill(kNullBlock);
+		}
+
+		const auto block = NewBlock();
+		m_Blocks[block].offset = 0;
+		m_Blocks[block].size   = capacity;
+		InsertFree(block);
+	}
+
+	auto TLSFAllocator::Allocate(U64 size, U64 alignment /*= 1*/) -> Handle
+	{
+		GAZE_ASSERT(size > 0, "Cannot allocate 0 bytes");
+		GAZE_ASSERT(alignment > 0, "Alignment must not be 0");
+
+		// Any block of at least this size can hold an aligned range
+		const auto searchSize = size + alignment - 1;
+		if (searchSize > m_Capacity) {
+			return kInvalidHandle;
+		}
+
+		auto idx = FindFree(MapSearch(searchSize));
+		if (idx == kNullBlock) {
+			// Rounding up skips blocks in the request's own size class,
+			// some of which may still be large enough
+			const auto [fl, sl] = MapInsert(searchSize);
+			idx = m_Heads[fl][sl];
+			while (idx != kNullBlock && m_Blocks[idx].size < searchSize) {
+				idx = m_Blocks[idx].nextFree;
+			}
+		}
+		if (idx == kNullBlock) {
+			return kInvalidHandle;
+		}
+
+		return Carve(idx, size, alignment);
+	}
+
+	auto TLSFAllocator::Free(Handle handle) -> void
+	{
+		GAZE_ASSERT(handle < m_Handles.size() && m_Handles[handle] != kNullBlock, "Invalid handle");
+
+		auto idx = m_Handles[handle];
+		m_Handles[handle] = kNullBlock;
+		m_FreeHandles.push_back(handle);
+
+		m_Used -= m_Blocks[idx].size;
+		m_Blocks[idx].handle = kInvalidHandle;
+
+		const auto absorb = [this](BlockIndex into, BlockIndex from) {
+			auto& target = m_Blocks[into];
+			auto& source = m_Blocks[from];
+
+			target.size        += source.size;
+			target.nextPhysical = source.nextPhysical;
+			if (source.nextPhysical != kNullBlock) {
+				m_Blocks[source.nextPhysical].prevPhysical = into;
+			}
+			m_FreeRecords.push_back(from);
+		};
+
+		if (const auto next = m_Blocks[idx].nextPhysical; next != kNullBlock && m_Blocks[next].handle == kInvalidHandle) {
+			RemoveFree(next);
+			absorb(idx, next);
+		}
+		if (const auto prev = m_Blocks[idx].prevPhysical; prev != kNullBlock && m_Blocks[prev].handle == kInvalidHandle) {
+			RemoveFree(prev);
+			absorb(prev, idx);
+			idx = prev;
+		}
+
+		InsertFree(idx);
+	}
+
+	auto TLSFAllocator::Offset(Handle handle) const noexcept -> U64
+	{
+		return m_Blocks[m_Handles[handle]].offset;
+	}
+
+	auto TLSFAllocator::Size(Handle handle) const noexcept -> U64
+	{
+		return m_Blocks[m_Handles[handle]].size;
+	}
+
+	auto TLSFAllocator::Defragment(U64 budget, const MoveFn& move) -> U64
+	{
+		auto handles = std::vector<Handle>();
+		for (auto handle = Handle(0); handle < m_Handles.size(); handle++) {
+			if (m_Handles[handle] != kNullBlock) {
+				handles.push_back(handle);
+			}
+		}
+		std::sort(handles.begin(), handles.end(), [this](Handle lhs, Handle rhs) {
+			return Offset(lhs) > Offset(rhs);
+		});
+
+		auto moved = U64(0);
+		for (const auto handle : handles) {
+			if (moved >= budget) {
+				break;
+			}
+
+			const auto from = Offset(handle);
+			const auto size = Size(handle);
+
+			const auto alignment = m_Blocks[m_Handles[handle]].alignment;
+			const auto idx       = FindFreeBelow(size + alignment - 1, from);
+			if (idx == kNullBlock) {
+				continue;
+			}
+
+			const auto target = Carve(idx, size, alignment);
+			move(from, Offset(target), size);
+
+			// The handle follows its data, the old block goes away with the temporary one
+			std::swap(m_Handles[handle], m_Handles[target]);
+			m_Blocks[m_Handles[handle]].handle = handle;
+			m_Blocks[m_Handles[target]].handle = target;
+			Free(target);
+
+			moved += size;
+		}
+
+		return moved;
+	}
+
+	auto TLSFAllocator::GetStats() const noexcept -> Stats
+	{
+		auto stats = Stats{
+			.capacity         = m_Capacity,
+			.used             = m_Used,
+			.largestFreeBlock = 0,
+			.nAllocations     = U32(m_Handles.size() - m_FreeHandles.size()),
+			.nFreeBlocks      = 0,
+			.fragmentation    = 0.F,
+		};
+
+		for (auto fl = 0U; fl < kFLCount; fl++) {
+			for (auto sl = 0U; sl < kSLCount; sl++) {
+				for (auto idx = m_Heads[fl][sl]; idx != kNullBlock; idx = m_Blocks[idx].nextFree) {
+					stats.largestFreeBlock = std::max(stats.largestFreeBlock, m_Blocks[idx].size);
+					stats.nFreeBlocks++;
+				}
+			}
+		}
+
+		const auto free = m_Capacity - m_Used;
+		if (free > 0) {
+			stats.fragmentation = 1.F - F32(F64(stats.largestFreeBlock) / F64(free));
+		}
+
+		return stats;
+	}
+
+	auto TLSFAllocator::Carve(BlockIndex idx, U64 size, U64 alignment) -> Handle
+	{
+		RemoveFree(idx);
+		const auto offset  = m_Blocks[idx].offset;
+		const auto aligned = (offset + alignment - 1) / alignment * alignment;
+
+		if (aligned != offset) {
+			// Give the padding back as a block of its own. The previous
+			// block is in use, otherwise it would have been merged with this
+			// one, so there is nothing to merge the padding with.
+			const auto padding = NewBlock();
+			auto& block = m_Blocks[idx];
+
+			m_Blocks[padding].offset       = offset;
+			m_Blocks[padding].size         = aligned - offset;
+			m_Blocks[padding].prevPhysical = block.prevPhysical;
+			m_Blocks[padding].nextPhysical = idx;
+			if (block.prevPhysical != kNullBlock) {
+				m_Blocks[block.prevPhysical].nextPhysical = padding;
+			}
+
+			block.prevPhysical = padding;
+			block.offset       = aligned;
+			block.size        -= aligned - offset;
+			InsertFree(padding);
+		}
+
+		if (m_Blocks[idx].size > size) {
+			SplitFree(idx, size);
+		}
+
+		m_Blocks[idx].alignment = alignment;
+		m_Used += size;
+
+		return NewHandle(idx);
+	}
+
+	auto TLSFAllocator::FindFreeBelow(U64 size, U64 limit) const noexcept -> BlockIndex
+	{
+		static constexpr auto kMaxProbes = 8;
+
+		// Only a few blocks of each large enough size class are looked at.
+		// Taking the lowest of them, rather than the first, keeps allocations
+		// from merely swapping places with the hole right below them.
+		auto best = kNullBlock;
+
+		const auto start = MapInsert(size);
+		for (auto flMap = m_FLBitmap & (~U64(0) << start.fl); flMap != 0; flMap &= flMap - 1) {
+			const auto fl = U32(std::countr_zero(flMap));
+
+			auto slMap = m_SLBitmaps[fl];
+			if (fl == start.fl) {
+				slMap &= ~0U << start.sl;
+			}
+
+			for (; slMap != 0; slMap &= slMap - 1) {
+				auto idx = m_Heads[fl][U32(std::countr_zero(slMap))];
+				for (auto probe = 0; idx != kNullBlock && probe < kMaxProbes; probe++) {
+					const auto& block = m_Blocks[idx];
+					if (block.offset < limit && block.size >= size && (best == kNullBlock || block.offset < m_Blocks[best].offset)) {
+						best = idx;
+					}
+					idx = block.nextFree;
+				}
+			}
+		}
+
+		return best;
+	}
+
+	auto TLSFAllocator::MapInsert(U64 size) noexcept -> Mapping
+	{
+		if (size < (U64(1) << kFLShift)) {
+			return { 0, U32(size) };
+		}
+
+		const auto msb = U32(std::bit_width(size) - 1);
+		return {
+			msb - kFLShift + 1,
+			U32(size >> (msb - kSLBits)) ^ kSLCount,
+		};
+	}
+
+	auto TLSFAllocator::MapSearch(U64 size) noexcept -> Mapping
+	{
+		// Round up to the next size class, so that any block found is large enough
+		if (size >= (U64(1) << kFLShift)) {
+			const auto msb = U32(std::bit_width(size) - 1);
+			size += (U64(1) << (msb - kSLBits)) - 1;
+		}
+
+		return MapInsert(size);
+	}
+
+	auto TLSFAllocator::FindFree(Mapping mapping) const noexcept -> BlockIndex
+	{
+		if (mapping.fl >= kFLCount) {
+			return kNullBlock;
+		}
+
+		auto slMap = m_SLBitmaps[mapping.fl] & (~0U << mapping.sl);
+		if (slMap == 0) {
+			const auto flMap = mapping.fl + 1 < kFLCount ? m_FLBitmap & (~U64(0) << (mapping.fl + 1)) : U64(0);
+			if (flMap == 0) {
+				return kNullBlock;
+			}
+
+			mapping.fl = U32(std::countr_zero(flMap));
+			slMap      = m_SLBitmaps[mapping.fl];
+		}
+
+		return m_Heads[mapping.fl][U32(std::countr_zero(slMap))];
+	}
+
+	auto TLSFAllocator::InsertFree(BlockIndex idx) noexcept -> void
+	{
+		auto& block = m_Blocks[idx];
+		const auto [fl, sl] = MapInsert(block.size);
+
+		block.handle   = kInvalidHandle;
+		block.prevFree = kNullBlock;
+		block.nextFree = m_Heads[fl][sl];
+		if (block.nextFree != kNullBlock) {
+			m_Blocks[block.nextFree].prevFree = idx;
+		}
+		m_Heads[fl][sl] = idx;
+
+		m_FLBitmap      |= U64(1) << fl;
+		m_SLBitmaps[fl] |= 1U << sl;
+	}
+
+	auto TLSFAllocator::RemoveFree(BlockIndex idx) noexcept -> void
+	{
+		const auto& block = m_Blocks[idx];
+		const auto [fl, sl] = MapInsert(block.size);
+
+		if (block.prevFree != kNullBlock) {
+			m_Blocks[block.prevFree].nextFree = block.nextFree;
+		} else {
+			m_Heads[fl][sl] = block.nextFree;
+		}
+		if (block.nextFree != kNullBlock) {
+			m_Blocks[block.nextFree].prevFree = block.prevFree;
+		}
+
+		if (m_Heads[fl][sl] == kNullBlock) {
+			m_SLBitmaps[fl] &= ~(1U << sl);
+			if (m_SLBitmaps[fl] == 0) {
+				m_FLBitmap &= ~(U64(1) << fl);
+			}
+		}
+	}
+
+	auto TLSFAllocator::SplitFree(BlockIndex idx, U64 size) -> void
+	{
+		const auto tail = NewBlock();
+		auto& block = m_Blocks[idx];
+
+		m_Blocks[tail].offset       = block.offset + size;
+		m_Blocks[tail].size         = block.size - size;
+		m_Blocks[tail].prevPhysical = idx;
+		m_Blocks[tail].nextPhysical = block.nextPhysical;
+		if (block.nextPhysical != kNullBlock) {
+			m_Blocks[block.nextPhysical].prevPhysical = tail;
+		}
+
+		block.nextPhysical = tail;
+		block.size         = size;
+		InsertFree(tail);
+	}
+
+	auto TLSFAllocator::NewBlock() -> BlockIndex
+	{
+		auto idx = kNullBlock;
+		if (m_FreeRecords.empty()) {
+			idx = BlockIndex(m_Blocks.size());
+			m_Blocks.emplace_back();
+		} else {
+			idx = m_FreeRecords.back();
+			m_FreeRecords.pop_back();
+		}
+
+		m_Blocks[idx] = Block{
+			.offset       = 0,
+			.size         = 0,
+			.alignment    = 1,
+			.prevPhysical = kNullBlock,
+			.nextPhysical = kNullBlock,
+			.prevFree     = kNullBlock,
+			.nextFree     = kNullBlock,
+			.handle       = kInvalidHandle,
+		};
+
+		return idx;
+	}
+
+	auto TLSFAllocator::NewHandle(BlockIndex block) -> Handle
+	{
+		auto handle = kInvalidHandle;
+		if (m_FreeHandles.empty()) {
+			handle = Handle(m_Handles.size());
+			m_Handles.push_back(block);
+		} else {
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+			m_Handles[handle] = block;
+		}
+
+		m_Blocks[block].handle = handle;
+		return handle;
+	}
+}
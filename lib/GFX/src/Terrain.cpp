@@ -0,0 +1,457 @@
+#include "GFX/Terrain.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <limits>
+
+namespace Gaze::GFX {
+	namespace {
+		/**
+		 * @brief Chebyshev distance between two tiles, so the resident area is a square.
+		 */
+		auto TileDistance(glm::ivec2 a, glm::ivec2 b) noexcept -> I32
+		{
+			return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+		}
+
+		auto DistanceToBox(const glm::vec3& point, const AABB& box) noexcept -> F32
+		{
+			return glm::length(glm::max(glm::max(box.min - point, 0.F), point - box.max));
+		}
+
+		auto PackNormal(const glm::vec3& normal) noexcept -> std::array<I8, 4>
+		{
+			const auto packed = glm::round(glm::clamp(normal, -1.F, 1.F) * 127.F);
+
+			return { I8(packed.x), I8(packed.y), I8(packed.z), 0 };
+		}
+	}
+
+	Terrain::Terrain(Settings settings, Jobs::ThreadPool* pool)
+		: m_Settings(std::move(settings))
+		, m_Pool(pool)
+	{
+		GAZE_ASSERT(m_Settings.loader, "The terrain needs a tile loader");
+		GAZE_ASSERT(std::has_single_bit(U32(m_Settings.tileResolution)), "The tile resolution must be a power of two");
+		GAZE_ASSERT(std::has_single_bit(U32(m_Settings.chunkResolution)), "The chunk resolution must be a power of two");
+		GAZE_ASSERT(m_Settings.chunkResolution <= m_Settings.tileResolution, "Chunks can't be larger than tiles");
+		GAZE_ASSERT(m_Settings.maxResidentTiles > 0 && m_Settings.maxPendingLoads > 0, "The terrain needs room for tiles");
+
+		for (auto slot = m_Settings.maxResidentTiles; slot-- > 0;) {
+			m_FreeSlots.push_back(slot);
+		}
+	}
+
+	Terrain::~Terrain()
+	{
+		// The loads write into the pending tiles
+		for (auto& load : m_Pending) {
+			if (m_Pool != nullptr) {
+				m_Pool->Wait(load.done);
+			} else {
+				load.done.wait();
+			}
+		}
+	}
+
+	auto Terrain::Update(const glm::vec3& camera) -> void
+	{
+		const auto center = glm::ivec2(
+			I32(std::floor(camera.x / m_Settings.tileSize)),
+			I32(std::floor(camera.z / m_Settings.tileSize))
+		);
+		const auto isInRange = [&](glm::ivec2 coords, I32 radius) {
+			return TileDistance(coords, center) <= radius;
+		};
+
+		// Tiles just out of range are kept, so moving back and forth over a tile's edge doesn't reload it
+		const auto keepRadius = m_Settings.loadRadius + 1;
+		for (auto i = m_Tiles.size(); i-- > 0;) {
+			if (!isInRange(m_Tiles[i].coords, keepRadius)) {
+				Evict(i);
+			}
+		}
+		std::erase_if(m_Missing, [&](glm::ivec2 coords) { return !isInRange(coords, keepRadius); });
+
+		// Nearest missing tiles first
+		auto wanted = std::vector<glm::ivec2>();
+		for (auto z = center.y - m_Settings.loadRadius; z <= center.y + m_Settings.loadRadius; z++) {
+			for (auto x = center.x - m_Settings.loadRadius; x <= center.x + m_Settings.loadRadius; x++) {
+				const auto coords = glm::ivec2(x, z);
+
+				const auto isPending = std::ranges::any_of(m_Pending, [coords](const PendingLoad& load) { return load.coords == coords; });
+				if (TileAt(coords) == nullptr && !isPending && std::ranges::find(m_Missing, coords) == m_Missing.end()) {
+					wanted.push_back(coords);
+				}
+			}
+		}
+
+		const auto tileCenter = [this](glm::ivec2 coords) {
+			return (glm::vec2(coords) + .5F) * m_Settings.tileSize;
+		};
+		const auto camera2D = glm::vec2(camera.x, camera.z);
+		std::ranges::sort(wanted, {}, [&](glm::ivec2 coords) { return glm::distance(tileCenter(coords), camera2D); });
+
+		for (const auto coords : wanted) {
+			if (I32(m_Pending.size()) >= m_Settings.maxPendingLoads) {
+				break;
+			}
+
+			// Out of slots, make room by evicting the farthest tile that is no longer wanted
+			if (m_FreeSlots.empty()) {
+				auto farthest = std::optional<std::size_t>();
+				for (auto i = std::size_t(0); i < m_Tiles.size(); i++) {
+					const auto distance = TileDistance(m_Tiles[i].coords, center);
+					if (distance > m_Settings.loadRadius && (!farthest || distance > TileDistance(m_Tiles[*farthest].coords, center))) {
+						farthest = i;
+					}
+				}
+				if (!farthest) {
+					break;
+				}
+
+				Evict(*farthest);
+			}
+
+			auto load = PendingLoad{ coords, m_FreeSlots.back(), MakeUnique<Tile>(), {} };
+			m_FreeSlots.pop_back();
+
+			load.tile->coords  = coords;
+			load.tile->slot    = load.slot;
+			load.tile->version = m_NextVersion++;
+
+			if (m_Pool != nullptr) {
+				load.done = m_Pool->Submit([this, tile = load.tile.get()] { Load(*tile); });
+			} else {
+				auto promise = std::promise<void>();
+				Load(*load.tile);
+				promise.set_value();
+				load.done = promise.get_future();
+			}
+
+			m_Pending.push_back(std::move(load));
+		}
+
+		for (auto it = m_Pending.begin(); it != m_Pending.end();) {
+			if (it->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				++it;
+				continue;
+			}
+
+			if (it->tile->vertices.empty()) {
+				m_Missing.push_back(it->coords);
+				m_FreeSlots.push_back(it->slot);
+			} else {
+				m_TileIndices[Key(it->coords)] = m_Tiles.size();
+				m_Tiles.push_back(std::move(*it->tile));
+			}
+
+			it = m_Pending.erase(it);
+		}
+
+		PickLods(camera);
+	}
+
+	auto Terrain::Select(const Frustum& frustum, std::vector<ChunkDraw>& out) const -> void
+	{
+		out.clear();
+
+		const auto nChunks = ChunksPerTile();
+		const auto stride  = m_Settings.tileResolution + 1;
+
+		for (const auto& tile : m_Tiles) {
+			for (auto cz = 0; cz < nChunks; cz++) {
+				for (auto cx = 0; cx < nChunks; cx++) {
+					const auto chunk = std::size_t(cz * nChunks + cx);
+					if (!frustum.Intersects(tile.bounds[chunk])) {
+						continue;
+					}
+
+					out.push_back({
+						.slot        = tile.slot,
+						.firstVertex = (cz * stride + cx) * m_Settings.chunkResolution,
+						.lod         = tile.lods[chunk],
+						.stitches    = tile.stitches[chunk],
+						.bounds      = tile.bounds[chunk],
+					});
+				}
+			}
+		}
+	}
+
+	auto Terrain::HeightAt(F32 x, F32 z) const noexcept -> std::optional<F32>
+	{
+		const auto coords = glm::ivec2(I32(std::floor(x / m_Settings.tileSize)), I32(std::floor(z / m_Settings.tileSize)));
+		const auto* tile  = TileAt(coords);
+		if (tile == nullptr) {
+			return std::nullopt;
+		}
+
+		const auto resolution = m_Settings.tileResolution;
+		const auto stride     = resolution + 1;
+		const auto local      = (glm::vec2(x, z) / m_Settings.tileSize - glm::vec2(coords)) * F32(resolution);
+		const auto cell       = glm::clamp(glm::ivec2(glm::floor(local)), 0, resolution - 1);
+		const auto t          = glm::clamp(local - glm::vec2(cell), 0.F, 1.F);
+
+		const auto height = [&](I32 dx, I32 dz) {
+			return tile->vertices[std::size_t((cell.y + dz) * stride + cell.x + dx)].position.y;
+		};
+
+		return glm::mix(
+			glm::mix(height(0, 0), height(1, 0), t.x),
+			glm::mix(height(0, 1), height(1, 1), t.x),
+			t.y
+		);
+	}
+
+	auto Terrain::LodCount() const noexcept -> I32
+	{
+		return LodCount(m_Settings.chunkResolution);
+	}
+
+	auto Terrain::LodCount(I32 chunkResolution) noexcept -> I32
+	{
+		return std::countr_zero(U32(chunkResolution)) + 1;
+	}
+
+	auto Terrain::BuildChunkIndices(I32 chunkResolution, I32 rowStride, I32 lod, U8 stitches) -> std::vector<U32>
+	{
+		const auto step = 1 << lod;
+		const auto n    = chunkResolution >> lod;
+		GAZE_ASSERT(n >= 1, "Level of detail out of range");
+
+		// A single quad has no vertex to skip
+		if (n < 2) {
+			stitches = 0;
+		}
+
+		// Odd vertices of a stitched side collapse onto the previous one, so
+		// the side is made of the coarser neighbour's edges
+		const auto vertex = [&](I32 i, I32 j) {
+			if (((stitches & kNegativeX) != 0 && i == 0) || ((stitches & kPositiveX) != 0 && i == n)) {
+				j &= ~1;
+			}
+			if (((stitches & kNegativeZ) != 0 && j == 0) || ((stitches & kPositiveZ) != 0 && j == n)) {
+				i &= ~1;
+			}
+
+			return U32((j * rowStride + i) * step);
+		};
+
+		auto indices = std::vector<U32>();
+		indices.reserve(std::size_t(n * n * 6));
+
+		const auto triangle = [&indices](U32 a, U32 b, U32 c) {
+			if (a != b && b != c && c != a) {
+				indices.insert(indices.end(), { a, b, c });
+			}
+		};
+
+		// Where both positive sides are stitched, the usual diagonal of the
+		// corner quad would join the two collapsed vertices through its centre
+		const auto flipCorner = (stitches & (kPositiveX | kPositiveZ)) == (kPositiveX | kPositiveZ);
+
+		for (auto j = 0; j < n; j++) {
+			for (auto i = 0; i < n; i++) {
+				const auto a = vertex(i, j);
+				const auto b = vertex(i + 1, j);
+				const auto c = vertex(i, j + 1);
+				const auto d = vertex(i + 1, j + 1);
+
+				if (flipCorner && i == n - 1 && j == n - 1) {
+					triangle(a, c, d);
+					triangle(a, d, b);
+				} else {
+					triangle(a, c, b);
+					triangle(b, c, d);
+				}
+			}
+		}
+
+		return indices;
+	}
+
+	auto Terrain::RawTileLoader(std::filesystem::path directory, I32 resolution, F32 heightScale) -> TileLoader
+	{
+		return [directory = std::move(directory), resolution, heightScale](glm::ivec2 tile) {
+			const auto nSamples = std::size_t(resolution + 1) * std::size_t(resolution + 1);
+
+			auto file = std::ifstream(directory / std::format("{}_{}.r16", tile.x, tile.y), std::ios::binary);
+			auto raw  = std::vector<U8>(nSamples * 2);
+			if (!file.read(reinterpret_cast<char*>(raw.data()), std::streamsize(raw.size()))) {
+				return std::vector<F32>();
+			}
+
+			auto heights = std::vector<F32>(nSamples);
+			for (auto i = std::size_t(0); i < nSamples; i++) {
+				const auto sample = U32(raw[i * 2]) | (U32(raw[i * 2 + 1]) << 8);
+				heights[i] = F32(sample) / 65535.F * heightScale;
+			}
+
+			return heights;
+		};
+	}
+
+	auto Terrain::Load(Tile& tile) const -> void
+	{
+		const auto resolution = m_Settings.tileResolution;
+		const auto stride     = resolution + 1;
+		const auto heights    = m_Settings.loader(tile.coords);
+		if (heights.size() != std::size_t(stride * stride)) {
+			return;
+		}
+
+		const auto spacing = m_Settings.tileSize / F32(resolution);
+		const auto origin  = glm::vec2(tile.coords) * m_Settings.tileSize;
+		const auto height  = [&](I32 x, I32 z) {
+			return heights[std::size_t(std::clamp(z, 0, resolution) * stride + std::clamp(x, 0, resolution))];
+		};
+
+		tile.vertices.resize(heights.size());
+		for (auto z = 0; z <= resolution; z++) {
+			for (auto x = 0; x <= resolution; x++) {
+				// Central differences, one-sided on the tile's edges
+				const auto x0 = std::max(x - 1, 0);
+				const auto x1 = std::min(x + 1, resolution);
+				const auto z0 = std::max(z - 1, 0);
+				const auto z1 = std::min(z + 1, resolution);
+
+				const auto dx = (height(x1, z) - height(x0, z)) / (F32(x1 - x0) * spacing);
+				const auto dz = (height(x, z1) - height(x, z0)) / (F32(z1 - z0) * spacing);
+
+				tile.vertices[std::size_t(z * stride + x)] = {
+					.position = { origin.x + F32(x) * spacing, height(x, z), origin.y + F32(z) * spacing },
+					.normal   = PackNormal(glm::normalize(glm::vec3(-dx, 1.F, -dz))),
+				};
+			}
+		}
+
+		const auto nChunks    = ChunksPerTile();
+		const auto chunkQuads = m_Settings.chunkResolution;
+
+		tile.bounds.resize(std::size_t(nChunks * nChunks));
+		for (auto cz = 0; cz < nChunks; cz++) {
+			for (auto cx = 0; cx < nChunks; cx++) {
+				auto minHeight = std::numeric_limits<F32>::max();
+				auto maxHeight = std::numeric_limits<F32>::lowest();
+				for (auto z = cz * chunkQuads; z <= (cz + 1) * chunkQuads; z++) {
+					for (auto x = cx * chunkQuads; x <= (cx + 1) * chunkQuads; x++) {
+						minHeight = std::min(minHeight, height(x, z));
+						maxHeight = std::max(maxHeight, height(x, z));
+					}
+				}
+
+				const auto min = origin + glm::vec2(F32(cx), F32(cz)) * F32(chunkQuads) * spacing;
+				const auto max = min + F32(chunkQuads) * spacing;
+				tile.bounds[std::size_t(cz * nChunks + cx)] = { { min.x, minHeight, min.y }, { max.x, maxHeight, max.y } };
+			}
+		}
+
+		tile.lods.assign(tile.bounds.size(), 0);
+		tile.stitches.assign(tile.bounds.size(), 0);
+	}
+
+	auto Terrain::Evict(std::size_t index) -> void
+	{
+		m_FreeSlots.push_back(m_Tiles[index].slot);
+		m_TileIndices.erase(Key(m_Tiles[index].coords));
+
+		if (index != m_Tiles.size() - 1) {
+			m_Tiles[index] = std::move(m_Tiles.back());
+			m_TileIndices[Key(m_Tiles[index].coords)] = index;
+		}
+		m_Tiles.pop_back();
+	}
+
+	auto Terrain::PickLods(const glm::vec3& camera) -> void
+	{
+		const auto nChunks = ChunksPerTile();
+		const auto maxLod  = LodCount() - 1;
+
+		for (auto& tile : m_Tiles) {
+			for (auto chunk = std::size_t(0); chunk < tile.bounds.size(); chunk++) {
+				const auto distance = DistanceToBox(camera, tile.bounds[chunk]) / m_Settings.lodDistance;
+
+				tile.lods[chunk] = distance < 1.F ? 0 : U8(std::min(maxLod, I32(std::log2(distance)) + 1));
+			}
+		}
+
+		// The level of the chunk next to (cx, cz), which may be in a neighbouring tile
+		const auto neighbour = [this, nChunks](const Tile& tile, I32 cx, I32 cz) -> std::optional<U8> {
+			const auto offset = glm::ivec2(cx < 0 ? -1 : (cx >= nChunks ? 1 : 0), cz < 0 ? -1 : (cz >= nChunks ? 1 : 0));
+			const auto* other = offset == glm::ivec2(0) ? &tile : TileAt(tile.coords + offset);
+			if (other == nullptr) {
+				return std::nullopt;
+			}
+
+			const auto local = glm::ivec2(cx, cz) - offset * nChunks;
+			return other->lods[std::size_t(local.y * nChunks + local.x)];
+		};
+
+		static constexpr auto kSides = std::array{
+			std::pair{ glm::ivec2(-1, 0), kNegativeX },
+			std::pair{ glm::ivec2(1, 0),  kPositiveX },
+			std::pair{ glm::ivec2(0, -1), kNegativeZ },
+			std::pair{ glm::ivec2(0, 1),  kPositiveZ },
+		};
+
+		// Stitching only bridges one level, so refine chunks until no neighbour is finer by more than that
+		auto changed = true;
+		while (changed) {
+			changed = false;
+			for (auto& tile : m_Tiles) {
+				for (auto cz = 0; cz < nChunks; cz++) {
+					for (auto cx = 0; cx < nChunks; cx++) {
+						auto& lod = tile.lods[std::size_t(cz * nChunks + cx)];
+						for (const auto& [direction, side] : kSides) {
+							const auto other = neighbour(tile, cx + direction.x, cz + direction.y);
+							if (other && lod > *other + 1) {
+								lod     = U8(*other + 1);
+								changed = true;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (auto& tile : m_Tiles) {
+			for (auto cz = 0; cz < nChunks; cz++) {
+				for (auto cx = 0; cx < nChunks; cx++) {
+					const auto chunk = std::size_t(cz * nChunks + cx);
+
+					auto stitches = U8(0);
+					for (const auto& [direction, side] : kSides) {
+						const auto other = neighbour(tile, cx + direction.x, cz + direction.y);
+						if (other && *other > tile.lods[chunk]) {
+							stitches |= side;
+						}
+					}
+					tile.stitches[chunk] = stitches;
+				}
+			}
+		}
+	}
+
+	auto Terrain::TileAt(glm::ivec2 coords) const noexcept -> const Tile*
+	{
+		const auto it = m_TileIndices.find(Key(coords));
+		return it == m_TileIndices.end() ? nullptr : &m_Tiles[it->second];
+	}
+
+	auto Terrain::Key(glm::ivec2 coords) noexcept -> U64
+	{
+		return (U64(U32(coords.x)) << 32) | U64(U32(coords.y));
+	}
+}
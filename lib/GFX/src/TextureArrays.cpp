@@ -0,0 +1,140 @@
+#include "GFX/TextureArrays.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Gaze::GFX {
+	auto TextureArrays::Add(TextureID texture, const Shape& shape) -> std::optional<Slot>
+	{
+		GAZE_ASSERT(!m_Entries.contains(texture), "Texture added twice");
+		GAZE_ASSERT(shape.levels > 0 && shape.width > 0 && shape.height > 0, "Texture shape must not be empty");
+
+		auto array = std::find_if(m_Arrays.begin(), m_Arrays.end(), [&](const Array& candidate) {
+			return candidate.shape == shape && !candidate.freeLayers.empty();
+		});
+		if (array == m_Arrays.end()) {
+			if (m_Arrays.size() >= std::size_t(kMaxArrays)) {
+				return std::nullopt;
+			}
+
+			// Layers are handed out from the back, lowest first
+			auto& added = m_Arrays.emplace_back(Array { shape, {} });
+			added.freeLayers.reserve(std::size_t(kLayersPerArray));
+			for (auto layer = kLayersPerArray - 1; layer >= 0; layer--) {
+				added.freeLayers.push_back(layer);
+			}
+
+			array = std::prev(m_Arrays.end());
+		}
+
+		const auto slot = Slot { I32(std::distance(m_Arrays.begin(), array)), array->freeLayers.back() };
+		array->freeLayers.pop_back();
+		m_Entries.emplace(texture, Entry { slot, shape.levels, shape.levels });
+
+		return slot;
+	}
+
+	auto TextureArrays::Remove(TextureID texture) -> void
+	{
+		const auto entry = m_Entries.find(texture);
+		GAZE_ASSERT(entry != m_Entries.end(), "Removing a texture that wasn't added");
+
+		const auto slot = entry->second.slot;
+		m_Arrays[std::size_t(slot.array)].freeLayers.push_back(slot.layer);
+		m_Entries.erase(entry);
+	}
+
+	auto TextureArrays::Find(TextureID texture) const noexcept -> std::optional<Residency>
+	{
+		const auto entry = m_Entries.find(texture);
+		if (entry == m_Entries.end() || entry->second.minLevel == ArrayShape(entry->second.slot.array).levels) {
+			return std::nullopt;
+		}
+
+		return Residency { entry->second.slot, entry->second.minLevel };
+	}
+
+	auto TextureArrays::WantedLevel(I32 size, F32 screenSize, I32 levels) noexcept -> I32
+	{
+		if (!(screenSize > 0.F)) {
+			return levels - 1;
+		}
+
+		// One texel per pixel, as hardware mip selection would pick for a texture facing the camera
+		const auto level = std::floor(std::log2(F32(size) / screenSize));
+
+		return std::clamp(I32(std::max(level, 0.F)), 0, levels - 1);
+	}
+
+	auto TextureArrays::Request(TextureID texture, F32 screenSize) noexcept -> void
+	{
+		const auto entry = m_Entries.find(texture);
+		if (entry == m_Entries.end()) {
+			return;
+		}
+
+		const auto& shape = ArrayShape(entry->second.slot.array);
+		entry->second.wanted = std::min(entry->second.wanted, WantedLevel(std::max(shape.width, shape.height), screenSize, shape.levels));
+	}
+
+	auto TextureArrays::Stream(I64 budget) -> std::span<const Upload>
+	{
+		m_Uploads.clear();
+
+		// Tails first, so every texture can be drawn from the frame it is added
+		for (auto& [texture, entry] : m_Entries) {
+			const auto tail = TailLevel(ArrayShape(entry.slot.array));
+			for (; entry.minLevel > tail; entry.minLevel--) {
+				const auto& shape = ArrayShape(entry.slot.array);
+				budget -= TextureImage::LevelSize(shape.format, shape.width, shape.height, entry.minLevel - 1);
+				m_Uploads.push_back({ texture, entry.slot, entry.minLevel - 1 });
+			}
+		}
+
+		auto pending = std::vector<std::pair<TextureID, Entry*>>();
+		for (auto& [texture, entry] : m_Entries) {
+			if (entry.wanted < entry.minLevel) {
+				pending.emplace_back(texture, &entry);
+			}
+			entry.wanted = ArrayShape(entry.slot.array).levels;
+		}
+
+		// The blurriest first, then by ID so the order doesn't depend on the map's
+		std::sort(pending.begin(), pending.end(), [](const auto& a, const auto& b) {
+			return a.second->minLevel != b.second->minLevel ? a.second->minLevel > b.second->minLevel : a.first < b.first;
+		});
+
+		for (auto& [texture, entry] : pending) {
+			const auto& shape = ArrayShape(entry->slot.array);
+			const auto  size  = TextureImage::LevelSize(shape.format, shape.width, shape.height, entry->minLevel - 1);
+			if (size > budget) {
+				break;
+			}
+
+			budget -= size;
+			entry->minLevel--;
+			m_Uploads.push_back({ texture, entry->slot, entry->minLevel });
+		}
+
+		return m_Uploads;
+	}
+
+	auto TextureArrays::ArrayShape(I32 array) const noexcept -> const Shape&
+	{
+		GAZE_ASSERT(array >= 0 && array < Arrays(), "Texture array out of range");
+
+		return m_Arrays[std::size_t(array)].shape;
+	}
+
+	auto TextureArrays::TailLevel(const Shape& shape) noexcept -> I32
+	{
+		auto level = 0;
+		while (level < shape.levels - 1 && std::max(shape.width >> level, shape.height >> level) > kTailSize) {
+			level++;
+		}
+
+		return level;
+	}
+}
@@ -0,0 +1,180 @@
+#include "GFX/TextureImage.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <fstream>
+#include <iterator>
+
+namespace Gaze::GFX {
+	// Layout of the container, see the DDS_HEADER and DDS_HEADER_DXT10 structures
+	static constexpr auto kHeaderSize     = std::size_t(128); /**< The magic number and DDS_HEADER */
+	static constexpr auto kDX10HeaderSize = std::size_t(20);
+
+	static constexpr auto kMagicOffset       = std::size_t(0);
+	static constexpr auto kSizeOffset        = std::size_t(4);
+	static constexpr auto kFlagsOffset       = std::size_t(8);
+	static constexpr auto kHeightOffset      = std::size_t(12);
+	static constexpr auto kWidthOffset       = std::size_t(16);
+	static constexpr auto kMipCountOffset    = std::size_t(28);
+	static constexpr auto kPixelFlagsOffset  = std::size_t(80);
+	static constexpr auto kFourCCOffset      = std::size_t(84);
+	static constexpr auto kCaps2Offset       = std::size_t(112);
+	static constexpr auto kDXGIFormatOffset  = kHeaderSize;
+	static constexpr auto kDimensionOffset   = kHeaderSize + 4;
+	static constexpr auto kMiscFlagOffset    = kHeaderSize + 8;
+	static constexpr auto kArraySizeOffset   = kHeaderSize + 12;
+
+	static constexpr auto kMipCountFlag      = 0x20000U;
+	static constexpr auto kFourCCFlag        = 0x4U;
+	static constexpr auto kCubemapFlag       = 0x200U;
+	static constexpr auto kVolumeFlag        = 0x200000U;
+	static constexpr auto kTextureCubeFlag   = 0x4U;
+	static constexpr auto kTexture2D         = 3U;
+
+	static constexpr auto kMaxSize = 1U << (TextureImage::kMaxLevels - 1);
+
+	static constexpr auto FourCC(char a, char b, char c, char d) noexcept -> U32
+	{
+		return U32(U8(a)) | (U32(U8(b)) << 8) | (U32(U8(c)) << 16) | (U32(U8(d)) << 24);
+	}
+
+	/**
+	 * @brief Read a little endian 32-bit value.
+	 */
+	static auto ReadU32(std::span<const std::byte> data, std::size_t offset) noexcept -> U32
+	{
+		return U32(data[offset]) | (U32(data[offset + 1]) << 8) | (U32(data[offset + 2]) << 16) | (U32(data[offset + 3]) << 24);
+	}
+
+	struct DXGIFormat
+	{
+		U32                  value;
+		TextureImage::Format format;
+		bool                 isSRGB;
+	};
+
+	static constexpr DXGIFormat kDXGIFormats[] = {
+		{ 71, TextureImage::Format::BC1, false },
+		{ 72, TextureImage::Format::BC1, true },
+		{ 77, TextureImage::Format::BC3, false },
+		{ 78, TextureImage::Format::BC3, true },
+		{ 83, TextureImage::Format::BC5, false },
+		{ 98, TextureImage::Format::BC7, false },
+		{ 99, TextureImage::Format::BC7, true },
+	};
+
+	auto TextureImage::Parse(std::vector<std::byte> data) -> std::optional<TextureImage>
+	{
+		if (data.size() < kHeaderSize || ReadU32(data, kMagicOffset) != FourCC('D', 'D', 'S', ' ') || ReadU32(data, kSizeOffset) != 124) {
+			return std::nullopt;
+		}
+
+		const auto flags  = ReadU32(data, kFlagsOffset);
+		const auto width  = ReadU32(data, kWidthOffset);
+		const auto height = ReadU32(data, kHeightOffset);
+		const auto levels = (flags & kMipCountFlag) != 0 ? std::max(ReadU32(data, kMipCountOffset), 1U) : 1U;
+		if ((ReadU32(data, kPixelFlagsOffset) & kFourCCFlag) == 0 || (ReadU32(data, kCaps2Offset) & (kCubemapFlag | kVolumeFlag)) != 0) {
+			return std::nullopt;
+		}
+		if (width == 0 || height == 0 || width > kMaxSize || height > kMaxSize) {
+			return std::nullopt;
+		}
+		if (levels > std::bit_width(std::max(width, height))) {
+			return std::nullopt;
+		}
+
+		auto image   = TextureImage();
+		auto offset  = kHeaderSize;
+		image.m_Width  = I32(width);
+		image.m_Height = I32(height);
+
+		switch (ReadU32(data, kFourCCOffset)) {
+		case FourCC('D', 'X', 'T', '1'): image.m_Format = Format::BC1; break;
+		case FourCC('D', 'X', 'T', '5'): image.m_Format = Format::BC3; break;
+		case FourCC('A', 'T', 'I', '2'):
+		case FourCC('B', 'C', '5', 'U'): image.m_Format = Format::BC5; break;
+		case FourCC('D', 'X', '1', '0'): {
+			if (data.size() < kHeaderSize + kDX10HeaderSize) {
+				return std::nullopt;
+			}
+			if (
+				ReadU32(data, kDimensionOffset) != kTexture2D ||
+				(ReadU32(data, kMiscFlagOffset) & kTextureCubeFlag) != 0 ||
+				ReadU32(data, kArraySizeOffset) > 1
+			) {
+				return std::nullopt;
+			}
+
+			const auto dxgiFormat = ReadU32(data, kDXGIFormatOffset);
+			const auto* known     = std::ranges::find(kDXGIFormats, dxgiFormat, &DXGIFormat::value);
+			if (known == std::ranges::end(kDXGIFormats)) {
+				return std::nullopt;
+			}
+
+			image.m_Format = known->format;
+			image.m_IsSRGB = known->isSRGB;
+			offset += kDX10HeaderSize;
+			break;
+		}
+		default:
+			return std::nullopt;
+		}
+
+		for (auto level = 0; level < I32(levels); level++) {
+			image.m_LevelOffsets.push_back(offset);
+			offset += std::size_t(LevelSize(image.m_Format, image.m_Width, image.m_Height, level));
+		}
+		if (data.size() < offset) {
+			return std::nullopt;
+		}
+
+		image.m_Data = std::move(data);
+		image.m_ID   = NextID();
+
+		return image;
+	}
+
+	auto TextureImage::Load(const std::filesystem::path& path) -> std::optional<TextureImage>
+	{
+		auto file = std::ifstream(path, std::ios::binary);
+		if (!file) {
+			return std::nullopt;
+		}
+
+		auto contents = std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		auto data     = std::vector<std::byte>(contents.size());
+		std::ranges::transform(contents, data.begin(), [](char c) { return std::byte(c); });
+
+		return Parse(std::move(data));
+	}
+
+	auto TextureImage::BlockSize(Format format) noexcept -> I32
+	{
+		return format == Format::BC1 ? 8 : 16;
+	}
+
+	auto TextureImage::LevelSize(Format format, I32 width, I32 height, I32 level) noexcept -> I64
+	{
+		// Levels smaller than a block still take a whole one
+		const auto blocksX = (std::max(width >> level, 1) + 3) / 4;
+		const auto blocksY = (std::max(height >> level, 1) + 3) / 4;
+
+		return I64(blocksX) * I64(blocksY) * BlockSize(format);
+	}
+
+	auto TextureImage::Level(I32 level) const noexcept -> std::span<const std::byte>
+	{
+		GAZE_ASSERT(level >= 0 && level < Levels(), "Mip level out of range");
+
+		return { m_Data.data() + m_LevelOffsets[std::size_t(level)], std::size_t(LevelSize(m_Format, m_Width, m_Height, level)) };
+	}
+
+	auto TextureImage::NextID() noexcept -> TextureID
+	{
+		static auto next = std::atomic<TextureID>(kInvalidTextureID + 1);
+		return next++;
+	}
+}
@@ -0,0 +1,570 @@
+#include "GFX/ThreadedRenderer.hpp"
+
+#include "GFX/FrameHandoff.hpp"
+#include "GFX/Light.hpp"
+#include "GFX/StaticBatcher.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Gaze::GFX {
+	namespace {
+		/**
+		 * @brief Calls to a renderer, type-erased and stored back to back in pages reused from frame to frame.
+		 */
+		class CommandBuffer
+		{
+		public:
+			CommandBuffer() = default;
+			~CommandBuffer() { Clear(); }
+
+			CommandBuffer(const CommandBuffer&) = delete;
+			CommandBuffer(CommandBuffer&&) = delete;
+			auto operator=(const CommandBuffer&) = delete;
+			auto operator=(CommandBuffer&&) = delete;
+
+			/**
+			 * @brief Store a call, a function taking the renderer to call.
+			 */
+			template<typename TFunction>
+			auto Push(TFunction&& function) -> void
+			{
+				using Function = std::decay_t<TFunction>;
+
+				auto* stored = new (Allocate(sizeof(Function), alignof(Function))) Function(std::forward<TFunction>(function));
+				m_Commands.push_back({
+					.data    = stored,
+					.execute = [](void* data, Renderer& renderer) { (*static_cast<Function*>(data))(renderer); },
+					.destroy = [](void* data) noexcept { static_cast<Function*>(data)->~Function(); },
+				});
+			}
+
+			/**
+			 * @brief Copy an array next to the calls, for them to refer to.
+			 */
+			template<typename T>
+			[[nodiscard]] auto Copy(std::span<const T> values) -> std::span<const T>
+			{
+				const auto out = Allocate<T>(values.size());
+				std::copy(values.begin(), values.end(), out.begin());
+
+				return out;
+			}
+
+			/**
+			 * @brief Reserve an array next to the calls, for them to refer to. Left uninitialized.
+			 */
+			template<typename T>
+			[[nodiscard]] auto Allocate(std::size_t count) -> std::span<T>
+			{
+				static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "Arrays are never destroyed");
+
+				return { static_cast<T*>(Allocate(count * sizeof(T), alignof(T))), count };
+			}
+
+			auto Execute(Renderer& renderer) -> void
+			{
+				for (const auto& command : m_Commands) {
+					command.execute(command.data, renderer);
+				}
+			}
+
+			/**
+			 * @brief Destroy the calls, keeping the pages.
+			 */
+			auto Clear() noexcept -> void
+			{
+				for (const auto& command : m_Commands) {
+					command.destroy(command.data);
+				}
+
+				m_Commands.clear();
+				m_Page   = 0;
+				m_Offset = 0;
+			}
+
+		private:
+			static constexpr auto kPageSize = std::size_t(256 * 1024);
+
+			struct Command
+			{
+				void* data;
+				void  (*execute)(void* data, Renderer& renderer);
+				void  (*destroy)(void* data) noexcept;
+			};
+
+			struct Page
+			{
+				Unique<std::byte[]> data;
+				std::size_t         size;
+			};
+
+			[[nodiscard]] auto Allocate(std::size_t size, std::size_t alignment) -> void*
+			{
+				for (;; m_Page++, m_Offset = 0) {
+					if (m_Page == m_Pages.size()) {
+						const auto pageSize = std::max(kPageSize, size + alignment);
+						m_Pages.push_back({ std::make_unique_for_overwrite<std::byte[]>(pageSize), pageSize });
+					}
+
+					auto& page  = m_Pages[m_Page];
+					void* at    = page.data.get() + m_Offset;
+					auto  space = page.size - m_Offset;
+					if (std::align(alignment, size, at, space) != nullptr) {
+						m_Offset = page.size - space + size;
+						return at;
+					}
+				}
+			}
+
+		private:
+			std::vector<Command> m_Commands;
+			std::vector<Page>    m_Pages;
+			std::size_t          m_Page   = 0; /**< Being filled */
+			std::size_t          m_Offset = 0; /**< Into m_Page */
+		};
+
+		/**
+		 * @brief A camera frozen as it was when a frame was recorded.
+		 */
+		class CameraSnapshot : public Camera
+		{
+		public:
+			explicit CameraSnapshot(const Camera& camera) noexcept
+				: m_Projection(camera.ComputeProjectionMatrix())
+			{
+				SetPosition(camera.Position());
+				SetFront(camera.Front());
+			}
+
+			[[nodiscard]] auto ComputeProjectionMatrix() const noexcept -> glm::mat4 override
+			{
+				return m_Projection;
+			}
+
+		private:
+			glm::mat4 m_Projection;
+		};
+
+		/**
+		 * @brief A frame, as recorded for the render thread.
+		 */
+		struct Packet
+		{
+			CommandBuffer         commands;
+			DebugDraw             debug;
+			SpriteBatch           sprites;
+			GFX::Overlay          overlay;
+			Renderer::RenderStats stats = {}; /**< Of the frame, once rendered */
+		};
+	}
+
+	struct ThreadedRenderer::Impl
+	{
+		Unique<Renderer>     renderer; /**< Destroyed last, once its context is back on the destroying thread */
+		FrameHandoff<Packet> handoff;
+		Shared<Camera>       camera;
+		bool                 isCameraRecorded = false; /**< Whether the camera has been copied into the packet being recorded */
+		RenderStats          stats = {};               /**< Of the last frame rendered */
+		std::jthread         thread;
+
+		const StaticBatcher*        shadowCasters = nullptr; /**< As set with SetStaticShadowCasters() */
+		Shared<const StaticBatcher> casterSnapshot;          /**< The copy of shadowCasters the render thread draws */
+
+		I32                              terrainTileResolution   = 0;
+		I32                              terrainChunkResolution  = 0;
+		I32                              terrainMaxResidentTiles = 0;
+		std::vector<U64>                 terrainVersions; /**< Of the tile handed to the render thread per slot, 0 for none */
+		std::vector<Terrain::TileUpload> terrainTiles;   /**< Scratch: the tiles of a snapshot, before they are copied */
+		std::vector<Terrain::ChunkDraw>  terrainChunks;  /**< Scratch for Terrain::Select() */
+
+		/**
+		 * @brief Record a call into the packet being recorded, after the camera if it isn't there yet.
+		 */
+		template<typename TFunction>
+		auto Record(TFunction&& function) -> void
+		{
+			auto& commands = handoff.Recording().commands;
+
+			if (!isCameraRecorded && camera != nullptr) {
+				commands.Push([snapshot = MakeShared<CameraSnapshot>(*camera)](Renderer& target) {
+					target.SetCamera(snapshot);
+				});
+				isCameraRecorded = true;
+			}
+
+			commands.Push(std::forward<TFunction>(function));
+		}
+
+		template<typename T>
+		[[nodiscard]] auto Copy(std::span<const T> values) -> std::span<const T>
+		{
+			return handoff.Recording().commands.Copy(values);
+		}
+
+		/**
+		 * @brief Hand the render thread a copy of the static shadow casters as they are now.
+		 */
+		auto RecordShadowCasters() -> void
+		{
+			auto snapshot = shadowCasters != nullptr ? MakeShared<const StaticBatcher>(*shadowCasters) : nullptr;
+
+			// The previous copy is drawn until the render thread gets here, and released with the packet
+			Record([snapshot, previous = std::move(casterSnapshot)](Renderer& target) {
+				target.SetStaticShadowCasters(snapshot.get());
+			});
+			casterSnapshot = std::move(snapshot);
+		}
+	};
+
+	ThreadedRenderer::ThreadedRenderer(Shared<WM::Window> window, Unique<Renderer> renderer)
+		: GFX::Renderer(std::move(window))
+		, m_pImpl(MakeUnique<Impl>())
+	{
+		m_pImpl->renderer = std::move(renderer);
+
+		// A context is current on one thread at most
+		m_pImpl->renderer->ReleaseContext();
+		m_pImpl->thread = std::jthread([this] { RenderLoop(); });
+	}
+
+	ThreadedRenderer::~ThreadedRenderer()
+	{
+		m_pImpl->handoff.WaitIdle();
+		m_pImpl->handoff.Close();
+		m_pImpl->thread.join();
+
+		m_pImpl->renderer->MakeContextCurrent();
+	}
+
+	auto ThreadedRenderer::RenderLoop() noexcept -> void
+	{
+		auto& renderer = *m_pImpl->renderer;
+		renderer.MakeContextCurrent();
+
+		while (auto* packet = m_pImpl->handoff.Acquire()) {
+			packet->commands.Execute(renderer);
+			packet->commands.Clear();
+			packet->stats = renderer.Stats();
+
+			m_pImpl->handoff.Release();
+		}
+
+		renderer.ReleaseContext();
+	}
+
+	auto ThreadedRenderer::SetClearColor(F32 r, F32 g, F32 b, F32 a) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetClearColor(r, g, b, a); });
+	}
+
+	auto ThreadedRenderer::Clear(Buffer buffer) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.Clear(buffer); });
+	}
+
+	auto ThreadedRenderer::Flush() noexcept -> void
+	{
+		m_pImpl->Record([](Renderer& renderer) { renderer.Flush(); });
+	}
+
+	auto ThreadedRenderer::Render() noexcept -> void
+	{
+		const auto* casters = m_pImpl->shadowCasters;
+		if (casters != nullptr && casters->Version() != m_pImpl->casterSnapshot->Version()) {
+			m_pImpl->RecordShadowCasters();
+		}
+
+		auto& packet = m_pImpl->handoff.Recording();
+
+		// The frame's shapes move into the packet, and the packet's, emptied by
+		// the renderer when it last rendered them, come back for the next frame
+		std::swap(packet.debug, Debug());
+		std::swap(packet.sprites, Sprites());
+
+		const auto isOverlayVisible = Overlay().IsVisible();
+		std::swap(packet.overlay, Overlay());
+		Overlay().SetVisible(isOverlayVisible);
+
+		m_pImpl->Record([&packet](Renderer& renderer) {
+			std::swap(renderer.Debug(), packet.debug);
+			std::swap(renderer.Sprites(), packet.sprites);
+			std::swap(renderer.Overlay(), packet.overlay);
+
+			renderer.Render();
+		});
+
+		// Returns once the render thread is done with the packet recorded next
+		m_pImpl->handoff.Publish();
+		m_pImpl->stats            = m_pImpl->handoff.Recording().stats;
+		m_pImpl->isCameraRecorded = false;
+	}
+
+	auto ThreadedRenderer::SetResolveMode(ResolveMode mode, I32 samples) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetResolveMode(mode, samples); });
+	}
+
+	auto ThreadedRenderer::SetVSync(VSyncMode mode) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetVSync(mode); });
+	}
+
+	auto ThreadedRenderer::SetMaxFramesInFlight(I32 nFrames) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetMaxFramesInFlight(nFrames); });
+	}
+
+	auto ThreadedRenderer::SetVertexPulling(bool enabled) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetVertexPulling(enabled); });
+	}
+
+	auto ThreadedRenderer::SetVisibilityBuffer(bool enabled) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetVisibilityBuffer(enabled); });
+	}
+
+	auto ThreadedRenderer::SetDeferredShading(bool enabled) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetDeferredShading(enabled); });
+	}
+
+	auto ThreadedRenderer::SetSkinning(SkinningMode mode, Jobs::ThreadPool* pool) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetSkinning(mode, pool); });
+	}
+
+	auto ThreadedRenderer::SetShadows(std::optional<ShadowCache::Settings> settings) -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetShadows(settings); });
+	}
+
+	auto ThreadedRenderer::SetStaticShadowCasters(const StaticBatcher* batcher) noexcept -> void
+	{
+		m_pImpl->shadowCasters = batcher;
+		m_pImpl->RecordShadowCasters();
+	}
+
+	auto ThreadedRenderer::SetImpostors(std::optional<ImpostorAtlas::Settings> settings) -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetImpostors(settings); });
+	}
+
+	auto ThreadedRenderer::LoadTexture(const Shared<const TextureImage>& image) -> void
+	{
+		// Keeps the image alive until the render thread holds its own reference
+		m_pImpl->Record([=](Renderer& renderer) { renderer.LoadTexture(image); });
+	}
+
+	auto ThreadedRenderer::CaptureFrame(CaptureCallback callback) -> void
+	{
+		m_pImpl->Record([callback = std::move(callback)](Renderer& renderer) mutable {
+			renderer.CaptureFrame(std::move(callback));
+		});
+	}
+
+	auto ThreadedRenderer::MakeContextCurrent() noexcept -> void
+	{
+		// The context belongs to the render thread
+	}
+
+	auto ThreadedRenderer::ReleaseContext() noexcept -> void
+	{
+		// The context belongs to the render thread
+	}
+
+	auto ThreadedRenderer::Synchronize() noexcept -> void
+	{
+		m_pImpl->handoff.WaitIdle();
+	}
+
+	auto ThreadedRenderer::Stats() noexcept -> RenderStats
+	{
+		return m_pImpl->stats;
+	}
+
+	auto ThreadedRenderer::SetViewport(I32 x, I32 y, I32 width, I32 height) noexcept -> void
+	{
+		m_pImpl->Record([=](Renderer& renderer) { renderer.SetViewport(x, y, width, height); });
+	}
+
+	auto ThreadedRenderer::SetCamera(Shared<Camera> camera) noexcept -> void
+	{
+		m_pImpl->camera           = std::move(camera);
+		m_pImpl->isCameraRecorded = false;
+	}
+
+	// The deprecated entry points are still part of the interface, so they are forwarded too
+#if defined(_MSC_VER)
+	#pragma warning(push)
+	#pragma warning(disable: 4996)
+#else
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+	auto ThreadedRenderer::DrawMesh(const Mesh& mesh, PrimitiveMode mode) -> void
+	{
+		m_pImpl->Record([mesh, mode](Renderer& renderer) { renderer.DrawMesh(mesh, mode); });
+	}
+
+	auto ThreadedRenderer::DrawMesh(
+		const Mesh& mesh,
+		const Light lights[],
+		I32 nLights,
+		PrimitiveMode mode
+	) -> void
+	{
+		const auto copy = m_pImpl->Copy(std::span(lights, std::size_t(nLights)));
+		m_pImpl->Record([mesh, copy, mode](Renderer& renderer) {
+			renderer.DrawMesh(mesh, copy.data(), I32(copy.size()), mode);
+		});
+	}
+
+#if defined(_MSC_VER)
+	#pragma warning(pop)
+#else
+	#pragma GCC diagnostic pop
+#endif
+
+	auto ThreadedRenderer::SetLights(const Light lights[], I32 nLights) -> void
+	{
+		const auto copy = m_pImpl->Copy(std::span(lights, std::size_t(nLights)));
+		m_pImpl->Record([copy](Renderer& renderer) { renderer.SetLights(copy.data(), I32(copy.size())); });
+	}
+
+	auto ThreadedRenderer::SubmitObject(const Object& object, PrimitiveMode mode) -> void
+	{
+		m_pImpl->Record([object, mode](Renderer& renderer) { renderer.SubmitObject(object, mode); });
+	}
+
+	auto ThreadedRenderer::SubmitObject(const Object& object, const glm::mat4& transform, PrimitiveMode mode) -> void
+	{
+		m_pImpl->Record([object, transform, mode](Renderer& renderer) { renderer.SubmitObject(object, transform, mode); });
+	}
+
+	auto ThreadedRenderer::SubmitSkinned(
+		const Object& object,
+		const glm::mat4& transform,
+		std::span<const glm::mat4> palette,
+		PrimitiveMode mode
+	) -> void
+	{
+		const auto copy = m_pImpl->Copy(palette);
+		m_pImpl->Record([object, transform, copy, mode](Renderer& renderer) {
+			renderer.SubmitSkinned(object, transform, copy, mode);
+		});
+	}
+
+	auto ThreadedRenderer::SubmitWithImpostor(const Object& object, const glm::mat4& transform) -> void
+	{
+		m_pImpl->Record([object, transform](Renderer& renderer) { renderer.SubmitWithImpostor(object, transform); });
+	}
+
+	auto ThreadedRenderer::SubmitObject(
+		const Object& object,
+		const Light lights[],
+		I32 nLights,
+		PrimitiveMode mode
+	) -> void
+	{
+		const auto copy = m_pImpl->Copy(std::span(lights, std::size_t(nLights)));
+		m_pImpl->Record([object, copy, mode](Renderer& renderer) {
+			renderer.SubmitObject(object, copy.data(), I32(copy.size()), mode);
+		});
+	}
+
+	auto ThreadedRenderer::SubmitObject(
+		const Object& object,
+		const glm::mat4& transform,
+		const Light lights[],
+		I32 nLights,
+		PrimitiveMode mode
+	) -> void
+	{
+		const auto copy = m_pImpl->Copy(std::span(lights, std::size_t(nLights)));
+		m_pImpl->Record([object, transform, copy, mode](Renderer& renderer) {
+			renderer.SubmitObject(object, transform, copy.data(), I32(copy.size()), mode);
+		});
+	}
+
+	auto ThreadedRenderer::SubmitParticles(const ParticleEmitter& emitter) -> void
+	{
+		// Only the live particles, the emitter's arrays are sized for its maximum
+		const auto instances = m_pImpl->handoff.Recording().commands.Allocate<ParticleEmitter::Instance>(emitter.Count());
+		const auto written   = std::span<const ParticleEmitter::Instance>(instances.first(emitter.WriteInstances(instances)));
+
+		m_pImpl->Record([written](Renderer& renderer) { renderer.SubmitParticles(written); });
+	}
+
+	auto ThreadedRenderer::SubmitParticles(std::span<const ParticleEmitter::Instance> instances) -> void
+	{
+		const auto copy = m_pImpl->Copy(instances);
+		m_pImpl->Record([copy](Renderer& renderer) { renderer.SubmitParticles(copy); });
+	}
+
+	auto ThreadedRenderer::SubmitTerrain(const Terrain& terrain) -> void
+	{
+		auto&       impl     = *m_pImpl;
+		const auto& settings = terrain.GetSettings();
+
+		// Another layout starts over, as the wrapped renderer does
+		if (
+			impl.terrainTileResolution != settings.tileResolution ||
+			impl.terrainChunkResolution != settings.chunkResolution ||
+			impl.terrainMaxResidentTiles != settings.maxResidentTiles
+		) {
+			impl.terrainTileResolution   = settings.tileResolution;
+			impl.terrainChunkResolution  = settings.chunkResolution;
+			impl.terrainMaxResidentTiles = settings.maxResidentTiles;
+			impl.terrainVersions.assign(std::size_t(settings.maxResidentTiles), 0);
+		}
+
+		// Only the tiles the render thread hasn't been handed yet
+		impl.terrainTiles.clear();
+		for (const auto& tile : terrain.Tiles()) {
+			auto& handed = impl.terrainVersions[std::size_t(tile.slot)];
+			if (handed != tile.version) {
+				impl.terrainTiles.push_back({ tile.slot, tile.version, tile.vertices });
+				handed = tile.version;
+			}
+		}
+
+		GAZE_ASSERT(impl.camera != nullptr, "Terrains are culled against the camera, set with SetCamera()");
+		terrain.Select(Frustum(impl.camera->ComputeProjectionMatrix() * impl.camera->ComputeViewMatrix()), impl.terrainChunks);
+
+		SubmitTerrain(Terrain::Snapshot{
+			.tileResolution   = settings.tileResolution,
+			.chunkResolution  = settings.chunkResolution,
+			.maxResidentTiles = settings.maxResidentTiles,
+			.material         = settings.material,
+			.tiles            = impl.terrainTiles,
+			.chunks           = impl.terrainChunks,
+		});
+	}
+
+	auto ThreadedRenderer::SubmitTerrain(const Terrain::Snapshot& snapshot) -> void
+	{
+		auto& commands = m_pImpl->handoff.Recording().commands;
+
+		const auto tiles = commands.Allocate<Terrain::TileUpload>(snapshot.tiles.size());
+		for (auto i = std::size_t(0); i < tiles.size(); i++) {
+			const auto& tile = snapshot.tiles[i];
+
+			tiles[i] = { tile.slot, tile.version, commands.Copy(tile.vertices) };
+		}
+
+		auto copy   = snapshot;
+		copy.tiles  = tiles;
+		copy.chunks = commands.Copy(snapshot.chunks);
+
+		m_pImpl->Record([copy](Renderer& renderer) { renderer.SubmitTerrain(copy); });
+	}
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/FrameHandoff.hpp"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("GFX - FrameHandoff") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	struct Packet
+	{
+		U64              frame = 0;
+		std::vector<U64> values;
+	};
+
+	auto handoff = FrameHandoff<Packet>();
+
+	SECTION("Packets alternate, and are consumed in order") {
+		auto& first = handoff.Recording();
+		first.frame = 1;
+		handoff.Publish();
+
+		auto& second = handoff.Recording();
+		REQUIRE(&second != &first);
+		second.frame = 2;
+
+		auto* acquired = handoff.Acquire();
+		REQUIRE(acquired == &first);
+		REQUIRE(handoff.Acquire() == &first);
+		handoff.Release();
+
+		handoff.Publish();
+		REQUIRE(&handoff.Recording() == &first);
+		REQUIRE(handoff.Acquire()->frame == 2);
+		handoff.Release();
+
+		REQUIRE(handoff.Published() == 2);
+		REQUIRE(handoff.Released() == 2);
+	}
+
+	SECTION("Closing wakes the consumer up") {
+		auto* acquired = &handoff.Recording();
+		auto  consumer = std::thread([&] {
+			acquired = handoff.Acquire();
+		});
+
+		handoff.Close();
+		consumer.join();
+
+		REQUIRE(acquired == nullptr);
+	}
+
+	SECTION("The producer never records into the packet being consumed") {
+		constexpr auto kFrames = U64(2000);
+
+		auto consumed = std::vector<U64>();
+		auto consumer = std::thread([&] {
+			while (auto* packet = handoff.Acquire()) {
+				// The producer would be overwriting these if it got ahead
+				for (const auto value : packet->values) {
+					consumed.push_back(value == packet->frame ? value : 0);
+				}
+				packet->values.clear();
+				handoff.Release();
+			}
+		});
+
+		for (auto frame = U64(1); frame <= kFrames; frame++) {
+			auto& packet = handoff.Recording();
+			packet.frame = frame;
+			packet.values.assign(8, frame);
+			handoff.Publish();
+
+			// At most the packet just published is still waiting
+			REQUIRE(handoff.Published() - handoff.Released() <= 1);
+		}
+
+		handoff.WaitIdle();
+		REQUIRE(handoff.Released() == kFrames);
+
+		handoff.Close();
+		consumer.join();
+
+		REQUIRE(consumed.size() == kFrames * 8);
+		for (auto i = std::size_t(0); i < consumed.size(); i++) {
+			REQUIRE(consumed[i] == i / 8 + 1);
+		}
+	}
+}
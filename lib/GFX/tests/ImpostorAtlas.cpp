@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "GFX/ImpostorAtlas.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <cmath>
+
+TEST_CASE("GFX - ImpostorAtlas") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+	using Catch::Matchers::WithinAbs;
+
+	auto settings = ImpostorAtlas::Settings();
+	settings.maxImpostors = 2;
+
+	auto atlas = ImpostorAtlas(settings);
+
+	SECTION("Slots are handed out until the atlas is full") {
+		const auto first  = atlas.Acquire();
+		const auto second = atlas.Acquire();
+
+		REQUIRE(first == 0);
+		REQUIRE(second == 1);
+		REQUIRE_FALSE(atlas.Acquire().has_value());
+
+		atlas.Release(*first);
+		REQUIRE(atlas.Acquire() == 0);
+		REQUIRE(atlas.SlotSize() == glm::ivec2(settings.nYaw * settings.cellResolution, settings.nPitch * settings.cellResolution));
+	}
+
+	SECTION("Screen size shrinks with distance") {
+		const auto close = ImpostorAtlas::ScreenSize(1.F, 10.F, 1.F, 720.F);
+		const auto far   = ImpostorAtlas::ScreenSize(1.F, 20.F, 1.F, 720.F);
+
+		REQUIRE_THAT(close, WithinAbs(72.F, 1e-4));
+		REQUIRE_THAT(far, WithinAbs(close / 2.F, 1e-4));
+		REQUIRE(std::isinf(ImpostorAtlas::ScreenSize(1.F, .5F, 1.F, 720.F)));
+	}
+
+	SECTION("Instances cross-fade between the thresholds") {
+		const auto small = atlas.Blend(settings.switchSize - 1.F);
+		const auto large = atlas.Blend(settings.switchSize + settings.fadeSize + 1.F);
+		const auto half  = atlas.Blend(settings.switchSize + settings.fadeSize / 2.F);
+
+		REQUIRE(small.mesh == 0.F);
+		REQUIRE(small.impostor == 1.F);
+		REQUIRE(large.mesh == 1.F);
+		REQUIRE(large.impostor == 0.F);
+		REQUIRE_THAT(half.mesh, WithinAbs(.5F, 1e-4));
+		REQUIRE_THAT(half.mesh + half.impostor, WithinAbs(1.F, 1e-4));
+
+		settings.fadeSize = 0.F;
+		const auto step = ImpostorAtlas(settings);
+		REQUIRE(step.Blend(settings.switchSize - .1F).impostor == 1.F);
+		REQUIRE(step.Blend(settings.switchSize).mesh == 1.F);
+	}
+
+	SECTION("Each cell is selected from its own direction") {
+		for (auto yaw = 0; yaw < settings.nYaw; yaw++) {
+			for (auto pitch = 0; pitch < settings.nPitch; pitch++) {
+				const auto cell      = glm::ivec2(yaw, pitch);
+				const auto direction = atlas.CellDirection(cell);
+
+				REQUIRE_THAT(glm::length(direction), WithinAbs(1.F, 1e-4));
+				REQUIRE(std::abs(direction.y) < 1.F);
+				REQUIRE(atlas.SelectCell(direction * 5.F) == cell);
+			}
+		}
+
+		// Straight above falls in the highest band
+		REQUIRE(atlas.SelectCell({ 0.F, 1.F, 0.F }).y == settings.nPitch - 1);
+		REQUIRE(atlas.SelectCell({ 0.F, -1.F, 0.F }).y == 0);
+	}
+
+	SECTION("Bake views fit the bounding sphere") {
+		const auto center = glm::vec3(1.F, 2.F, 3.F);
+		const auto radius = 2.F;
+
+		for (auto yaw = 0; yaw < settings.nYaw; yaw++) {
+			const auto cell      = glm::ivec2(yaw, 1);
+			const auto vp        = atlas.BakeViewProjection(cell, center, radius);
+			const auto direction = atlas.CellDirection(cell);
+
+			const auto middle = vp * glm::vec4(center, 1.F);
+			const auto front  = vp * glm::vec4(center + direction * radius, 1.F);
+			const auto back   = vp * glm::vec4(center - direction * radius, 1.F);
+
+			REQUIRE_THAT(middle.x, WithinAbs(0.F, 1e-4));
+			REQUIRE_THAT(middle.y, WithinAbs(0.F, 1e-4));
+			REQUIRE_THAT(front.z, WithinAbs(-1.F, 1e-4));
+			REQUIRE_THAT(back.z, WithinAbs(1.F, 1e-4));
+
+			// The sphere's silhouette touches the cell's edges
+			const auto side = glm::normalize(glm::cross(direction, glm::vec3(0.F, 1.F, 0.F)));
+			const auto edge = vp * glm::vec4(center + side * radius, 1.F);
+			REQUIRE_THAT(std::abs(edge.x), WithinAbs(1.F, 1e-4));
+		}
+	}
+
+	SECTION("Billboards face the viewer, upright and scaled with the instance") {
+		const auto model  = glm::scale(glm::translate(glm::mat4(1.F), glm::vec3(10.F, 0.F, 0.F)), glm::vec3(3.F));
+		const auto viewer = glm::vec3(10.F, 1.5F, 50.F);
+
+		const auto billboard = atlas.MakeBillboard(model, { 0.F, .5F, 0.F }, 1.F, viewer);
+		const auto toViewer  = glm::normalize(viewer - billboard.center);
+
+		REQUIRE_THAT(billboard.center.x, WithinAbs(10.F, 1e-4));
+		REQUIRE_THAT(billboard.center.y, WithinAbs(1.5F, 1e-4));
+		REQUIRE_THAT(glm::length(billboard.right), WithinAbs(3.F, 1e-4));
+		REQUIRE_THAT(glm::length(billboard.up), WithinAbs(3.F, 1e-4));
+		REQUIRE_THAT(glm::dot(billboard.right, toViewer), WithinAbs(0.F, 1e-4));
+		REQUIRE_THAT(glm::dot(billboard.up, toViewer), WithinAbs(0.F, 1e-4));
+		REQUIRE_THAT(billboard.up.y, WithinAbs(3.F, 1e-4));
+		REQUIRE(billboard.cell == atlas.SelectCell({ 0.F, 0.F, 1.F }));
+
+		// Looking down the up axis still gives a quad
+		const auto above = atlas.MakeBillboard(model, { 0.F, .5F, 0.F }, 1.F, { 10.F, 40.F, 0.F });
+		REQUIRE_THAT(glm::length(above.right), WithinAbs(3.F, 1e-4));
+		REQUIRE(above.cell.y == settings.nPitch - 1);
+	}
+}
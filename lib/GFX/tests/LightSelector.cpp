@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/LightSelector.hpp"
+
+#include "MakeLight.hpp"
+
+#include <vector>
+
+TEST_CASE("GFX - LightSelector") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+	using Tests::MakeLight;
+
+	const auto box = AABB{ { -1.F, -1.F, -1.F }, { 1.F, 1.F, 1.F } };
+
+	auto selector = LightSelector();
+	auto selected = std::vector<Light>(8);
+
+	SECTION("Closest lights are selected first") {
+		auto lights = std::vector<Light>();
+		for (auto i = 0; i < 11; i++) {
+			lights.push_back(MakeLight({ 0.F, 0.F, 2.F + F32(10 - i) }, { 1.F, 1.F, 1.F }));
+		}
+		selector.SetLights(lights.data(), I32(lights.size()));
+
+		REQUIRE(selector.Select(box, 3, selected.data()) == 3);
+		REQUIRE(selected[0].position.z == 2.F);
+		REQUIRE(selected[1].position.z == 3.F);
+		REQUIRE(selected[2].position.z == 4.F);
+	}
+
+	SECTION("Lights inside the bounds are not attenuated") {
+		const Light lights[] = {
+			MakeLight({ 5.F, 0.F, 0.F }, { 1.F, 1.F, 1.F }),
+			MakeLight({ .5F, .5F, .5F }, { .5F, .5F, .5F }),
+		};
+		selector.SetLights(lights, 2);
+
+		REQUIRE(selector.Select(box, 1, selected.data()) == 1);
+		REQUIRE(selected[0].position.x == .5F);
+	}
+
+	SECTION("Lights that do not contribute are never selected") {
+		const Light lights[] = {
+			MakeLight({ 0.F, 0.F, 0.F }, { 0.F, 0.F, 0.F }),
+			MakeLight({ 9.F, 0.F, 0.F }, { 1.F, 0.F, 0.F }),
+			MakeLight({ 1000.F, 0.F, 0.F }, { 1.F, 1.F, 1.F }),
+		};
+		selector.SetLights(lights, 3);
+
+		REQUIRE(selector.Select(box, 8, selected.data()) == 1);
+		REQUIRE(selected[0].position.x == 9.F);
+	}
+
+	SECTION("Directional lights are not attenuated") {
+		auto sun = MakeLight({ 1000.F, 0.F, 0.F }, { .5F, .5F, .5F });
+		sun.direction = { 0.F, -1.F, 0.F };
+
+		const Light lights[] = {
+			MakeLight({ 3.F, 0.F, 0.F }, { 1.F, 1.F, 1.F }),
+			sun,
+		};
+		selector.SetLights(lights, 2);
+
+		REQUIRE(selector.Select(box, 2, selected.data()) == 2);
+		REQUIRE(selected[0].IsDirectional());
+	}
+}
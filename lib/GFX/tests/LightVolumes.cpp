@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "GFX/LightSelector.hpp"
+#include "GFX/LightVolumes.hpp"
+
+#include "MakeLight.hpp"
+
+TEST_CASE("GFX - LightVolumes") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+	using Tests::MakeLight;
+	using Catch::Matchers::WithinAbs;
+
+	auto volumes = LightVolumes();
+
+	SECTION("Spheres end where the light stops contributing") {
+		const auto light  = MakeLight({}, { .25F, 1.F, .5F }, 2.F);
+		const auto radius = LightVolumes::Radius(light);
+
+		REQUIRE_THAT(1.F / (1.F + light.attenuation * radius * radius), WithinAbs(LightSelector::kMinContribution, 1e-4));
+
+		// Stronger attenuation, smaller volume
+		REQUIRE(LightVolumes::Radius(MakeLight({}, { 1.F, 1.F, 1.F }, 8.F)) < radius);
+		REQUIRE(LightVolumes::Radius(MakeLight({}, { 0.F, 0.F, 0.F }, 1.F)) == 0.F);
+	}
+
+	SECTION("Unattenuated and directional lights cover the screen") {
+		auto directional      = MakeLight({}, { 1.F, 1.F, 1.F }, 1.F);
+		directional.direction = { 0.F, -1.F, 0.F };
+
+		const Light lights[] = {
+			directional,
+			MakeLight({}, { 1.F, 1.F, 1.F }, 0.F),
+			MakeLight({ 100.F, 0.F, 0.F }, { 1.F, 1.F, 1.F }, 1.F),
+		};
+		volumes.Build(lights, {}, .1F);
+
+		const auto built = volumes.Volumes();
+		REQUIRE(built.size() == 3);
+		REQUIRE(built[0].shape == LightVolumes::Shape::FullScreen);
+		REQUIRE(built[1].shape == LightVolumes::Shape::FullScreen);
+		REQUIRE(built[2].shape == LightVolumes::Shape::Sphere);
+		REQUIRE(built[2].light == 2);
+		REQUIRE_FALSE(built[2].containsView);
+	}
+
+	SECTION("Volumes tell whether the view may be inside them") {
+		const Light lights[] = {
+			MakeLight({ 0.F, 0.F, 0.F }, { 1.F, 1.F, 1.F }, 1.F),
+			MakeLight({ 0.F, 0.F, 0.F }, { 0.F, 0.F, 0.F }, 1.F),
+		};
+		const auto radius = LightVolumes::Radius(lights[0]);
+
+		volumes.Build(lights, { radius + .05F, 0.F, 0.F }, .1F);
+		REQUIRE(volumes.Volumes().size() == 1);
+		REQUIRE(volumes.Volumes()[0].containsView);
+
+		volumes.Build(lights, { radius + .2F, 0.F, 0.F }, .1F);
+		REQUIRE_FALSE(volumes.Volumes()[0].containsView);
+	}
+
+	SECTION("Ambient terms are summed over every light") {
+		auto dim   = MakeLight({}, { 0.F, 0.F, 0.F }, 1.F);
+		auto red   = MakeLight({}, { 1.F, 0.F, 0.F }, 1.F);
+		auto white = MakeLight({}, { 1.F, 1.F, 1.F }, 1.F);
+
+		dim.ambientCoefficient   = 1.F;
+		red.ambientCoefficient   = .5F;
+		white.ambientCoefficient = .25F;
+
+		const Light lights[] = { dim, red, white };
+		volumes.Build(lights, {}, .1F);
+
+		REQUIRE_THAT(volumes.Ambient().r, WithinAbs(.75F, 1e-4));
+		REQUIRE_THAT(volumes.Ambient().g, WithinAbs(.25F, 1e-4));
+		REQUIRE_THAT(volumes.Ambient().b, WithinAbs(.25F, 1e-4));
+	}
+}
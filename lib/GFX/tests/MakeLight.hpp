@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "GFX/Light.hpp"
+
+namespace Gaze::GFX::Tests {
+	/**
+	 * @brief Make a point light without ambient contribution.
+	 */
+	inline auto MakeLight(glm::vec3 position, glm::vec3 diffuse, F32 attenuation = .5F) -> Light
+	{
+		return Light{
+			.position           = position,
+			.direction          = {},
+			.diffuse            = diffuse,
+			.ambientCoefficient = 0.F,
+			.attenuation        = attenuation,
+		};
+	}
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/MultiDraw.hpp"
+
+#include <vector>
+
+TEST_CASE("GFX - MultiDraw") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	auto multiDraws = std::vector<MultiDraw>();
+
+	SECTION("Groups are split at the draw limit") {
+		const std::size_t groupEnds[] = { 10 };
+		SplitMultiDraws(groupEnds, 4, multiDraws);
+
+		REQUIRE(multiDraws.size() == 3);
+		REQUIRE(multiDraws[0].first == 0);
+		REQUIRE(multiDraws[0].count == 4);
+		REQUIRE(multiDraws[1].first == 4);
+		REQUIRE(multiDraws[2].first == 8);
+		REQUIRE(multiDraws[2].count == 2);
+	}
+
+	SECTION("Multi-draws never straddle groups") {
+		const std::size_t groupEnds[] = { 3, 4, 9 };
+		SplitMultiDraws(groupEnds, 4, multiDraws);
+
+		REQUIRE(multiDraws.size() == 4);
+		REQUIRE(multiDraws[0].first == 0);
+		REQUIRE(multiDraws[0].count == 3);
+		REQUIRE(multiDraws[1].first == 3);
+		REQUIRE(multiDraws[1].count == 1);
+		REQUIRE(multiDraws[2].first == 4);
+		REQUIRE(multiDraws[2].count == 4);
+		REQUIRE(multiDraws[3].first == 8);
+		REQUIRE(multiDraws[3].count == 1);
+	}
+
+	SECTION("Draw IDs are right for groups starting off the draw limit") {
+		// The second group starts at 5, the limit is 4: the first draw of each multi-draw plus its base instance must give back every draw
+		const std::size_t groupEnds[] = { 5, 14 };
+		SplitMultiDraws(groupEnds, 4, multiDraws);
+
+		auto drawIDs = std::vector<std::size_t>();
+		for (const auto& multiDraw : multiDraws) {
+			REQUIRE(multiDraw.count <= 4);
+			for (auto baseInstance = std::size_t(0); baseInstance < multiDraw.count; baseInstance++) {
+				drawIDs.push_back(multiDraw.first + baseInstance);
+			}
+		}
+
+		REQUIRE(drawIDs.size() == 14);
+		for (auto i = std::size_t(0); i < drawIDs.size(); i++) {
+			REQUIRE(drawIDs[i] == i);
+		}
+		REQUIRE(multiDraws[2].first == 5);
+	}
+
+	SECTION("No groups, no multi-draws") {
+		multiDraws.push_back({ 0, 1 });
+		SplitMultiDraws({}, 4, multiDraws);
+
+		REQUIRE(multiDraws.empty());
+	}
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/Overlay.hpp"
+
+#include <algorithm>
+#include <array>
+
+TEST_CASE("GFX - Overlay") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	auto overlay = Overlay();
+
+	SECTION("A hidden overlay ignores submissions") {
+		REQUIRE_FALSE(overlay.IsVisible());
+
+		overlay.Text({ 0.F, 0.F }, "Hidden");
+		overlay.Rect({ 0.F, 0.F }, { 10.F, 10.F }, Overlay::kWhite);
+		REQUIRE(overlay.Quads().empty());
+	}
+
+	overlay.SetVisible(true);
+
+	SECTION("Glyphs map to atlas cells") {
+		REQUIRE(Overlay::GlyphIndex(' ') == 0);
+		REQUIRE(Overlay::GlyphIndex('A') == 33);
+		REQUIRE(Overlay::GlyphIndex('~') == 94);
+		REQUIRE(Overlay::GlyphIndex('\t') == Overlay::GlyphIndex('?'));
+	}
+
+	SECTION("Text skips spaces and wraps on new lines") {
+		overlay.Text({ 10.F, 20.F }, "a b\nc", Overlay::kWhite, 2.F);
+
+		const auto& quads = overlay.Quads();
+		REQUIRE(quads.size() == 3);
+		REQUIRE(quads[0].position.x == 10.F);
+		REQUIRE(quads[1].position.x == 42.F);
+		REQUIRE(quads[1].size.x == 16.F);
+		REQUIRE(quads[2].position.x == 10.F);
+		REQUIRE(quads[2].position.y == 36.F);
+		REQUIRE(quads[2].glyph == Overlay::GlyphIndex('c'));
+	}
+
+	SECTION("Graph bars are bottom-aligned and clamped") {
+		const auto values = std::array{ 0.F, 5.F, 20.F };
+		overlay.Graph({ 0.F, 0.F }, { 30.F, 10.F }, values, 10.F);
+
+		const auto& quads = overlay.Quads();
+		REQUIRE(quads.size() == 2);
+		REQUIRE(quads[0].position.x == 10.F);
+		REQUIRE(quads[0].position.y == 5.F);
+		REQUIRE(quads[1].position.y == 0.F);
+		REQUIRE(quads[1].size.y == 10.F);
+	}
+
+	SECTION("The atlas has a solid cell") {
+		const auto atlas = Overlay::BuildFontAtlas();
+		REQUIRE(atlas.size() == std::size_t(Overlay::kAtlasWidth * Overlay::kAtlasHeight));
+
+		const auto left = std::size_t(Overlay::kSolidGlyph % Overlay::kAtlasColumns) * Overlay::kGlyphSize;
+		const auto top  = std::size_t(Overlay::kSolidGlyph / Overlay::kAtlasColumns) * Overlay::kGlyphSize;
+		for (auto y = top; y < top + Overlay::kGlyphSize; y++) {
+			const auto row = atlas.begin() + std::ptrdiff_t(y * Overlay::kAtlasWidth + left);
+			REQUIRE(std::all_of(row, row + Overlay::kGlyphSize, [](U8 texel) { return texel == 255; }));
+		}
+		REQUIRE(std::all_of(atlas.begin(), atlas.begin() + Overlay::kAtlasWidth, [](U8 texel) { return texel == 0 || texel == 255; }));
+	}
+
+	SECTION("Clear discards everything") {
+		overlay.Rect({ 0.F, 0.F }, { 1.F, 1.F }, Overlay::kWhite);
+		overlay.Clear();
+		REQUIRE(overlay.Quads().empty());
+	}
+}
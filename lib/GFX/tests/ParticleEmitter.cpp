@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "GFX/ParticleEmitter.hpp"
+
+#include <vector>
+
+TEST_CASE("GFX - ParticleEmitter") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+	using Catch::Matchers::WithinAbs;
+
+	// Deterministic particles: no spawn area, no velocity spread, no spawning by rate
+	auto settings = ParticleEmitter::Settings();
+	settings.velocity       = { 1.F, 0.F, 0.F };
+	settings.velocitySpread = { 0.F, 0.F, 0.F };
+	settings.gravity        = { 0.F, -10.F, 0.F };
+	settings.rate           = 0.F;
+	settings.minLifetime    = 1.F;
+	settings.maxLifetime    = 1.F;
+	settings.maxParticles   = 10;
+
+	auto instances = std::vector<ParticleEmitter::Instance>(16);
+
+	SECTION("Emitting stops at the maximum") {
+		auto emitter = ParticleEmitter(settings);
+
+		REQUIRE(emitter.Emit(7) == 7);
+		REQUIRE(emitter.Emit(7) == 3);
+		REQUIRE(emitter.Count() == 10);
+		REQUIRE(emitter.WriteInstances(instances) == 10);
+		REQUIRE(emitter.WriteInstances(std::span(instances).first(4)) == 4);
+	}
+
+	SECTION("Particles move under gravity") {
+		auto emitter = ParticleEmitter(settings);
+		emitter.Emit(1);
+		emitter.Update(.1F);
+
+		REQUIRE(emitter.WriteInstances(instances) == 1);
+		REQUIRE_THAT(instances[0].position.x, WithinAbs(.1F, 1e-5));
+		REQUIRE_THAT(instances[0].position.y, WithinAbs(-.1F, 1e-5));
+		REQUIRE_THAT(instances[0].position.z, WithinAbs(0.F, 1e-5));
+	}
+
+	SECTION("Particles die after their lifetime, the live ones staying packed") {
+		auto emitter = ParticleEmitter(settings);
+		emitter.Emit(3);
+		emitter.Update(.5F);
+
+		settings.minLifetime = 4.F;
+		settings.maxLifetime = 4.F;
+		emitter.SetSettings(settings);
+		emitter.Emit(2);
+		emitter.Update(.6F);
+
+		REQUIRE(emitter.Count() == 2);
+		REQUIRE(emitter.WriteInstances(instances) == 2);
+		for (auto i = 0; i < 2; i++) {
+			REQUIRE_THAT(instances[i].position.x, WithinAbs(.6F, 1e-5));
+		}
+
+		emitter.Update(4.F);
+		REQUIRE(emitter.Count() == 0);
+	}
+
+	SECTION("Size and color follow the age") {
+		settings.minLifetime = 2.F;
+		settings.maxLifetime = 2.F;
+		settings.startSize   = 1.F;
+		settings.endSize     = 3.F;
+		settings.startColor  = { 1.F, 0.F, 0.F, 1.F };
+		settings.endColor    = { 0.F, 0.F, 1.F, 0.F };
+
+		auto emitter = ParticleEmitter(settings);
+		emitter.Emit(5);
+		emitter.Update(1.F);
+
+		REQUIRE(emitter.WriteInstances(instances) == 5);
+		for (auto i = 0; i < 5; i++) {
+			REQUIRE_THAT(instances[i].size, WithinAbs(2.F, 1e-5));
+			REQUIRE(instances[i].color == (128U | (128U << 16) | (128U << 24)));
+		}
+	}
+
+	SECTION("Update spawns at the configured rate") {
+		settings.rate         = 100.F;
+		settings.maxParticles = 1000;
+
+		auto emitter = ParticleEmitter(settings);
+		for (auto i = 0; i < 4; i++) {
+			emitter.Update(.125F);
+		}
+
+		REQUIRE(emitter.Count() == 50);
+	}
+}
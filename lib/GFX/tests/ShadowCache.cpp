@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/ShadowCache.hpp"
+
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("GFX - ShadowCache") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	auto sun = Light{
+		.position           = {},
+		.direction          = { -.3F, -1.F, -.2F },
+		.diffuse            = { 1.F, 1.F, 1.F },
+		.ambientCoefficient = .1F,
+		.attenuation        = 0.F,
+		.castsShadows       = true,
+	};
+	auto lamp = Light{
+		.position           = { 2.F, 3.F, 0.F },
+		.direction          = {},
+		.diffuse            = { 1.F, .8F, .6F },
+		.ambientCoefficient = 0.F,
+		.attenuation        = .1F,
+		.castsShadows       = true,
+	};
+
+	const auto projection = glm::perspective(glm::radians(75.F), 16.F / 9.F, .1F, 100.F);
+	const auto cameraAt   = [&](const glm::vec3& position) {
+		return projection * glm::lookAt(position, position + glm::vec3(0.F, 0.F, -1.F), glm::vec3(0.F, 1.F, 0.F));
+	};
+
+	const auto countViews = [](const ShadowCache& cache, ShadowCache::Target target, bool redrawStatic) {
+		const auto views = cache.Views();
+		return std::count_if(views.begin(), views.end(), [&](const ShadowCache::View& view) {
+			return view.target == target && view.redrawStatic == redrawStatic;
+		});
+	};
+
+	auto cache = ShadowCache(ShadowCache::Settings());
+
+	SECTION("Cascades are staggered") {
+		for (auto frame = U64(1); frame < 64; frame++) {
+			auto nDue = 0;
+			for (auto cascade = 0; cascade < ShadowCache::kMaxCascades; cascade++) {
+				if (ShadowCache::IsCascadeDue(cascade, frame)) {
+					nDue++;
+				}
+			}
+
+			REQUIRE(ShadowCache::IsCascadeDue(0, frame));
+			REQUIRE(nDue <= 2);
+		}
+
+		auto nUpdates = 0;
+		for (auto frame = U64(0); frame < 64; frame++) {
+			nUpdates += ShadowCache::IsCascadeDue(2, frame) ? 1 : 0;
+		}
+		REQUIRE(nUpdates == 16);
+	}
+
+	SECTION("Cascades cover the camera's view, and stay put as it moves a little") {
+		const Light lights[] = { sun };
+		cache.SetLights(lights);
+
+		const auto camera = glm::vec3(0.F, 2.F, 0.F);
+		cache.Update(cameraAt(camera), camera, 1, 0);
+		REQUIRE(cache.Cascades().size() == 3);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 3);
+		REQUIRE(cache.ShadowIndex(sun) == ShadowCache::kCascaded);
+
+		// Points in front of the camera land in a cascade, the nearest one first
+		for (const auto depth : { 1.F, 10.F, 40.F, 75.F }) {
+			const auto point = camera + glm::vec3(.3F, -.5F, -depth);
+
+			auto inside = false;
+			for (const auto& matrix : cache.Cascades()) {
+				const auto coords = matrix * glm::vec4(point, 1.F);
+				inside = inside || (
+					coords.x > 0.F && coords.x < 1.F &&
+					coords.y > 0.F && coords.y < 1.F &&
+					coords.z > 0.F && coords.z < 1.F
+				);
+			}
+			REQUIRE(inside);
+		}
+		REQUIRE(cache.CascadeTexelSize(0) < cache.CascadeTexelSize(1));
+		REQUIRE(cache.CascadeTexelSize(1) < cache.CascadeTexelSize(2));
+
+		// A few centimeters don't move the cascades, so their static casters are reused
+		const auto first = std::vector(cache.Cascades().begin(), cache.Cascades().end());
+		for (auto frame = U64(1); frame < 8; frame++) {
+			const auto moved = camera + glm::vec3(.01F * F32(frame), 0.F, 0.F);
+			cache.Update(cameraAt(moved), moved, 1, frame);
+
+			REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 0);
+			REQUIRE(countViews(cache, ShadowCache::Target::Cascade, false) >= 1);
+		}
+		REQUIRE(std::equal(first.begin(), first.end(), cache.Cascades().begin()));
+
+		// Far away, the nearest cascade follows on the next frame, the others when they are due
+		const auto far = camera + glm::vec3(50.F, 0.F, 0.F);
+		cache.Update(cameraAt(far), far, 1, 8);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 1);
+		cache.Update(cameraAt(far), far, 1, 9);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 1);
+		REQUIRE(cache.Views()[1].layer == 1);
+	}
+
+	SECTION("Static casters are only redrawn when they change or the light moves") {
+		const Light lights[] = { sun, lamp };
+		cache.SetLights(lights);
+
+		const auto camera = glm::vec3(0.F, 2.F, 0.F);
+		cache.Update(cameraAt(camera), camera, 1, 0);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 6);
+		REQUIRE(cache.ShadowIndex(lamp) == 0);
+
+		cache.Update(cameraAt(camera), camera, 1, 1);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 0);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, false) == 6);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 0);
+
+		// New static casters
+		cache.Update(cameraAt(camera), camera, 2, 2);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 6);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 2);
+
+		// The lamp moves, the sun keeps its cache, only the cascade not due on the last frame catches up
+		lamp.position.x += 1.F;
+		const Light moved[] = { sun, lamp };
+		cache.SetLights(moved);
+		cache.Update(cameraAt(camera), camera, 2, 3);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 6);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 1);
+		cache.Update(cameraAt(camera), camera, 2, 5);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 0);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 0);
+		REQUIRE(cache.ShadowIndex(lamp) == 0);
+
+		cache.Invalidate();
+		cache.Update(cameraAt(camera), camera, 2, 6);
+		REQUIRE(countViews(cache, ShadowCache::Target::CubeFace, true) == 6);
+		REQUIRE(countViews(cache, ShadowCache::Target::Cascade, true) == 2);
+	}
+
+	SECTION("Lights without shadows, and shadow-casting lights beyond the limit, sample no shadow map") {
+		auto plain = lamp;
+		plain.castsShadows = false;
+
+		auto lights = std::vector<Light>(ShadowCache::kMaxPointLights + 1, lamp);
+		for (auto i = std::size_t(0); i < lights.size(); i++) {
+			lights[i].position.x = F32(i);
+		}
+		lights.push_back(plain);
+		cache.SetLights(lights);
+		cache.Update(cameraAt({}), {}, 1, 0);
+
+		REQUIRE(cache.PointShadows().size() == std::size_t(ShadowCache::kMaxPointLights));
+		REQUIRE(cache.ShadowIndex(lights[ShadowCache::kMaxPointLights - 1]) == ShadowCache::kMaxPointLights - 1);
+		REQUIRE(cache.ShadowIndex(lights[ShadowCache::kMaxPointLights]) == -1);
+		REQUIRE(cache.ShadowIndex(plain) == -1);
+		REQUIRE(cache.ShadowIndex(sun) == -1);
+		REQUIRE(cache.Cascades().empty());
+	}
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/TLSFAllocator.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+TEST_CASE("GFX - TLSFAllocator") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	auto allocator = TLSFAllocator(1024);
+
+	SECTION("Allocations are aligned and do not overlap") {
+		auto ranges = std::vector<std::pair<U64, U64>>();
+		for (const auto& [size, alignment] : { std::pair<U64, U64>{ 10, 1 }, { 48, 24 }, { 7, 16 }, { 100, 4 }, { 24, 24 } }) {
+			const auto handle = allocator.Allocate(size, alignment);
+
+			REQUIRE(handle != TLSFAllocator::kInvalidHandle);
+			REQUIRE(allocator.Offset(handle) % alignment == 0);
+			REQUIRE(allocator.Size(handle) == size);
+			ranges.emplace_back(allocator.Offset(handle), allocator.Offset(handle) + size);
+		}
+
+		std::sort(ranges.begin(), ranges.end());
+		for (auto i = 1UL; i < ranges.size(); i++) {
+			REQUIRE(ranges[i - 1].second <= ranges[i].first);
+		}
+	}
+
+	SECTION("Freed blocks are merged back together") {
+		const auto a = allocator.Allocate(256);
+		const auto b = allocator.Allocate(256);
+		const auto c = allocator.Allocate(512);
+
+		REQUIRE(allocator.Allocate(1) == TLSFAllocator::kInvalidHandle);
+
+		allocator.Free(a);
+		allocator.Free(c);
+		allocator.Free(b);
+
+		const auto stats = allocator.GetStats();
+		REQUIRE(allocator.IsEmpty());
+		REQUIRE(stats.nFreeBlocks == 1);
+		REQUIRE(stats.largestFreeBlock == 1024);
+		REQUIRE(allocator.Allocate(1024) != TLSFAllocator::kInvalidHandle);
+	}
+
+	SECTION("Defragmenting moves allocations down and keeps handles valid") {
+		auto handles = std::vector<TLSFAllocator::Handle>();
+		for (auto i = 0; i < 16; i++) {
+			handles.push_back(allocator.Allocate(64));
+		}
+		for (auto i = 0UL; i < handles.size(); i += 2) {
+			allocator.Free(handles[i]);
+		}
+
+		REQUIRE(allocator.GetStats().fragmentation > .5F);
+
+		auto moves = std::vector<std::pair<U64, U64>>();
+		const auto moved = allocator.Defragment(1024, [&moves](U64 from, U64 to, U64 size) {
+			REQUIRE((to + size <= from || from + size <= to));
+			moves.emplace_back(from, to);
+		});
+
+		const auto stats = allocator.GetStats();
+		REQUIRE(moved == moves.size() * 64);
+		REQUIRE(stats.fragmentation == 0.F);
+		REQUIRE(stats.largestFreeBlock == 512);
+		for (auto i = 1UL; i < handles.size(); i += 2) {
+			REQUIRE(allocator.Offset(handles[i]) < 512);
+			REQUIRE(allocator.Size(handles[i]) == 64);
+		}
+	}
+}
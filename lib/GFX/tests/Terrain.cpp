@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/Terrain.hpp"
+
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+
+TEST_CASE("GFX - Terrain") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	// Tiles of 8x8 quads, one world unit per quad, with heights rising along x
+	auto settings = Terrain::Settings();
+	settings.tileResolution   = 8;
+	settings.chunkResolution  = 4;
+	settings.tileSize         = 8.F;
+	settings.lodDistance      = 2.F;
+	settings.loadRadius       = 1;
+	settings.maxResidentTiles = 9;
+	settings.maxPendingLoads  = 9;
+	settings.loader           = [](glm::ivec2 tile) {
+		auto heights = std::vector<F32>();
+		for (auto z = 0; z <= 8; z++) {
+			for (auto x = 0; x <= 8; x++) {
+				heights.push_back(F32(tile.x * 8 + x) * .5F);
+			}
+		}
+		return heights;
+	};
+
+	const auto updateUntilLoaded = [](Terrain& terrain, const glm::vec3& camera) {
+		do {
+			terrain.Update(camera);
+		} while (terrain.PendingLoads() > 0);
+	};
+
+	SECTION("Chunks are covered exactly, whatever their stitching") {
+		constexpr auto kResolution = 8;
+		constexpr auto kStride     = 17;
+
+		for (auto lod = 0; lod < 4; lod++) {
+			for (auto stitches = 0; stitches < Terrain::kStitchVariants; stitches++) {
+				const auto indices = Terrain::BuildChunkIndices(kResolution, kStride, lod, U8(stitches));
+				REQUIRE(indices.size() % 3 == 0);
+
+				auto area = 0;
+				for (auto i = std::size_t(0); i < indices.size(); i += 3) {
+					const auto corner = [&](std::size_t k) { return glm::ivec2(I32(indices[i + k]) % kStride, I32(indices[i + k]) / kStride); };
+					const auto a = corner(0);
+					const auto b = corner(1);
+					const auto c = corner(2);
+
+					// Counter-clockwise seen from above
+					const auto doubleArea = (b.y - a.y) * (c.x - a.x) - (b.x - a.x) * (c.y - a.y);
+					REQUIRE(doubleArea > 0);
+					area += doubleArea;
+				}
+				REQUIRE(area == 2 * kResolution * kResolution);
+
+				// Stitched sides only use the vertices of the next level
+				if (lod < 3 && (stitches & Terrain::kNegativeX) != 0) {
+					const auto coarseStep = 2 << lod;
+					for (const auto index : indices) {
+						if (index % kStride == 0) {
+							REQUIRE(I32(index / kStride) % coarseStep == 0);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Tiles stream around the camera") {
+		auto terrain = Terrain(settings);
+		updateUntilLoaded(terrain, { 4.F, 0.F, 4.F });
+		REQUIRE(terrain.Tiles().size() == 9);
+
+		// Far away, every tile is replaced, in the same slots
+		updateUntilLoaded(terrain, { 1004.F, 0.F, 4.F });
+		REQUIRE(terrain.Tiles().size() == 9);
+
+		auto slots = std::set<I32>();
+		for (const auto& tile : terrain.Tiles()) {
+			REQUIRE(std::abs(tile.coords.x - 125) <= 1);
+			REQUIRE(tile.slot < settings.maxResidentTiles);
+			slots.insert(tile.slot);
+		}
+		REQUIRE(slots.size() == 9);
+	}
+
+	SECTION("Tiles without data are skipped") {
+		auto halfWorld = settings;
+		halfWorld.loader = [loader = settings.loader](glm::ivec2 tile) {
+			return tile.x < 0 ? std::vector<F32>() : loader(tile);
+		};
+
+		auto terrain = Terrain(halfWorld);
+		updateUntilLoaded(terrain, { 4.F, 0.F, 4.F });
+		REQUIRE(terrain.Tiles().size() == 6);
+		REQUIRE_FALSE(terrain.HeightAt(-4.F, 4.F));
+	}
+
+	SECTION("Heights are interpolated") {
+		auto terrain = Terrain(settings);
+		updateUntilLoaded(terrain, { 4.F, 0.F, 4.F });
+
+		REQUIRE(std::abs(*terrain.HeightAt(3.5F, 2.25F) - 1.75F) < 1e-5F);
+		REQUIRE(std::abs(*terrain.HeightAt(-.5F, 7.F) + .25F) < 1e-5F);
+	}
+
+	SECTION("Neighbouring chunks differ by one level at most") {
+		auto terrain = Terrain(settings);
+		updateUntilLoaded(terrain, { 0.F, 0.F, 0.F });
+
+		// Level and stitching of each chunk, by global chunk coordinates
+		auto chunks = std::map<std::pair<I32, I32>, std::pair<U8, U8>>();
+		for (const auto& tile : terrain.Tiles()) {
+			for (auto chunk = 0; chunk < 4; chunk++) {
+				chunks[{ tile.coords.x * 2 + chunk % 2, tile.coords.y * 2 + chunk / 2 }] = { tile.lods[std::size_t(chunk)], tile.stitches[std::size_t(chunk)] };
+			}
+		}
+
+		auto levels = std::set<U8>();
+		for (const auto& [coords, chunk] : chunks) {
+			const auto [lod, stitches] = chunk;
+			levels.insert(lod);
+
+			const auto right = chunks.find({ coords.first + 1, coords.second });
+			if (right != chunks.end()) {
+				const auto otherLod = right->second.first;
+				REQUIRE(std::abs(I32(lod) - I32(otherLod)) <= 1);
+				REQUIRE(((stitches & Terrain::kPositiveX) != 0) == (otherLod > lod));
+				REQUIRE(((right->second.second & Terrain::kNegativeX) != 0) == (lod > otherLod));
+			}
+		}
+		REQUIRE(levels.size() > 1);
+	}
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/TextureArrays.hpp"
+
+#include <algorithm>
+
+TEST_CASE("GFX - TextureArrays") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	// 256 texels: levels 0 (256) and 1 (128) stream in, 2 (64) to 8 are the tail
+	const auto shape = TextureArrays::Shape { TextureImage::Format::BC1, false, 256, 256, 9 };
+	const auto tail  = [&](I32 first) {
+		auto size = I64(0);
+		for (auto level = first; level < shape.levels; level++) {
+			size += TextureImage::LevelSize(shape.format, shape.width, shape.height, level);
+		}
+		return size;
+	};
+
+	auto arrays = TextureArrays();
+
+	SECTION("Textures of a shape share an array") {
+		const auto first  = arrays.Add(1, shape);
+		const auto second = arrays.Add(2, shape);
+		const auto other  = arrays.Add(3, { TextureImage::Format::BC7, false, 256, 256, 9 });
+
+		REQUIRE(first.has_value());
+		REQUIRE(second.has_value());
+		REQUIRE(other.has_value());
+		REQUIRE(first->array == 0);
+		REQUIRE(first->layer == 0);
+		REQUIRE(second->array == 0);
+		REQUIRE(second->layer == 1);
+		REQUIRE(other->array == 1);
+		REQUIRE(arrays.Arrays() == 2);
+		REQUIRE(arrays.ArrayShape(0) == shape);
+
+		arrays.Remove(1);
+		REQUIRE(arrays.Add(4, shape)->layer == 0);
+	}
+
+	SECTION("Arrays run out") {
+		for (auto i = 0; i < TextureArrays::kMaxArrays * TextureArrays::kLayersPerArray; i++) {
+			REQUIRE(arrays.Add(TextureID(i + 1), shape).has_value());
+		}
+
+		REQUIRE(arrays.Arrays() == TextureArrays::kMaxArrays);
+		REQUIRE_FALSE(arrays.Add(TextureID(100000), shape).has_value());
+	}
+
+	SECTION("Levels are wanted at a texel per pixel") {
+		REQUIRE(TextureArrays::WantedLevel(256, 256.F, 9) == 0);
+		REQUIRE(TextureArrays::WantedLevel(256, 1000.F, 9) == 0);
+		REQUIRE(TextureArrays::WantedLevel(256, 127.F, 9) == 1);
+		REQUIRE(TextureArrays::WantedLevel(256, 64.F, 9) == 2);
+		REQUIRE(TextureArrays::WantedLevel(256, 0.F, 9) == 8);
+		REQUIRE(TextureArrays::WantedLevel(256, .01F, 9) == 8);
+	}
+
+	SECTION("Tails are uploaded right away, whatever the budget") {
+		REQUIRE(arrays.Add(1, shape).has_value());
+		REQUIRE_FALSE(arrays.Find(1).has_value());
+
+		const auto uploads = arrays.Stream(0);
+
+		REQUIRE(uploads.size() == 7);
+		REQUIRE(uploads.front().level == 8);
+		REQUIRE(uploads.back().level == 2);
+		REQUIRE(arrays.Find(1)->minLevel == 2);
+		REQUIRE(arrays.Stream(0).empty());
+	}
+
+	SECTION("Finer levels stream in one per frame, as requested") {
+		REQUIRE(arrays.Add(1, shape).has_value());
+		REQUIRE(arrays.Stream(0).size() == 7);
+
+		// Not requested, nothing more
+		REQUIRE(arrays.Stream(tail(0)).empty());
+
+		arrays.Request(1, 512.F);
+		auto uploads = arrays.Stream(tail(0));
+		REQUIRE(uploads.size() == 1);
+		REQUIRE(uploads[0].level == 1);
+
+		// Requests only last a frame
+		REQUIRE(arrays.Stream(tail(0)).empty());
+
+		arrays.Request(1, 512.F);
+		uploads = arrays.Stream(tail(0));
+		REQUIRE(uploads.size() == 1);
+		REQUIRE(uploads[0].level == 0);
+		REQUIRE(arrays.Find(1)->minLevel == 0);
+	}
+
+	SECTION("The budget goes to the blurriest textures first") {
+		REQUIRE(arrays.Add(1, shape).has_value());
+		REQUIRE(arrays.Add(2, shape).has_value());
+		REQUIRE(arrays.Stream(0).size() == 14);
+
+		arrays.Request(1, 512.F);
+		REQUIRE(arrays.Stream(tail(0)).size() == 1);
+
+		// Texture 1 wants level 0, texture 2 level 1; only one fits
+		const auto level1 = TextureImage::LevelSize(shape.format, shape.width, shape.height, 1);
+		arrays.Request(1, 512.F);
+		arrays.Request(2, 512.F);
+		const auto uploads = arrays.Stream(level1);
+
+		REQUIRE(uploads.size() == 1);
+		REQUIRE(uploads[0].texture == 2);
+		REQUIRE(uploads[0].level == 1);
+		REQUIRE(arrays.Find(1)->minLevel == 1);
+	}
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "GFX/TextureImage.hpp"
+
+#include <cstring>
+
+namespace {
+	auto Write(std::vector<std::byte>& data, std::size_t offset, Gaze::U32 value) -> void
+	{
+		for (auto i = 0U; i < 4; i++) {
+			data[offset + i] = std::byte((value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	auto FourCC(const char* code) -> Gaze::U32
+	{
+		auto value = Gaze::U32(0);
+		std::memcpy(&value, code, 4);
+		return value;
+	}
+
+	/**
+	 * @brief Make a DDS file with zeroed blocks.
+	 */
+	auto MakeDDS(const char* fourCC, Gaze::U32 width, Gaze::U32 height, Gaze::U32 levels, std::size_t dataSize, Gaze::U32 dxgiFormat = 0) -> std::vector<std::byte>
+	{
+		const auto isDX10 = std::strcmp(fourCC, "DX10") == 0;
+		auto data = std::vector<std::byte>(128 + (isDX10 ? 20 : 0) + dataSize);
+
+		Write(data, 0, FourCC("DDS "));
+		Write(data, 4, 124);
+		Write(data, 8, 0x1007 | (levels > 1 ? 0x20000 : 0));
+		Write(data, 12, height);
+		Write(data, 16, width);
+		Write(data, 28, levels);
+		Write(data, 76, 32);
+		Write(data, 80, 0x4);
+		Write(data, 84, FourCC(fourCC));
+		if (isDX10) {
+			Write(data, 128, dxgiFormat);
+			Write(data, 132, 3);
+			Write(data, 140, 1);
+		}
+
+		return data;
+	}
+}
+
+TEST_CASE("GFX - TextureImage") {
+	using namespace Gaze;
+	using namespace Gaze::GFX;
+
+	SECTION("Levels take whole blocks") {
+		REQUIRE(TextureImage::LevelSize(TextureImage::Format::BC1, 256, 128, 0) == 64 * 32 * 8);
+		REQUIRE(TextureImage::LevelSize(TextureImage::Format::BC7, 256, 128, 2) == 16 * 8 * 16);
+		REQUIRE(TextureImage::LevelSize(TextureImage::Format::BC3, 256, 128, 7) == 16);
+		REQUIRE(TextureImage::LevelSize(TextureImage::Format::BC5, 6, 6, 0) == 4 * 16);
+	}
+
+	SECTION("Legacy headers are read with their levels") {
+		// 16x8: 4x2 blocks, 2x1, 1x1, 1x1
+		const auto image = TextureImage::Parse(MakeDDS("DXT1", 16, 8, 4, (8 + 2 + 1 + 1) * 8));
+
+		REQUIRE(image.has_value());
+		REQUIRE(image->ID() != kInvalidTextureID);
+		REQUIRE(image->GetFormat() == TextureImage::Format::BC1);
+		REQUIRE_FALSE(image->IsSRGB());
+		REQUIRE(image->Width() == 16);
+		REQUIRE(image->Height() == 8);
+		REQUIRE(image->Levels() == 4);
+		REQUIRE(image->Level(0).size() == 64);
+		REQUIRE(image->Level(3).size() == 8);
+		REQUIRE(image->Level(1).data() == image->Level(0).data() + 64);
+	}
+
+	SECTION("The DX10 header gives the format and encoding") {
+		const auto image = TextureImage::Parse(MakeDDS("DX10", 4, 4, 1, 16, 99));
+
+		REQUIRE(image.has_value());
+		REQUIRE(image->GetFormat() == TextureImage::Format::BC7);
+		REQUIRE(image->IsSRGB());
+		REQUIRE(image->Levels() == 1);
+	}
+
+	SECTION("Images get distinct IDs") {
+		const auto first  = TextureImage::Parse(MakeDDS("DXT5", 4, 4, 1, 16));
+		const auto second = TextureImage::Parse(MakeDDS("ATI2", 4, 4, 1, 16));
+
+		REQUIRE(first.has_value());
+		REQUIRE(second.has_value());
+		REQUIRE(second->GetFormat() == TextureImage::Format::BC5);
+		REQUIRE(first->ID() != second->ID());
+	}
+
+	SECTION("Invalid files are rejected") {
+		auto notDDS = MakeDDS("DXT1", 4, 4, 1, 8);
+		notDDS[0] = std::byte('X');
+
+		auto cubemap = MakeDDS("DXT1", 4, 4, 1, 8);
+		Write(cubemap, 112, 0x200);
+
+		REQUIRE_FALSE(TextureImage::Parse(notDDS).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(cubemap).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(MakeDDS("DXT1", 16, 16, 1, 8)).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(MakeDDS("DXT3", 4, 4, 1, 16)).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(MakeDDS("DX10", 4, 4, 1, 16, 28)).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(MakeDDS("DXT1", 4, 4, 5, 64)).has_value());
+		REQUIRE_FALSE(TextureImage::Parse(std::vector<std::byte>(64)).has_value());
+	}
+}
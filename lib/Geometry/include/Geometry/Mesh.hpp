@@ -2,6 +2,7 @@
 
 #include "Core/Type.hpp"
 
+#include <array>
 #include <vector>
 #include <initializer_list>
 
@@ -13,6 +14,7 @@ namespace Gaze::Geometry {
 	{
 		float x, y, z;    /**< Coordinates */
 		float nx, ny, nz; /**< Normals */
+		float u, v;       /**< Texture coordinates */
 	};
 
 	/**
@@ -20,13 +22,23 @@ namespace Gaze::Geometry {
 	 */
 	using Index = U32;
 
+	/**
+	 * @brief The joints influencing a vertex of a skinned mesh, and how much.
+	 */
+	struct SkinWeights
+	{
+		std::array<U16, 4> joints;  /**< Indices into the skeleton's joints */
+		std::array<F32, 4> weights; /**< Sum to 1; unused influences have a weight of 0 */
+	};
+
 	/**
 	 * @brief Represents a primitive in a mesh.
 	 */
 	struct Primitive
 	{
-		std::vector<Vertex> vertices; /**< List of vertices in the primitive */
-		std::vector<Index>  indices;  /**< List of indices in the primitive */
+		std::vector<Vertex>      vertices; /**< List of vertices in the primitive */
+		std::vector<Index>       indices;  /**< List of indices in the primitive */
+		std::vector<SkinWeights> skin;     /**< Skinning influences, one per vertex; empty for rigid primitives */
 	};
 
 	/**
@@ -76,6 +88,10 @@ namespace Gaze::Geometry {
 		 * @brief Returns the list of primitives in the mesh.
 		 */
 		[[nodiscard]] auto Primitives() const noexcept -> const std::vector<Primitive>&;
+		/**
+		 * @brief Returns whether any primitive of the mesh carries skin weights.
+		 */
+		[[nodiscard]] auto IsSkinned()  const noexcept -> bool;
 
 	private:
 		std::vector<Primitive> m_Primitives; /**< List of primitives in the mesh */
@@ -85,4 +101,15 @@ namespace Gaze::Geometry {
 	{
 		return m_Primitives;
 	}
+
+	inline auto Mesh::IsSkinned() const noexcept -> bool
+	{
+		for (const auto& prim : m_Primitives) {
+			if (!prim.skin.empty()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "Geometry/Mesh.hpp"
+
+#include <memory>
+
+namespace Gaze::Geometry {
+	/**
+	 * @brief Identifies a unique, immutable mesh. Never reused within a process.
+	 */
+	using MeshID = U64;
+
+	static constexpr auto kInvalidMeshID = MeshID(0);
+
+	/**
+	 * @brief Lightweight shared reference to an immutable mesh.
+	 *
+	 * Copying a handle only bumps a reference count. All handles to the same
+	 * mesh carry the same ID, which lets consumers (such as the renderer)
+	 * recognize shared geometry without comparing contents.
+	 *
+	 * @see MeshRegistry
+	 */
+	class MeshHandle
+	{
+		friend class MeshRegistry;
+
+	public:
+		MeshHandle() = default;
+		/**
+		 * @brief Wrap a mesh into a new, unregistered handle with its own ID.
+		 *
+		 * Identical meshes wrapped this way are not shared; go through a
+		 * MeshRegistry for that.
+		 *
+		 * @param mesh The mesh.
+		 */
+		explicit MeshHandle(Mesh mesh);
+
+		[[nodiscard]] auto Get()        const noexcept -> const Mesh&;
+		[[nodiscard]] auto operator*()  const noexcept -> const Mesh&;
+		[[nodiscard]] auto operator->() const noexcept -> const Mesh*;
+		[[nodiscard]] auto ID()         const noexcept -> MeshID;
+		/**
+		 * @brief Get the number of handles sharing the mesh.
+		 */
+		[[nodiscard]] auto UseCount()   const noexcept -> long;
+		/**
+		 * @brief Get a reference to the mesh that does not keep it alive.
+		 *
+		 * Lets caches keyed by ID() notice when the mesh goes away.
+		 */
+		[[nodiscard]] auto WeakRef()    const noexcept -> std::weak_ptr<const Mesh>;
+
+		[[nodiscard]] explicit operator bool() const noexcept;
+
+	private:
+		MeshHandle(Shared<const Mesh> mesh, MeshID id) noexcept;
+
+		[[nodiscard]] static auto NextID() noexcept -> MeshID;
+
+	private:
+		Shared<const Mesh> m_Mesh;
+		MeshID             m_ID = kInvalidMeshID;
+	};
+
+	inline auto MeshHandle::Get() const noexcept -> const Mesh&
+	{
+		return *m_Mesh;
+	}
+
+	inline auto MeshHandle::operator*() const noexcept -> const Mesh&
+	{
+		return *m_Mesh;
+	}
+
+	inline auto MeshHandle::operator->() const noexcept -> const Mesh*
+	{
+		return m_Mesh.get();
+	}
+
+	inline auto MeshHandle::ID() const noexcept -> MeshID
+	{
+		return m_ID;
+	}
+
+	inline auto MeshHandle::UseCount() const noexcept -> long
+	{
+		return m_Mesh.use_count();
+	}
+
+	inline auto MeshHandle::WeakRef() const noexcept -> std::weak_ptr<const Mesh>
+	{
+		return m_Mesh;
+	}
+
+	inline MeshHandle::operator bool() const noexcept
+	{
+		return m_Mesh != nullptr;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshHandle.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Gaze::Geometry {
+	/**
+	 * @brief Deduplicating store of shared meshes
+	 *
+	 * Loading a mesh identical (bitwise) to one still referenced elsewhere
+	 * returns a handle to the existing copy instead of keeping a new one, so
+	 * memory scales with the number of unique meshes rather than the number
+	 * of users. The registry only holds weak references: a mesh is freed once
+	 * its last handle goes away.
+	 *
+	 * Thread-safe.
+	 */
+	class MeshRegistry
+	{
+	public:
+		/**
+		 * @brief Get a handle to @p mesh, sharing an existing identical mesh if there is one.
+		 *
+		 * @param mesh The mesh.
+		 *
+		 * @return The handle.
+		 */
+		[[nodiscard]] auto Load(Mesh mesh) -> MeshHandle;
+		/**
+		 * @brief Forget meshes that are no longer referenced by any handle.
+		 *
+		 * @return The number of meshes forgotten.
+		 */
+		auto Purge() -> std::size_t;
+		/**
+		 * @brief Get the number of meshes still referenced by at least one handle.
+		 */
+		[[nodiscard]] auto Size() const -> std::size_t;
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<const Mesh> mesh;
+			MeshID                    id;
+		};
+
+		[[nodiscard]] static auto Hash(const Mesh& mesh)                   noexcept -> U64;
+		[[nodiscard]] static auto Equal(const Mesh& lhs, const Mesh& rhs) noexcept -> bool;
+
+	private:
+		mutable std::mutex                  m_Mutex;
+		std::unordered_multimap<U64, Entry> m_Entries; /**< Keyed by content hash */
+	};
+}
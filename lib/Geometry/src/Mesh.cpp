@@ -4,12 +4,12 @@
 
 namespace Gaze::Geometry {
 	Mesh::Mesh(std::initializer_list<Vertex> vertices, std::initializer_list<Index> indices)
-		: Mesh({ Primitive{ std::move(vertices), std::move(indices) } })
+		: Mesh({ Primitive{ std::move(vertices), std::move(indices), {} } })
 	{
 	}
 
 	Mesh::Mesh(std::vector<Vertex> vertices, std::vector<Index> indices)
-		: Mesh({ Primitive{ std::move(vertices), std::move(indices) } })
+		: Mesh({ Primitive{ std::move(vertices), std::move(indices), {} } })
 	{
 	}
 
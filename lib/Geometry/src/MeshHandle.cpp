@@ -0,0 +1,23 @@
+#include "Geometry/MeshHandle.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace Gaze::Geometry {
+	MeshHandle::MeshHandle(Mesh mesh)
+		: MeshHandle(MakeShared<const Mesh>(std::move(mesh)), NextID())
+	{
+	}
+
+	MeshHandle::MeshHandle(Shared<const Mesh> mesh, MeshID id) noexcept
+		: m_Mesh(std::move(mesh))
+		, m_ID(id)
+	{
+	}
+
+	auto MeshHandle::NextID() noexcept -> MeshID
+	{
+		static auto next = std::atomic<MeshID>(kInvalidMeshID + 1);
+		return next++;
+	}
+}
@@ -0,0 +1,100 @@
+#include "Geometry/MeshRegistry.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Gaze::Geometry {
+	static_assert(
+		std::is_trivially_copyable_v<Vertex> &&
+		std::is_trivially_copyable_v<Index> &&
+		std::is_trivially_copyable_v<SkinWeights>
+	);
+
+	auto MeshRegistry::Load(Mesh mesh) -> MeshHandle
+	{
+		const auto hash = Hash(mesh);
+		auto lock = std::scoped_lock(m_Mutex);
+
+		const auto [begin, end] = m_Entries.equal_range(hash);
+		for (auto it = begin; it != end; ++it) {
+			if (auto existing = it->second.mesh.lock(); existing && Equal(*existing, mesh)) {
+				return MeshHandle(std::move(existing), it->second.id);
+			}
+		}
+
+		auto handle = MeshHandle(std::move(mesh));
+		m_Entries.emplace(hash, Entry{ handle.m_Mesh, handle.ID() });
+
+		return handle;
+	}
+
+	auto MeshRegistry::Purge() -> std::size_t
+	{
+		auto lock = std::scoped_lock(m_Mutex);
+
+		return std::erase_if(m_Entries, [](const auto& entry) { return entry.second.mesh.expired(); });
+	}
+
+	auto MeshRegistry::Size() const -> std::size_t
+	{
+		auto lock = std::scoped_lock(m_Mutex);
+
+		return std::size_t(std::count_if(m_Entries.cbegin(), m_Entries.cend(), [](const auto& entry) {
+			return !entry.second.mesh.expired();
+		}));
+	}
+
+	auto MeshRegistry::Hash(const Mesh& mesh) noexcept -> U64
+	{
+		// FNV-1a over the raw vertex and index data
+		auto hash = U64(14695981039346656037ULL);
+		const auto feed = [&hash](const void* data, std::size_t size) {
+			const auto* bytes = static_cast<const Byte*>(data);
+			for (auto i = 0UL; i < size; i++) {
+				hash = (hash ^ bytes[i]) * 1099511628211ULL;
+			}
+		};
+
+		for (const auto& prim : mesh.Primitives()) {
+			const auto nVertices = prim.vertices.size();
+			const auto nIndices  = prim.indices.size();
+			const auto nSkin     = prim.skin.size();
+
+			feed(&nVertices, sizeof(nVertices));
+			feed(&nIndices, sizeof(nIndices));
+			feed(&nSkin, sizeof(nSkin));
+			feed(prim.vertices.data(), nVertices * sizeof(Vertex));
+			feed(prim.indices.data(), nIndices * sizeof(Index));
+			feed(prim.skin.data(), nSkin * sizeof(SkinWeights));
+		}
+
+		return hash;
+	}
+
+	auto MeshRegistry::Equal(const Mesh& lhs, const Mesh& rhs) noexcept -> bool
+	{
+		if (lhs.Primitives().size() != rhs.Primitives().size()) {
+			return false;
+		}
+
+		for (auto i = 0UL; i < lhs.Primitives().size(); i++) {
+			const auto& a = lhs.Primitives()[i];
+			const auto& b = rhs.Primitives()[i];
+
+			if (
+				a.vertices.size() != b.vertices.size() ||
+				a.indices.size() != b.indices.size() ||
+				a.skin.size() != b.skin.size() ||
+				std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex)) != 0 ||
+				std::memcmp(a.indices.data(), b.indices.data(), a.indices.size() * sizeof(Index)) != 0 ||
+				std::memcmp(a.skin.data(), b.skin.data(), a.skin.size() * sizeof(SkinWeights)) != 0
+			) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -1,7 +1,16 @@
 #pragma once
 
+#include "Core/Type.hpp"
+
 #include "Geometry/Mesh.hpp"
 
+#include "Scene/Animation.hpp"
+#include "Scene/Skeleton.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <string>
 #include <vector>
 #include <filesystem>
 
@@ -9,17 +18,68 @@ namespace Gaze::IO::Loader {
 	class Scene
 	{
 	public:
+		/**
+		 * @brief A node of the imported scene graph.
+		 */
+		struct Node
+		{
+			std::string              name;
+			I32                      parent;   /**< Index of the parent node, -1 for the root. Always lower than the node's own index */
+			glm::vec3                position; /**< Local transform, relative to the parent */
+			glm::quat                rotation;
+			glm::vec3                scale;
+			std::vector<std::size_t> meshes;   /**< Indices into Meshes(), shared by every node instancing the same mesh */
+		};
 
+	public:
 		[[nodiscard]] auto Load(const std::filesystem::path& path) -> bool;
 
+		/**
+		 * @brief Get the scene's meshes, each stored once.
+		 */
 		[[nodiscard]] auto Meshes() const noexcept -> const std::vector<Geometry::Mesh>&;
+		/**
+		 * @brief Get the scene's nodes, parents first.
+		 */
+		[[nodiscard]] auto Nodes()  const noexcept -> const std::vector<Node>&;
+		/**
+		 * @brief Get the joints the skinned meshes are bound to.
+		 *
+		 * Made of every node that is a bone, plus their ancestors up to the
+		 * root, so the skinning matrices take skinned meshes straight to the
+		 * scene's root space: the transforms of the nodes instancing them do
+		 * not apply. Empty if no mesh is skinned.
+		 */
+		[[nodiscard]] auto Skeleton()   const noexcept -> const Gaze::Scene::Skeleton&;
+		/**
+		 * @brief Get the scene's animations. Only channels animating joints of Skeleton() are kept.
+		 */
+		[[nodiscard]] auto Animations() const noexcept -> const std::vector<Gaze::Scene::AnimationClip>&;
 
 	private:
-		std::vector<Geometry::Mesh> m_Meshes;
+		std::vector<Geometry::Mesh>             m_Meshes;
+		std::vector<Node>                       m_Nodes;
+		Gaze::Scene::Skeleton                   m_Skeleton;
+		std::vector<Gaze::Scene::AnimationClip> m_Animations;
 	};
 
 	inline auto Scene::Meshes() const noexcept -> const std::vector<Geometry::Mesh>&
 	{
 		return m_Meshes;
 	}
+
+	inline auto Scene::Nodes() const noexcept -> const std::vector<Node>&
+	{
+		return m_Nodes;
+	}
+
+	inline auto Scene::Skeleton() const noexcept -> const Gaze::Scene::Skeleton&
+	{
+		return m_Skeleton;
+	}
+
+	inline auto Scene::Animations() const noexcept -> const std::vector<Gaze::Scene::AnimationClip>&
+	{
+		return m_Animations;
+	}
 }
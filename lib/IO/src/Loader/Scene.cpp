@@ -7,61 +7,259 @@
 #include <assimp/postprocess.h>
 
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 #include <iostream>
 
 namespace Gaze::IO::Loader {
-	static auto ProcessNode(const aiNode* node, const aiScene* scene, std::vector<Geometry::Mesh>& outMeshes) -> void
+	static auto ToMat4(const aiMatrix4x4& m) noexcept -> glm::mat4
+	{
+		// Assimp matrices are row-major
+		return glm::mat4(
+			glm::vec4(m.a1, m.b1, m.c1, m.d1),
+			glm::vec4(m.a2, m.b2, m.c2, m.d2),
+			glm::vec4(m.a3, m.b3, m.c3, m.d3),
+			glm::vec4(m.a4, m.b4, m.c4, m.d4)
+		);
+	}
+
+	static auto ProcessSkin(const aiMesh* mesh, const Gaze::Scene::Skeleton& skeleton) -> std::vector<Geometry::SkinWeights>
+	{
+		auto skin = std::vector<Geometry::SkinWeights>(mesh->mNumVertices, Geometry::SkinWeights{ {}, {} });
+
+		for (auto i = 0U; i < mesh->mNumBones; ++i) {
+			const auto* bone  = mesh->mBones[i];
+			const auto  joint = skeleton.FindJoint(bone->mName.C_Str());
+			if (joint < 0) {
+				continue;
+			}
+
+			// Keep the 4 strongest influences of each vertex
+			for (auto j = 0U; j < bone->mNumWeights; ++j) {
+				auto& influences = skin[bone->mWeights[j].mVertexId];
+				const auto weakest = std::min_element(influences.weights.begin(), influences.weights.end());
+				if (bone->mWeights[j].mWeight > *weakest) {
+					const auto slot = std::size_t(std::distance(influences.weights.begin(), weakest));
+
+					influences.joints[slot]  = U16(joint);
+					influences.weights[slot] = bone->mWeights[j].mWeight;
+				}
+			}
+		}
+
+		for (auto& influences : skin) {
+			auto total = 0.F;
+			for (const auto weight : influences.weights) {
+				total += weight;
+			}
+
+			if (total > 0.F) {
+				for (auto& weight : influences.weights) {
+					weight /= total;
+				}
+			} else {
+				// Unweighted vertices follow the root joint rigidly
+				influences.joints  = {};
+				influences.weights = { 1.F, 0.F, 0.F, 0.F };
+			}
+		}
+
+		return skin;
+	}
+
+	static auto ProcessMesh(const aiMesh* mesh, const Gaze::Scene::Skeleton& skeleton) -> Geometry::Mesh
+	{
+		auto vertices = std::vector<Geometry::Vertex>();
+		vertices.reserve(mesh->mNumVertices);
+		for (auto j = 0U; j < mesh->mNumVertices; ++j) {
+			auto vertex = Geometry::Vertex {
+				.x = mesh->mVertices[j].x,
+				.y = mesh->mVertices[j].y,
+				.z = mesh->mVertices[j].z,
+				.nx = 0.0f,
+				.ny = 0.0f,
+				.nz = 0.0f,
+				.u = 0.0f,
+				.v = 0.0f,
+			};
+			if (mesh->HasNormals()) {
+				vertex.nx = mesh->mNormals[j].x;
+				vertex.ny = mesh->mNormals[j].y;
+				vertex.nz = mesh->mNormals[j].z;
+			}
+			if (mesh->HasTextureCoords(0)) {
+				vertex.u = mesh->mTextureCoords[0][j].x;
+				vertex.v = mesh->mTextureCoords[0][j].y;
+			}
+
+			vertices.push_back(std::move(vertex));
+		}
+
+		auto indices = std::vector<Geometry::Index>();
+		indices.reserve(size_t(mesh->mNumFaces) * 3);
+		for (auto j = 0U; j < mesh->mNumFaces; ++j) {
+			const auto& face = mesh->mFaces[j];
+			std::copy(face.mIndices, face.mIndices + face.mNumIndices, std::back_inserter(indices));
+		}
+
+		auto skin = mesh->HasBones() ? ProcessSkin(mesh, skeleton) : std::vector<Geometry::SkinWeights>();
+
+		return Geometry::Mesh(std::vector<Geometry::Primitive>{
+			{ std::move(vertices), std::move(indices), std::move(skin) }
+		});
+	}
+
+	static auto ProcessNode(
+		const aiNode* node,
+		I32 parent,
+		std::vector<Scene::Node>& outNodes
+	) -> void
 	{
 		if (node == nullptr) {
 			return;
 		}
 
-		for (auto i = 0U; i < node->mNumMeshes; ++i) {
-			const auto* mesh = scene->mMeshes[node->mMeshes[i]];
-
-			auto vertices = std::vector<Geometry::Vertex>();
-			vertices.reserve(mesh->mNumVertices);
-			for (auto j = 0U; j < mesh->mNumVertices; ++j) {
-				auto vertex = Geometry::Vertex {
-					.x = mesh->mVertices[j].x,
-					.y = mesh->mVertices[j].y,
-					.z = mesh->mVertices[j].z,
-					.nx = 0.0f,
-					.ny = 0.0f,
-					.nz = 0.0f,
-				};
-				if (mesh->HasNormals()) {
-					vertex.nx = mesh->mNormals[j].x;
-					vertex.ny = mesh->mNormals[j].y;
-					vertex.nz = mesh->mNormals[j].z;
-				}
+		auto scaling  = aiVector3D();
+		auto rotation = aiQuaternion();
+		auto position = aiVector3D();
+		node->mTransformation.Decompose(scaling, rotation, position);
+
+		const auto nodeIdx = I32(outNodes.size());
+		outNodes.push_back({
+			.name     = node->mName.C_Str(),
+			.parent   = parent,
+			.position = { position.x, position.y, position.z },
+			.rotation = { rotation.w, rotation.x, rotation.y, rotation.z },
+			.scale    = { scaling.x, scaling.y, scaling.z },
+			.meshes   = { node->mMeshes, node->mMeshes + node->mNumMeshes },
+		});
 
-				vertices.push_back(std::move(vertex));
+		for (auto i = 0U; i < node->mNumChildren; ++i) {
+			ProcessNode(node->mChildren[i], nodeIdx, outNodes);
+		}
+	}
+
+	static auto ProcessSkeleton(const aiScene* scene, const std::vector<Scene::Node>& nodes) -> Gaze::Scene::Skeleton
+	{
+		auto inverseBinds = std::unordered_map<std::string, glm::mat4>();
+		for (auto i = 0U; i < scene->mNumMeshes; ++i) {
+			const auto* mesh = scene->mMeshes[i];
+			for (auto j = 0U; j < mesh->mNumBones; ++j) {
+				inverseBinds.emplace(mesh->mBones[j]->mName.C_Str(), ToMat4(mesh->mBones[j]->mOffsetMatrix));
 			}
+		}
 
-			auto indices = std::vector<Geometry::Index>();
-			indices.reserve(size_t(mesh->mNumFaces) * 3);
-			for (auto j = 0U; j < mesh->mNumFaces; ++j) {
-				const auto& face = mesh->mFaces[j];
-				std::copy(face.mIndices, face.mIndices + face.mNumIndices, std::back_inserter(indices));
+		// Bones and all their ancestors. Parents come first, so walking
+		// backwards reaches every node after its children
+		auto isJoint = std::vector<bool>(nodes.size(), false);
+		for (auto i = nodes.size(); i-- > 0;) {
+			if (inverseBinds.contains(nodes[i].name)) {
+				isJoint[i] = true;
+			}
+			if (isJoint[i] && nodes[i].parent >= 0) {
+				isJoint[std::size_t(nodes[i].parent)] = true;
 			}
+		}
 
-			outMeshes.emplace_back(std::move(vertices), std::move(indices));
+		auto skeleton = Gaze::Scene::Skeleton();
+		auto jointOf  = std::vector<I32>(nodes.size(), -1);
+		for (auto i = 0UL; i < nodes.size(); ++i) {
+			if (!isJoint[i]) {
+				continue;
+			}
+
+			const auto& node = nodes[i];
+			const auto  bind = inverseBinds.find(node.name);
+
+			jointOf[i] = I32(skeleton.joints.size());
+			skeleton.joints.push_back({
+				.name        = node.name,
+				.parent      = node.parent >= 0 ? jointOf[std::size_t(node.parent)] : -1,
+				.inverseBind = bind != inverseBinds.end() ? bind->second : glm::mat4(1.F),
+				.position    = node.position,
+				.rotation    = node.rotation,
+				.scale       = node.scale,
+			});
 		}
 
-		for (auto i = 0U; i < node->mNumChildren; ++i) {
-			ProcessNode(node->mChildren[i], scene, outMeshes);
+		return skeleton;
+	}
+
+	static auto ProcessAnimation(const aiAnimation* animation, const Gaze::Scene::Skeleton& skeleton) -> Gaze::Scene::AnimationClip
+	{
+		static constexpr auto kDefaultTicksPerSecond = 25.0;
+
+		const auto ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : kDefaultTicksPerSecond;
+		const auto toSeconds      = [ticksPerSecond](double ticks) { return F32(ticks / ticksPerSecond); };
+
+		auto clip = Gaze::Scene::AnimationClip{
+			.name     = animation->mName.C_Str(),
+			.duration = toSeconds(animation->mDuration),
+			.channels = {},
+		};
+
+		for (auto i = 0U; i < animation->mNumChannels; ++i) {
+			const auto* channel = animation->mChannels[i];
+			const auto  joint   = skeleton.FindJoint(channel->mNodeName.C_Str());
+			if (joint < 0) {
+				continue;
+			}
+
+			auto& out = clip.channels.emplace_back();
+			out.joint = joint;
+
+			for (auto k = 0U; k < channel->mNumPositionKeys; ++k) {
+				const auto& key = channel->mPositionKeys[k];
+				out.positions.times.push_back(toSeconds(key.mTime));
+				out.positions.values.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+			}
+			for (auto k = 0U; k < channel->mNumRotationKeys; ++k) {
+				const auto& key = channel->mRotationKeys[k];
+				out.rotations.times.push_back(toSeconds(key.mTime));
+				out.rotations.values.emplace_back(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z);
+			}
+			for (auto k = 0U; k < channel->mNumScalingKeys; ++k) {
+				const auto& key = channel->mScalingKeys[k];
+				out.scales.times.push_back(toSeconds(key.mTime));
+				out.scales.values.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+			}
 		}
+
+		return clip;
 	}
 
-	static auto ProcessScene(const aiScene* scene, std::vector<Geometry::Mesh>& outMeshes) -> bool
+	static auto ProcessScene(
+		const aiScene* scene,
+		std::vector<Geometry::Mesh>& outMeshes,
+		std::vector<Scene::Node>& outNodes,
+		Gaze::Scene::Skeleton& outSkeleton,
+		std::vector<Gaze::Scene::AnimationClip>& outAnimations
+	) -> bool
 	{
 		if (!scene->HasMeshes()) {
 			return false;
 		}
 
-		ProcessNode(scene->mRootNode, scene, outMeshes);
+		ProcessNode(scene->mRootNode, -1, outNodes);
+
+		// Skin weights refer to joints by index, so the skeleton comes before the meshes
+		outSkeleton = ProcessSkeleton(scene, outNodes);
+		if (outSkeleton.Size() > std::numeric_limits<U16>::max()) {
+			return false;
+		}
+
+		// Meshes are converted once, however many nodes instance them
+		outMeshes.reserve(scene->mNumMeshes);
+		for (auto i = 0U; i < scene->mNumMeshes; ++i) {
+			outMeshes.push_back(ProcessMesh(scene->mMeshes[i], outSkeleton));
+		}
+
+		outAnimations.reserve(scene->mNumAnimations);
+		for (auto i = 0U; i < scene->mNumAnimations; ++i) {
+			outAnimations.push_back(ProcessAnimation(scene->mAnimations[i], outSkeleton));
+		}
+
 		return true;
 	}
 
@@ -84,6 +282,7 @@ namespace Gaze::IO::Loader {
 			aiProcess_Triangulate |
 			aiProcess_JoinIdenticalVertices |
 			aiProcess_SortByPType |
+			aiProcess_LimitBoneWeights |
 			aiProcess_ValidateDataStructure
 		);
 
@@ -92,6 +291,6 @@ namespace Gaze::IO::Loader {
 			return false;
 		}
 
-		return ProcessScene(scene, m_Meshes);
+		return ProcessScene(scene, m_Meshes, m_Nodes, m_Skeleton, m_Animations);
 	}
 }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gaze::Jobs {
+	/**
+	 * @brief A fixed set of worker threads running jobs from a shared queue
+	 *
+	 * Threads that wait on the pool (ParallelFor(), Wait()) run queued jobs
+	 * themselves while waiting, so jobs may safely wait on other jobs.
+	 */
+	class ThreadPool
+	{
+	public:
+		/**
+		 * @brief Range callback used by ParallelFor()
+		 *
+		 * Called with a half-open range [begin, end).
+		 */
+		using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+	public:
+		/**
+		 * @brief Start the pool
+		 *
+		 * @param nWorkers The number of worker threads. The thread calling
+		 *                 ParallelFor() takes part in the work as well, so the
+		 *                 default leaves one hardware thread for it.
+		 */
+		explicit ThreadPool(U32 nWorkers = DefaultWorkerCount());
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		~ThreadPool();
+
+		auto operator=(const ThreadPool&) = delete;
+		auto operator=(ThreadPool&&) = delete;
+
+		/**
+		 * @brief Queue a job
+		 *
+		 * @param job The job to run
+		 *
+		 * @return A future that becomes ready once the job has run
+		 */
+		auto Submit(std::function<void()> job) -> std::future<void>;
+		/**
+		 * @brief Wait for a future returned by Submit(), running queued jobs in the meantime
+		 *
+		 * @param future The future to wait for
+		 */
+		auto Wait(const std::future<void>& future) -> void;
+		/**
+		 * @brief Split [0, count) into chunks and process them in parallel
+		 *
+		 * Blocks until every chunk is processed. Runs inline when the range
+		 * fits in a single chunk.
+		 *
+		 * @param count The size of the range
+		 * @param grainSize The minimum number of elements per chunk
+		 * @param fn The function processing a chunk
+		 */
+		auto ParallelFor(std::size_t count, std::size_t grainSize, const RangeFn& fn) -> void;
+
+		[[nodiscard]] auto WorkerCount() const noexcept -> U32;
+
+		/**
+		 * @brief The worker count used by default: one less than the number of hardware threads, at least 1
+		 */
+		[[nodiscard]] static auto DefaultWorkerCount() noexcept -> U32;
+
+	private:
+		auto WorkerLoop(std::stop_token stopToken) -> void;
+		auto TryRunOne()                           -> bool;
+
+	private:
+		std::mutex                        m_Mutex;
+		std::condition_variable_any       m_CV;
+		std::deque<std::function<void()>> m_Queue;
+		std::vector<std::jthread>         m_Workers;
+	};
+
+	inline auto ThreadPool::WorkerCount() const noexcept -> U32
+	{
+		return U32(m_Workers.size());
+	}
+}
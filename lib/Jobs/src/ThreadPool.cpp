@@ -0,0 +1,129 @@
+#include "Jobs/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Gaze::Jobs {
+	ThreadPool::ThreadPool(U32 nWorkers)
+	{
+		m_Workers.reserve(nWorkers);
+		for (auto i = 0U; i < nWorkers; i++) {
+			m_Workers.emplace_back([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		for (auto& worker : m_Workers) {
+			worker.request_stop();
+		}
+		m_CV.notify_all();
+		m_Workers.clear(); // Joins
+	}
+
+	auto ThreadPool::Submit(std::function<void()> job) -> std::future<void>
+	{
+		auto task   = MakeShared<std::packaged_task<void()>>(std::move(job));
+		auto future = task->get_future();
+
+		{
+			auto lock = std::scoped_lock(m_Mutex);
+			m_Queue.emplace_back([task = std::move(task)] { (*task)(); });
+		}
+		m_CV.notify_one();
+
+		return future;
+	}
+
+	auto ThreadPool::Wait(const std::future<void>& future) -> void
+	{
+		while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			if (!TryRunOne()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	auto ThreadPool::ParallelFor(std::size_t count, std::size_t grainSize, const RangeFn& fn) -> void
+	{
+		grainSize = std::max(grainSize, std::size_t(1));
+
+		const auto nChunks = (count + grainSize - 1) / grainSize;
+		if (nChunks <= 1 || m_Workers.empty()) {
+			if (count > 0) {
+				fn(0, count);
+			}
+			return;
+		}
+
+		auto nextChunk = std::atomic<std::size_t>(0);
+		auto nDone     = std::atomic<std::size_t>(0);
+
+		const auto work = [&] {
+			for (auto chunk = nextChunk++; chunk < nChunks; chunk = nextChunk++) {
+				const auto begin = chunk * grainSize;
+				fn(begin, std::min(begin + grainSize, count));
+			}
+		};
+
+		// Helpers reference this stack frame, so all of them must have
+		// finished before returning, even those that found no work left.
+		const auto nHelpers = std::min(nChunks - 1, m_Workers.size());
+		{
+			auto lock = std::scoped_lock(m_Mutex);
+			for (auto i = 0UL; i < nHelpers; i++) {
+				m_Queue.emplace_back([&] { work(); nDone++; });
+			}
+		}
+		m_CV.notify_all();
+
+		work();
+		while (nDone.load() < nHelpers) {
+			if (!TryRunOne()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	auto ThreadPool::DefaultWorkerCount() noexcept -> U32
+	{
+		return std::max(std::thread::hardware_concurrency(), 2U) - 1;
+	}
+
+	auto ThreadPool::WorkerLoop(std::stop_token stopToken) -> void
+	{
+		while (true) {
+			auto job = std::function<void()>();
+
+			{
+				auto lock = std::unique_lock(m_Mutex);
+				if (!m_CV.wait(lock, stopToken, [this] { return !m_Queue.empty(); })) {
+					return; // Stop requested
+				}
+
+				job = std::move(m_Queue.front());
+				m_Queue.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	auto ThreadPool::TryRunOne() -> bool
+	{
+		auto job = std::function<void()>();
+
+		{
+			auto lock = std::scoped_lock(m_Mutex);
+			if (m_Queue.empty()) {
+				return false;
+			}
+
+			job = std::move(m_Queue.front());
+			m_Queue.pop_front();
+		}
+
+		job();
+		return true;
+	}
+}
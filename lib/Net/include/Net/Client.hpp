@@ -12,6 +12,18 @@ namespace Gaze::Net {
 	{
 		struct Impl;
 
+	public:
+		/**
+		 * @brief Statistics of the connection to the server
+		 */
+		struct Stats
+		{
+			U32 roundTripMs   = 0;   /**< Mean round trip time */
+			F32 packetLoss    = 0.F; /**< Fraction of reliable packets lost, between 0 and 1 */
+			U64 bytesSent     = 0;   /**< Since the client was created */
+			U64 bytesReceived = 0;   /**< Since the client was created */
+		};
+
 	public:
 		Client();
 		~Client();
@@ -28,6 +40,9 @@ namespace Gaze::Net {
 
 		auto OnPacketReceived(PacketReceivedCallback callback) -> void;
 
+		[[nodiscard]]
+		auto GetStats() const -> Stats;
+
 	private:
 		Impl* m_pImpl;
 	};
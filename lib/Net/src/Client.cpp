@@ -131,4 +131,16 @@ namespace Gaze::Net {
 	{
 		m_pImpl->cbPacketReceived = std::move(callback);
 	}
+
+	auto Client::GetStats() const -> Stats
+	{
+		const auto& peer = m_pImpl->host->peers[0];
+
+		return {
+			.roundTripMs   = peer.roundTripTime,
+			.packetLoss    = F32(peer.packetLoss) / F32(ENET_PEER_PACKET_LOSS_SCALE),
+			.bytesSent     = m_pImpl->host->totalSentData,
+			.bytesReceived = m_pImpl->host->totalReceivedData,
+		};
+	}
 }
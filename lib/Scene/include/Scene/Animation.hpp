@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Scene/Skeleton.hpp"
+
+#include "Core/Type.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Gaze::Scene {
+	/**
+	 * @brief Keyframed joint transforms over time
+	 */
+	struct AnimationClip
+	{
+		template<typename T>
+		struct Track
+		{
+			std::vector<F32> times;  /**< In seconds, increasing */
+			std::vector<T>   values; /**< One per time */
+		};
+
+		/**
+		 * @brief The keys of one joint. Components without keys keep the joint's rest transform.
+		 */
+		struct Channel
+		{
+			I32              joint; /**< Index into the skeleton's joints */
+			Track<glm::vec3> positions;
+			Track<glm::quat> rotations;
+			Track<glm::vec3> scales;
+		};
+
+		std::string          name;
+		F32                  duration; /**< In seconds */
+		std::vector<Channel> channels;
+	};
+
+	/**
+	 * @brief Local transforms of every joint of a skeleton, stored as structure-of-arrays
+	 *
+	 * Each component (position x, y, z, rotation x, y, z, w, scale x, y, z)
+	 * is a separate array padded to a multiple of 4 joints, so that poses
+	 * are blended 4 joints at a time with SIMD.
+	 */
+	class Pose
+	{
+	public:
+		explicit Pose(std::size_t nJoints = 0);
+
+		/**
+		 * @brief Resize the pose. Added joints get an identity transform.
+		 */
+		auto Resize(std::size_t nJoints) -> void;
+		/**
+		 * @brief Set every joint to the skeleton's rest transform, resizing the pose to match.
+		 */
+		auto SetRest(const Skeleton& skeleton) -> void;
+		/**
+		 * @brief Overwrite the joints animated by a clip with its keys at the given time.
+		 *
+		 * Keys are interpolated linearly, rotations along the shortest arc and
+		 * renormalized, which is close enough to slerp for typical key rates.
+		 *
+		 * @param clip The clip to sample. Its joints must exist in the pose.
+		 * @param time The time to sample at, in seconds. Wraps around the clip's duration.
+		 */
+		auto Sample(const AnimationClip& clip, F32 time) noexcept -> void;
+		/**
+		 * @brief Blend towards another pose of the same size.
+		 *
+		 * @param other The pose to blend towards.
+		 * @param weight 0 keeps this pose, 1 replaces it with @p other.
+		 */
+		auto Blend(const Pose& other, F32 weight) noexcept -> void;
+		/**
+		 * @brief Compute the skinning matrices of the pose.
+		 *
+		 * @param skeleton The skeleton the pose is for.
+		 * @param palette Receives one matrix per joint, taking bind pose vertices to the posed mesh space.
+		 */
+		auto ComputePalette(const Skeleton& skeleton, std::span<glm::mat4> palette) const noexcept -> void;
+
+		auto SetJoint(
+			std::size_t joint,
+			const glm::vec3& position,
+			const glm::quat& rotation,
+			const glm::vec3& scale
+		) noexcept -> void;
+
+		[[nodiscard]] auto Position(std::size_t joint) const noexcept -> glm::vec3;
+		[[nodiscard]] auto Rotation(std::size_t joint) const noexcept -> glm::quat;
+		[[nodiscard]] auto Scale(std::size_t joint)    const noexcept -> glm::vec3;
+		[[nodiscard]] auto Size()                      const noexcept -> std::size_t;
+
+	private:
+		enum Component : std::size_t
+		{
+			kPositionX,
+			kPositionY,
+			kPositionZ,
+			kRotationX,
+			kRotationY,
+			kRotationZ,
+			kRotationW,
+			kScaleX,
+			kScaleY,
+			kScaleZ,
+
+			kComponentCount,
+		};
+
+		[[nodiscard]] auto Lane(Component component)       noexcept -> F32*;
+		[[nodiscard]] auto Lane(Component component) const noexcept -> const F32*;
+
+	private:
+		std::size_t      m_Size   = 0;
+		std::size_t      m_Stride = 0; /**< Joints per component array, padding included */
+		std::vector<F32> m_Data;
+	};
+
+	/**
+	 * @brief Blends clips into skinning matrices for one skeleton
+	 *
+	 * Keeps the scratch poses around between calls, so evaluating a pose
+	 * every frame does not allocate. Not thread-safe: animate crowds in
+	 * parallel with one sampler per character.
+	 */
+	class AnimationSampler
+	{
+	public:
+		struct Layer
+		{
+			const AnimationClip* clip;
+			F32                  time;   /**< In seconds, see Pose::Sample() */
+			F32                  weight; /**< Relative to the other layers; layers weighing 0 or less are skipped */
+		};
+
+	public:
+		explicit AnimationSampler(const Skeleton& skeleton);
+
+		/**
+		 * @brief Blend the layers' poses, weighted, and compute the resulting skinning matrices.
+		 *
+		 * Without any layer the skeleton's rest pose is used.
+		 *
+		 * @param palette Receives one matrix per joint of the skeleton.
+		 */
+		auto Evaluate(std::span<const Layer> layers, std::span<glm::mat4> palette) -> void;
+
+		/**
+		 * @brief Get the pose blended by the last Evaluate().
+		 */
+		[[nodiscard]] auto GetPose()     const noexcept -> const Pose&;
+		[[nodiscard]] auto GetSkeleton() const noexcept -> const Skeleton&;
+
+	private:
+		const Skeleton* m_Skeleton;
+		Pose            m_Rest;
+		Pose            m_Pose;
+		Pose            m_Layer;
+	};
+
+	inline auto Pose::Size() const noexcept -> std::size_t
+	{
+		return m_Size;
+	}
+
+	inline auto Pose::Lane(Component component) noexcept -> F32*
+	{
+		return m_Data.data() + component * m_Stride;
+	}
+
+	inline auto Pose::Lane(Component component) const noexcept -> const F32*
+	{
+		return m_Data.data() + component * m_Stride;
+	}
+
+	inline auto AnimationSampler::GetPose() const noexcept -> const Pose&
+	{
+		return m_Pose;
+	}
+
+	inline auto AnimationSampler::GetSkeleton() const noexcept -> const Skeleton&
+	{
+		return *m_Skeleton;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Gaze::Scene {
+	/**
+	 * @brief The joint hierarchy a skinned mesh is bound to
+	 *
+	 * Joints are sorted parents first, so a single forward pass computes
+	 * their model-space transforms. Skin weights refer to joints by index.
+	 */
+	struct Skeleton
+	{
+		struct Joint
+		{
+			std::string name;
+			I32         parent;      /**< Index of the parent joint, -1 for a root. Always lower than the joint's own index */
+			glm::mat4   inverseBind; /**< From the mesh's bind pose space to the joint's space */
+			glm::vec3   position;    /**< Rest local transform, relative to the parent. Used where no clip animates the joint */
+			glm::quat   rotation;
+			glm::vec3   scale;
+		};
+
+		std::vector<Joint> joints;
+
+		/**
+		 * @brief Find a joint by name.
+		 *
+		 * @return The joint's index, or -1 if there is no such joint.
+		 */
+		[[nodiscard]] auto FindJoint(std::string_view name) const noexcept -> I32;
+		[[nodiscard]] auto Size()                           const noexcept -> std::size_t;
+	};
+
+	inline auto Skeleton::Size() const noexcept -> std::size_t
+	{
+		return joints.size();
+	}
+}
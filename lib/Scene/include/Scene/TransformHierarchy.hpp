@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/Type.hpp"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Gaze::Jobs {
+	class ThreadPool;
+}
+
+namespace Gaze::Scene {
+	/**
+	 * @brief Parent/child transforms, stored as structure-of-arrays
+	 *
+	 * Every node has a local translation/rotation/scale relative to its parent
+	 * and a world matrix computed by Update(). Nodes are kept sorted
+	 * breadth-first, so parents always come before their children and nodes
+	 * at the same depth are contiguous. Update() walks the nodes one depth
+	 * level at a time and only recomputes nodes whose local transform, or an
+	 * ancestor's, changed since the last update. Large levels are split across
+	 * a thread pool.
+	 *
+	 * Nodes are referred to by stable IDs; their position in the arrays may
+	 * change whenever the hierarchy is re-sorted.
+	 */
+	class TransformHierarchy
+	{
+	public:
+		using NodeID = U32;
+
+		static constexpr auto kInvalidNode = std::numeric_limits<NodeID>::max();
+
+	public:
+		/**
+		 * @brief Create a node with an identity local transform.
+		 *
+		 * @param parent The parent node, or kInvalidNode for a root node.
+		 *
+		 * @return The new node's ID.
+		 */
+		auto Create(NodeID parent = kInvalidNode) -> NodeID;
+		/**
+		 * @brief Destroy a node and all of its descendants.
+		 *
+		 * @param node The node to destroy.
+		 */
+		auto Destroy(NodeID node) -> void;
+		/**
+		 * @brief Re-parent a node, keeping its local transform.
+		 *
+		 * @param node The node to move.
+		 * @param parent The new parent, or kInvalidNode to make it a root. Must not be a descendant of @p node.
+		 */
+		auto SetParent(NodeID node, NodeID parent) -> void;
+
+		auto SetPosition(NodeID node, const glm::vec3& position) -> void;
+		auto SetRotation(NodeID node, const glm::quat& rotation) -> void;
+		auto SetScale(NodeID node, const glm::vec3& scale)       -> void;
+		/**
+		 * @brief Set a node's whole local transform at once.
+		 */
+		auto SetLocal(
+			NodeID node,
+			const glm::vec3& position,
+			const glm::quat& rotation,
+			const glm::vec3& scale
+		) -> void;
+
+		[[nodiscard]] auto Parent(NodeID node)   const noexcept -> NodeID;
+		[[nodiscard]] auto Position(NodeID node) const noexcept -> const glm::vec3&;
+		[[nodiscard]] auto Rotation(NodeID node) const noexcept -> const glm::quat&;
+		[[nodiscard]] auto Scale(NodeID node)    const noexcept -> const glm::vec3&;
+		/**
+		 * @brief Get a node's world matrix, as of the last Update().
+		 */
+		[[nodiscard]] auto World(NodeID node)    const noexcept -> const glm::mat4&;
+		/**
+		 * @brief Check whether the last Update() recomputed the node's world matrix.
+		 */
+		[[nodiscard]] auto HasChanged(NodeID node) const noexcept -> bool;
+
+		/**
+		 * @brief Recompute the world matrices of all nodes affected by a change.
+		 *
+		 * @param pool If not null, levels with many dirty candidates are processed in parallel on it.
+		 */
+		auto Update(Jobs::ThreadPool* pool = nullptr) -> void;
+
+		/**
+		 * @brief Get all world matrices, in hierarchy order.
+		 *
+		 * Only valid until the next structural change (Create(), Destroy(), SetParent()).
+		 */
+		[[nodiscard]] auto WorldMatrices() const noexcept -> std::span<const glm::mat4>;
+		/**
+		 * @brief Get the IDs of all nodes, in the same order as WorldMatrices().
+		 */
+		[[nodiscard]] auto Nodes()         const noexcept -> std::span<const NodeID>;
+		[[nodiscard]] auto Size()          const noexcept -> std::size_t;
+
+	private:
+		using Index = U32;
+
+		static constexpr auto kInvalidIndex      = std::numeric_limits<Index>::max();
+		static constexpr auto kParallelGrainSize = std::size_t(1024);
+
+		[[nodiscard]] auto IndexOf(NodeID node) const noexcept -> Index;
+
+		auto Sort()                                          -> void;
+		auto UpdateRange(std::size_t begin, std::size_t end) noexcept -> void;
+
+	private:
+		// Per node, indexed by position in the hierarchy
+		std::vector<NodeID>      m_IDs;
+		std::vector<Index>       m_Parents;
+		std::vector<glm::vec3>   m_Positions;
+		std::vector<glm::quat>   m_Rotations;
+		std::vector<glm::vec3>   m_Scales;
+		std::vector<glm::mat4>   m_World;
+		std::vector<U8>          m_Dirty;
+		std::vector<U8>          m_Changed;
+		std::vector<U8>          m_Destroyed;
+
+		std::vector<std::size_t> m_LevelOffsets; /**< Start of each depth level, plus one past the end */
+		std::vector<Index>       m_Indices;      /**< NodeID -> index, kInvalidIndex if free */
+		std::vector<NodeID>      m_FreeIDs;
+		bool                     m_NeedsSort = false;
+	};
+
+	inline auto TransformHierarchy::WorldMatrices() const noexcept -> std::span<const glm::mat4>
+	{
+		return m_World;
+	}
+
+	inline auto TransformHierarchy::Nodes() const noexcept -> std::span<const NodeID>
+	{
+		return m_IDs;
+	}
+
+	inline auto TransformHierarchy::Size() const noexcept -> std::size_t
+	{
+		return m_IDs.size();
+	}
+}
@@ -0,0 +1,332 @@
+#include "Scene/Animation.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define GAZE_ANIMATION_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Gaze::Scene {
+	namespace {
+		/**
+		 * @brief The two keys surrounding a time, and how far between them it is.
+		 */
+		struct KeyPair
+		{
+			std::size_t first;
+			std::size_t second;
+			F32         t;
+		};
+
+		auto FindKeys(const std::vector<F32>& times, F32 time) noexcept -> KeyPair
+		{
+			const auto next = std::upper_bound(times.cbegin(), times.cend(), time);
+			if (next == times.cbegin()) {
+				return { 0, 0, 0.F };
+			}
+			if (next == times.cend()) {
+				return { times.size() - 1, times.size() - 1, 0.F };
+			}
+
+			const auto second = std::size_t(std::distance(times.cbegin(), next));
+			const auto first  = second - 1;
+			const auto span   = times[second] - times[first];
+
+			return { first, second, span > 0.F ? (time - times[first]) / span : 0.F };
+		}
+
+		auto Nlerp(const glm::quat& a, glm::quat b, F32 t) noexcept -> glm::quat
+		{
+			// Flip to the same hemisphere, so the blend takes the shortest arc
+			if (glm::dot(a, b) < 0.F) {
+				b = -b;
+			}
+
+			return glm::normalize(glm::quat(
+				a.w + (b.w - a.w) * t,
+				a.x + (b.x - a.x) * t,
+				a.y + (b.y - a.y) * t,
+				a.z + (b.z - a.z) * t
+			));
+		}
+
+		auto SampleTrack(const AnimationClip::Track<glm::vec3>& track, F32 time) noexcept -> glm::vec3
+		{
+			const auto keys = FindKeys(track.times, time);
+
+			return glm::mix(track.values[keys.first], track.values[keys.second], keys.t);
+		}
+
+		auto SampleTrack(const AnimationClip::Track<glm::quat>& track, F32 time) noexcept -> glm::quat
+		{
+			const auto keys = FindKeys(track.times, time);
+
+			return Nlerp(track.values[keys.first], track.values[keys.second], keys.t);
+		}
+	}
+
+	Pose::Pose(std::size_t nJoints)
+	{
+		Resize(nJoints);
+	}
+
+	auto Pose::Resize(std::size_t nJoints) -> void
+	{
+		const auto stride = (nJoints + 3) & ~std::size_t(3);
+
+		// Padding lanes hold identity transforms too, so that blending them is harmless
+		auto data = std::vector<F32>(kComponentCount * stride, 0.F);
+		std::fill_n(data.begin() + std::ptrdiff_t(kRotationW * stride), stride, 1.F);
+		std::fill(data.begin() + std::ptrdiff_t(kScaleX * stride), data.end(), 1.F);
+
+		for (auto c = std::size_t(0); c < kComponentCount; c++) {
+			const auto* src = m_Data.data() + c * m_Stride;
+			std::copy_n(src, std::min(m_Size, nJoints), data.begin() + std::ptrdiff_t(c * stride));
+		}
+
+		m_Data   = std::move(data);
+		m_Size   = nJoints;
+		m_Stride = stride;
+	}
+
+	auto Pose::SetRest(const Skeleton& skeleton) -> void
+	{
+		if (m_Size != skeleton.Size()) {
+			Resize(skeleton.Size());
+		}
+
+		for (auto i = std::size_t(0); i < skeleton.Size(); i++) {
+			const auto& joint = skeleton.joints[i];
+
+			SetJoint(i, joint.position, joint.rotation, joint.scale);
+		}
+	}
+
+	auto Pose::Sample(const AnimationClip& clip, F32 time) noexcept -> void
+	{
+		if (clip.duration > 0.F) {
+			time = std::fmod(time, clip.duration);
+			if (time < 0.F) {
+				time += clip.duration;
+			}
+		}
+
+		for (const auto& channel : clip.channels) {
+			GAZE_ASSERT(channel.joint >= 0 && std::size_t(channel.joint) < m_Size, "Clip animates a joint the pose does not have");
+
+			const auto joint = std::size_t(channel.joint);
+
+			if (!channel.positions.times.empty()) {
+				const auto position = SampleTrack(channel.positions, time);
+
+				Lane(kPositionX)[joint] = position.x;
+				Lane(kPositionY)[joint] = position.y;
+				Lane(kPositionZ)[joint] = position.z;
+			}
+			if (!channel.rotations.times.empty()) {
+				const auto rotation = SampleTrack(channel.rotations, time);
+
+				Lane(kRotationX)[joint] = rotation.x;
+				Lane(kRotationY)[joint] = rotation.y;
+				Lane(kRotationZ)[joint] = rotation.z;
+				Lane(kRotationW)[joint] = rotation.w;
+			}
+			if (!channel.scales.times.empty()) {
+				const auto scale = SampleTrack(channel.scales, time);
+
+				Lane(kScaleX)[joint] = scale.x;
+				Lane(kScaleY)[joint] = scale.y;
+				Lane(kScaleZ)[joint] = scale.z;
+			}
+		}
+	}
+
+	auto Pose::Blend(const Pose& other, F32 weight) noexcept -> void
+	{
+		GAZE_ASSERT(other.m_Size == m_Size, "Blended poses must have the same joints");
+
+		// Positions and scales are each a contiguous run of 3 component arrays, lerped as plain floats
+		auto* positions            = Lane(kPositionX);
+		auto* scales               = Lane(kScaleX);
+		const auto* otherPositions = other.Lane(kPositionX);
+		const auto* otherScales    = other.Lane(kScaleX);
+		const auto  nLinear        = 3 * m_Stride;
+
+		auto* rx = Lane(kRotationX);
+		auto* ry = Lane(kRotationY);
+		auto* rz = Lane(kRotationZ);
+		auto* rw = Lane(kRotationW);
+		const auto* ox = other.Lane(kRotationX);
+		const auto* oy = other.Lane(kRotationY);
+		const auto* oz = other.Lane(kRotationZ);
+		const auto* ow = other.Lane(kRotationW);
+
+#if defined(GAZE_ANIMATION_SSE)
+		const auto w = _mm_set1_ps(weight);
+
+		const auto lerp = [w](F32* a, const F32* b) {
+			const auto va = _mm_loadu_ps(a);
+			_mm_storeu_ps(a, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), va), w)));
+		};
+		for (auto i = std::size_t(0); i < nLinear; i += 4) {
+			lerp(positions + i, otherPositions + i);
+			lerp(scales + i, otherScales + i);
+		}
+
+		const auto signBit = _mm_set1_ps(-0.F);
+		const auto one     = _mm_set1_ps(1.F);
+		for (auto i = std::size_t(0); i < m_Stride; i += 4) {
+			const auto ax = _mm_loadu_ps(rx + i);
+			const auto ay = _mm_loadu_ps(ry + i);
+			const auto az = _mm_loadu_ps(rz + i);
+			const auto aw = _mm_loadu_ps(rw + i);
+			auto bx = _mm_loadu_ps(ox + i);
+			auto by = _mm_loadu_ps(oy + i);
+			auto bz = _mm_loadu_ps(oz + i);
+			auto bw = _mm_loadu_ps(ow + i);
+
+			// Flip the other rotation where the dot product is negative, to take the shortest arc
+			const auto dot = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+				_mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw))
+			);
+			const auto flip = _mm_and_ps(dot, signBit);
+			bx = _mm_xor_ps(bx, flip);
+			by = _mm_xor_ps(by, flip);
+			bz = _mm_xor_ps(bz, flip);
+			bw = _mm_xor_ps(bw, flip);
+
+			const auto x = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), w));
+			const auto y = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), w));
+			const auto z = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), w));
+			const auto s = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), w));
+
+			const auto length2 = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+				_mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(s, s))
+			);
+			const auto invLength = _mm_div_ps(one, _mm_sqrt_ps(length2));
+
+			_mm_storeu_ps(rx + i, _mm_mul_ps(x, invLength));
+			_mm_storeu_ps(ry + i, _mm_mul_ps(y, invLength));
+			_mm_storeu_ps(rz + i, _mm_mul_ps(z, invLength));
+			_mm_storeu_ps(rw + i, _mm_mul_ps(s, invLength));
+		}
+#else
+		for (auto i = std::size_t(0); i < nLinear; i++) {
+			positions[i] += (otherPositions[i] - positions[i]) * weight;
+			scales[i]    += (otherScales[i] - scales[i]) * weight;
+		}
+
+		for (auto i = std::size_t(0); i < m_Stride; i++) {
+			const auto rotation = Nlerp(glm::quat(rw[i], rx[i], ry[i], rz[i]), glm::quat(ow[i], ox[i], oy[i], oz[i]), weight);
+
+			rx[i] = rotation.x;
+			ry[i] = rotation.y;
+			rz[i] = rotation.z;
+			rw[i] = rotation.w;
+		}
+#endif
+	}
+
+	auto Pose::ComputePalette(const Skeleton& skeleton, std::span<glm::mat4> palette) const noexcept -> void
+	{
+		GAZE_ASSERT(skeleton.Size() == m_Size, "The pose does not match the skeleton");
+		GAZE_ASSERT(palette.size() >= m_Size, "The palette is too small for the skeleton");
+
+		// Model-space joint transforms first; parents come first, so they are ready for their children
+		for (auto i = std::size_t(0); i < m_Size; i++) {
+			const auto parent = skeleton.joints[i].parent;
+
+			auto local = glm::mat4_cast(Rotation(i));
+			local[0] *= Lane(kScaleX)[i];
+			local[1] *= Lane(kScaleY)[i];
+			local[2] *= Lane(kScaleZ)[i];
+			local[3]  = glm::vec4(Position(i), 1.F);
+
+			palette[i] = parent < 0 ? local : palette[std::size_t(parent)] * local;
+		}
+
+		for (auto i = std::size_t(0); i < m_Size; i++) {
+			palette[i] = palette[i] * skeleton.joints[i].inverseBind;
+		}
+	}
+
+	auto Pose::SetJoint(
+		std::size_t joint,
+		const glm::vec3& position,
+		const glm::quat& rotation,
+		const glm::vec3& scale
+	) noexcept -> void
+	{
+		GAZE_ASSERT(joint < m_Size, "Invalid joint");
+
+		Lane(kPositionX)[joint] = position.x;
+		Lane(kPositionY)[joint] = position.y;
+		Lane(kPositionZ)[joint] = position.z;
+		Lane(kRotationX)[joint] = rotation.x;
+		Lane(kRotationY)[joint] = rotation.y;
+		Lane(kRotationZ)[joint] = rotation.z;
+		Lane(kRotationW)[joint] = rotation.w;
+		Lane(kScaleX)[joint]    = scale.x;
+		Lane(kScaleY)[joint]    = scale.y;
+		Lane(kScaleZ)[joint]    = scale.z;
+	}
+
+	auto Pose::Position(std::size_t joint) const noexcept -> glm::vec3
+	{
+		return { Lane(kPositionX)[joint], Lane(kPositionY)[joint], Lane(kPositionZ)[joint] };
+	}
+
+	auto Pose::Rotation(std::size_t joint) const noexcept -> glm::quat
+	{
+		return { Lane(kRotationW)[joint], Lane(kRotationX)[joint], Lane(kRotationY)[joint], Lane(kRotationZ)[joint] };
+	}
+
+	auto Pose::Scale(std::size_t joint) const noexcept -> glm::vec3
+	{
+		return { Lane(kScaleX)[joint], Lane(kScaleY)[joint], Lane(kScaleZ)[joint] };
+	}
+
+	AnimationSampler::AnimationSampler(const Skeleton& skeleton)
+		: m_Skeleton(&skeleton)
+	{
+		m_Rest.SetRest(skeleton);
+		m_Pose  = m_Rest;
+		m_Layer = m_Rest;
+	}
+
+	auto AnimationSampler::Evaluate(std::span<const Layer> layers, std::span<glm::mat4> palette) -> void
+	{
+		m_Pose = m_Rest;
+
+		// Running weighted average: each layer is blended in by its share of the weight so far
+		auto totalWeight = 0.F;
+		for (const auto& layer : layers) {
+			if (layer.weight <= 0.F || layer.clip == nullptr) {
+				continue;
+			}
+
+			if (totalWeight <= 0.F) {
+				m_Pose.Sample(*layer.clip, layer.time);
+				totalWeight = layer.weight;
+				continue;
+			}
+
+			m_Layer = m_Rest;
+			m_Layer.Sample(*layer.clip, layer.time);
+
+			totalWeight += layer.weight;
+			m_Pose.Blend(m_Layer, layer.weight / totalWeight);
+		}
+
+		m_Pose.ComputePalette(*m_Skeleton, palette);
+	}
+}
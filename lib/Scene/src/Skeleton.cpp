@@ -0,0 +1,14 @@
+#include "Scene/Skeleton.hpp"
+
+#include <algorithm>
+
+namespace Gaze::Scene {
+	auto Skeleton::FindJoint(std::string_view name) const noexcept -> I32
+	{
+		const auto it = std::find_if(joints.cbegin(), joints.cend(), [name](const Joint& joint) {
+			return joint.name == name;
+		});
+
+		return it != joints.cend() ? I32(std::distance(joints.cbegin(), it)) : -1;
+	}
+}
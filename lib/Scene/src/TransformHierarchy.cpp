@@ -0,0 +1,275 @@
+#include "Scene/TransformHierarchy.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include "Debug/Assert.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Gaze::Scene {
+	auto TransformHierarchy::Create(NodeID parent) -> NodeID
+	{
+		const auto parentIdx = parent == kInvalidNode ? kInvalidIndex : IndexOf(parent);
+		GAZE_ASSERT(parent == kInvalidNode || parentIdx != kInvalidIndex, "Invalid parent node");
+
+		auto id = kInvalidNode;
+		if (m_FreeIDs.empty()) {
+			id = NodeID(m_Indices.size());
+			m_Indices.push_back(kInvalidIndex);
+		} else {
+			id = m_FreeIDs.back();
+			m_FreeIDs.pop_back();
+		}
+
+		m_Indices[id] = Index(m_IDs.size());
+
+		m_IDs.push_back(id);
+		m_Parents.push_back(parentIdx);
+		m_Positions.emplace_back(.0F);
+		m_Rotations.emplace_back(1.F, .0F, .0F, .0F);
+		m_Scales.emplace_back(1.F);
+		m_World.emplace_back(1.F);
+		m_Dirty.push_back(1);
+		m_Changed.push_back(0);
+		m_Destroyed.push_back(0);
+
+		// Appending keeps parents first, but not the level grouping
+		m_NeedsSort = true;
+
+		return id;
+	}
+
+	auto TransformHierarchy::Destroy(NodeID node) -> void
+	{
+		const auto idx = IndexOf(node);
+		GAZE_ASSERT(idx != kInvalidIndex, "Invalid node");
+
+		// Descendants are dropped along with it when sorting
+		m_Destroyed[idx] = 1;
+		m_NeedsSort = true;
+	}
+
+	auto TransformHierarchy::SetParent(NodeID node, NodeID parent) -> void
+	{
+		const auto idx       = IndexOf(node);
+		const auto parentIdx = parent == kInvalidNode ? kInvalidIndex : IndexOf(parent);
+		GAZE_ASSERT(idx != kInvalidIndex, "Invalid node");
+		GAZE_ASSERT(parent == kInvalidNode || parentIdx != kInvalidIndex, "Invalid parent node");
+
+		for (auto ancestor = parentIdx; ancestor != kInvalidIndex; ancestor = m_Parents[ancestor]) {
+			GAZE_ASSERT(ancestor != idx, "A node cannot be parented to one of its descendants");
+		}
+
+		m_Parents[idx] = parentIdx;
+		m_Dirty[idx]   = 1;
+		m_NeedsSort    = true;
+	}
+
+	auto TransformHierarchy::SetPosition(NodeID node, const glm::vec3& position) -> void
+	{
+		const auto idx = IndexOf(node);
+
+		m_Positions[idx] = position;
+		m_Dirty[idx]     = 1;
+	}
+
+	auto TransformHierarchy::SetRotation(NodeID node, const glm::quat& rotation) -> void
+	{
+		const auto idx = IndexOf(node);
+
+		m_Rotations[idx] = rotation;
+		m_Dirty[idx]     = 1;
+	}
+
+	auto TransformHierarchy::SetScale(NodeID node, const glm::vec3& scale) -> void
+	{
+		const auto idx = IndexOf(node);
+
+		m_Scales[idx] = scale;
+		m_Dirty[idx]  = 1;
+	}
+
+	auto TransformHierarchy::SetLocal(
+		NodeID node,
+		const glm::vec3& position,
+		const glm::quat& rotation,
+		const glm::vec3& scale
+	) -> void
+	{
+		const auto idx = IndexOf(node);
+
+		m_Positions[idx] = position;
+		m_Rotations[idx] = rotation;
+		m_Scales[idx]    = scale;
+		m_Dirty[idx]     = 1;
+	}
+
+	auto TransformHierarchy::Parent(NodeID node) const noexcept -> NodeID
+	{
+		const auto parentIdx = m_Parents[IndexOf(node)];
+		return parentIdx == kInvalidIndex ? kInvalidNode : m_IDs[parentIdx];
+	}
+
+	auto TransformHierarchy::Position(NodeID node) const noexcept -> const glm::vec3&
+	{
+		return m_Positions[IndexOf(node)];
+	}
+
+	auto TransformHierarchy::Rotation(NodeID node) const noexcept -> const glm::quat&
+	{
+		return m_Rotations[IndexOf(node)];
+	}
+
+	auto TransformHierarchy::Scale(NodeID node) const noexcept -> const glm::vec3&
+	{
+		return m_Scales[IndexOf(node)];
+	}
+
+	auto TransformHierarchy::World(NodeID node) const noexcept -> const glm::mat4&
+	{
+		return m_World[IndexOf(node)];
+	}
+
+	auto TransformHierarchy::HasChanged(NodeID node) const noexcept -> bool
+	{
+		return m_Changed[IndexOf(node)] != 0;
+	}
+
+	auto TransformHierarchy::Update(Jobs::ThreadPool* pool) -> void
+	{
+		if (m_NeedsSort) {
+			Sort();
+		}
+
+		// A level only reads the world matrices and dirty flags of the one
+		// above it, so each level is safe to split across threads.
+		for (auto level = 1UL; level < m_LevelOffsets.size(); level++) {
+			const auto begin = m_LevelOffsets[level - 1];
+			const auto end   = m_LevelOffsets[level];
+
+			if (pool != nullptr && end - begin > kParallelGrainSize) {
+				pool->ParallelFor(end - begin, kParallelGrainSize, [this, begin](std::size_t first, std::size_t last) {
+					UpdateRange(begin + first, begin + last);
+				});
+			} else {
+				UpdateRange(begin, end);
+			}
+		}
+
+		std::swap(m_Dirty, m_Changed);
+		std::fill(m_Dirty.begin(), m_Dirty.end(), U8(0));
+	}
+
+	auto TransformHierarchy::IndexOf(NodeID node) const noexcept -> Index
+	{
+		return node < m_Indices.size() ? m_Indices[node] : kInvalidIndex;
+	}
+
+	auto TransformHierarchy::Sort() -> void
+	{
+		const auto nNodes = m_IDs.size();
+
+		// Children lists, in CSR form
+		auto childOffsets = std::vector<Index>(nNodes + 1, 0);
+		for (const auto parent : m_Parents) {
+			if (parent != kInvalidIndex) {
+				childOffsets[parent + 1]++;
+			}
+		}
+		for (auto i = 1UL; i <= nNodes; i++) {
+			childOffsets[i] += childOffsets[i - 1];
+		}
+		auto children = std::vector<Index>(childOffsets.back());
+		auto cursors  = std::vector<Index>(childOffsets.begin(), childOffsets.end() - 1);
+		for (auto i = 0U; i < nNodes; i++) {
+			if (m_Parents[i] != kInvalidIndex) {
+				children[cursors[m_Parents[i]]++] = i;
+			}
+		}
+
+		// Breadth-first, skipping destroyed subtrees
+		auto order = std::vector<Index>();
+		order.reserve(nNodes);
+		for (auto i = 0U; i < nNodes; i++) {
+			if (m_Parents[i] == kInvalidIndex && m_Destroyed[i] == 0) {
+				order.push_back(i);
+			}
+		}
+
+		m_LevelOffsets.assign(1, 0);
+		for (auto begin = std::size_t(0); begin < order.size();) {
+			const auto end = order.size();
+			m_LevelOffsets.push_back(end);
+
+			for (auto i = begin; i < end; i++) {
+				for (auto c = childOffsets[order[i]]; c < childOffsets[order[i] + 1]; c++) {
+					if (m_Destroyed[children[c]] == 0) {
+						order.push_back(children[c]);
+					}
+				}
+			}
+			begin = end;
+		}
+
+		auto newIndices = std::vector<Index>(nNodes, kInvalidIndex);
+		for (auto i = 0U; i < order.size(); i++) {
+			newIndices[order[i]] = i;
+		}
+
+		for (auto i = 0U; i < nNodes; i++) {
+			if (newIndices[i] == kInvalidIndex) {
+				m_Indices[m_IDs[i]] = kInvalidIndex;
+				m_FreeIDs.push_back(m_IDs[i]);
+			}
+		}
+
+		const auto permute = [&order](auto& values) {
+			auto sorted = std::remove_reference_t<decltype(values)>();
+			sorted.reserve(order.size());
+			for (const auto idx : order) {
+				sorted.push_back(values[idx]);
+			}
+			values = std::move(sorted);
+		};
+
+		permute(m_IDs);
+		permute(m_Parents);
+		permute(m_Positions);
+		permute(m_Rotations);
+		permute(m_Scales);
+		permute(m_World);
+		permute(m_Dirty);
+		permute(m_Changed);
+		permute(m_Destroyed);
+
+		for (auto i = 0U; i < m_IDs.size(); i++) {
+			m_Indices[m_IDs[i]] = i;
+			if (m_Parents[i] != kInvalidIndex) {
+				m_Parents[i] = newIndices[m_Parents[i]];
+			}
+		}
+
+		m_NeedsSort = false;
+	}
+
+	auto TransformHierarchy::UpdateRange(std::size_t begin, std::size_t end) noexcept -> void
+	{
+		for (auto i = begin; i < end; i++) {
+			const auto parent = m_Parents[i];
+
+			if (m_Dirty[i] == 0 && (parent == kInvalidIndex || m_Dirty[parent] == 0)) {
+				continue;
+			}
+			m_Dirty[i] = 1; // Propagates to the children, in the next level
+
+			auto local = glm::mat4_cast(m_Rotations[i]);
+			local[0] *= m_Scales[i].x;
+			local[1] *= m_Scales[i].y;
+			local[2] *= m_Scales[i].z;
+			local[3]  = glm::vec4(m_Positions[i], 1.F);
+
+			m_World[i] = parent == kInvalidIndex ? local : m_World[parent] * local;
+		}
+	}
+}
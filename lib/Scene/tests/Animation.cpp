@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "Scene/Animation.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Scene - Animation") {
+	using namespace Gaze;
+	using namespace Gaze::Scene;
+	using Catch::Matchers::WithinAbs;
+
+	// A two-joint arm: the elbow sits one unit along x from the shoulder
+	const auto identity = glm::quat(1.F, 0.F, 0.F, 0.F);
+	auto elbowInverseBind = glm::mat4(1.F);
+	elbowInverseBind[3] = glm::vec4(-1.F, 0.F, 0.F, 1.F);
+
+	auto skeleton = Skeleton();
+	skeleton.joints = {
+		{ "shoulder", -1, glm::mat4(1.F), glm::vec3(0.F), identity, glm::vec3(1.F) },
+		{ "elbow",     0, elbowInverseBind, glm::vec3(1.F, 0.F, 0.F), identity, glm::vec3(1.F) },
+	};
+
+	auto raise = AnimationClip{ .name = "raise", .duration = 2.F, .channels = {} };
+	raise.channels.push_back({
+		.joint     = 0,
+		.positions = { { 0.F, 2.F }, { glm::vec3(0.F), glm::vec3(0.F, 4.F, 0.F) } },
+		.rotations = {},
+		.scales    = {},
+	});
+
+	SECTION("Keys are interpolated and time wraps around the clip") {
+		auto pose = Pose();
+		pose.SetRest(skeleton);
+
+		pose.Sample(raise, .5F);
+		REQUIRE_THAT(pose.Position(0).y, WithinAbs(1.F, 1e-5));
+
+		pose.Sample(raise, 2.5F);
+		REQUIRE_THAT(pose.Position(0).y, WithinAbs(1.F, 1e-5));
+
+		// Joints without keys keep their rest transform
+		REQUIRE_THAT(pose.Position(1).x, WithinAbs(1.F, 1e-5));
+	}
+
+	SECTION("Blending takes the shortest arc") {
+		auto a = Pose(5);
+		auto b = Pose(5);
+
+		// The same rotation with opposite signs, blended halfway, must stay put
+		const auto halfTurn = glm::quat(0.F, 0.F, 0.F, 1.F);
+		a.SetJoint(4, glm::vec3(0.F), halfTurn, glm::vec3(1.F));
+		b.SetJoint(4, glm::vec3(2.F), glm::quat(-0.F, 0.F, 0.F, -1.F), glm::vec3(3.F));
+
+		a.Blend(b, .5F);
+
+		REQUIRE_THAT(a.Position(4).x, WithinAbs(1.F, 1e-5));
+		REQUIRE_THAT(a.Scale(4).y, WithinAbs(2.F, 1e-5));
+		REQUIRE_THAT(std::abs(a.Rotation(4).z), WithinAbs(1.F, 1e-5));
+		REQUIRE_THAT(a.Rotation(0).w, WithinAbs(1.F, 1e-5));
+	}
+
+	SECTION("The rest pose skins to the bind pose") {
+		auto sampler = AnimationSampler(skeleton);
+		auto palette = std::vector<glm::mat4>(skeleton.Size());
+
+		sampler.Evaluate({}, palette);
+
+		for (const auto& joint : palette) {
+			for (auto c = 0; c < 4; c++) {
+				for (auto r = 0; r < 4; r++) {
+					REQUIRE_THAT(joint[c][r], WithinAbs(c == r ? 1.F : 0.F, 1e-5));
+				}
+			}
+		}
+	}
+
+	SECTION("Layers are weighted against each other") {
+		auto sampler = AnimationSampler(skeleton);
+		auto palette = std::vector<glm::mat4>(skeleton.Size());
+
+		const AnimationSampler::Layer layers[] = {
+			{ &raise, 2.F, 3.F }, // Wraps to the start: not raised
+			{ &raise, 1.F, 1.F }, // Raised by 2
+		};
+		sampler.Evaluate(layers, palette);
+
+		REQUIRE_THAT(sampler.GetPose().Position(0).y, WithinAbs(.5F, 1e-5));
+		REQUIRE_THAT(palette[1][3][1], WithinAbs(.5F, 1e-5));
+	}
+}
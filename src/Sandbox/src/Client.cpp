@@ -12,19 +12,37 @@
 #include "WM/Core.hpp"
 #include "WM/Window.hpp"
 
+#include "ECS/Components.hpp"
+#include "ECS/Scheduler.hpp"
+#include "ECS/Systems.hpp"
+#include "ECS/World.hpp"
+
+#include "Jobs/ThreadPool.hpp"
+
+#include "GFX/Bounds.hpp"
 #include "GFX/Camera.hpp"
 #include "GFX/Light.hpp"
 #include "GFX/Renderer.hpp"
 #include "GFX/Primitives.hpp"
+#include "GFX/StaticBatcher.hpp"
+#include "GFX/StatsOverlay.hpp"
+#include "GFX/Terrain.hpp"
 
 #include "Physics/World.hpp"
 #include "Physics/Shape.hpp"
 #include "Physics/Rigidbody.hpp"
 
+#include "Geometry/MeshRegistry.hpp"
+
 #include "IO/Loader/Scene.hpp"
 
+#include "Scene/TransformHierarchy.hpp"
+
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cmath>
+#include <format>
+#include <fstream>
 #include <iostream>
 
 using namespace Gaze;
@@ -51,9 +69,23 @@ private:
 	double m_Yaw{};
 	double m_Pitch{};
 
+	bool m_VertexPulling{};
+	bool m_VisibilityBuffer{};
+	bool m_DeferredShading{};
+
 	Physics::World m_PhysicsWorld;
 	Shared<Physics::Rigidbody> m_RbCube;
-	std::vector<GFX::Object> m_Objects;
+	GFX::StaticBatcher m_StaticBatcher;
+	std::vector<GFX::Object> m_Props; // Scattered far out, drawn as impostors once small on screen
+	GFX::StatsOverlay m_StatsOverlay;
+	Geometry::MeshRegistry m_Meshes;
+
+	Jobs::ThreadPool m_Jobs;
+	ECS::World m_World;
+	ECS::Scheduler m_Systems;
+	ECS::Entity m_Cube;
+
+	Unique<GFX::Terrain> m_Terrain; // Loads tiles on m_Jobs, so it is destroyed first
 };
 
 MyApp::MyApp(int argc, char** argv)
@@ -69,7 +101,12 @@ MyApp::MyApp(int argc, char** argv)
 	m_Cam->SetPosition({ 1.F, 1.F, 1.F });
 	m_Cam->SetFront({ -1.F, -1.F, -1.F });
 
-	m_Rdr = Gaze::GFX::CreateRenderer(m_Win);
+	auto renderThread = 0;
+	if (!m_Config.Get<int>("/Engine/GFX", "RenderThread", renderThread)) {
+		renderThread = 0;
+	}
+
+	m_Rdr = Gaze::GFX::CreateRenderer(m_Win, renderThread != 0);
 	m_Rdr->Clear();
 
 	m_PhysicsWorld.AddRigidbody(MakeShared<Physics::Rigidbody>(MakeUnique<Physics::BoxShape>(10.F, .0002F, 10.F), 0.F));
@@ -78,6 +115,19 @@ MyApp::MyApp(int argc, char** argv)
 	m_RbCube->SetRotation({ 1, 1, 1 }, glm::radians(45.F));
 
 	m_PhysicsWorld.AddRigidbody(m_RbCube);
+
+	m_Cube = m_World.Create(ECS::Transform(), ECS::WorldTransform(), ECS::Rigidbody{ m_RbCube });
+
+	m_Systems.Add(
+		"SyncRigidbodies",
+		{ .reads = ECS::MaskOf<ECS::Rigidbody>(), .writes = ECS::MaskOf<ECS::Transform>() },
+		[](ECS::World& world, ECS::CommandBuffer&) { ECS::SyncRigidbodies(world); }
+	);
+	m_Systems.Add(
+		"UpdateWorldTransforms",
+		{ .reads = ECS::MaskOf<ECS::Transform>(), .writes = ECS::MaskOf<ECS::WorldTransform>() },
+		[this](ECS::World& world, ECS::CommandBuffer&) { ECS::UpdateWorldTransforms(world, &m_Jobs); }
+	);
 }
 
 auto MyApp::OnInit() -> Status
@@ -147,6 +197,35 @@ auto MyApp::OnInit() -> Status
 			if (event.Keycode() == Input::Key::kEscape) {
 				Quit();
 			}
+			if (event.Keycode() == Input::Key::kV) {
+				m_VertexPulling = !m_VertexPulling;
+				m_Rdr->SetVertexPulling(m_VertexPulling);
+			}
+			if (event.Keycode() == Input::Key::kB) {
+				m_VisibilityBuffer = !m_VisibilityBuffer;
+				m_Rdr->SetVisibilityBuffer(m_VisibilityBuffer);
+			}
+			if (event.Keycode() == Input::Key::kG) {
+				m_DeferredShading = !m_DeferredShading;
+				m_Rdr->SetDeferredShading(m_DeferredShading);
+			}
+			if (event.Keycode() == Input::Key::kF3) {
+				m_Rdr->Overlay().ToggleVisible();
+			}
+			if (event.Keycode() == Input::Key::kF12) {
+				// Runs on the capture worker, off the main thread
+				m_Rdr->CaptureFrame([](GFX::Renderer::FrameCapture capture) {
+					auto file = std::ofstream(std::format("capture-{}.ppm", capture.frame), std::ios::binary);
+					file << std::format("P6\n{} {}\n255\n", capture.width, capture.height);
+
+					const auto stride = std::size_t(capture.width) * 4;
+					for (auto y = std::size_t(capture.height); y-- > 0;) {
+						for (auto x = std::size_t(0); x < std::size_t(capture.width); x++) {
+							file.write(reinterpret_cast<const char*>(&capture.pixels[y * stride + x * 4]), 3);
+						}
+					}
+				});
+			}
 
 			if (event.Keycode() == Input::Key::kW) {
 				m_CameraDir.z -= 1;
@@ -175,60 +254,157 @@ auto MyApp::OnInit() -> Status
 	m_Rdr->SetCamera(m_Cam);
 	m_Rdr->SetClearColor(.1F, .1F, .1F, 1.F);
 
-	auto sceneLoader = IO::Loader::Scene();
-	if (sceneLoader.Load("Engine/Assets/3D/Scenes/Default.obj")) {
-		const auto whiteMat = GFX::Material{
-			{ 1.F, 1.F, 1.F },
-			{ .5F, .5F, .5F },
-			32.F
-		};
-
-		for (const auto& mesh : sceneLoader.Meshes()) {
-			m_Objects.emplace_back(GFX::Object{ mesh });
-			m_Objects.back().GetProperties().material = whiteMat;
+	// Rolling hills below the scene, generated as tiles come into range
+	auto terrain = GFX::Terrain::Settings();
+	terrain.tileResolution = 128;
+	terrain.tileSize       = 64.F;
+	terrain.lodDistance    = 24.F;
+	terrain.material       = { .diffuse = { .3F, .5F, .25F }, .specular = {}, .shininess = 1.F };
+	terrain.loader         = [resolution = terrain.tileResolution, size = terrain.tileSize](glm::ivec2 tile) {
+		auto heights = std::vector<F32>();
+		heights.reserve(std::size_t(resolution + 1) * std::size_t(resolution + 1));
+		for (auto z = 0; z <= resolution; z++) {
+			for (auto x = 0; x <= resolution; x++) {
+				const auto world = (glm::vec2(tile) + glm::vec2(F32(x), F32(z)) / F32(resolution)) * size;
+				heights.push_back(-4.F + 3.F * std::sin(world.x * .05F) * std::cos(world.y * .07F));
+			}
 		}
-
-	} else {
-		std::cerr << "Failed to load scene" << std::endl;
-		return Status::Fail;
-	}
-
-	return Status::Success;
-}
-
-auto MyApp::OnUpdate(F64 /*deltaTime*/) -> void
-{
-	m_Rdr->Clear();
+		return heights;
+	};
+	m_Terrain = MakeUnique<GFX::Terrain>(std::move(terrain), &m_Jobs);
 
 	const GFX::Light lights[] = {
 		{
 			.position           = { -5.F, 1.F, 5.F },
+			.direction          = {},
 			.diffuse            = {  3.F, 0.F, 0.F },
 			.ambientCoefficient = .005F,
 			.attenuation        = .5F,
 		},
 		{
 			.position           = { 5.F, 1.F, 5.F },
+			.direction          = {},
 			.diffuse            = { 0.F, 3.F, 0.F },
 			.ambientCoefficient = .005F,
 			.attenuation        = .5F,
 		},
 		{
 			.position           = { 5.F, 1.F, -5.F },
+			.direction          = {},
 			.diffuse            = { 0.F, 0.F,  3.F },
 			.ambientCoefficient = .005F,
 			.attenuation        = .5F,
 		},
 		{
 			.position           = { -5.F, 1.F, -5.F },
+			.direction          = {},
 			.diffuse            = {  3.F, 3.F,  3.F },
 			.ambientCoefficient = .005F,
 			.attenuation        = .5F,
+			.castsShadows       = true,
+		},
+		{
+			.position           = {},
+			.direction          = { -.4F, -1.F, -.3F },
+			.diffuse            = { .6F, .55F, .5F },
+			.ambientCoefficient = .05F,
+			.attenuation        = 0.F,
+			.castsShadows       = true,
 		}
 	};
+	m_Rdr->SetLights(lights, I32(std::size(lights)));
+	m_Rdr->SetShadows(GFX::ShadowCache::Settings());
+	m_Rdr->SetStaticShadowCasters(&m_StaticBatcher);
+	m_Rdr->SetImpostors(GFX::ImpostorAtlas::Settings());
+
+	auto sceneLoader = IO::Loader::Scene();
+	if (sceneLoader.Load("Engine/Assets/3D/Scenes/Default.obj")) {
+		const auto whiteMat = GFX::Material{
+			{ 1.F, 1.F, 1.F },
+			{ .5F, .5F, .5F },
+			32.F
+		};
+
+		// Rebuild the file's node hierarchy to place the meshes in the world
+		auto transforms = Scene::TransformHierarchy();
+		auto nodeIDs    = std::vector<Scene::TransformHierarchy::NodeID>();
+		for (const auto& node : sceneLoader.Nodes()) {
+			const auto parent = node.parent < 0
+				? Scene::TransformHierarchy::kInvalidNode
+				: nodeIDs[std::size_t(node.parent)];
+			const auto id = transforms.Create(parent);
+
+			transforms.SetLocal(id, node.position, node.rotation, node.scale);
+			nodeIDs.push_back(id);
+		}
+		transforms.Update();
+
+		auto meshes = std::vector<Geometry::MeshHandle>();
+		for (const auto& mesh : sceneLoader.Meshes()) {
+			meshes.push_back(m_Meshes.Load(mesh));
+		}
+
+		for (auto i = 0UL; i < sceneLoader.Nodes().size(); i++) {
+			for (const auto meshIdx : sceneLoader.Nodes()[i].meshes) {
+				auto object = GFX::Object{ meshes[meshIdx] };
+				object.GetProperties().transform = transforms.World(nodeIDs[i]);
+				object.GetProperties().material = whiteMat;
+				object.SetStatic(true);
+
+				m_StaticBatcher.Add(object);
+			}
+		}
+		m_StaticBatcher.Build();
+
+		for (auto x = -10; x < 10 && !meshes.empty(); x++) {
+			for (auto z = 4; z < 14; z++) {
+				auto prop = GFX::Object{ meshes.front() };
+				prop.GetProperties().transform = glm::translate(glm::mat4(1.F), { F32(x) * 6.F, 0.F, -F32(z) * 6.F });
+				prop.GetProperties().material = whiteMat;
 
-	for (const auto& object : m_Objects) {
-		m_Rdr->SubmitObject(object, lights, std::size(lights), GFX::Renderer::PrimitiveMode::Triangles);
+				m_Props.push_back(std::move(prop));
+			}
+		}
+	} else {
+		std::cerr << "Failed to load scene" << std::endl;
+		return Status::Fail;
+	}
+
+	return Status::Success;
+}
+
+auto MyApp::OnUpdate(F64 /*deltaTime*/) -> void
+{
+	m_Rdr->Clear();
+
+	const auto frustum = GFX::Frustum(m_Cam->ComputeProjectionMatrix() * m_Cam->ComputeViewMatrix());
+	m_StaticBatcher.Submit(*m_Rdr, frustum);
+
+	m_Systems.Run(m_World, &m_Jobs);
+
+	for (const auto& prop : m_Props) {
+		m_Rdr->SubmitWithImpostor(prop, prop.GetProperties().transform);
+	}
+
+	m_Terrain->Update(m_Cam->Position());
+	m_Rdr->SubmitTerrain(*m_Terrain);
+
+	m_Rdr->Debug().Box(m_World.Get<ECS::WorldTransform>(m_Cube)->matrix, { .5F, .5F, .5F }, { 1.F, 1.F, 0.F, 1.F });
+
+	// Last frame's stats, the current one is still being recorded
+	m_StatsOverlay.Record(m_Rdr->Stats());
+	if (m_Rdr->Overlay().IsVisible()) {
+		const auto net = NetStats();
+		const std::string netLines[] = {
+			std::format(
+				"Net RTT {} ms  loss {:.1f}%  sent {} KiB  recv {} KiB",
+				net.roundTripMs,
+				net.packetLoss * 100.F,
+				net.bytesSent / 1024,
+				net.bytesReceived / 1024
+			),
+		};
+		m_StatsOverlay.Draw(m_Rdr->Overlay(), { 8.F, 8.F }, netLines);
 	}
 
 	m_Rdr->Render();